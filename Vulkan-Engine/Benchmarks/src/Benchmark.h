@@ -0,0 +1,63 @@
+/***************************************************************************
+ * Filename		: Benchmark.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Registration of the cpu benchmarks and a helper that times
+ *				  repeated runs of a piece of work.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Timers/Timer.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Benchmarks
+	{
+		struct BenchmarkCase
+		{
+			const char* Name;
+			void (*Function)();
+		};
+
+		inline std::vector<BenchmarkCase>& GetBenchmarks()
+		{
+			static std::vector<BenchmarkCase> benchmarks; // filled by static registrars before main
+			return benchmarks;
+		}
+
+		struct BenchmarkRegistrar
+		{
+			BenchmarkRegistrar(const char* name, void (*function)()) { GetBenchmarks().push_back({ name, function }); }
+		};
+
+		// runs the work once to warm up the caches, then collects one sample per iteration
+		template<typename Work>
+		TimerStatistics Measure(uint32_t iterations, Work&& work)
+		{
+			work();
+			TimerStatistics statistics;
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				const Timer timer;
+				work();
+				statistics.AddSample(timer.GetMilliseconds());
+			}
+			return statistics;
+		}
+	}
+}
+
+#define VKE_BENCHMARK(name) \
+	static void Benchmark_##name(); \
+	static const ::Vulkan_Engine::Benchmarks::BenchmarkRegistrar s_Benchmark_##name##_Registrar(#name, &Benchmark_##name); \
+	static void Benchmark_##name()
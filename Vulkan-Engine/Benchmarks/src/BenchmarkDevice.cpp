@@ -0,0 +1,378 @@
+/***************************************************************************
+ * Filename		: BenchmarkDevice.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: A vulkan device without a window, with the engine's main
+ *				  pipeline, for benchmarks that record draws on the cpu.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "BenchmarkDevice.h"
+
+#include "Core/Graphics/Pipeline/Shaders/Shader.h"
+#include "Core/Graphics/Pipeline/Shaders/UniformBuffer.h"
+#include "Core/Graphics/Pipeline/Shaders/Vertex.h"
+#include "Core/Logger/Log.h"
+
+#include <array>
+
+using namespace Vulkan_Engine::Graphics;
+
+namespace Vulkan_Engine
+{
+	namespace Benchmarks
+	{
+		namespace
+		{
+			// the benchmarks run from their project directory, like the engine from its own
+			const std::string s_VertexShaderPath = "../Resources/Shaders/SPV/Vert.spv";
+			const std::string s_FragmentShaderPath = "../Resources/Shaders/SPV/Frag.spv";
+
+			void Check(VkResult result, const char* message)
+			{
+				if (result != VK_SUCCESS)
+				{
+					throw std::runtime_error(std::string("[Benchmarks::BenchmarkDevice]: ") + message + " (VkResult " + std::to_string(result) + ")");
+				}
+			}
+		}
+
+		BenchmarkDevice::~BenchmarkDevice()
+		{
+			if (m_LogicalDevice != VK_NULL_HANDLE)
+			{
+				for (size_t i = 0; i < m_Buffers.size(); ++i)
+				{
+					vkDestroyBuffer(m_LogicalDevice, m_Buffers[i], nullptr);
+					m_MemoryAllocator->Free(m_Allocations[i]);
+				}
+				vkDestroyPipeline(m_LogicalDevice, m_Pipeline, nullptr);
+				vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr);
+				vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr); // frees its sets
+				vkDestroyDescriptorSetLayout(m_LogicalDevice, m_DescriptorSetLayout, nullptr);
+				vkDestroyRenderPass(m_LogicalDevice, m_RenderPass, nullptr);
+				m_MemoryAllocator.reset();
+				vkDestroyDevice(m_LogicalDevice, nullptr);
+			}
+			if (m_Instance != VK_NULL_HANDLE)
+			{
+				vkDestroyInstance(m_Instance, nullptr);
+			}
+		}
+
+		Scope<BenchmarkDevice> BenchmarkDevice::Create()
+		{
+			Scope<BenchmarkDevice> device(new BenchmarkDevice());
+			try
+			{
+				device->CreateDevice();
+			}
+			catch (const std::exception& e)
+			{
+				VK_WARN("[Benchmarks]: No vulkan device to record on -> {0}", e.what());
+				return nullptr;
+			}
+			// a device without the engine's shaders or pipeline is an error, not a machine to skip
+			device->CreateRenderPass();
+			device->CreatePipeline();
+			return device;
+		}
+
+		VkDescriptorSet BenchmarkDevice::CreateDescriptorSet(VkBuffer uniformBuffer)
+		{
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.descriptorPool = m_DescriptorPool;
+			allocateInfo.descriptorSetCount = 1;
+			allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+			VkDescriptorSet descriptorSet;
+			Check(vkAllocateDescriptorSets(m_LogicalDevice, &allocateInfo, &descriptorSet), "Failed to allocate descriptor set!");
+
+			// the texture binding stays unwritten, a set that is only recorded and never submitted may leave it undefined
+			VkDescriptorBufferInfo bufferInfo = {};
+			bufferInfo.buffer = uniformBuffer;
+			bufferInfo.offset = 0;
+			bufferInfo.range = sizeof(UniformBuffer);
+			VkWriteDescriptorSet write = {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = descriptorSet;
+			write.dstBinding = 0;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			write.pBufferInfo = &bufferInfo;
+			vkUpdateDescriptorSets(m_LogicalDevice, 1, &write, 0, nullptr);
+			return descriptorSet;
+		}
+
+		DrawCommand BenchmarkDevice::CreateDrawCommand() const
+		{
+			DrawCommand command;
+			command.Pipeline = m_Pipeline;
+			command.PipelineLayout = m_PipelineLayout;
+			command.DynamicOffsetCount = 1;
+			command.VertexBuffer = m_VertexBuffer;
+			command.IndexBuffer = m_IndexBuffer;
+			command.IndexType = VK_INDEX_TYPE_UINT32;
+			command.IndexCount = 3;
+			return command;
+		}
+
+		VkCommandBufferInheritanceInfo BenchmarkDevice::GetInheritanceInfo() const
+		{
+			VkCommandBufferInheritanceInfo inheritanceInfo = {};
+			inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			inheritanceInfo.renderPass = m_RenderPass;
+			inheritanceInfo.subpass = 0;
+			inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+			return inheritanceInfo;
+		}
+
+		VkViewport BenchmarkDevice::GetViewport() const
+		{
+			VkViewport viewport = {};
+			viewport.width = static_cast<float>(s_Extent.width);
+			viewport.height = static_cast<float>(s_Extent.height);
+			viewport.maxDepth = 1.0f;
+			return viewport;
+		}
+
+		VkRect2D BenchmarkDevice::GetScissor() const
+		{
+			VkRect2D scissor = {};
+			scissor.extent = s_Extent;
+			return scissor;
+		}
+
+		void BenchmarkDevice::CreateDevice()
+		{
+			VkApplicationInfo appInfo = {};
+			appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+			appInfo.pApplicationName = "Benchmarks";
+			appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+			appInfo.pEngineName = "Vulkan Engine";
+			appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+			appInfo.apiVersion = VK_API_VERSION_1_1;
+			VkInstanceCreateInfo instanceInfo = {};
+			instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+			instanceInfo.pApplicationInfo = &appInfo;
+			Check(vkCreateInstance(&instanceInfo, nullptr, &m_Instance), "Failed to create instance!");
+
+			// the first discrete gpu with a graphics queue, any device with one otherwise
+			uint32_t deviceCount = 0;
+			vkEnumeratePhysicalDevices(m_Instance, &deviceCount, nullptr);
+			std::vector<VkPhysicalDevice> physicalDevices(deviceCount);
+			vkEnumeratePhysicalDevices(m_Instance, &deviceCount, physicalDevices.data());
+			for (const VkPhysicalDevice physicalDevice : physicalDevices)
+			{
+				uint32_t familyCount = 0;
+				vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+				std::vector<VkQueueFamilyProperties> families(familyCount);
+				vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+				const auto graphicsFamily = std::find_if(families.begin(), families.end(),
+					[](const VkQueueFamilyProperties& family) { return (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0; });
+				if (graphicsFamily == families.end())
+				{
+					continue;
+				}
+				VkPhysicalDeviceProperties properties;
+				vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+				if (m_PhysicalDevice == VK_NULL_HANDLE || (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && m_Properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU))
+				{
+					m_PhysicalDevice = physicalDevice;
+					m_Properties = properties;
+					m_QueueFamilyIndex = static_cast<uint32_t>(graphicsFamily - families.begin());
+				}
+			}
+			if (m_PhysicalDevice == VK_NULL_HANDLE)
+			{
+				throw std::runtime_error("[Benchmarks::BenchmarkDevice]: No device with a graphics queue!");
+			}
+
+			// the queue is never submitted to, a device needs at least one
+			const float queuePriority = 1.0f;
+			VkDeviceQueueCreateInfo queueInfo = {};
+			queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueInfo.queueFamilyIndex = m_QueueFamilyIndex;
+			queueInfo.queueCount = 1;
+			queueInfo.pQueuePriorities = &queuePriority;
+			VkDeviceCreateInfo deviceInfo = {};
+			deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+			deviceInfo.queueCreateInfoCount = 1;
+			deviceInfo.pQueueCreateInfos = &queueInfo;
+			Check(vkCreateDevice(m_PhysicalDevice, &deviceInfo, nullptr, &m_LogicalDevice), "Failed to create logical device!");
+
+			VkPhysicalDeviceMemoryProperties memoryProperties;
+			vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memoryProperties);
+			m_MemoryAllocator = CreateScope<DeviceMemoryAllocator>(m_LogicalDevice, memoryProperties);
+		}
+
+		void BenchmarkDevice::CreateRenderPass()
+		{
+			// a single color attachment, the format every device supports as one
+			VkAttachmentDescription colorAttachment = {};
+			colorAttachment.format = VK_FORMAT_R8G8B8A8_UNORM;
+			colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+			colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			VkAttachmentReference colorAttachmentRef = {};
+			colorAttachmentRef.attachment = 0;
+			colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			VkSubpassDescription subpass = {};
+			subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			subpass.colorAttachmentCount = 1;
+			subpass.pColorAttachments = &colorAttachmentRef;
+			VkRenderPassCreateInfo renderPassInfo = {};
+			renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+			renderPassInfo.attachmentCount = 1;
+			renderPassInfo.pAttachments = &colorAttachment;
+			renderPassInfo.subpassCount = 1;
+			renderPassInfo.pSubpasses = &subpass;
+			Check(vkCreateRenderPass(m_LogicalDevice, &renderPassInfo, nullptr, &m_RenderPass), "Failed to create render pass!");
+		}
+
+		void BenchmarkDevice::CreatePipeline()
+		{
+			// set 0 of the window: the uniform buffer read at a dynamic offset and the texture
+			const std::array<VkDescriptorSetLayoutBinding, 2> bindings =
+			{
+				VkDescriptorSetLayoutBinding{ 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+				VkDescriptorSetLayoutBinding{ 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr }
+			};
+			VkDescriptorSetLayoutCreateInfo setLayoutInfo = {};
+			setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+			setLayoutInfo.pBindings = bindings.data();
+			Check(vkCreateDescriptorSetLayout(m_LogicalDevice, &setLayoutInfo, nullptr, &m_DescriptorSetLayout), "Failed to create descriptor set layout!");
+
+			const std::array<VkDescriptorPoolSize, 2> poolSizes =
+			{
+				VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, s_MaxDescriptorSets },
+				VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, s_MaxDescriptorSets }
+			};
+			VkDescriptorPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.maxSets = s_MaxDescriptorSets;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolInfo.pPoolSizes = poolSizes.data();
+			Check(vkCreateDescriptorPool(m_LogicalDevice, &poolInfo, nullptr, &m_DescriptorPool), "Failed to create descriptor pool!");
+
+			// the range is declared whether or not Vert.spv was compiled with the push constant block, a layout may cover more than its shaders use
+			VkPushConstantRange pushConstantRange = {};
+			pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			pushConstantRange.offset = 0;
+			pushConstantRange.size = sizeof(DrawPushConstants);
+			VkPipelineLayoutCreateInfo layoutInfo = {};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			layoutInfo.setLayoutCount = 1;
+			layoutInfo.pSetLayouts = &m_DescriptorSetLayout;
+			layoutInfo.pushConstantRangeCount = 1;
+			layoutInfo.pPushConstantRanges = &pushConstantRange;
+			Check(vkCreatePipelineLayout(m_LogicalDevice, &layoutInfo, nullptr, &m_PipelineLayout), "Failed to create pipeline layout!");
+
+			const Shader vertexShader(s_VertexShaderPath, &m_LogicalDevice);
+			const Shader fragmentShader(s_FragmentShaderPath, &m_LogicalDevice);
+			std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages = {};
+			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+			shaderStages[0].module = vertexShader.GetShaderModule();
+			shaderStages[0].pName = "main";
+			shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+			shaderStages[1].module = fragmentShader.GetShaderModule();
+			shaderStages[1].pName = "main";
+
+			// the full precision vertex, what Vert.spv reads
+			const VkVertexInputBindingDescription bindingDescription = VertexLayout<Vertex>::GetBindingDescription();
+			const auto attributeDescriptions = VertexLayout<Vertex>::GetAttributeDescriptions();
+			VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
+			vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+			vertexInputInfo.vertexBindingDescriptionCount = 1;
+			vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+			vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+			vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+			VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+			inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+			inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+			VkPipelineViewportStateCreateInfo viewportState = {};
+			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+			viewportState.viewportCount = 1; // dynamic, like the window's
+			viewportState.scissorCount = 1;
+			VkPipelineRasterizationStateCreateInfo rasterizer = {};
+			rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+			rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+			rasterizer.lineWidth = 1.0f;
+			rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+			rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+			VkPipelineMultisampleStateCreateInfo multisampling = {};
+			multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+			multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+			VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+			colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+			VkPipelineColorBlendStateCreateInfo colorBlending = {};
+			colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+			colorBlending.attachmentCount = 1;
+			colorBlending.pAttachments = &colorBlendAttachment;
+			const std::array<VkDynamicState, 2> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+			VkPipelineDynamicStateCreateInfo dynamicState = {};
+			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+			dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+			dynamicState.pDynamicStates = dynamicStates.data();
+
+			VkGraphicsPipelineCreateInfo pipelineInfo = {};
+			pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+			pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
+			pipelineInfo.pStages = shaderStages.data();
+			pipelineInfo.pVertexInputState = &vertexInputInfo;
+			pipelineInfo.pInputAssemblyState = &inputAssembly;
+			pipelineInfo.pViewportState = &viewportState;
+			pipelineInfo.pRasterizationState = &rasterizer;
+			pipelineInfo.pMultisampleState = &multisampling;
+			pipelineInfo.pColorBlendState = &colorBlending;
+			pipelineInfo.pDynamicState = &dynamicState;
+			pipelineInfo.layout = m_PipelineLayout;
+			pipelineInfo.renderPass = m_RenderPass;
+			pipelineInfo.subpass = 0;
+			Check(vkCreateGraphicsPipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline), "Failed to create graphics pipeline!");
+
+			// only bound, never read, their contents don't matter
+			m_VertexBuffer = CreateBuffer(3 * sizeof(Vertex), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+			m_IndexBuffer = CreateBuffer(3 * sizeof(uint32_t), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+		}
+
+		VkBuffer BenchmarkDevice::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage)
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = size;
+			bufferInfo.usage = usage;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			VkBuffer buffer;
+			Check(vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &buffer), "Failed to create buffer!");
+			DeviceAllocation allocation;
+			try
+			{
+				allocation = m_MemoryAllocator->AllocateForBuffer(buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			}
+			catch (const std::exception&)
+			{
+				vkDestroyBuffer(m_LogicalDevice, buffer, nullptr);
+				throw;
+			}
+			m_Buffers.push_back(buffer);
+			m_Allocations.push_back(allocation);
+			return buffer;
+		}
+	}
+}
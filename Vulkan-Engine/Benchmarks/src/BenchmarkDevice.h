@@ -0,0 +1,82 @@
+/***************************************************************************
+ * Filename		: BenchmarkDevice.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: A vulkan device without a window, with the engine's main
+ *				  pipeline, for benchmarks that record draws on the cpu.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Core.h"
+#include "Core/Graphics/Commands/DrawList.h"
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Benchmarks
+	{
+		// nothing is ever submitted, command buffers are recorded inside the render pass and thrown away. The pipeline is built
+		// from Vert.spv / Frag.spv with the layout the window uses (a dynamic uniform buffer and a texture in set 0) plus a
+		// push constant range for DrawPushConstants, so both the uniform and the push constant paths can be recorded with it
+		class BenchmarkDevice
+		{
+		public:
+			~BenchmarkDevice();
+			BenchmarkDevice(const BenchmarkDevice&) = delete;
+			BenchmarkDevice& operator=(const BenchmarkDevice&) = delete;
+		public:
+			// nullptr (with a warning) when there is no vulkan driver or device with a graphics queue, the caller skips its benchmark
+			static Scope<BenchmarkDevice> Create();
+			// set 0 with its uniform buffer binding pointing at one UniformBuffer of uniformBuffer, read at a dynamic offset
+			VkDescriptorSet CreateDescriptorSet(VkBuffer uniformBuffer);
+			// one indexed triangle of the pipeline, without its descriptor set and push constants
+			_NODISCARD Graphics::DrawCommand CreateDrawCommand() const;
+			// inside the render pass, the framebuffer is left unknown
+			_NODISCARD VkCommandBufferInheritanceInfo GetInheritanceInfo() const;
+			_NODISCARD VkViewport GetViewport() const;
+			_NODISCARD VkRect2D GetScissor() const;
+			_NODISCARD VkDevice GetLogicalDevice() const { return m_LogicalDevice; }
+			_NODISCARD uint32_t GetQueueFamilyIndex() const { return m_QueueFamilyIndex; }
+			_NODISCARD Graphics::DeviceMemoryAllocator& GetMemoryAllocator() { return *m_MemoryAllocator; }
+			_NODISCARD VkDeviceSize GetMinUniformBufferOffsetAlignment() const { return m_Properties.limits.minUniformBufferOffsetAlignment; }
+			_NODISCARD const char* GetDeviceName() const { return m_Properties.deviceName; }
+		private:
+			BenchmarkDevice() = default;
+			void CreateDevice(); // throws when there is no device to run on
+			void CreateRenderPass();
+			void CreatePipeline();
+			VkBuffer CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage);
+		private:
+			static constexpr uint32_t s_MaxDescriptorSets = 4;
+			static constexpr VkExtent2D s_Extent = { 1280, 720 };
+		private:
+			VkInstance m_Instance = VK_NULL_HANDLE;
+			VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+			VkPhysicalDeviceProperties m_Properties = {};
+			VkDevice m_LogicalDevice = VK_NULL_HANDLE;
+			uint32_t m_QueueFamilyIndex = 0;
+			Scope<Graphics::DeviceMemoryAllocator> m_MemoryAllocator;
+			VkRenderPass m_RenderPass = VK_NULL_HANDLE;
+			VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+			VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+			VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+			VkPipeline m_Pipeline = VK_NULL_HANDLE;
+			VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+			VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+			std::vector<VkBuffer> m_Buffers;
+			std::vector<Graphics::DeviceAllocation> m_Allocations; // of m_Buffers
+		};
+	}
+}
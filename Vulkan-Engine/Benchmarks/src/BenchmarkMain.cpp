@@ -0,0 +1,54 @@
+/***************************************************************************
+ * Filename		: BenchmarkMain.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Runs the registered benchmarks, optionally only the ones
+ *				  whose name contains the first argument.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+
+#include "Core/Logger/Log.h"
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+
+int main(int argc, char** argv)
+{
+	Log::Init();
+	// Benchmarks [filter]
+	const std::string filter = argc > 1 ? argv[1] : "";
+	uint32_t ran = 0;
+	for (const BenchmarkCase& benchmark : GetBenchmarks())
+	{
+		if (!filter.empty() && std::string(benchmark.Name).find(filter) == std::string::npos)
+		{
+			continue;
+		}
+		VK_INFO("[Benchmarks]: {0}", benchmark.Name);
+		try
+		{
+			benchmark.Function();
+			++ran;
+		}
+		catch (const std::exception& e)
+		{
+			VK_ERROR("[Benchmarks]: {0} failed -> {1}", benchmark.Name, e.what());
+			return EXIT_FAILURE;
+		}
+	}
+	if (ran == 0)
+	{
+		VK_ERROR("[Benchmarks]: No benchmark matches '{0}'", filter);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
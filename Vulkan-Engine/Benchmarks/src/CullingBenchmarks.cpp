@@ -0,0 +1,106 @@
+/***************************************************************************
+ * Filename		: CullingBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Cpu frustum culling of a million bounding spheres with
+ *				  every simd level, on one thread and across the job system.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+
+#include "Core/Graphics/Culling/FrustumCuller.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_ObjectCount = 1000000;
+	constexpr uint32_t s_Iterations = 50;
+
+	// random spheres in a cube around the camera's target, the camera sits inside the cube so only a small share is visible
+	CullingBounds CreateBounds()
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> radius(0.01f, 1.0f);
+		CullingBounds bounds;
+		bounds.Reserve(s_ObjectCount);
+		for (uint32_t i = 0; i < s_ObjectCount; ++i)
+		{
+			bounds.Add(glm::vec4(position(random), position(random), position(random), radius(random)));
+		}
+		return bounds;
+	}
+
+	Frustum CreateFrustum()
+	{
+		const glm::mat4 view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 10.0f);
+		projection[1][1] *= -1;
+		return Frustum::FromMatrix(projection * view);
+	}
+}
+
+VKE_BENCHMARK(FrustumCulling)
+{
+	const CullingBounds bounds = CreateBounds();
+	const Frustum frustum = CreateFrustum();
+
+	// one thread, the scalar result is the reference every other level has to match
+	std::vector<uint8_t> reference((s_ObjectCount + 7) / 8);
+	double scalarAverage = 0.0;
+	for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 })
+	{
+		if (level > CpuFeatures::GetSimdLevel())
+		{
+			break;
+		}
+		std::vector<uint8_t> visibility(reference.size());
+		uint32_t visibleCount = 0;
+		const TimerStatistics statistics = Measure(s_Iterations, [&]()
+		{
+			visibleCount = FrustumCuller::CullSpheres(frustum, bounds, 0, bounds.GetCount(), visibility.data(), level);
+		});
+		if (level == SimdLevel::Scalar)
+		{
+			reference = visibility;
+			scalarAverage = statistics.GetAverage();
+		}
+		else if (visibility != reference)
+		{
+			throw std::runtime_error(std::string(CpuFeatures::GetSimdLevelName(level)) + " visibility differs from the scalar reference");
+		}
+		VK_INFO("[Benchmarks]: {0} {1} objects ({2} visible) on 1 thread: {3:.3f}ms (min {4:.3f}ms), {5:.2f}ns per object, {6:.2f}x",
+			CpuFeatures::GetSimdLevelName(level), s_ObjectCount, visibleCount, statistics.GetAverage(), statistics.GetMin(),
+			statistics.GetAverage() * 1e6 / s_ObjectCount, scalarAverage / statistics.GetAverage());
+	}
+
+	// the batches of the fastest level across the workers
+	JobSystem::Init();
+	std::vector<uint8_t> visibility;
+	const TimerStatistics parallel = Measure(s_Iterations, [&]() { FrustumCuller::Cull(frustum, bounds, visibility); });
+	const uint32_t threadCount = JobSystem::GetThreadCount();
+	JobSystem::Shutdown();
+	if (visibility != reference)
+	{
+		throw std::runtime_error("Cull visibility differs from the scalar reference");
+	}
+	VK_INFO("[Benchmarks]: {0} {1} objects on {2} threads: {3:.3f}ms (min {4:.3f}ms), {5:.2f}x", CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()),
+		s_ObjectCount, threadCount, parallel.GetAverage(), parallel.GetMin(), scalarAverage / parallel.GetAverage());
+}
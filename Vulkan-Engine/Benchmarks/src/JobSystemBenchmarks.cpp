@@ -0,0 +1,88 @@
+/***************************************************************************
+ * Filename		: JobSystemBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: ParallelFor scaling over batch sizes against a serial loop
+ *				  and the cost of scheduling a single job.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+#include <cmath>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+
+namespace
+{
+	constexpr uint32_t s_ItemCount = 1u << 22;
+	constexpr uint32_t s_Iterations = 20;
+
+	// a few dozen cycles per item, roughly the cost of testing one bounding volume
+	uint64_t ProcessItems(uint32_t first, uint32_t last)
+	{
+		uint64_t sum = 0;
+		for (uint32_t i = first; i < last; ++i)
+		{
+			const float value = static_cast<float>(i);
+			sum += static_cast<uint64_t>(std::sqrt(value) * 3.f + value * 0.5f);
+		}
+		return sum;
+	}
+}
+
+VKE_BENCHMARK(JobSystemParallelFor)
+{
+	uint64_t serialSum = 0;
+	const TimerStatistics serial = Measure(s_Iterations, [&serialSum]() { serialSum = ProcessItems(0, s_ItemCount); });
+	VK_INFO("[Benchmarks]: Serial {0} items: {1:.3f}ms (min {2:.3f}ms)", s_ItemCount, serial.GetAverage(), serial.GetMin());
+
+	JobSystem::Init();
+	for (uint32_t batchSize : { 64u, 1024u, 16384u, 262144u })
+	{
+		std::atomic<uint64_t> sum{ 0 };
+		const TimerStatistics parallel = Measure(s_Iterations, [&sum, batchSize]()
+		{
+			sum = 0;
+			JobSystem::ParallelFor(s_ItemCount, batchSize, [&sum](uint32_t first, uint32_t last) { sum += ProcessItems(first, last); });
+		});
+		if (sum != serialSum)
+		{
+			JobSystem::Shutdown();
+			throw std::runtime_error("ParallelFor result differs from the serial loop");
+		}
+		VK_INFO("[Benchmarks]: ParallelFor batch {0} on {1} threads: {2:.3f}ms (min {3:.3f}ms), {4:.2f}x", batchSize, JobSystem::GetThreadCount(),
+			parallel.GetAverage(), parallel.GetMin(), serial.GetAverage() / parallel.GetAverage());
+	}
+	JobSystem::Shutdown();
+}
+
+VKE_BENCHMARK(JobSystemScheduling)
+{
+	constexpr uint32_t jobCount = 100000;
+	JobSystem::Init();
+	std::atomic<uint32_t> ran{ 0 };
+	const TimerStatistics statistics = Measure(s_Iterations, [&ran]()
+	{
+		JobCounter counter;
+		for (uint32_t i = 0; i < jobCount; ++i)
+		{
+			JobSystem::Execute([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+		}
+		JobSystem::Wait(counter);
+	});
+	VK_INFO("[Benchmarks]: {0} empty jobs on {1} threads: {2:.3f}ms, {3:.1f}ns per job", jobCount, JobSystem::GetThreadCount(),
+		statistics.GetAverage(), statistics.GetAverage() * 1e6f / jobCount);
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ * Filename		: PushConstantBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Building and recording 10k draws that each get their own
+ *				  transform, through a uniform block or a push constant.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+#include "BenchmarkDevice.h"
+
+#include "Core/Graphics/Commands/ParallelCommandRecorder.h"
+#include "Core/Graphics/Memory/UniformRingBuffer.h"
+#include "Core/Graphics/Pipeline/Shaders/UniformBuffer.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_DrawCount = 10000;
+	constexpr uint32_t s_Iterations = 100;
+}
+
+VKE_BENCHMARK(PushConstantDraws)
+{
+	const Scope<BenchmarkDevice> device = BenchmarkDevice::Create();
+	if (!device)
+	{
+		VK_WARN("[Benchmarks]: Skipped");
+		return;
+	}
+
+	// the uniform path writes a whole block per draw and binds it at its dynamic offset, the push constant path shares
+	// one block (view / projection) between every draw and pushes the model matrix
+	const VkDeviceSize alignment = device->GetMinUniformBufferOffsetAlignment();
+	UniformRingBuffer perDrawUniforms(device->GetLogicalDevice(), device->GetMemoryAllocator(), 1,
+		UniformRingBuffer::GetAlignedFrameSize(sizeof(UniformBuffer), alignment) * s_DrawCount, alignment);
+	UniformRingBuffer sharedUniforms(device->GetLogicalDevice(), device->GetMemoryAllocator(), 1, sizeof(UniformBuffer), alignment);
+	const DrawCommand command = device->CreateDrawCommand();
+	DrawCommand uniformCommand = command;
+	uniformCommand.DescriptorSet = device->CreateDescriptorSet(perDrawUniforms.GetBuffer());
+	DrawCommand pushCommand = command;
+	pushCommand.DescriptorSet = device->CreateDescriptorSet(sharedUniforms.GetBuffer());
+	UniformBuffer ubo = {};
+	ubo.View = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+	ubo.Projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 10.0f);
+	sharedUniforms.Begin(0);
+	sharedUniforms.Write(ubo, pushCommand.DynamicOffset);
+
+	std::vector<glm::mat4> transforms(s_DrawCount);
+	for (uint32_t i = 0; i < s_DrawCount; ++i)
+	{
+		transforms[i] = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+	}
+
+	// building the draw list and recording it on one thread are timed together. Nothing is submitted, so the pools can be
+	// reset between recordings, the reset is timed with them, a frame does both
+	JobSystem::Init();
+	{
+		ParallelCommandRecorder recorder(device->GetLogicalDevice(), device->GetQueueFamilyIndex(), 1);
+		recorder.SetThreadLimit(1);
+		const VkCommandBufferInheritanceInfo inheritanceInfo = device->GetInheritanceInfo();
+		const VkViewport viewport = device->GetViewport();
+		const VkRect2D scissor = device->GetScissor();
+		DrawList drawList;
+
+		const TimerStatistics uniformTimings = Measure(s_Iterations, [&]()
+		{
+			drawList.Clear();
+			recorder.Reset(0);
+			perDrawUniforms.Begin(0);
+			for (uint32_t i = 0; i < s_DrawCount; ++i)
+			{
+				ubo.Model = transforms[i];
+				perDrawUniforms.Write(ubo, uniformCommand.DynamicOffset);
+				drawList.Add(uniformCommand);
+			}
+			recorder.Record(0, drawList, inheritanceInfo, viewport, scissor);
+		});
+
+		const TimerStatistics pushTimings = Measure(s_Iterations, [&]()
+		{
+			drawList.Clear();
+			recorder.Reset(0);
+			for (uint32_t i = 0; i < s_DrawCount; ++i)
+			{
+				DrawPushConstants pushConstants;
+				pushConstants.Model = transforms[i];
+				drawList.Add(pushCommand, &pushConstants, sizeof(pushConstants), VK_SHADER_STAGE_VERTEX_BIT);
+			}
+			recorder.Record(0, drawList, inheritanceInfo, viewport, scissor);
+		});
+		recorder.Reset(0);
+
+		VK_INFO("[Benchmarks]: {0} draws with a uniform block each ({1}): {2:.3f}ms (min {3:.3f}ms, max {4:.3f}ms)", s_DrawCount,
+			device->GetDeviceName(), uniformTimings.GetAverage(), uniformTimings.GetMin(), uniformTimings.GetMax());
+		VK_INFO("[Benchmarks]: {0} draws with push constants ({1}): {2:.3f}ms (min {3:.3f}ms, max {4:.3f}ms), {5:.2f}x", s_DrawCount,
+			device->GetDeviceName(), pushTimings.GetAverage(), pushTimings.GetMin(), pushTimings.GetMax(), uniformTimings.GetAverage() / pushTimings.GetAverage());
+	}
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+ * Filename		: RecordingBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Recording of a large draw list into secondary command
+ *				  buffers on one thread and on every job system thread.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+#include "BenchmarkDevice.h"
+
+#include "Core/Graphics/Commands/ParallelCommandRecorder.h"
+#include "Core/Graphics/Memory/UniformRingBuffer.h"
+#include "Core/Graphics/Pipeline/Shaders/UniformBuffer.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_DrawCount = 20000;
+	constexpr uint32_t s_Iterations = 100;
+}
+
+VKE_BENCHMARK(SecondaryCommandRecording)
+{
+	const Scope<BenchmarkDevice> device = BenchmarkDevice::Create();
+	if (!device)
+	{
+		VK_WARN("[Benchmarks]: Skipped");
+		return;
+	}
+
+	// the same draw repeated, every draw binds its uniform block at the same offset so only the draw itself is recorded again
+	UniformRingBuffer uniforms(device->GetLogicalDevice(), device->GetMemoryAllocator(), 1, sizeof(UniformBuffer), device->GetMinUniformBufferOffsetAlignment());
+	DrawCommand command = device->CreateDrawCommand();
+	command.DescriptorSet = device->CreateDescriptorSet(uniforms.GetBuffer());
+	DrawList drawList;
+	for (uint32_t i = 0; i < s_DrawCount; ++i)
+	{
+		drawList.Add(command);
+	}
+
+	// nothing is submitted, so the pools can be reset between recordings. The reset is timed with the recording, a frame does both
+	JobSystem::Init();
+	{
+		ParallelCommandRecorder recorder(device->GetLogicalDevice(), device->GetQueueFamilyIndex(), 1);
+		const VkCommandBufferInheritanceInfo inheritanceInfo = device->GetInheritanceInfo();
+		const VkViewport viewport = device->GetViewport();
+		const VkRect2D scissor = device->GetScissor();
+		double singleThreadAverage = 0.0;
+		for (uint32_t threadCount = 1; threadCount <= recorder.GetThreadCount(); ++threadCount)
+		{
+			recorder.SetThreadLimit(threadCount);
+			const TimerStatistics statistics = Measure(s_Iterations, [&]()
+			{
+				recorder.Reset(0);
+				recorder.Record(0, drawList, inheritanceInfo, viewport, scissor);
+			});
+			if (threadCount == 1)
+			{
+				singleThreadAverage = statistics.GetAverage();
+			}
+			VK_INFO("[Benchmarks]: {0} draws on {1} threads ({2}): {3:.3f}ms (min {4:.3f}ms, max {5:.3f}ms), {6:.2f}x", s_DrawCount, threadCount,
+				device->GetDeviceName(), statistics.GetAverage(), statistics.GetMin(), statistics.GetMax(), singleThreadAverage / statistics.GetAverage());
+		}
+		recorder.Reset(0);
+	}
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ * Filename		: SceneBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Bounding volume hierarchy build (serial and with jobs),
+ *				  refit and frustum / ray / box queries on 200k objects.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+#include "Core/Scene/Bvh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_ObjectCount = 200000; // random boxes in a s_Extent sized cube
+	constexpr float s_Extent = 1000.0f;
+	constexpr uint32_t s_QueryCount = 10000; // rays / boxes per query sample
+	constexpr uint32_t s_Iterations = 10;
+
+	std::vector<Aabb> CreateBounds(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> position(-0.5f * s_Extent, 0.5f * s_Extent);
+		std::uniform_real_distribution<float> size(0.1f, 5.0f);
+		std::vector<Aabb> bounds(s_ObjectCount);
+		for (Aabb& box : bounds)
+		{
+			const glm::vec3 center(position(random), position(random), position(random));
+			const glm::vec3 extents(size(random), size(random), size(random));
+			box = Aabb(center - extents, center + extents);
+		}
+		return bounds;
+	}
+
+	// the camera looks at the center of the cube from outside of it
+	Frustum CreateFrustum()
+	{
+		const glm::mat4 view = glm::lookAt(glm::vec3(s_Extent), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 2.0f * s_Extent);
+		projection[1][1] *= -1;
+		return Frustum::FromMatrix(projection * view);
+	}
+}
+
+VKE_BENCHMARK(SceneHierarchy)
+{
+	std::mt19937 random(42);
+	std::vector<Aabb> bounds = CreateBounds(random);
+
+	JobSystem::Init();
+	Bvh hierarchy;
+	for (const bool parallel : { false, true })
+	{
+		const TimerStatistics build = Measure(s_Iterations, [&]() { hierarchy.Build(bounds, parallel); });
+		VK_INFO("[Benchmarks]: {0} build of {1} objects on {2} threads: {3:.3f}ms (min {4:.3f}ms), {5} nodes, cost {6:.2f}",
+			parallel ? "Parallel" : "Serial", s_ObjectCount, parallel ? JobSystem::GetThreadCount() : 1, build.GetAverage(), build.GetMin(),
+			hierarchy.GetNodeCount(), hierarchy.GetCost());
+	}
+	JobSystem::Shutdown();
+
+	// every box moves a little, the tree keeps its topology
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+	for (Aabb& box : bounds)
+	{
+		const glm::vec3 movement(offset(random), offset(random), offset(random));
+		box = Aabb(box.Min + movement, box.Max + movement);
+	}
+	const TimerStatistics refit = Measure(s_Iterations, [&]() { hierarchy.Refit(bounds); });
+	VK_INFO("[Benchmarks]: Refit {0:.3f}ms (min {1:.3f}ms), cost {2:.2f}", refit.GetAverage(), refit.GetMin(), hierarchy.GetCost());
+
+	const Frustum frustum = CreateFrustum();
+	std::vector<uint32_t> objects;
+	const TimerStatistics frustumQuery = Measure(s_Iterations, [&]()
+	{
+		objects.clear();
+		hierarchy.QueryFrustum(frustum, objects);
+	});
+	VK_INFO("[Benchmarks]: Frustum query {0:.3f}ms (min {1:.3f}ms), {2} objects", frustumQuery.GetAverage(), frustumQuery.GetMin(), objects.size());
+
+	// the queries are generated up front so only the traversal is timed
+	std::uniform_real_distribution<float> position(-0.5f * s_Extent, 0.5f * s_Extent);
+	std::vector<glm::vec3> origins(s_QueryCount);
+	std::vector<glm::vec3> directions(s_QueryCount);
+	for (uint32_t i = 0; i < s_QueryCount; ++i)
+	{
+		origins[i] = glm::vec3(position(random), position(random), position(random));
+		directions[i] = glm::vec3(offset(random), offset(random), offset(random));
+	}
+
+	uint32_t hitCount = 0;
+	const TimerStatistics rays = Measure(s_Iterations, [&]()
+	{
+		hitCount = 0;
+		for (uint32_t i = 0; i < s_QueryCount; ++i)
+		{
+			BvhRayHit hit;
+			hitCount += hierarchy.Raycast(origins[i], directions[i], s_Extent, hit) ? 1 : 0;
+		}
+	});
+	VK_INFO("[Benchmarks]: {0} rays {1:.3f}ms (min {2:.3f}ms), {3:.0f} rays/s, {4} hits", s_QueryCount, rays.GetAverage(), rays.GetMin(),
+		s_QueryCount * 1000.0 / rays.GetAverage(), hitCount);
+
+	const TimerStatistics boxes = Measure(s_Iterations, [&]()
+	{
+		objects.clear();
+		for (uint32_t i = 0; i < s_QueryCount; ++i)
+		{
+			hierarchy.QueryBox(Aabb(origins[i] - glm::vec3(10.0f), origins[i] + glm::vec3(10.0f)), objects);
+		}
+	});
+	VK_INFO("[Benchmarks]: {0} box queries {1:.3f}ms (min {2:.3f}ms), {3:.0f} queries/s, {4} objects", s_QueryCount, boxes.GetAverage(),
+		boxes.GetMin(), s_QueryCount * 1000.0 / boxes.GetAverage(), objects.size());
+}
@@ -0,0 +1,98 @@
+/***************************************************************************
+ * Filename		: UniformBenchmarks.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Per object uniform blocks written through the uniform ring
+ *				  against plain copies into the same host arena.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Benchmark.h"
+
+#include "Core/Graphics/Memory/UniformRingBuffer.h"
+#include "Core/Graphics/Pipeline/Shaders/UniformBuffer.h"
+#include "Core/Logger/Log.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Benchmarks;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_ObjectCount = 10000; // uniform blocks written per frame
+	constexpr uint32_t s_Iterations = 100;
+	constexpr VkDeviceSize s_MinOffsetAlignment = 256; // the largest minUniformBufferOffsetAlignment a device may report
+
+	std::vector<UniformBuffer> CreateBlocks()
+	{
+		const glm::mat4 view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+		const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 10.0f);
+		std::vector<UniformBuffer> blocks(s_ObjectCount);
+		for (uint32_t i = 0; i < s_ObjectCount; ++i)
+		{
+			blocks[i].Model = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+			blocks[i].View = view;
+			blocks[i].Projection = projection;
+		}
+		return blocks;
+	}
+}
+
+VKE_BENCHMARK(UniformRingWrites)
+{
+	// host memory stands in for the persistently mapped buffer, so only the cpu side of the write is timed. Writes to
+	// write combined device memory are slower, but they are slower for both paths alike
+	const std::vector<UniformBuffer> blocks = CreateBlocks();
+	const VkDeviceSize blockSize = UniformRingBuffer::GetAlignedFrameSize(sizeof(UniformBuffer), s_MinOffsetAlignment);
+	const VkDeviceSize frameSize = blockSize * s_ObjectCount;
+	void* arena = std::malloc(static_cast<size_t>(frameSize));
+	if (arena == nullptr)
+	{
+		throw std::runtime_error("Failed to allocate the uniform arena");
+	}
+	UniformRingBuffer ring(arena, 1, frameSize, s_MinOffsetAlignment);
+
+	// the least a frame can do: each block copied to its aligned slot, offsets known up front
+	const TimerStatistics copies = Measure(s_Iterations, [&]()
+	{
+		for (uint32_t i = 0; i < s_ObjectCount; ++i)
+		{
+			std::memcpy(static_cast<char*>(arena) + i * blockSize, &blocks[i], sizeof(UniformBuffer));
+		}
+	});
+
+	uint32_t lastOffset = 0;
+	const TimerStatistics ringWrites = Measure(s_Iterations, [&]()
+	{
+		ring.Begin(0);
+		for (uint32_t i = 0; i < s_ObjectCount; ++i)
+		{
+			ring.Write(blocks[i], lastOffset);
+		}
+	});
+	std::free(arena);
+	if (lastOffset != (s_ObjectCount - 1) * blockSize)
+	{
+		throw std::runtime_error("The uniform ring didn't place every block in its own aligned slot");
+	}
+
+	const auto logTimings = [](const char* path, const TimerStatistics& timings, double baseline)
+	{
+		VK_INFO("[Benchmarks]: {0} blocks through {1}: {2:.3f}ms ({3:.1f}ns per block), min {4:.3f}ms, max {5:.3f}ms, {6:.2f}x",
+			s_ObjectCount, path, timings.GetAverage(), timings.GetAverage() * 1e6 / s_ObjectCount, timings.GetMin(), timings.GetMax(), timings.GetAverage() / baseline);
+	};
+	logTimings("memcpy", copies, copies.GetAverage());
+	logTimings("the uniform ring", ringWrites, copies.GetAverage());
+}
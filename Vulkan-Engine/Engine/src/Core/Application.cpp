@@ -16,6 +16,7 @@
 #include "Application.h"
 
 #include "Logger/Log.h"
+#include "Jobs/JobSystem.h"
 #include "Graphics/GraphicsSystem.h"
 
 #include "Events/ApplicationEvent.h"
@@ -42,6 +43,7 @@ namespace Vulkan_Engine
 	void Application::Run()
 	{
 		InitLogger();
+		InitJobSystem();
 		InitGraphics();
 		UpdateLoop();
 		Cleanup();
@@ -54,6 +56,13 @@ namespace Vulkan_Engine
 		return VKE_RESULT::VKE_SUCCESS;
 	}
 
+	VKE_RESULT Application::InitJobSystem()
+	{
+		JobSystem::Init(); // before graphics, which sizes its per thread command pools by the worker count
+		VK_CORE_DEBUG("[Application]: Initialized Job System");
+		return VKE_RESULT::VKE_SUCCESS;
+	}
+
 	VKE_RESULT Application::InitGraphics()
 	{
 		VK_CORE_DEBUG("[Application]: Initializing Graphics System");
@@ -80,6 +89,7 @@ namespace Vulkan_Engine
 	{
 		VK_CORE_DEBUG("[Application]: Cleaning up engine data");
 		m_GraphicsSystem->Cleanup();
+		JobSystem::Shutdown();
 		return VKE_RESULT::VKE_SUCCESS;
 	}
 
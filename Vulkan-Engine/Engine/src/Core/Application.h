@@ -37,6 +37,7 @@ namespace Vulkan_Engine
 		void OnEvent(Event& e);
 	private:
 		VKE_RESULT InitLogger();
+		VKE_RESULT InitJobSystem();
 		VKE_RESULT InitGraphics();
 		VKE_RESULT UpdateLoop(); 
 		VKE_RESULT Cleanup();
@@ -0,0 +1,122 @@
+/***************************************************************************
+ * Filename		: DrawList.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: List of draws rebuilt every frame and recorded into the
+ *				  frame's command buffer.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "DrawList.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		void DrawList::Add(const DrawCommand& command, const void* pushConstants, uint32_t size, VkShaderStageFlags stages)
+		{
+			m_Commands.push_back(command);
+			DrawCommand& added = m_Commands.back();
+			added.PushConstantStages = stages;
+			added.PushConstantSize = size;
+			added.PushConstantOffset = static_cast<uint32_t>(m_PushConstantData.size());
+			const uint8_t* data = static_cast<const uint8_t*>(pushConstants);
+			m_PushConstantData.insert(m_PushConstantData.end(), data, data + size);
+		}
+
+		void DrawList::Record(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count) const
+		{
+			VkPipeline boundPipeline = VK_NULL_HANDLE;
+			VkDescriptorSet boundDescriptorSet = VK_NULL_HANDLE;
+			uint32_t boundDynamicOffset = 0;
+			VkDescriptorSet boundBindlessSet = VK_NULL_HANDLE;
+			VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+			VkBuffer boundInstanceBuffer = VK_NULL_HANDLE;
+			VkDeviceSize boundInstanceOffset = 0;
+			VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+			const uint32_t end = std::min(first + count, GetSize());
+			for (uint32_t i = first; i < end; ++i)
+			{
+				const DrawCommand& command = m_Commands[i];
+				if (command.Pipeline != boundPipeline)
+				{
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.Pipeline);
+					boundPipeline = command.Pipeline;
+					boundDescriptorSet = VK_NULL_HANDLE; // the new pipeline may use a different layout, so sets are bound again
+					boundBindlessSet = VK_NULL_HANDLE;
+				}
+				// a new dynamic offset (another block of the uniform arena) also needs the set bound again
+				if (command.DescriptorSet != boundDescriptorSet || (command.DynamicOffsetCount > 0 && command.DynamicOffset != boundDynamicOffset))
+				{
+					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.PipelineLayout, 0, 1, &command.DescriptorSet,
+						command.DynamicOffsetCount, &command.DynamicOffset);
+					boundDescriptorSet = command.DescriptorSet;
+					boundDynamicOffset = command.DynamicOffset;
+				}
+				// rebinding set 0 with the same layout leaves set 1 bound, so the texture / material set is bound once per pipeline
+				if (command.BindlessSet != VK_NULL_HANDLE && command.BindlessSet != boundBindlessSet)
+				{
+					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.PipelineLayout, 1, 1, &command.BindlessSet, 0, nullptr);
+					boundBindlessSet = command.BindlessSet;
+				}
+				if (command.VertexBuffer != boundVertexBuffer)
+				{
+					const VkDeviceSize offset = 0;
+					vkCmdBindVertexBuffers(commandBuffer, 0, 1, &command.VertexBuffer, &offset);
+					boundVertexBuffer = command.VertexBuffer;
+				}
+				if (command.InstanceBuffer != VK_NULL_HANDLE && (command.InstanceBuffer != boundInstanceBuffer || command.InstanceOffset != boundInstanceOffset))
+				{
+					vkCmdBindVertexBuffers(commandBuffer, 1, 1, &command.InstanceBuffer, &command.InstanceOffset);
+					boundInstanceBuffer = command.InstanceBuffer;
+					boundInstanceOffset = command.InstanceOffset;
+				}
+				if (command.IndexBuffer != boundIndexBuffer)
+				{
+					vkCmdBindIndexBuffer(commandBuffer, command.IndexBuffer, 0, command.IndexType);
+					boundIndexBuffer = command.IndexBuffer;
+				}
+				if (command.PushConstantSize > 0)
+				{
+					vkCmdPushConstants(commandBuffer, command.PipelineLayout, command.PushConstantStages, 0, command.PushConstantSize,
+						m_PushConstantData.data() + command.PushConstantOffset);
+				}
+				if (command.IndirectBuffer != VK_NULL_HANDLE)
+				{
+					RecordIndirect(commandBuffer, command);
+				}
+				else
+				{
+					vkCmdDrawIndexed(commandBuffer, command.IndexCount, command.InstanceCount, command.FirstIndex, command.VertexOffset, command.FirstInstance);
+				}
+			}
+		}
+
+		void DrawList::RecordIndirect(VkCommandBuffer commandBuffer, const DrawCommand& command) const
+		{
+			const uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+			if (command.CountBuffer != VK_NULL_HANDLE && m_DrawIndexedIndirectCount != nullptr)
+			{
+				m_DrawIndexedIndirectCount(commandBuffer, command.IndirectBuffer, command.IndirectOffset, command.CountBuffer, command.CountOffset, command.DrawCount, stride);
+			}
+			else if (m_MultiDrawIndirect || command.DrawCount <= 1)
+			{
+				vkCmdDrawIndexedIndirect(commandBuffer, command.IndirectBuffer, command.IndirectOffset, command.DrawCount, stride);
+			}
+			else // without the feature drawCount must be 0 or 1
+			{
+				for (uint32_t i = 0; i < command.DrawCount; ++i)
+				{
+					vkCmdDrawIndexedIndirect(commandBuffer, command.IndirectBuffer, command.IndirectOffset + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+				}
+			}
+		}
+	}
+}
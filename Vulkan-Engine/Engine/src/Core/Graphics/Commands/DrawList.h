@@ -0,0 +1,89 @@
+/***************************************************************************
+ * Filename		: DrawList.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: List of draws rebuilt every frame and recorded into the
+ *				  frame's command buffer.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// everything needed to record a single indexed draw, or a batch of indexed draws read from a buffer
+		// when IndirectBuffer is set (the direct draw parameters are ignored then)
+		struct DrawCommand
+		{
+			VkPipeline Pipeline = VK_NULL_HANDLE;
+			VkPipelineLayout PipelineLayout = VK_NULL_HANDLE;
+			VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+			uint32_t DynamicOffsetCount = 0; // 0 or 1, the set's dynamic uniform buffer
+			uint32_t DynamicOffset = 0;
+			VkDescriptorSet BindlessSet = VK_NULL_HANDLE; // optional set 1 (BindlessDescriptors), only bound again after a pipeline change
+			VkShaderStageFlags PushConstantStages = 0;
+			uint32_t PushConstantSize = 0; // bytes at PushConstantOffset of the list's push constant data, pushed to offset 0
+			uint32_t PushConstantOffset = 0;
+			VkBuffer VertexBuffer = VK_NULL_HANDLE;
+			VkBuffer InstanceBuffer = VK_NULL_HANDLE; // optional per instance vertex data (binding 1)
+			VkDeviceSize InstanceOffset = 0;
+			VkBuffer IndexBuffer = VK_NULL_HANDLE;
+			VkIndexType IndexType = VK_INDEX_TYPE_UINT32;
+			uint32_t IndexCount = 0;
+			uint32_t InstanceCount = 1;
+			uint32_t FirstIndex = 0;
+			int32_t VertexOffset = 0;
+			uint32_t FirstInstance = 0;
+			VkBuffer IndirectBuffer = VK_NULL_HANDLE; // tightly packed VkDrawIndexedIndirectCommand records
+			VkDeviceSize IndirectOffset = 0;
+			uint32_t DrawCount = 0; // records at IndirectOffset, the upper bound when a count buffer is used
+			VkBuffer CountBuffer = VK_NULL_HANDLE; // optional uint32_t draw count written by the cpu or a compute pass
+			VkDeviceSize CountOffset = 0;
+		};
+
+		class DrawList
+		{
+		public:
+			DrawList() = default;
+			~DrawList() = default;
+		public:
+			inline void Add(const DrawCommand& command) { m_Commands.push_back(command); }
+			// copies the push constant data into the list, it is pushed right before the command's draw
+			void Add(const DrawCommand& command, const void* pushConstants, uint32_t size, VkShaderStageFlags stages);
+			inline void Clear() { m_Commands.clear(); m_PushConstantData.clear(); } // keeps the capacity, so steady state frames don't allocate
+			_NODISCARD inline const std::vector<DrawCommand>& GetCommands() const { return m_Commands; }
+			_NODISCARD inline uint32_t GetSize() const { return static_cast<uint32_t>(m_Commands.size()); }
+			_NODISCARD inline bool IsEmpty() const { return m_Commands.empty(); }
+			// records draws [first, first + count) into a command buffer inside a render pass,
+			// state that matches the previous draw is not bound again
+			void Record(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count) const;
+			inline void Record(VkCommandBuffer commandBuffer) const { Record(commandBuffer, 0, GetSize()); }
+			// indirect batches use vkCmdDrawIndexedIndirectCount when a count buffer is set and the function was loaded,
+			// a single multi draw with the multiDrawIndirect feature and one indirect draw per record otherwise
+			inline void SetIndirectSupport(bool multiDrawIndirect, PFN_vkCmdDrawIndexedIndirectCountKHR drawIndexedIndirectCount)
+			{
+				m_MultiDrawIndirect = multiDrawIndirect;
+				m_DrawIndexedIndirectCount = drawIndexedIndirectCount;
+			}
+		private:
+			void RecordIndirect(VkCommandBuffer commandBuffer, const DrawCommand& command) const;
+		private:
+			std::vector<DrawCommand> m_Commands;
+			std::vector<uint8_t> m_PushConstantData;
+			bool m_MultiDrawIndirect = false;
+			PFN_vkCmdDrawIndexedIndirectCountKHR m_DrawIndexedIndirectCount = nullptr;
+		};
+	}
+}
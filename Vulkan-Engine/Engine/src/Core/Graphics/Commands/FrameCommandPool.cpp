@@ -0,0 +1,84 @@
+/***************************************************************************
+ * Filename		: FrameCommandPool.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Transient command pool owned by a single frame in flight,
+ *				  reset as a whole once the frame's fence has signaled.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "FrameCommandPool.h"
+
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		FrameCommandPool::FrameCommandPool(VkDevice logicalDevice, uint32_t queueFamilyIndex)
+			: m_LogicalDevice(logicalDevice)
+		{
+			VkCommandPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			poolInfo.queueFamilyIndex = queueFamilyIndex;
+			// buffers are re-recorded every frame and only ever reset together with the pool
+			poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			if (vkCreateCommandPool(m_LogicalDevice, &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::FrameCommandPool::FrameCommandPool]: Failed to create frame command pool!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+		}
+
+		FrameCommandPool::~FrameCommandPool()
+		{
+			vkDestroyCommandPool(m_LogicalDevice, m_CommandPool, nullptr); // frees every command buffer allocated from it
+		}
+
+		void FrameCommandPool::Reset()
+		{
+			vkResetCommandPool(m_LogicalDevice, m_CommandPool, 0);
+			m_PrimaryUsed = 0;
+			m_SecondaryUsed = 0;
+		}
+
+		VkCommandBuffer FrameCommandPool::GetPrimaryCommandBuffer()
+		{
+			return GetCommandBuffer(m_PrimaryBuffers, m_PrimaryUsed, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		}
+
+		VkCommandBuffer FrameCommandPool::GetSecondaryCommandBuffer()
+		{
+			return GetCommandBuffer(m_SecondaryBuffers, m_SecondaryUsed, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+		}
+
+		VkCommandBuffer FrameCommandPool::GetCommandBuffer(std::vector<VkCommandBuffer>& buffers, uint32_t& used, VkCommandBufferLevel level)
+		{
+			if (used == buffers.size())
+			{
+				VkCommandBufferAllocateInfo allocInfo = {};
+				allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocInfo.commandPool = m_CommandPool;
+				allocInfo.level = level;
+				allocInfo.commandBufferCount = 1;
+				VkCommandBuffer commandBuffer;
+				if (vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &commandBuffer) != VK_SUCCESS)
+				{
+					static const std::string message = "[GraphicsSystem::FrameCommandPool::GetCommandBuffer]: Failed to allocate command buffer!";
+					VK_CORE_CRITICAL(message);
+					throw std::runtime_error(message);
+				}
+				buffers.push_back(commandBuffer);
+			}
+			return buffers[used++];
+		}
+	}
+}
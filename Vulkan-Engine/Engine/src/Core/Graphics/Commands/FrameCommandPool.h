@@ -0,0 +1,50 @@
+/***************************************************************************
+ * Filename		: FrameCommandPool.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Transient command pool owned by a single frame in flight,
+ *				  reset as a whole once the frame's fence has signaled.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// Command buffers handed out are only valid until the next Reset.
+		// They are kept allocated between frames, so after the first few frames no vkAllocateCommandBuffers calls happen.
+		class FrameCommandPool
+		{
+		public:
+			FrameCommandPool(VkDevice logicalDevice, uint32_t queueFamilyIndex);
+			~FrameCommandPool();
+			FrameCommandPool(const FrameCommandPool&) = delete;
+			FrameCommandPool& operator=(const FrameCommandPool&) = delete;
+		public:
+			void Reset(); // vkResetCommandPool, only call once the gpu has finished with every buffer from this pool
+			VkCommandBuffer GetPrimaryCommandBuffer();
+			VkCommandBuffer GetSecondaryCommandBuffer();
+		private:
+			VkCommandBuffer GetCommandBuffer(std::vector<VkCommandBuffer>& buffers, uint32_t& used, VkCommandBufferLevel level);
+		private:
+			VkDevice m_LogicalDevice;
+			VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+			std::vector<VkCommandBuffer> m_PrimaryBuffers;
+			std::vector<VkCommandBuffer> m_SecondaryBuffers;
+			uint32_t m_PrimaryUsed = 0;
+			uint32_t m_SecondaryUsed = 0;
+		};
+	}
+}
@@ -0,0 +1,72 @@
+/***************************************************************************
+ * Filename		: IndirectDrawBuffer.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Host visible buffer of indexed indirect draw records and
+ *				  their draw count, one region per frame in flight.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "IndirectDrawBuffer.h"
+
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		IndirectDrawBuffer::IndirectDrawBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, uint32_t maxDraws)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_MaxDraws(maxDraws),
+			m_FrameSize(s_CountSize + static_cast<VkDeviceSize>(maxDraws) * sizeof(VkDrawIndexedIndirectCommand))
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = m_FrameSize * frameCount;
+			bufferInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_Buffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::IndirectDrawBuffer]: Failed to create indirect draw buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			// written every frame and read once by the gpu, so it stays in host memory
+			m_Allocation = m_Allocator.AllocateForBuffer(m_Buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		}
+
+		IndirectDrawBuffer::~IndirectDrawBuffer()
+		{
+			vkDestroyBuffer(m_LogicalDevice, m_Buffer, nullptr);
+			m_Allocator.Free(m_Allocation);
+		}
+
+		void IndirectDrawBuffer::Begin(uint32_t frameIndex)
+		{
+			m_FrameIndex = frameIndex;
+			m_DrawCount = 0;
+			m_Commands = reinterpret_cast<VkDrawIndexedIndirectCommand*>(static_cast<char*>(m_Allocation.MappedData) + GetCommandOffset());
+		}
+
+		void IndirectDrawBuffer::Add(const VkDrawIndexedIndirectCommand& command)
+		{
+			if (m_DrawCount == m_MaxDraws)
+			{
+				VK_CORE_WARN("[GraphicsSystem::IndirectDrawBuffer::Add]: More than {0} draws in a frame, the rest are dropped!", m_MaxDraws);
+				return;
+			}
+			m_Commands[m_DrawCount++] = command;
+		}
+
+		void IndirectDrawBuffer::End()
+		{
+			*reinterpret_cast<uint32_t*>(static_cast<char*>(m_Allocation.MappedData) + GetCountOffset()) = m_DrawCount;
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/***************************************************************************
+ * Filename		: IndirectDrawBuffer.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Host visible buffer of indexed indirect draw records and
+ *				  their draw count, one region per frame in flight.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// every frame region starts with the uint32_t draw count (padded to 16 bytes) followed by the records, so a
+		// single buffer is the argument and the count buffer of vkCmdDrawIndexedIndirectCount.
+		// Only write the region of a frame whose fence has signaled.
+		class IndirectDrawBuffer
+		{
+		public:
+			IndirectDrawBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, uint32_t maxDraws);
+			~IndirectDrawBuffer();
+			IndirectDrawBuffer(const IndirectDrawBuffer&) = delete;
+			IndirectDrawBuffer& operator=(const IndirectDrawBuffer&) = delete;
+		public:
+			void Begin(uint32_t frameIndex);
+			void Add(const VkDrawIndexedIndirectCommand& command); // records past maxDraws are dropped (with a warning)
+			void End(); // writes the draw count of the frame
+			_NODISCARD VkBuffer GetBuffer() const { return m_Buffer; }
+			_NODISCARD VkDeviceSize GetCountOffset() const { return m_FrameIndex * m_FrameSize; }
+			_NODISCARD VkDeviceSize GetCommandOffset() const { return m_FrameIndex * m_FrameSize + s_CountSize; }
+			_NODISCARD uint32_t GetDrawCount() const { return m_DrawCount; }
+			_NODISCARD uint32_t GetMaxDraws() const { return m_MaxDraws; }
+		public:
+			static constexpr VkDeviceSize s_CountSize = 16; // keeps the records 16 byte aligned
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			VkBuffer m_Buffer = VK_NULL_HANDLE;
+			DeviceAllocation m_Allocation; // persistently mapped
+			uint32_t m_MaxDraws;
+			VkDeviceSize m_FrameSize;
+			uint32_t m_FrameIndex = 0;
+			uint32_t m_DrawCount = 0;
+			VkDrawIndexedIndirectCommand* m_Commands = nullptr; // records of the frame being written
+		};
+	}
+}
@@ -0,0 +1,66 @@
+/***************************************************************************
+ * Filename		: InstanceBatcher.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Groups the instances of a frame by mesh and level of detail,
+ *				  so every group is recorded as a single instanced draw.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "InstanceBatcher.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		void InstanceBatcher::Clear()
+		{
+			m_Keys.clear();
+			m_Added.clear();
+			m_AddedBounds.clear();
+			m_Instances.clear();
+			m_Batches.clear();
+		}
+
+		void InstanceBatcher::Add(uint32_t meshId, uint32_t lod, const glm::mat4& transform, uint32_t materialId, const Aabb& worldBounds)
+		{
+			InstanceData instance = {};
+			instance.Transform = transform;
+			instance.MaterialId = materialId;
+			m_Keys.emplace_back((static_cast<uint64_t>(meshId) << 32) | lod, static_cast<uint32_t>(m_Added.size()));
+			m_Added.push_back(instance);
+			m_AddedBounds.push_back(worldBounds);
+		}
+
+		void InstanceBatcher::Build()
+		{
+			// the index breaks ties, so the order within a batch is the order of Add
+			std::sort(m_Keys.begin(), m_Keys.end());
+			m_Instances.resize(m_Keys.size());
+			m_Batches.clear();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_Keys.size()); ++i)
+			{
+				const uint64_t key = m_Keys[i].first;
+				if (i == 0 || key != m_Keys[i - 1].first)
+				{
+					InstanceBatch batch;
+					batch.MeshId = static_cast<uint32_t>(key >> 32);
+					batch.Lod = static_cast<uint32_t>(key);
+					batch.FirstInstance = i;
+					m_Batches.push_back(batch);
+				}
+				InstanceBatch& batch = m_Batches.back();
+				++batch.InstanceCount;
+				batch.Bounds.Expand(m_AddedBounds[m_Keys[i].second]);
+				m_Instances[i] = m_Added[m_Keys[i].second];
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+/***************************************************************************
+ * Filename		: InstanceBatcher.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Groups the instances of a frame by mesh and level of detail,
+ *				  so every group is recorded as a single instanced draw.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Graphics/Pipeline/Shaders/Vertex.h"
+#include "Core/Scene/Aabb.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		struct InstanceBatch
+		{
+			uint32_t MeshId = 0;
+			uint32_t Lod = 0;
+			uint32_t FirstInstance = 0; // into InstanceBatcher::GetInstances, the firstInstance of the draw
+			uint32_t InstanceCount = 0;
+			Aabb Bounds; // union of the instances' world bounds, what a culler tests the whole batch against
+		};
+
+		// cpu only, Build sorts the instances added since Clear into one contiguous run per (mesh, level of detail).
+		// Batches are ordered by mesh id then level, instances keep the order they were added in within their batch.
+		class InstanceBatcher
+		{
+		public:
+			InstanceBatcher() = default;
+			~InstanceBatcher() = default;
+		public:
+			void Clear(); // keeps the capacity, so steady state frames don't allocate
+			void Add(uint32_t meshId, uint32_t lod, const glm::mat4& transform, uint32_t materialId, const Aabb& worldBounds);
+			void Build();
+			_NODISCARD const std::vector<InstanceData>& GetInstances() const { return m_Instances; } // in batch order after Build
+			_NODISCARD const std::vector<InstanceBatch>& GetBatches() const { return m_Batches; }
+			_NODISCARD uint32_t GetInstanceCount() const { return static_cast<uint32_t>(m_Keys.size()); }
+		private:
+			std::vector<std::pair<uint64_t, uint32_t>> m_Keys; // (mesh << 32 | lod, index into m_Added)
+			std::vector<InstanceData> m_Added; // in the order of Add
+			std::vector<Aabb> m_AddedBounds;
+			std::vector<InstanceData> m_Instances;
+			std::vector<InstanceBatch> m_Batches;
+		};
+	}
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+ * Filename		: InstanceBuffer.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Per frame in flight vertex buffer region for the instance
+ *				  data read by the instanced draws (second vertex binding).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "InstanceBuffer.h"
+
+#include "Core/Logger/Log.h"
+
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		InstanceBuffer::InstanceBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, uint32_t maxInstances)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_MaxInstances(maxInstances),
+			m_FrameSize(static_cast<VkDeviceSize>(maxInstances) * sizeof(InstanceData))
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = m_FrameSize * frameCount;
+			bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_Buffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::InstanceBuffer]: Failed to create instance buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			// rewritten every frame and read once per draw, so it stays in host memory like the indirect records
+			m_Allocation = m_Allocator.AllocateForBuffer(m_Buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		}
+
+		InstanceBuffer::~InstanceBuffer()
+		{
+			vkDestroyBuffer(m_LogicalDevice, m_Buffer, nullptr);
+			m_Allocator.Free(m_Allocation);
+		}
+
+		uint32_t InstanceBuffer::Write(uint32_t frameIndex, const std::vector<InstanceData>& instances)
+		{
+			m_FrameIndex = frameIndex;
+			uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+			if (instanceCount > m_MaxInstances)
+			{
+				VK_CORE_WARN("[GraphicsSystem::InstanceBuffer::Write]: More than {0} instances in a frame, the rest are dropped!", m_MaxInstances);
+				instanceCount = m_MaxInstances;
+			}
+			if (instanceCount > 0)
+			{
+				std::memcpy(static_cast<char*>(m_Allocation.MappedData) + GetOffset(), instances.data(), instanceCount * sizeof(InstanceData));
+			}
+			return instanceCount;
+		}
+	}
+}
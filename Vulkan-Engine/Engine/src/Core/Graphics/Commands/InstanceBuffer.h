@@ -0,0 +1,54 @@
+/***************************************************************************
+ * Filename		: InstanceBuffer.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Per frame in flight vertex buffer region for the instance
+ *				  data read by the instanced draws (second vertex binding).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+#include "Core/Graphics/Pipeline/Shaders/Vertex.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// bind the buffer at GetOffset and draw with firstInstance relative to the written instances.
+		// Only write the region of a frame whose fence has signaled.
+		class InstanceBuffer
+		{
+		public:
+			InstanceBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, uint32_t maxInstances);
+			~InstanceBuffer();
+			InstanceBuffer(const InstanceBuffer&) = delete;
+			InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+		public:
+			// replaces the instances of the frame, instances past maxInstances are dropped (with a warning) -> written count
+			uint32_t Write(uint32_t frameIndex, const std::vector<InstanceData>& instances);
+			_NODISCARD VkBuffer GetBuffer() const { return m_Buffer; }
+			_NODISCARD VkDeviceSize GetOffset() const { return m_FrameIndex * m_FrameSize; }
+			_NODISCARD uint32_t GetMaxInstances() const { return m_MaxInstances; }
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			VkBuffer m_Buffer = VK_NULL_HANDLE;
+			DeviceAllocation m_Allocation; // persistently mapped
+			uint32_t m_MaxInstances;
+			VkDeviceSize m_FrameSize;
+			uint32_t m_FrameIndex = 0;
+		};
+	}
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ * Filename		: ParallelCommandRecorder.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Splits a draw list into jobs which each record a secondary
+ *				  command buffer from the running thread's command pool.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "ParallelCommandRecorder.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		ParallelCommandRecorder::ParallelCommandRecorder(VkDevice logicalDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight)
+			: m_ThreadCount(JobSystem::GetThreadCount()), m_ThreadLimit(JobSystem::GetThreadCount())
+		{
+			// command pools are externally synchronized, so every thread records from its own pool (one per frame in flight)
+			for (uint32_t i = 0; i < framesInFlight * m_ThreadCount; ++i)
+			{
+				m_Pools.push_back(CreateScope<FrameCommandPool>(logicalDevice, queueFamilyIndex));
+			}
+		}
+
+		void ParallelCommandRecorder::Reset(uint32_t frameIndex)
+		{
+			for (uint32_t i = 0; i < m_ThreadCount; ++i)
+			{
+				m_Pools[frameIndex * m_ThreadCount + i]->Reset();
+			}
+		}
+
+		const std::vector<VkCommandBuffer>& ParallelCommandRecorder::Record(uint32_t frameIndex, const DrawList& drawList, const VkCommandBufferInheritanceInfo& inheritance,
+			const VkViewport& viewport, const VkRect2D& scissor)
+		{
+			const uint32_t wantedRanges = (drawList.GetSize() + s_MinDrawsPerThread - 1) / s_MinDrawsPerThread;
+			m_FrameIndex = frameIndex;
+			m_RangeCount = std::max(1u, std::min(wantedRanges, m_ThreadLimit));
+			m_DrawList = &drawList;
+			m_Inheritance = inheritance;
+			m_Viewport = viewport;
+			m_Scissor = scissor;
+			m_SecondaryBuffers.assign(m_RangeCount, VK_NULL_HANDLE);
+			JobSystem::ParallelFor(m_RangeCount, 1, [this](uint32_t first, uint32_t last)
+			{
+				for (uint32_t rangeIndex = first; rangeIndex < last; ++rangeIndex)
+				{
+					RecordRange(rangeIndex);
+				}
+			});
+			return m_SecondaryBuffers;
+		}
+
+		void ParallelCommandRecorder::RecordRange(uint32_t rangeIndex)
+		{
+			// contiguous ranges keep the draws in list order once the buffers are executed one after another
+			const uint32_t drawCount = m_DrawList->GetSize();
+			const uint32_t first = static_cast<uint32_t>(static_cast<uint64_t>(drawCount) * rangeIndex / m_RangeCount);
+			const uint32_t last = static_cast<uint32_t>(static_cast<uint64_t>(drawCount) * (rangeIndex + 1) / m_RangeCount);
+
+			// the pool of whichever thread runs this job, it is only ever touched from that thread
+			const VkCommandBuffer commandBuffer = m_Pools[m_FrameIndex * m_ThreadCount + JobSystem::GetThreadIndex()]->GetSecondaryCommandBuffer();
+			VkCommandBufferBeginInfo beginInfo = {};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT; // entirely inside the render pass
+			beginInfo.pInheritanceInfo = &m_Inheritance;
+			vkBeginCommandBuffer(commandBuffer, &beginInfo);
+			vkCmdSetViewport(commandBuffer, 0, 1, &m_Viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &m_Scissor);
+			m_DrawList->Record(commandBuffer, first, last - first);
+			vkEndCommandBuffer(commandBuffer);
+			m_SecondaryBuffers[rangeIndex] = commandBuffer;
+		}
+	}
+}
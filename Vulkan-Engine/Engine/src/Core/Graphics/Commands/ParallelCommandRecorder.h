@@ -0,0 +1,67 @@
+/***************************************************************************
+ * Filename		: ParallelCommandRecorder.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Splits a draw list into jobs which each record a secondary
+ *				  command buffer from the running thread's command pool.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Core.h"
+#include "Core/Jobs/JobSystem.h"
+#include "DrawList.h"
+#include "FrameCommandPool.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// Usage (per frame):
+		// 1. Reset(frameIndex) once the frame's fence has signaled
+		// 2. begin the render pass with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+		// 3. vkCmdExecuteCommands with the buffers returned by Record (they are in draw list order)
+		// Ranges are recorded as JobSystem jobs, so the pools are per job system thread (the main thread helps while it waits).
+		class ParallelCommandRecorder
+		{
+		public:
+			ParallelCommandRecorder(VkDevice logicalDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+			~ParallelCommandRecorder() = default;
+			ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+			ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+		public:
+			void Reset(uint32_t frameIndex); // resets the pools of every thread for this frame
+			// inheritance must describe the render pass / subpass (and ideally framebuffer) the buffers are executed in,
+			// dynamic state isn't inherited from the primary buffer so every secondary buffer sets the viewport & scissor itself
+			const std::vector<VkCommandBuffer>& Record(uint32_t frameIndex, const DrawList& drawList, const VkCommandBufferInheritanceInfo& inheritance,
+				const VkViewport& viewport, const VkRect2D& scissor);
+			void SetThreadLimit(uint32_t threadLimit) { m_ThreadLimit = std::max(1u, std::min(threadLimit, m_ThreadCount)); } // caps the number of ranges, used to measure scaling
+			_NODISCARD uint32_t GetThreadCount() const { return m_ThreadCount; }
+		public:
+			static constexpr uint32_t s_MinDrawsPerThread = 64; // below this handing work to another thread costs more than it saves
+		private:
+			void RecordRange(uint32_t rangeIndex);
+		private:
+			uint32_t m_ThreadCount; // JobSystem::GetThreadCount() at creation
+			uint32_t m_ThreadLimit;
+			std::vector<Scope<FrameCommandPool>> m_Pools; // [frameIndex * m_ThreadCount + JobSystem::GetThreadIndex()]
+			// state of the current Record call, read by the jobs
+			uint32_t m_FrameIndex = 0;
+			uint32_t m_RangeCount = 0;
+			const DrawList* m_DrawList = nullptr;
+			VkCommandBufferInheritanceInfo m_Inheritance = {};
+			VkViewport m_Viewport = {};
+			VkRect2D m_Scissor = {};
+			std::vector<VkCommandBuffer> m_SecondaryBuffers; // one per range
+		};
+	}
+}
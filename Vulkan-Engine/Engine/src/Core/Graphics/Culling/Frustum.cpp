@@ -0,0 +1,88 @@
+/***************************************************************************
+ * Filename		: Frustum.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: View frustum planes extracted from a view projection
+ *				  matrix and the bounding sphere tests against them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Frustum.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+		{
+			// Gribb & Hartmann, the rows of the matrix combined (glm is column major, so row i is m[*][i])
+			const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+			const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+			const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+			const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+			Frustum frustum;
+			frustum.Planes[0] = row3 + row0;
+			frustum.Planes[1] = row3 - row0;
+			frustum.Planes[2] = row3 + row1;
+			frustum.Planes[3] = row3 - row1;
+			frustum.Planes[4] = row2; // 0 <= z, not -w <= z
+			frustum.Planes[5] = row3 - row2;
+			for (glm::vec4& plane : frustum.Planes)
+			{
+				plane /= glm::length(glm::vec3(plane));
+			}
+			return frustum;
+		}
+
+		bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+		{
+			for (const glm::vec4& plane : Planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		FrustumTest Frustum::ClassifyAabb(const Aabb& box) const
+		{
+			const glm::vec3 center = box.GetCenter();
+			const glm::vec3 extents = box.GetExtents();
+			FrustumTest result = FrustumTest::Inside;
+			for (const glm::vec4& plane : Planes)
+			{
+				// distance of the box's center and its projected radius onto the plane normal
+				const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+				const float radius = glm::dot(glm::abs(glm::vec3(plane)), extents);
+				if (distance < -radius)
+				{
+					return FrustumTest::Outside;
+				}
+				if (distance < radius)
+				{
+					result = FrustumTest::Intersecting;
+				}
+			}
+			return result;
+		}
+
+		glm::vec4 TransformBoundingSphere(const glm::mat4& model, const glm::vec3& center, float radius)
+		{
+			const float scale = std::sqrt(std::max({ glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+				glm::dot(glm::vec3(model[1]), glm::vec3(model[1])), glm::dot(glm::vec3(model[2]), glm::vec3(model[2])) }));
+			return glm::vec4(glm::vec3(model * glm::vec4(center, 1.0f)), radius * scale);
+		}
+	}
+}
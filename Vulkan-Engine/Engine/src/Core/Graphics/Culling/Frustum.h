@@ -0,0 +1,49 @@
+/***************************************************************************
+ * Filename		: Frustum.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: View frustum planes extracted from a view projection
+ *				  matrix and the bounding sphere tests against them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Scene/Aabb.h"
+
+#include <glm/glm.hpp>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		enum class FrustumTest
+		{
+			Outside = 0,
+			Intersecting,
+			Inside
+		};
+
+		// planes are normalized and point inwards (a point is inside if dot(plane.xyz, point) + plane.w >= 0)
+		struct Frustum
+		{
+			glm::vec4 Planes[6]; // left, right, bottom, top, near, far
+		public:
+			// the planes of the matrix's clip volume (vulkan's 0..1 depth range) in the space the matrix transforms from,
+			// so a projection * view matrix gives world space planes
+			_NODISCARD static Frustum FromMatrix(const glm::mat4& viewProjection);
+			_NODISCARD bool IntersectsSphere(const glm::vec3& center, float radius) const;
+			// conservative like the sphere test, a box near a frustum corner can be Intersecting while fully outside
+			_NODISCARD FrustumTest ClassifyAabb(const Aabb& box) const;
+		};
+
+		// bounding sphere transformed by a model matrix, the radius is scaled by the matrix's largest axis scale
+		_NODISCARD glm::vec4 TransformBoundingSphere(const glm::mat4& model, const glm::vec3& center, float radius);
+	}
+}
@@ -0,0 +1,211 @@
+/***************************************************************************
+ * Filename		: FrustumCuller.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Structure of arrays bounding spheres and the cpu frustum
+ *				  culling kernels (AVX2 / SSE4.1 / scalar) run over them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "FrustumCuller.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+#include <atomic>
+#include <bitset>
+#include <cfloat>
+
+#if VKE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		uint32_t CullingBounds::Add(const glm::vec4& sphere)
+		{
+			if (m_Count == m_CenterX.size())
+			{
+				const size_t paddedCount = m_CenterX.size() + s_Alignment;
+				m_CenterX.resize(paddedCount, 0.0f);
+				m_CenterY.resize(paddedCount, 0.0f);
+				m_CenterZ.resize(paddedCount, 0.0f);
+				m_Radius.resize(paddedCount, -FLT_MAX);
+			}
+			Set(m_Count++, sphere);
+			return m_Count - 1;
+		}
+
+		void CullingBounds::Set(uint32_t index, const glm::vec4& sphere)
+		{
+			VK_CORE_ASSERT(index < m_Count, "[GraphicsSystem::CullingBounds::Set]: Index out of range");
+			m_CenterX[index] = sphere.x;
+			m_CenterY[index] = sphere.y;
+			m_CenterZ[index] = sphere.z;
+			m_Radius[index] = sphere.w;
+		}
+
+		void CullingBounds::Reserve(uint32_t count)
+		{
+			const size_t paddedCount = (static_cast<size_t>(count) + s_Alignment - 1) / s_Alignment * s_Alignment;
+			m_CenterX.reserve(paddedCount);
+			m_CenterY.reserve(paddedCount);
+			m_CenterZ.reserve(paddedCount);
+			m_Radius.reserve(paddedCount);
+		}
+
+		void CullingBounds::Clear()
+		{
+			m_CenterX.clear();
+			m_CenterY.clear();
+			m_CenterZ.clear();
+			m_Radius.clear();
+			m_Count = 0;
+		}
+
+		// the padding makes every range a whole number of visibility bytes
+		static inline uint32_t GetPaddedEnd(uint32_t last)
+		{
+			return (last + CullingBounds::s_Alignment - 1) & ~(CullingBounds::s_Alignment - 1);
+		}
+
+		static uint32_t CullSpheresScalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t last, uint8_t* visibility)
+		{
+			uint32_t visibleCount = 0;
+			for (uint32_t i = first; i < GetPaddedEnd(last); i += 8)
+			{
+				uint32_t mask = 0;
+				for (uint32_t lane = 0; lane < 8; ++lane)
+				{
+					const uint32_t index = i + lane;
+					const glm::vec3 center(bounds.GetCenterX()[index], bounds.GetCenterY()[index], bounds.GetCenterZ()[index]);
+					mask |= static_cast<uint32_t>(frustum.IntersectsSphere(center, bounds.GetRadius()[index])) << lane;
+				}
+				visibility[i >> 3] = static_cast<uint8_t>(mask);
+				visibleCount += static_cast<uint32_t>(std::bitset<8>(mask).count());
+			}
+			return visibleCount;
+		}
+
+#if VKE_SIMD_X86
+		////////////////////////////////////////////
+		// SSE4.1, 4 objects per half of a visibility byte
+		////////////////////////////////////////////
+		VKE_TARGET_SSE41 static uint32_t CullSpheresSSE41(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t last, uint8_t* visibility)
+		{
+			__m128 planes[6][4];
+			for (int plane = 0; plane < 6; ++plane)
+			{
+				for (int component = 0; component < 4; ++component)
+				{
+					planes[plane][component] = _mm_set1_ps(frustum.Planes[plane][component]);
+				}
+			}
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			uint32_t visibleCount = 0;
+			for (uint32_t i = first; i < GetPaddedEnd(last); i += 8)
+			{
+				uint32_t mask = 0;
+				for (uint32_t half = 0; half < 2; ++half)
+				{
+					const uint32_t index = i + 4 * half;
+					const __m128 x = _mm_loadu_ps(bounds.GetCenterX() + index);
+					const __m128 y = _mm_loadu_ps(bounds.GetCenterY() + index);
+					const __m128 z = _mm_loadu_ps(bounds.GetCenterZ() + index);
+					const __m128 negativeRadius = _mm_xor_ps(_mm_loadu_ps(bounds.GetRadius() + index), signMask);
+					__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+					for (int plane = 0; plane < 6; ++plane)
+					{
+						// same operation order as Frustum::IntersectsSphere, not-less-than keeps nans visible like the scalar compare
+						const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[plane][0], x), _mm_mul_ps(planes[plane][1], y)),
+							_mm_mul_ps(planes[plane][2], z)), planes[plane][3]);
+						inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, negativeRadius));
+					}
+					mask |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << (4 * half);
+				}
+				visibility[i >> 3] = static_cast<uint8_t>(mask);
+				visibleCount += static_cast<uint32_t>(std::bitset<8>(mask).count());
+			}
+			return visibleCount;
+		}
+
+		////////////////////////////////////////////
+		// AVX2, 8 objects (one visibility byte) per iteration
+		////////////////////////////////////////////
+		// no fma, a fused multiply add would round differently from the scalar reference
+		VKE_TARGET_AVX2 static uint32_t CullSpheresAVX2(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t last, uint8_t* visibility)
+		{
+			__m256 planes[6][4];
+			for (int plane = 0; plane < 6; ++plane)
+			{
+				for (int component = 0; component < 4; ++component)
+				{
+					planes[plane][component] = _mm256_set1_ps(frustum.Planes[plane][component]);
+				}
+			}
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			uint32_t visibleCount = 0;
+			for (uint32_t i = first; i < GetPaddedEnd(last); i += 8)
+			{
+				const __m256 x = _mm256_loadu_ps(bounds.GetCenterX() + i);
+				const __m256 y = _mm256_loadu_ps(bounds.GetCenterY() + i);
+				const __m256 z = _mm256_loadu_ps(bounds.GetCenterZ() + i);
+				const __m256 negativeRadius = _mm256_xor_ps(_mm256_loadu_ps(bounds.GetRadius() + i), signMask);
+				__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (int plane = 0; plane < 6; ++plane)
+				{
+					const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planes[plane][0], x), _mm256_mul_ps(planes[plane][1], y)),
+						_mm256_mul_ps(planes[plane][2], z)), planes[plane][3]);
+					inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_NLT_UQ));
+				}
+				const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+				visibility[i >> 3] = static_cast<uint8_t>(mask);
+				visibleCount += static_cast<uint32_t>(std::bitset<8>(mask).count());
+			}
+			return visibleCount;
+		}
+#endif
+
+		uint32_t FrustumCuller::CullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t last, uint8_t* visibility, SimdLevel level)
+		{
+			VK_CORE_ASSERT(first % 8 == 0 && last <= bounds.GetCount(), "[GraphicsSystem::FrustumCuller::CullSpheres]: Invalid range");
+			if (first >= last)
+			{
+				return 0;
+			}
+			level = std::min(level, CpuFeatures::GetSimdLevel());
+#if VKE_SIMD_X86
+			if (level == SimdLevel::AVX2)
+			{
+				return CullSpheresAVX2(frustum, bounds, first, last, visibility);
+			}
+			if (level == SimdLevel::SSE41)
+			{
+				return CullSpheresSSE41(frustum, bounds, first, last, visibility);
+			}
+#endif
+			return CullSpheresScalar(frustum, bounds, first, last, visibility);
+		}
+
+		uint32_t FrustumCuller::Cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint8_t>& visibility, SimdLevel level)
+		{
+			static_assert(s_BatchSize % 8 == 0, "batches have to cover whole visibility bytes");
+			visibility.assign((static_cast<size_t>(bounds.GetCount()) + 7) / 8, 0);
+			std::atomic<uint32_t> visibleCount{ 0 };
+			JobSystem::ParallelFor(bounds.GetCount(), s_BatchSize, [&](uint32_t first, uint32_t last)
+			{
+				visibleCount.fetch_add(CullSpheres(frustum, bounds, first, last, visibility.data(), level), std::memory_order_relaxed);
+			});
+			return visibleCount.load();
+		}
+	}
+}
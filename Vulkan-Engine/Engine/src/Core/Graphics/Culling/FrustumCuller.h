@@ -0,0 +1,74 @@
+/***************************************************************************
+ * Filename		: FrustumCuller.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Structure of arrays bounding spheres and the cpu frustum
+ *				  culling kernels (AVX2 / SSE4.1 / scalar) run over them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Utility/CpuFeatures.h"
+#include "Frustum.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// world space bounding spheres stored as four float arrays, so the simd kernels load 8 (or 4) of a component at once.
+		// The arrays are padded to a multiple of s_Alignment with spheres that are never visible, the kernels need no tail loop.
+		class CullingBounds
+		{
+		public:
+			CullingBounds() = default;
+			~CullingBounds() = default;
+		public:
+			uint32_t Add(const glm::vec4& sphere); // center, radius -> the object's index
+			void Set(uint32_t index, const glm::vec4& sphere);
+			void Reserve(uint32_t count);
+			void Clear();
+			_NODISCARD uint32_t GetCount() const { return m_Count; }
+			_NODISCARD const float* GetCenterX() const { return m_CenterX.data(); }
+			_NODISCARD const float* GetCenterY() const { return m_CenterY.data(); }
+			_NODISCARD const float* GetCenterZ() const { return m_CenterZ.data(); }
+			_NODISCARD const float* GetRadius() const { return m_Radius.data(); }
+		public:
+			static constexpr uint32_t s_Alignment = 8; // objects per avx2 iteration
+		private:
+			std::vector<float> m_CenterX;
+			std::vector<float> m_CenterY;
+			std::vector<float> m_CenterZ;
+			std::vector<float> m_Radius; // -FLT_MAX in the padding
+			uint32_t m_Count = 0;
+		};
+
+		// visibility is a bit array, bit (index & 7) of byte (index >> 3) is set if the object's sphere intersects the frustum.
+		// Every level gives the same result as Frustum::IntersectsSphere, the level parameter only exists so the paths
+		// can be benchmarked / compared against each other. Levels above the supported one are clamped.
+		class FrustumCuller
+		{
+		public:
+			FrustumCuller() = delete;
+			~FrustumCuller() = delete;
+		public:
+			// tests [first, last) on the calling thread, first must be a multiple of 8 (whole visibility bytes) -> visible count
+			static uint32_t CullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t last, uint8_t* visibility,
+				SimdLevel level = CpuFeatures::GetSimdLevel());
+			// tests every object, split into batches across the job system -> visible count
+			static uint32_t Cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint8_t>& visibility,
+				SimdLevel level = CpuFeatures::GetSimdLevel());
+			_NODISCARD static bool IsVisible(const std::vector<uint8_t>& visibility, uint32_t index) { return (visibility[index >> 3] >> (index & 7)) & 1; }
+		public:
+			static constexpr uint32_t s_BatchSize = 16384; // objects per job, a multiple of 8
+		};
+	}
+}
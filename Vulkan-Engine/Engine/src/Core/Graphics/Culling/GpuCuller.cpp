@@ -0,0 +1,487 @@
+/***************************************************************************
+ * Filename		: GpuCuller.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Compute pass culling the frame's draws against the view
+ *				  frustum and last frame's depth pyramid (hi-z).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "GpuCuller.h"
+
+#include "Core/Logger/Log.h"
+#include "Frustum.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static const std::string CULL_SHADER_PATH = "../Resources/Shaders/SPV/Cull.spv";
+		static const std::string PYRAMID_SHADER_PATH = "../Resources/Shaders/SPV/DepthPyramid.spv";
+		static const std::string PYRAMID_MULTISAMPLED_SHADER_PATH = "../Resources/Shaders/SPV/DepthPyramidMS.spv";
+
+		static constexpr VkDeviceSize FRAME_ALIGNMENT = 256; // largest minStorageBufferOffsetAlignment the spec allows
+
+		// matches the push constants in DepthPyramid.comp
+		struct PyramidConstants
+		{
+			int32_t SourceSize[2];
+			int32_t DestinationSize[2];
+			int32_t SampleCount;
+		};
+
+		static VkDeviceSize AlignFrameSize(VkDeviceSize size)
+		{
+			return (size + FRAME_ALIGNMENT - 1) & ~(FRAME_ALIGNMENT - 1);
+		}
+
+		GpuCuller::GpuCuller(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, VkPipelineCache pipelineCache, uint32_t frameCount, uint32_t maxDraws)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_MaxDraws(maxDraws),
+			m_InputFrameSize(AlignFrameSize(sizeof(CullUniforms) + static_cast<VkDeviceSize>(maxDraws) * sizeof(CullDraw))),
+			m_OutputFrameSize(AlignFrameSize(sizeof(CullStatistics) + static_cast<VkDeviceSize>(maxDraws) * sizeof(VkDrawIndexedIndirectCommand))),
+			m_StatisticsPending(frameCount, false), m_StaleDescriptors(frameCount, false)
+		{
+			m_InputBuffer = CreateBuffer(m_InputFrameSize * frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_InputAllocation);
+			m_OutputBuffer = CreateBuffer(m_OutputFrameSize * frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_OutputAllocation);
+			m_ReadbackBuffer = CreateBuffer(sizeof(CullStatistics) * frameCount, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_ReadbackAllocation);
+			CreateDescriptors(frameCount);
+			m_CullPipeline = CreateScope<ComputePipeline>(m_LogicalDevice, pipelineCache, CULL_SHADER_PATH, m_CullSetLayout);
+			m_PyramidPipeline = CreateScope<ComputePipeline>(m_LogicalDevice, pipelineCache, PYRAMID_SHADER_PATH, m_PyramidSetLayout, static_cast<uint32_t>(sizeof(PyramidConstants)));
+			m_PyramidMultisampledPipeline = CreateScope<ComputePipeline>(m_LogicalDevice, pipelineCache, PYRAMID_MULTISAMPLED_SHADER_PATH, m_PyramidSetLayout,
+				static_cast<uint32_t>(sizeof(PyramidConstants)));
+		}
+
+		GpuCuller::~GpuCuller()
+		{
+			RetireDepthPyramid();
+			for (RetiredPyramid& pyramid : m_RetiredPyramids)
+			{
+				DestroyRetiredPyramid(pyramid);
+			}
+			m_PyramidMultisampledPipeline.reset();
+			m_PyramidPipeline.reset();
+			m_CullPipeline.reset();
+			vkDestroySampler(m_LogicalDevice, m_Sampler, nullptr);
+			vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr); // frees the sets
+			vkDestroyDescriptorSetLayout(m_LogicalDevice, m_PyramidSetLayout, nullptr);
+			vkDestroyDescriptorSetLayout(m_LogicalDevice, m_CullSetLayout, nullptr);
+			vkDestroyBuffer(m_LogicalDevice, m_ReadbackBuffer, nullptr);
+			m_Allocator.Free(m_ReadbackAllocation);
+			vkDestroyBuffer(m_LogicalDevice, m_OutputBuffer, nullptr);
+			m_Allocator.Free(m_OutputAllocation);
+			vkDestroyBuffer(m_LogicalDevice, m_InputBuffer, nullptr);
+			m_Allocator.Free(m_InputAllocation);
+		}
+
+		bool GpuCuller::AreShadersAvailable()
+		{
+			return std::filesystem::exists(CULL_SHADER_PATH) && std::filesystem::exists(PYRAMID_SHADER_PATH) && std::filesystem::exists(PYRAMID_MULTISAMPLED_SHADER_PATH);
+		}
+
+		VkBuffer GpuCuller::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, DeviceAllocation& allocation) const
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = size;
+			bufferInfo.usage = usage;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			VkBuffer buffer;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateBuffer]: Failed to create culling buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			allocation = m_Allocator.AllocateForBuffer(buffer, properties);
+			return buffer;
+		}
+
+		void GpuCuller::CreateDescriptors(uint32_t frameCount)
+		{
+			std::array<VkDescriptorSetLayoutBinding, 3> cullBindings = {};
+			cullBindings[0] = { 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }; // input
+			cullBindings[1] = { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }; // output
+			cullBindings[2] = { 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }; // depth pyramid
+			std::array<VkDescriptorSetLayoutBinding, 2> pyramidBindings = {};
+			pyramidBindings[0] = { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }; // source level (or depth)
+			pyramidBindings[1] = { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }; // destination level
+
+			VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			layoutInfo.bindingCount = static_cast<uint32_t>(cullBindings.size());
+			layoutInfo.pBindings = cullBindings.data();
+			VkResult result = vkCreateDescriptorSetLayout(m_LogicalDevice, &layoutInfo, nullptr, &m_CullSetLayout);
+			layoutInfo.bindingCount = static_cast<uint32_t>(pyramidBindings.size());
+			layoutInfo.pBindings = pyramidBindings.data();
+			if (result != VK_SUCCESS || vkCreateDescriptorSetLayout(m_LogicalDevice, &layoutInfo, nullptr, &m_PyramidSetLayout) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDescriptors]: Failed to create descriptor set layouts!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			std::array<VkDescriptorPoolSize, 3> poolSizes = {};
+			poolSizes[0] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 * frameCount };
+			poolSizes[1] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount + frameCount * s_MaxPyramidLevels };
+			poolSizes[2] = { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, frameCount * s_MaxPyramidLevels };
+			VkDescriptorPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolInfo.pPoolSizes = poolSizes.data();
+			poolInfo.maxSets = frameCount + frameCount * s_MaxPyramidLevels;
+			if (vkCreateDescriptorPool(m_LogicalDevice, &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDescriptors]: Failed to create descriptor pool!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			// the sets are allocated once, the image bindings of a frame are rewritten in its Begin after the depth pyramid was recreated
+			// (per frame, so that frames still in flight keep reading the sets they were recorded with)
+			m_CullSets.resize(frameCount);
+			m_PyramidSets.resize(frameCount * s_MaxPyramidLevels);
+			const std::vector<VkDescriptorSetLayout> cullLayouts(frameCount, m_CullSetLayout);
+			const std::vector<VkDescriptorSetLayout> pyramidLayouts(m_PyramidSets.size(), m_PyramidSetLayout);
+			VkDescriptorSetAllocateInfo allocateInfo = {};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocateInfo.descriptorPool = m_DescriptorPool;
+			allocateInfo.descriptorSetCount = frameCount;
+			allocateInfo.pSetLayouts = cullLayouts.data();
+			result = vkAllocateDescriptorSets(m_LogicalDevice, &allocateInfo, m_CullSets.data());
+			allocateInfo.descriptorSetCount = static_cast<uint32_t>(m_PyramidSets.size());
+			allocateInfo.pSetLayouts = pyramidLayouts.data();
+			if (result != VK_SUCCESS || vkAllocateDescriptorSets(m_LogicalDevice, &allocateInfo, m_PyramidSets.data()) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDescriptors]: Failed to allocate descriptor sets!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				const VkDescriptorBufferInfo inputInfo = { m_InputBuffer, frame * m_InputFrameSize, m_InputFrameSize };
+				const VkDescriptorBufferInfo outputInfo = { m_OutputBuffer, frame * m_OutputFrameSize, m_OutputFrameSize };
+				std::array<VkWriteDescriptorSet, 2> writes = {};
+				for (uint32_t i = 0; i < writes.size(); ++i)
+				{
+					writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					writes[i].dstSet = m_CullSets[frame];
+					writes[i].dstBinding = i;
+					writes[i].descriptorCount = 1;
+					writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				}
+				writes[0].pBufferInfo = &inputInfo;
+				writes[1].pBufferInfo = &outputInfo;
+				vkUpdateDescriptorSets(m_LogicalDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+			}
+
+			VkSamplerCreateInfo samplerInfo = {};
+			samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+			samplerInfo.magFilter = VK_FILTER_NEAREST;
+			samplerInfo.minFilter = VK_FILTER_NEAREST;
+			samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+			samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+			if (vkCreateSampler(m_LogicalDevice, &samplerInfo, nullptr, &m_Sampler) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDescriptors]: Failed to create depth pyramid sampler!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+		}
+
+		void GpuCuller::SetDepthImage(VkImage depthImage, VkImageView depthImageView, VkFormat depthFormat, VkExtent2D extent, VkSampleCountFlagBits samples)
+		{
+			m_DepthImage = depthImage;
+			m_DepthImageView = depthImageView;
+			m_DepthAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+			if (depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || depthFormat == VK_FORMAT_D24_UNORM_S8_UINT || depthFormat == VK_FORMAT_D16_UNORM_S8_UINT)
+			{
+				m_DepthAspect |= VK_IMAGE_ASPECT_STENCIL_BIT; // layout transitions of combined formats cover both aspects
+			}
+			m_DepthExtent = extent;
+			m_DepthSamples = samples;
+			RetireDepthPyramid();
+			CreateDepthPyramid(extent);
+			m_StaleDescriptors.assign(m_StaleDescriptors.size(), true);
+		}
+
+		void GpuCuller::WriteFrameDescriptors(uint32_t frameIndex)
+		{
+			// level 0 reads the depth buffer, every other level the one before it
+			VkDescriptorSet* pyramidSets = &m_PyramidSets[frameIndex * s_MaxPyramidLevels];
+			std::vector<VkDescriptorImageInfo> sourceInfos(m_PyramidLevels);
+			std::vector<VkDescriptorImageInfo> destinationInfos(m_PyramidLevels);
+			std::vector<VkWriteDescriptorSet> writes;
+			writes.reserve(2 * m_PyramidLevels + 1);
+			for (uint32_t level = 0; level < m_PyramidLevels; ++level)
+			{
+				sourceInfos[level] = level == 0 ?
+					VkDescriptorImageInfo{ m_Sampler, m_DepthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL } :
+					VkDescriptorImageInfo{ m_Sampler, m_PyramidLevelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL };
+				destinationInfos[level] = { VK_NULL_HANDLE, m_PyramidLevelViews[level], VK_IMAGE_LAYOUT_GENERAL };
+				VkWriteDescriptorSet write = {};
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = pyramidSets[level];
+				write.descriptorCount = 1;
+				write.dstBinding = 0;
+				write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				write.pImageInfo = &sourceInfos[level];
+				writes.push_back(write);
+				write.dstBinding = 1;
+				write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+				write.pImageInfo = &destinationInfos[level];
+				writes.push_back(write);
+			}
+			const VkDescriptorImageInfo pyramidInfo = { m_Sampler, m_PyramidView, VK_IMAGE_LAYOUT_GENERAL };
+			VkWriteDescriptorSet write = {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = m_CullSets[frameIndex];
+			write.dstBinding = 2;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			write.pImageInfo = &pyramidInfo;
+			writes.push_back(write);
+			vkUpdateDescriptorSets(m_LogicalDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+			m_StaleDescriptors[frameIndex] = false;
+		}
+
+		void GpuCuller::CreateDepthPyramid(VkExtent2D depthExtent)
+		{
+			m_PyramidExtent = { std::max(depthExtent.width / 2, 1u), std::max(depthExtent.height / 2, 1u) };
+			m_PyramidLevels = std::min(static_cast<uint32_t>(std::floor(std::log2(std::max(m_PyramidExtent.width, m_PyramidExtent.height)))) + 1, s_MaxPyramidLevels);
+
+			VkImageCreateInfo imageInfo = {};
+			imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageInfo.format = VK_FORMAT_R32_SFLOAT;
+			imageInfo.extent = { m_PyramidExtent.width, m_PyramidExtent.height, 1 };
+			imageInfo.mipLevels = m_PyramidLevels;
+			imageInfo.arrayLayers = 1;
+			imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			if (vkCreateImage(m_LogicalDevice, &imageInfo, nullptr, &m_PyramidImage) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDepthPyramid]: Failed to create depth pyramid image!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			m_PyramidAllocation = m_Allocator.AllocateForImage(m_PyramidImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+			VkImageViewCreateInfo viewInfo = {};
+			viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			viewInfo.image = m_PyramidImage;
+			viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			viewInfo.format = VK_FORMAT_R32_SFLOAT;
+			viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_PyramidLevels, 0, 1 };
+			VkResult result = vkCreateImageView(m_LogicalDevice, &viewInfo, nullptr, &m_PyramidView);
+			m_PyramidLevelViews.resize(m_PyramidLevels);
+			for (uint32_t level = 0; level < m_PyramidLevels && result == VK_SUCCESS; ++level)
+			{
+				viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+				result = vkCreateImageView(m_LogicalDevice, &viewInfo, nullptr, &m_PyramidLevelViews[level]);
+			}
+			if (result != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GpuCuller::CreateDepthPyramid]: Failed to create depth pyramid views!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			m_PyramidBuilt = false;
+		}
+
+		void GpuCuller::RetireDepthPyramid()
+		{
+			if (m_PyramidImage == VK_NULL_HANDLE)
+			{
+				return;
+			}
+			RetiredPyramid pyramid;
+			pyramid.Image = m_PyramidImage;
+			pyramid.Allocation = m_PyramidAllocation;
+			pyramid.View = m_PyramidView;
+			pyramid.LevelViews = std::move(m_PyramidLevelViews);
+			pyramid.FramesLeft = static_cast<uint32_t>(m_StaleDescriptors.size());
+			m_RetiredPyramids.push_back(std::move(pyramid));
+			m_PyramidLevelViews.clear();
+			m_PyramidView = VK_NULL_HANDLE;
+			m_PyramidImage = VK_NULL_HANDLE;
+		}
+
+		void GpuCuller::DestroyRetiredPyramid(RetiredPyramid& pyramid)
+		{
+			for (const VkImageView levelView : pyramid.LevelViews)
+			{
+				vkDestroyImageView(m_LogicalDevice, levelView, nullptr);
+			}
+			vkDestroyImageView(m_LogicalDevice, pyramid.View, nullptr);
+			vkDestroyImage(m_LogicalDevice, pyramid.Image, nullptr);
+			m_Allocator.Free(pyramid.Allocation);
+		}
+
+		void GpuCuller::Begin(uint32_t frameIndex, const glm::mat4& view, const glm::mat4& projection)
+		{
+			m_FrameIndex = frameIndex;
+			m_DrawCount = 0;
+			// every frame in flight when a pyramid was retired has used its fence slot once it reaches zero
+			for (size_t i = 0; i < m_RetiredPyramids.size();)
+			{
+				if (--m_RetiredPyramids[i].FramesLeft != 0)
+				{
+					++i;
+					continue;
+				}
+				DestroyRetiredPyramid(m_RetiredPyramids[i]);
+				m_RetiredPyramids.erase(m_RetiredPyramids.begin() + i);
+			}
+			if (m_StaleDescriptors[frameIndex])
+			{
+				WriteFrameDescriptors(frameIndex);
+			}
+			if (m_StatisticsPending[frameIndex]) // the frame's fence has signaled, so its copy has landed
+			{
+				std::memcpy(&m_Statistics, static_cast<const char*>(m_ReadbackAllocation.MappedData) + frameIndex * sizeof(CullStatistics), sizeof(CullStatistics));
+				m_StatisticsPending[frameIndex] = false;
+			}
+			char* frameData = static_cast<char*>(m_InputAllocation.MappedData) + frameIndex * m_InputFrameSize;
+			m_Uniforms = reinterpret_cast<CullUniforms*>(frameData);
+			m_Draws = reinterpret_cast<CullDraw*>(frameData + sizeof(CullUniforms));
+			m_Uniforms->View = view;
+			m_Uniforms->Projection = projection;
+			const Frustum frustum = Frustum::FromMatrix(projection * view);
+			std::memcpy(m_Uniforms->FrustumPlanes, frustum.Planes, sizeof(frustum.Planes));
+			m_Uniforms->DepthSize = glm::vec2(static_cast<float>(m_DepthExtent.width), static_cast<float>(m_DepthExtent.height));
+			m_Uniforms->PyramidLevels = m_PyramidLevels;
+			m_Uniforms->OcclusionEnabled = m_PyramidBuilt ? 1 : 0;
+		}
+
+		void GpuCuller::Add(const VkDrawIndexedIndirectCommand& command, const glm::vec4& boundingSphere)
+		{
+			if (m_DrawCount == m_MaxDraws)
+			{
+				VK_CORE_WARN("[GraphicsSystem::GpuCuller::Add]: More than {0} draws in a frame, the rest are dropped!", m_MaxDraws);
+				return;
+			}
+			CullDraw& draw = m_Draws[m_DrawCount++];
+			draw.BoundingSphere = boundingSphere;
+			draw.Command = command;
+		}
+
+		void GpuCuller::End()
+		{
+			m_Uniforms->DrawCount = m_DrawCount;
+		}
+
+		void GpuCuller::RecordCulling(VkCommandBuffer commandBuffer)
+		{
+			// clear the counters and every record the draw may read when the count function isn't available
+			const VkDeviceSize outputOffset = GetCountOffset();
+			const VkDeviceSize outputSize = sizeof(CullStatistics) + static_cast<VkDeviceSize>(m_DrawCount) * sizeof(VkDrawIndexedIndirectCommand);
+			vkCmdFillBuffer(commandBuffer, m_OutputBuffer, outputOffset, outputSize, 0);
+
+			VkBufferMemoryBarrier barrier = {};
+			barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.buffer = m_OutputBuffer;
+			barrier.offset = outputOffset;
+			barrier.size = outputSize;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+			if (m_DrawCount > 0)
+			{
+				m_CullPipeline->Bind(commandBuffer, m_CullSets[m_FrameIndex]);
+				vkCmdDispatch(commandBuffer, ComputePipeline::GetGroupCount(m_DrawCount, s_CullGroupSize), 1, 1);
+			}
+
+			// the records are read by the indirect draw, the counters are copied out for the statistics
+			barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+				0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+			const VkBufferCopy copy = { outputOffset, m_FrameIndex * sizeof(CullStatistics), sizeof(CullStatistics) };
+			vkCmdCopyBuffer(commandBuffer, m_OutputBuffer, m_ReadbackBuffer, 1, &copy);
+			barrier.buffer = m_ReadbackBuffer;
+			barrier.offset = copy.dstOffset;
+			barrier.size = copy.size;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+			m_StatisticsPending[m_FrameIndex] = true;
+		}
+
+		void GpuCuller::RecordDepthPyramid(VkCommandBuffer commandBuffer)
+		{
+			// depth writes -> reads by level 0, and this frame's cull pass is done reading the pyramid before it is overwritten
+			std::array<VkImageMemoryBarrier, 2> imageBarriers = {};
+			for (VkImageMemoryBarrier& imageBarrier : imageBarriers)
+			{
+				imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			}
+			imageBarriers[0].image = m_DepthImage;
+			imageBarriers[0].subresourceRange = { m_DepthAspect, 0, 1, 0, 1 };
+			imageBarriers[0].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+			imageBarriers[0].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+			imageBarriers[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			imageBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			imageBarriers[1].image = m_PyramidImage;
+			imageBarriers[1].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_PyramidLevels, 0, 1 };
+			imageBarriers[1].oldLayout = m_PyramidBuilt ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
+			imageBarriers[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+			imageBarriers[1].srcAccessMask = 0;
+			imageBarriers[1].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+			VkMemoryBarrier levelBarrier = {};
+			levelBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			VkExtent2D sourceExtent = m_DepthExtent;
+			for (uint32_t level = 0; level < m_PyramidLevels; ++level)
+			{
+				const VkExtent2D destinationExtent = { std::max(m_PyramidExtent.width >> level, 1u), std::max(m_PyramidExtent.height >> level, 1u) };
+				const ComputePipeline& pipeline = level == 0 && m_DepthSamples != VK_SAMPLE_COUNT_1_BIT ? *m_PyramidMultisampledPipeline : *m_PyramidPipeline;
+				const PyramidConstants constants = {
+					{ static_cast<int32_t>(sourceExtent.width), static_cast<int32_t>(sourceExtent.height) },
+					{ static_cast<int32_t>(destinationExtent.width), static_cast<int32_t>(destinationExtent.height) },
+					static_cast<int32_t>(m_DepthSamples) };
+				pipeline.Bind(commandBuffer, m_PyramidSets[m_FrameIndex * s_MaxPyramidLevels + level]);
+				pipeline.PushConstants(commandBuffer, &constants, sizeof(constants));
+				vkCmdDispatch(commandBuffer, ComputePipeline::GetGroupCount(destinationExtent.width, s_PyramidGroupSize),
+					ComputePipeline::GetGroupCount(destinationExtent.height, s_PyramidGroupSize), 1);
+				// the next level reads this one, after the last level: next frame's cull pass reads the pyramid, and the
+				// depth buffer is only cleared again once every read of it is done
+				const VkPipelineStageFlags destinationStages = level + 1 < m_PyramidLevels ?
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, destinationStages, 0, 1, &levelBarrier, 0, nullptr, 0, nullptr);
+				sourceExtent = destinationExtent;
+			}
+			m_PyramidBuilt = true;
+		}
+	}
+}
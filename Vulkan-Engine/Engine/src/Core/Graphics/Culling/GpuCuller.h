@@ -0,0 +1,160 @@
+/***************************************************************************
+ * Filename		: GpuCuller.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Compute pass culling the frame's draws against the view
+ *				  frustum and last frame's depth pyramid (hi-z).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+#include "Core/Graphics/Pipeline/ComputePipeline.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// matches CullDraw in Cull.comp (std430)
+		struct CullDraw
+		{
+			glm::vec4 BoundingSphere; // world space center, radius
+			VkDrawIndexedIndirectCommand Command;
+			uint32_t Padding[3];
+		};
+		static_assert(sizeof(CullDraw) == 48, "CullDraw must match the std430 layout in Cull.comp");
+
+		// header of every frame's input region, matches CullInput in Cull.comp (std430)
+		struct CullUniforms
+		{
+			alignas(16) glm::mat4 View;
+			alignas(16) glm::mat4 Projection;
+			alignas(16) glm::vec4 FrustumPlanes[6];
+			alignas(8) glm::vec2 DepthSize;
+			uint32_t DrawCount;
+			uint32_t PyramidLevels;
+			uint32_t OcclusionEnabled;
+			uint32_t Padding[3];
+		};
+		static_assert(sizeof(CullUniforms) == 256, "CullUniforms must match the std430 layout in Cull.comp");
+
+		// header of every frame's output region, the draw count doubles as the visible counter
+		struct CullStatistics
+		{
+			uint32_t VisibleCount = 0;
+			uint32_t FrustumCulledCount = 0;
+			uint32_t OcclusionCulledCount = 0;
+			uint32_t Padding = 0;
+		};
+
+		// Per frame:
+		// 1. Begin / Add / End write the candidate draws with their bounding spheres (host visible input buffer)
+		// 2. RecordCulling, before the render pass, compacts the survivors into the output buffer, which is the
+		//    argument and count buffer of the frame's vkCmdDrawIndexedIndirectCount
+		// 3. RecordDepthPyramid, after the render pass, reduces the depth buffer for the next frame's occlusion test
+		// Without the count function the output is drawn with the input count, the unused records are zeroed.
+		class GpuCuller
+		{
+		public:
+			GpuCuller(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, VkPipelineCache pipelineCache, uint32_t frameCount, uint32_t maxDraws);
+			~GpuCuller();
+			GpuCuller(const GpuCuller&) = delete;
+			GpuCuller& operator=(const GpuCuller&) = delete;
+		public:
+			// (re)creates the depth pyramid for a new depth buffer, occlusion culling resumes once it has been built.
+			// The depth image needs VK_IMAGE_USAGE_SAMPLED_BIT. Frames still in flight keep the old pyramid and their descriptor sets,
+			// each frame switches over in its next Begin and the old pyramid is destroyed once every frame has.
+			void SetDepthImage(VkImage depthImage, VkImageView depthImageView, VkFormat depthFormat, VkExtent2D extent, VkSampleCountFlagBits samples);
+			// only once the frame's fence has signaled, also picks up the statistics of the frame's previous use
+			void Begin(uint32_t frameIndex, const glm::mat4& view, const glm::mat4& projection);
+			void Add(const VkDrawIndexedIndirectCommand& command, const glm::vec4& boundingSphere); // draws past maxDraws are dropped (with a warning)
+			void End();
+			void RecordCulling(VkCommandBuffer commandBuffer); // outside of a render pass
+			void RecordDepthPyramid(VkCommandBuffer commandBuffer); // after the render pass that wrote the depth image
+			_NODISCARD VkBuffer GetDrawBuffer() const { return m_OutputBuffer; }
+			_NODISCARD VkDeviceSize GetCountOffset() const { return m_FrameIndex * m_OutputFrameSize; }
+			_NODISCARD VkDeviceSize GetCommandOffset() const { return m_FrameIndex * m_OutputFrameSize + sizeof(CullStatistics); }
+			_NODISCARD uint32_t GetDrawCount() const { return m_DrawCount; } // before culling, the upper bound of the indirect draw
+			_NODISCARD const CullStatistics& GetStatistics() const { return m_Statistics; } // of the last frame that finished on the gpu
+			// false if the compute shaders haven't been compiled (Compile_GLSL_to_SPV)
+			_NODISCARD static bool AreShadersAvailable();
+		public:
+			static constexpr uint32_t s_CullGroupSize = 64; // local_size_x in Cull.comp
+			static constexpr uint32_t s_PyramidGroupSize = 8; // local_size_x / y in DepthPyramid.comp
+			static constexpr uint32_t s_MaxPyramidLevels = 16;
+		private:
+			VkBuffer CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, DeviceAllocation& allocation) const;
+			void CreateDescriptors(uint32_t frameCount);
+			void CreateDepthPyramid(VkExtent2D depthExtent);
+			void RetireDepthPyramid(); // moves the current pyramid to m_RetiredPyramids
+			void WriteFrameDescriptors(uint32_t frameIndex); // binds the current depth buffer and pyramid to the frame's sets
+		private:
+			struct RetiredPyramid
+			{
+				VkImage Image = VK_NULL_HANDLE;
+				DeviceAllocation Allocation;
+				VkImageView View = VK_NULL_HANDLE;
+				std::vector<VkImageView> LevelViews;
+				uint32_t FramesLeft = 0; // Begin calls until no frame in flight can read it
+			};
+			void DestroyRetiredPyramid(RetiredPyramid& pyramid);
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			uint32_t m_MaxDraws;
+			// per frame regions, 256 byte aligned so they can be bound as storage buffer offsets
+			VkDeviceSize m_InputFrameSize;
+			VkDeviceSize m_OutputFrameSize;
+			VkBuffer m_InputBuffer = VK_NULL_HANDLE; // CullUniforms + CullDraw[], host visible
+			DeviceAllocation m_InputAllocation;
+			VkBuffer m_OutputBuffer = VK_NULL_HANDLE; // CullStatistics + VkDrawIndexedIndirectCommand[], device local
+			DeviceAllocation m_OutputAllocation;
+			VkBuffer m_ReadbackBuffer = VK_NULL_HANDLE; // CullStatistics per frame, host visible
+			DeviceAllocation m_ReadbackAllocation;
+			std::vector<bool> m_StatisticsPending; // per frame, the readback has been recorded but not read yet
+			CullStatistics m_Statistics;
+			uint32_t m_FrameIndex = 0;
+			uint32_t m_DrawCount = 0;
+			CullUniforms* m_Uniforms = nullptr; // frame being written
+			CullDraw* m_Draws = nullptr;
+
+			VkDescriptorSetLayout m_CullSetLayout = VK_NULL_HANDLE;
+			VkDescriptorSetLayout m_PyramidSetLayout = VK_NULL_HANDLE;
+			VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+			std::vector<VkDescriptorSet> m_CullSets; // per frame
+			std::vector<VkDescriptorSet> m_PyramidSets; // per frame and pyramid level, frameIndex * s_MaxPyramidLevels + level
+			std::vector<bool> m_StaleDescriptors; // per frame, the sets still point at the previous depth buffer
+			VkSampler m_Sampler = VK_NULL_HANDLE; // the shaders only use texelFetch
+			Scope<ComputePipeline> m_CullPipeline;
+			Scope<ComputePipeline> m_PyramidPipeline;
+			Scope<ComputePipeline> m_PyramidMultisampledPipeline; // reads the multisampled depth buffer into level 0
+
+			VkImage m_DepthImage = VK_NULL_HANDLE;
+			VkImageView m_DepthImageView = VK_NULL_HANDLE;
+			VkImageAspectFlags m_DepthAspect = 0;
+			VkExtent2D m_DepthExtent = {};
+			VkSampleCountFlagBits m_DepthSamples = VK_SAMPLE_COUNT_1_BIT;
+			VkImage m_PyramidImage = VK_NULL_HANDLE; // r32 farthest depth, level 0 is half the depth extent
+			DeviceAllocation m_PyramidAllocation;
+			VkImageView m_PyramidView = VK_NULL_HANDLE; // every level, read by the cull pass
+			std::vector<VkImageView> m_PyramidLevelViews;
+			VkExtent2D m_PyramidExtent = {};
+			uint32_t m_PyramidLevels = 0;
+			bool m_PyramidBuilt = false; // holds a depth buffer (in VK_IMAGE_LAYOUT_GENERAL)
+			std::vector<RetiredPyramid> m_RetiredPyramids; // replaced by SetDepthImage, may still be read by frames in flight
+		};
+	}
+}
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * Filename		: BindlessDescriptors.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: One update after bind descriptor set with every texture and
+ *				  the material buffer, indexed by the shaders (descriptor indexing).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "BindlessDescriptors.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Graphics/Utility/VulkanUtility.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		BindlessDescriptors::BindlessDescriptors(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, DescriptorLayoutCache& layoutCache, uint32_t maxTextures, uint32_t maxMaterials)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_MaxTextures(maxTextures), m_MaxMaterials(maxMaterials)
+		{
+			std::vector<VkDescriptorSetLayoutBinding> bindings(2);
+			bindings[0].binding = s_TextureBinding;
+			bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			bindings[0].descriptorCount = m_MaxTextures;
+			bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			bindings[1].binding = s_MaterialBinding;
+			bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			bindings[1].descriptorCount = 1;
+			bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			// unwritten texture slots are fine as long as no shader reads them, written ones may change after the set is bound
+			const std::vector<VkDescriptorBindingFlagsEXT> bindingFlags =
+			{
+				VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT,
+				0
+			};
+			m_DescriptorSetLayout = layoutCache.GetLayout(bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT, bindingFlags);
+
+			// update after bind sets need a pool created with the matching flag, so the set does not come from the DescriptorAllocator
+			std::array<VkDescriptorPoolSize, 2> poolSizes = {};
+			poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			poolSizes[0].descriptorCount = m_MaxTextures;
+			poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			poolSizes[1].descriptorCount = 1;
+			VkDescriptorPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+			poolInfo.maxSets = 1;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolInfo.pPoolSizes = poolSizes.data();
+			if (vkCreateDescriptorPool(m_LogicalDevice, &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::BindlessDescriptors]: Failed to create descriptor pool!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			VkDescriptorSetAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocInfo.descriptorPool = m_DescriptorPool;
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &m_DescriptorSetLayout;
+			if (vkAllocateDescriptorSets(m_LogicalDevice, &allocInfo, &m_DescriptorSet) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::BindlessDescriptors]: Failed to allocate descriptor set!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			// small and rarely written, the shaders read it straight from host memory
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = static_cast<VkDeviceSize>(m_MaxMaterials) * sizeof(MaterialData);
+			bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_MaterialBuffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::BindlessDescriptors]: Failed to create material buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			m_MaterialAllocation = m_Allocator.AllocateForBuffer(m_MaterialBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+			VkDescriptorBufferInfo materialInfo = {};
+			materialInfo.buffer = m_MaterialBuffer;
+			materialInfo.offset = 0;
+			materialInfo.range = VK_WHOLE_SIZE;
+			VkWriteDescriptorSet descriptorWrite = {};
+			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrite.dstSet = m_DescriptorSet;
+			descriptorWrite.dstBinding = s_MaterialBinding;
+			descriptorWrite.dstArrayElement = 0;
+			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			descriptorWrite.descriptorCount = 1;
+			descriptorWrite.pBufferInfo = &materialInfo;
+			vkUpdateDescriptorSets(m_LogicalDevice, 1, &descriptorWrite, 0, nullptr);
+		}
+
+		BindlessDescriptors::~BindlessDescriptors()
+		{
+			vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr); // frees the set
+			vkDestroyBuffer(m_LogicalDevice, m_MaterialBuffer, nullptr);
+			m_Allocator.Free(m_MaterialAllocation);
+		}
+
+		uint32_t BindlessDescriptors::AddTexture(VkImageView imageView, VkSampler sampler)
+		{
+			if (m_TextureCount == m_MaxTextures)
+			{
+				static const std::string message = "[GraphicsSystem::BindlessDescriptors::AddTexture]: Texture array is full!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			VkDescriptorImageInfo imageInfo = {};
+			imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			imageInfo.imageView = imageView;
+			imageInfo.sampler = sampler;
+			VkWriteDescriptorSet descriptorWrite = {};
+			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrite.dstSet = m_DescriptorSet;
+			descriptorWrite.dstBinding = s_TextureBinding;
+			descriptorWrite.dstArrayElement = m_TextureCount;
+			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			descriptorWrite.descriptorCount = 1;
+			descriptorWrite.pImageInfo = &imageInfo;
+			vkUpdateDescriptorSets(m_LogicalDevice, 1, &descriptorWrite, 0, nullptr);
+			return m_TextureCount++;
+		}
+
+		uint32_t BindlessDescriptors::AddMaterial(const MaterialData& material)
+		{
+			if (m_MaterialCount == m_MaxMaterials)
+			{
+				static const std::string message = "[GraphicsSystem::BindlessDescriptors::AddMaterial]: Material buffer is full!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			std::memcpy(static_cast<MaterialData*>(m_MaterialAllocation.MappedData) + m_MaterialCount, &material, sizeof(MaterialData));
+			return m_MaterialCount++;
+		}
+
+		bool BindlessDescriptors::IsSupported(VkInstance instance, VkPhysicalDevice physicalDevice, uint32_t& maxTextures)
+		{
+			// feature queries go through VK_KHR_get_physical_device_properties2 (the instance is created for vulkan 1.0)
+			if (!IsInstanceExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) ||
+				!IsDeviceExtensionAvailable(physicalDevice, VK_KHR_MAINTENANCE3_EXTENSION_NAME) ||
+				!IsDeviceExtensionAvailable(physicalDevice, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+			{
+				return false;
+			}
+			const auto getFeatures = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR"));
+			const auto getProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR"));
+			if (getFeatures == nullptr || getProperties == nullptr)
+			{
+				return false;
+			}
+			VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+			indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+			VkPhysicalDeviceFeatures2KHR features = {};
+			features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+			features.pNext = &indexingFeatures;
+			getFeatures(physicalDevice, &features);
+			if (!indexingFeatures.runtimeDescriptorArray || !indexingFeatures.descriptorBindingPartiallyBound ||
+				!indexingFeatures.descriptorBindingSampledImageUpdateAfterBind || !indexingFeatures.shaderSampledImageArrayNonUniformIndexing)
+			{
+				return false;
+			}
+			VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties = {};
+			indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+			VkPhysicalDeviceProperties2KHR properties = {};
+			properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+			properties.pNext = &indexingProperties;
+			getProperties(physicalDevice, &properties);
+			maxTextures = std::min({ maxTextures, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+				indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+			return maxTextures > 0;
+		}
+	}
+}
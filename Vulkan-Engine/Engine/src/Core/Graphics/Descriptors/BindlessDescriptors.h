@@ -0,0 +1,77 @@
+/***************************************************************************
+ * Filename		: BindlessDescriptors.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: One update after bind descriptor set with every texture and
+ *				  the material buffer, indexed by the shaders (descriptor indexing).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+#include "DescriptorLayoutCache.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// std430 element of the material buffer (Bindless.frag)
+		struct MaterialData
+		{
+			glm::vec4 BaseColor = glm::vec4(1.0f);
+			uint32_t AlbedoTexture = 0; // index returned by BindlessDescriptors::AddTexture
+			uint32_t Padding[3] = {};
+		};
+
+		static_assert(sizeof(MaterialData) == 32, "MaterialData has to match the std430 layout of the shader's Material");
+
+		// the set is bound once (set s_SetIndex) and never rebound between draws. Textures can be added while earlier frames
+		// are still in flight (update after bind, partially bound), materials are append only so a slot is never rewritten
+		// while a frame reads it. Requires VK_EXT_descriptor_indexing, check IsSupported before creating one.
+		class BindlessDescriptors
+		{
+		public:
+			BindlessDescriptors(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, DescriptorLayoutCache& layoutCache, uint32_t maxTextures, uint32_t maxMaterials);
+			~BindlessDescriptors();
+			BindlessDescriptors(const BindlessDescriptors&) = delete;
+			BindlessDescriptors& operator=(const BindlessDescriptors&) = delete;
+		public:
+			uint32_t AddTexture(VkImageView imageView, VkSampler sampler); // -> index into the shader's texture array
+			uint32_t AddMaterial(const MaterialData& material); // -> material id
+			_NODISCARD VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+			_NODISCARD VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet; }
+			_NODISCARD uint32_t GetTextureCount() const { return m_TextureCount; }
+			_NODISCARD uint32_t GetMaterialCount() const { return m_MaterialCount; }
+			_NODISCARD uint32_t GetMaxTextures() const { return m_MaxTextures; }
+
+			// the descriptor indexing features the set and Bindless.frag rely on, maxTextures is clamped to the device limits
+			static bool IsSupported(VkInstance instance, VkPhysicalDevice physicalDevice, uint32_t& maxTextures);
+		public:
+			static constexpr uint32_t s_SetIndex = 1; // set 0 stays the per frame uniform buffer set
+			static constexpr uint32_t s_TextureBinding = 0;
+			static constexpr uint32_t s_MaterialBinding = 1;
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE; // owned by the layout cache
+			VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+			VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+			VkBuffer m_MaterialBuffer = VK_NULL_HANDLE;
+			DeviceAllocation m_MaterialAllocation; // persistently mapped
+			uint32_t m_MaxTextures;
+			uint32_t m_MaxMaterials;
+			uint32_t m_TextureCount = 0;
+			uint32_t m_MaterialCount = 0;
+		};
+	}
+}
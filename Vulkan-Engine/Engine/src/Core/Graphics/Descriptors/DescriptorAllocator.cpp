@@ -0,0 +1,250 @@
+/***************************************************************************
+ * Filename		: DescriptorAllocator.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Allocates descriptor sets from pools that grow on demand,
+ *				  per frame transient sets and sharing of identically written sets.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "DescriptorAllocator.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Utility/Hash.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// descriptors per set of each type in a pool, pools are shared by every layout so this is a guess of the average set
+		static const std::array<std::pair<VkDescriptorType, float>, 6> POOL_DESCRIPTOR_RATIOS =
+		{{
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1.0f }
+		}};
+
+		DescriptorWrites& DescriptorWrites::WriteBuffer(uint32_t binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+		{
+			Write write = {};
+			write.Binding = binding;
+			write.Type = type;
+			write.BufferInfo.buffer = buffer;
+			write.BufferInfo.offset = offset;
+			write.BufferInfo.range = range;
+			write.IsImage = false;
+			m_Writes.push_back(write);
+			return *this;
+		}
+
+		DescriptorWrites& DescriptorWrites::WriteImage(uint32_t binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout)
+		{
+			Write write = {};
+			write.Binding = binding;
+			write.Type = type;
+			write.ImageInfo.imageView = imageView;
+			write.ImageInfo.sampler = sampler;
+			write.ImageInfo.imageLayout = imageLayout;
+			write.IsImage = true;
+			m_Writes.push_back(write);
+			return *this;
+		}
+
+		void DescriptorWrites::Apply(VkDevice logicalDevice, VkDescriptorSet descriptorSet) const
+		{
+			std::vector<VkWriteDescriptorSet> descriptorWrites(m_Writes.size());
+			for (size_t i = 0; i < m_Writes.size(); ++i)
+			{
+				const Write& write = m_Writes[i];
+				VkWriteDescriptorSet& descriptorWrite = descriptorWrites[i];
+				descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrite.dstSet = descriptorSet;
+				descriptorWrite.dstBinding = write.Binding;
+				descriptorWrite.dstArrayElement = 0;
+				descriptorWrite.descriptorType = write.Type;
+				descriptorWrite.descriptorCount = 1;
+				descriptorWrite.pBufferInfo = write.IsImage ? nullptr : &write.BufferInfo;
+				descriptorWrite.pImageInfo = write.IsImage ? &write.ImageInfo : nullptr;
+			}
+			vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+		}
+
+		void DescriptorWrites::AppendKey(std::vector<uint64_t>& words) const
+		{
+			for (const Write& write : m_Writes)
+			{
+				words.push_back((static_cast<uint64_t>(write.Binding) << 32) | write.Type);
+				if (write.IsImage)
+				{
+					words.push_back(reinterpret_cast<uint64_t>(write.ImageInfo.imageView));
+					words.push_back(reinterpret_cast<uint64_t>(write.ImageInfo.sampler));
+					words.push_back(write.ImageInfo.imageLayout);
+				}
+				else
+				{
+					words.push_back(reinterpret_cast<uint64_t>(write.BufferInfo.buffer));
+					words.push_back(write.BufferInfo.offset);
+					words.push_back(write.BufferInfo.range);
+				}
+			}
+		}
+
+		DescriptorAllocator::DescriptorAllocator(VkDevice logicalDevice, uint32_t frameCount)
+			: m_LogicalDevice(logicalDevice), m_Frames(frameCount), m_SetsPerPool(s_InitialSetsPerPool)
+		{
+		}
+
+		DescriptorAllocator::~DescriptorAllocator()
+		{
+			const auto destroyGroup = [this](const PoolGroup& group)
+			{
+				vkDestroyDescriptorPool(m_LogicalDevice, group.CurrentPool, nullptr); // frees the sets
+				for (const VkDescriptorPool pool : group.FullPools)
+				{
+					vkDestroyDescriptorPool(m_LogicalDevice, pool, nullptr);
+				}
+			};
+			destroyGroup(m_Persistent);
+			for (const PoolGroup& group : m_Frames)
+			{
+				destroyGroup(group);
+			}
+			for (const VkDescriptorPool pool : m_FreePools)
+			{
+				vkDestroyDescriptorPool(m_LogicalDevice, pool, nullptr);
+			}
+		}
+
+		VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout layout, const DescriptorWrites& writes)
+		{
+			return Allocate(m_Persistent, layout, writes);
+		}
+
+		VkDescriptorSet DescriptorAllocator::AllocateTransient(VkDescriptorSetLayout layout, const DescriptorWrites& writes)
+		{
+			return Allocate(m_Frames[m_FrameIndex], layout, writes);
+		}
+
+		void DescriptorAllocator::BeginFrame(uint32_t frameIndex)
+		{
+			m_FrameIndex = frameIndex;
+			PoolGroup& group = m_Frames[frameIndex];
+			if (group.CurrentPool != VK_NULL_HANDLE)
+			{
+				group.FullPools.push_back(group.CurrentPool);
+				group.CurrentPool = VK_NULL_HANDLE;
+			}
+			for (const VkDescriptorPool pool : group.FullPools)
+			{
+				vkResetDescriptorPool(m_LogicalDevice, pool, 0); // returns every set of the pool at once
+				m_FreePools.push_back(pool);
+			}
+			group.FullPools.clear();
+			group.Sets.clear();
+		}
+
+		VkDescriptorSet DescriptorAllocator::Allocate(PoolGroup& group, VkDescriptorSetLayout layout, const DescriptorWrites& writes)
+		{
+			SetKey key;
+			key.Words.push_back(reinterpret_cast<uint64_t>(layout));
+			writes.AppendKey(key.Words);
+			const auto shared = group.Sets.find(key);
+			if (shared != group.Sets.end())
+			{
+				++m_Statistics.SetsShared;
+				return shared->second;
+			}
+
+			VkDescriptorSetAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &layout;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+			if (group.CurrentPool != VK_NULL_HANDLE)
+			{
+				allocInfo.descriptorPool = group.CurrentPool;
+				result = vkAllocateDescriptorSets(m_LogicalDevice, &allocInfo, &descriptorSet);
+			}
+			if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+			{
+				// retire the full pool (it is reset with its group) and try once more with an empty one
+				if (group.CurrentPool != VK_NULL_HANDLE)
+				{
+					group.FullPools.push_back(group.CurrentPool);
+					++m_Statistics.PoolGrowths;
+				}
+				group.CurrentPool = AcquirePool();
+				allocInfo.descriptorPool = group.CurrentPool;
+				result = vkAllocateDescriptorSets(m_LogicalDevice, &allocInfo, &descriptorSet);
+			}
+			if (result != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::DescriptorAllocator::Allocate]: Failed to allocate descriptor set!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			writes.Apply(m_LogicalDevice, descriptorSet);
+			++m_Statistics.SetsWritten;
+			group.Sets.emplace(std::move(key), descriptorSet);
+			return descriptorSet;
+		}
+
+		VkDescriptorPool DescriptorAllocator::AcquirePool()
+		{
+			if (!m_FreePools.empty())
+			{
+				const VkDescriptorPool pool = m_FreePools.back();
+				m_FreePools.pop_back();
+				return pool;
+			}
+			std::array<VkDescriptorPoolSize, POOL_DESCRIPTOR_RATIOS.size()> poolSizes = {};
+			for (size_t i = 0; i < poolSizes.size(); ++i)
+			{
+				poolSizes[i].type = POOL_DESCRIPTOR_RATIOS[i].first;
+				poolSizes[i].descriptorCount = static_cast<uint32_t>(POOL_DESCRIPTOR_RATIOS[i].second * m_SetsPerPool);
+			}
+			VkDescriptorPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.flags = 0; // sets are only released by resetting or destroying the whole pool
+			poolInfo.maxSets = m_SetsPerPool;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+			poolInfo.pPoolSizes = poolSizes.data();
+			VkDescriptorPool pool;
+			if (vkCreateDescriptorPool(m_LogicalDevice, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::DescriptorAllocator::AcquirePool]: Failed to create descriptor pool!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			++m_Statistics.PoolCount;
+			m_SetsPerPool = std::min(m_SetsPerPool * 2, s_MaxSetsPerPool); // the next pool is needed by a scene with more sets
+			return pool;
+		}
+
+		void DescriptorAllocator::LogStatistics() const
+		{
+			VK_CORE_INFO("[GraphicsSystem::DescriptorAllocator]: {0} pools ({1} growths), {2} sets written, {3} requests shared an existing set",
+				m_Statistics.PoolCount, m_Statistics.PoolGrowths, m_Statistics.SetsWritten, m_Statistics.SetsShared);
+		}
+
+		size_t DescriptorAllocator::SetKeyHash::operator()(const SetKey& key) const
+		{
+			return static_cast<size_t>(HashBytes(key.Words.data(), key.Words.size() * sizeof(uint64_t)));
+		}
+	}
+}
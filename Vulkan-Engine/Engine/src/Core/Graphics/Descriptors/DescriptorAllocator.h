@@ -0,0 +1,105 @@
+/***************************************************************************
+ * Filename		: DescriptorAllocator.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Allocates descriptor sets from pools that grow on demand,
+ *				  per frame transient sets and sharing of identically written sets.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// the resources a set points at, compared by value so sets written with the same resources can be shared
+		class DescriptorWrites
+		{
+		public:
+			DescriptorWrites& WriteBuffer(uint32_t binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+			DescriptorWrites& WriteImage(uint32_t binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout);
+			void Apply(VkDevice logicalDevice, VkDescriptorSet descriptorSet) const; // a single vkUpdateDescriptorSets
+			void AppendKey(std::vector<uint64_t>& words) const;
+		private:
+			struct Write
+			{
+				uint32_t Binding;
+				VkDescriptorType Type;
+				VkDescriptorBufferInfo BufferInfo; // buffer descriptors
+				VkDescriptorImageInfo ImageInfo; // image / sampler descriptors
+				bool IsImage;
+			};
+			std::vector<Write> m_Writes;
+		};
+
+		struct DescriptorAllocatorStatistics
+		{
+			uint32_t PoolCount = 0; // created so far, in use or free
+			uint32_t PoolGrowths = 0; // allocations that failed with a full pool and moved on to another one
+			uint32_t SetsWritten = 0; // sets allocated and written with vkUpdateDescriptorSets
+			uint32_t SetsShared = 0; // requests answered with an already written set
+		};
+
+		// persistent sets live as long as the allocator, transient sets until BeginFrame is called with their frame index again,
+		// which resets the frame's pools in one call instead of freeing sets one by one. A full pool (VK_ERROR_OUT_OF_POOL_MEMORY
+		// or VK_ERROR_FRAGMENTED_POOL) is retired and the set is allocated from a new, larger pool, so the number of sets is never
+		// sized up front. Sets are never written twice: a request with the same layout and writes returns the existing set.
+		class DescriptorAllocator
+		{
+		public:
+			DescriptorAllocator(VkDevice logicalDevice, uint32_t frameCount);
+			~DescriptorAllocator();
+			DescriptorAllocator(const DescriptorAllocator&) = delete;
+			DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+		public:
+			VkDescriptorSet Allocate(VkDescriptorSetLayout layout, const DescriptorWrites& writes);
+			VkDescriptorSet AllocateTransient(VkDescriptorSetLayout layout, const DescriptorWrites& writes); // from the frame of the last BeginFrame
+			void BeginFrame(uint32_t frameIndex); // the frame's fence has signaled, its transient sets are released
+			_NODISCARD const DescriptorAllocatorStatistics& GetStatistics() const { return m_Statistics; }
+			void LogStatistics() const;
+		private:
+			struct SetKey
+			{
+				std::vector<uint64_t> Words; // layout, then the writes
+				bool operator==(const SetKey& other) const { return Words == other.Words; }
+			};
+			struct SetKeyHash
+			{
+				size_t operator()(const SetKey& key) const;
+			};
+			struct PoolGroup
+			{
+				VkDescriptorPool CurrentPool = VK_NULL_HANDLE;
+				std::vector<VkDescriptorPool> FullPools;
+				std::unordered_map<SetKey, VkDescriptorSet, SetKeyHash> Sets;
+			};
+		private:
+			VkDescriptorSet Allocate(PoolGroup& group, VkDescriptorSetLayout layout, const DescriptorWrites& writes);
+			VkDescriptorPool AcquirePool(); // a reset pool if there is one, a new one otherwise
+		private:
+			VkDevice m_LogicalDevice;
+			PoolGroup m_Persistent;
+			std::vector<PoolGroup> m_Frames;
+			uint32_t m_FrameIndex = 0;
+			std::vector<VkDescriptorPool> m_FreePools; // reset, ready to be handed out again
+			uint32_t m_SetsPerPool; // of the next new pool, doubles up to s_MaxSetsPerPool
+			DescriptorAllocatorStatistics m_Statistics;
+		public:
+			static constexpr uint32_t s_InitialSetsPerPool = 64;
+			static constexpr uint32_t s_MaxSetsPerPool = 4096;
+		};
+	}
+}
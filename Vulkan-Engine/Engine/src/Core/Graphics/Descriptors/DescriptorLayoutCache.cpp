@@ -0,0 +1,108 @@
+/***************************************************************************
+ * Filename		: DescriptorLayoutCache.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Owns every descriptor set layout, identical binding lists
+ *				  return the same VkDescriptorSetLayout instead of a new one.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "DescriptorLayoutCache.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Utility/Hash.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		DescriptorLayoutCache::DescriptorLayoutCache(VkDevice logicalDevice)
+			: m_LogicalDevice(logicalDevice)
+		{
+		}
+
+		DescriptorLayoutCache::~DescriptorLayoutCache()
+		{
+			for (const auto& layout : m_Layouts)
+			{
+				vkDestroyDescriptorSetLayout(m_LogicalDevice, layout.second, nullptr);
+			}
+		}
+
+		VkDescriptorSetLayout DescriptorLayoutCache::GetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags,
+			const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags)
+		{
+			if (!bindingFlags.empty() && bindingFlags.size() != bindings.size())
+			{
+				static const std::string message = "[GraphicsSystem::DescriptorLayoutCache::GetLayout]: Binding flags don't match the bindings!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			// the same bindings listed in another order describe the same layout
+			std::vector<uint32_t> order(bindings.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&bindings](uint32_t a, uint32_t b) { return bindings[a].binding < bindings[b].binding; });
+			LayoutKey key;
+			key.Words.reserve(1 + bindings.size() * 6);
+			key.Words.push_back(flags);
+			for (const uint32_t i : order)
+			{
+				const VkDescriptorSetLayoutBinding& binding = bindings[i];
+				key.Words.push_back(binding.binding);
+				key.Words.push_back(binding.descriptorType);
+				key.Words.push_back(binding.descriptorCount);
+				key.Words.push_back(binding.stageFlags);
+				key.Words.push_back(reinterpret_cast<uint64_t>(binding.pImmutableSamplers)); // samplers are compared by address
+				key.Words.push_back(bindingFlags.empty() ? 0 : bindingFlags[i]);
+			}
+			const auto cached = m_Layouts.find(key);
+			if (cached != m_Layouts.end())
+			{
+				++m_HitCount;
+				return cached->second;
+			}
+
+			VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {};
+			bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+			bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+			bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+			VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			layoutInfo.pNext = bindingFlags.empty() ? nullptr : &bindingFlagsInfo;
+			layoutInfo.flags = flags;
+			layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+			layoutInfo.pBindings = bindings.data();
+			VkDescriptorSetLayout layout;
+			if (vkCreateDescriptorSetLayout(m_LogicalDevice, &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::DescriptorLayoutCache::GetLayout]: Failed to create descriptor set layout!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			m_Layouts.emplace(std::move(key), layout);
+			m_Bindings.emplace(layout, bindings);
+			return layout;
+		}
+
+		const std::vector<VkDescriptorSetLayoutBinding>* DescriptorLayoutCache::GetBindings(VkDescriptorSetLayout layout) const
+		{
+			const auto bindings = m_Bindings.find(layout);
+			return bindings != m_Bindings.end() ? &bindings->second : nullptr;
+		}
+
+		size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey& key) const
+		{
+			return static_cast<size_t>(HashBytes(key.Words.data(), key.Words.size() * sizeof(uint64_t)));
+		}
+	}
+}
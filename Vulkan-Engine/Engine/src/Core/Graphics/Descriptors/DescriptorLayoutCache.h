@@ -0,0 +1,62 @@
+/***************************************************************************
+ * Filename		: DescriptorLayoutCache.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Owns every descriptor set layout, identical binding lists
+ *				  return the same VkDescriptorSetLayout instead of a new one.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// layouts are keyed by their bindings (in binding order), create flags and binding flags, so callers
+		// don't keep their own handles alive or destroy them. Sets allocated with equal layouts are interchangeable anyway.
+		class DescriptorLayoutCache
+		{
+		public:
+			explicit DescriptorLayoutCache(VkDevice logicalDevice);
+			~DescriptorLayoutCache();
+			DescriptorLayoutCache(const DescriptorLayoutCache&) = delete;
+			DescriptorLayoutCache& operator=(const DescriptorLayoutCache&) = delete;
+		public:
+			// bindingFlags is empty or has one entry per binding (VK_EXT_descriptor_indexing), the layout lives as long as the cache
+			VkDescriptorSetLayout GetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0,
+				const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags = {});
+			// bindings a layout of this cache was created with, nullptr for a layout created elsewhere
+			_NODISCARD const std::vector<VkDescriptorSetLayoutBinding>* GetBindings(VkDescriptorSetLayout layout) const;
+			_NODISCARD uint32_t GetLayoutCount() const { return static_cast<uint32_t>(m_Layouts.size()); }
+			_NODISCARD uint32_t GetHitCount() const { return m_HitCount; }
+		private:
+			struct LayoutKey
+			{
+				std::vector<uint64_t> Words; // flags, then (binding, type, count, stages, immutable samplers, binding flags) per binding
+				bool operator==(const LayoutKey& other) const { return Words == other.Words; }
+			};
+			struct LayoutKeyHash
+			{
+				size_t operator()(const LayoutKey& key) const;
+			};
+		private:
+			VkDevice m_LogicalDevice;
+			std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> m_Layouts;
+			std::unordered_map<VkDescriptorSetLayout, std::vector<VkDescriptorSetLayoutBinding>> m_Bindings; // reverse lookup, the pipeline layout derived from shader reflection validates against it
+			uint32_t m_HitCount = 0; // requests answered from the cache
+		};
+	}
+}
@@ -0,0 +1,166 @@
+/***************************************************************************
+ * Filename		: BuddyAllocator.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Buddy sub-allocator used to split a single device memory
+ *				  block among many resources (CPU bookkeeping only).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "BuddyAllocator.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static bool IsPowerOfTwo(VkDeviceSize value)
+		{
+			return value != 0 && (value & (value - 1)) == 0;
+		}
+
+		BuddyAllocator::BuddyAllocator(VkDeviceSize size, VkDeviceSize minBlockSize)
+			: m_Size(size), m_MinBlockSize(minBlockSize), m_LevelCount(1)
+		{
+			if (!IsPowerOfTwo(size) || !IsPowerOfTwo(minBlockSize) || minBlockSize > size)
+			{
+				throw std::invalid_argument("[GraphicsSystem::BuddyAllocator::Constructor]: Block sizes must be powers of two!");
+			}
+			while ((m_Size >> m_LevelCount) >= m_MinBlockSize)
+			{
+				++m_LevelCount;
+			}
+			m_FreeBlocks.resize(m_LevelCount);
+			m_FreeBlocks[0].insert(0); // the whole range starts out as a single free block
+		}
+
+		bool BuddyAllocator::GetLevelForSize(VkDeviceSize size, VkDeviceSize alignment, uint32_t& level) const
+		{
+			// vulkan alignments are always powers of two, a block of at least that size is naturally aligned
+			const VkDeviceSize required = std::max({ size, alignment, m_MinBlockSize });
+			if (required > m_Size)
+			{
+				return false;
+			}
+			level = m_LevelCount - 1;
+			while (GetBlockSize(level) < required)
+			{
+				--level;
+			}
+			return true;
+		}
+
+		bool BuddyAllocator::Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+		{
+			uint32_t level;
+			if (size == 0 || !GetLevelForSize(size, alignment, level))
+			{
+				return false;
+			}
+
+			// find the smallest free block that can hold the request
+			int32_t freeLevel = static_cast<int32_t>(level);
+			while (freeLevel >= 0 && m_FreeBlocks[freeLevel].empty())
+			{
+				--freeLevel;
+			}
+			if (freeLevel < 0)
+			{
+				return false;
+			}
+
+			VkDeviceSize blockOffset = *m_FreeBlocks[freeLevel].begin();
+			m_FreeBlocks[freeLevel].erase(m_FreeBlocks[freeLevel].begin());
+
+			// split it down to the requested level, keeping the lower half and freeing the upper buddy
+			for (uint32_t splitLevel = static_cast<uint32_t>(freeLevel) + 1; splitLevel <= level; ++splitLevel)
+			{
+				m_FreeBlocks[splitLevel].insert(blockOffset + GetBlockSize(splitLevel));
+			}
+
+			m_AllocatedLevels[blockOffset] = level;
+			m_UsedSize += GetBlockSize(level);
+			offset = blockOffset;
+			return true;
+		}
+
+		void BuddyAllocator::Free(VkDeviceSize offset)
+		{
+			const auto allocation = m_AllocatedLevels.find(offset);
+			if (allocation == m_AllocatedLevels.end())
+			{
+				throw std::invalid_argument("[GraphicsSystem::BuddyAllocator::Free]: Offset does not belong to a live allocation!");
+			}
+			uint32_t level = allocation->second;
+			m_AllocatedLevels.erase(allocation);
+			m_UsedSize -= GetBlockSize(level);
+
+			// merge with the buddy for as long as the buddy is free as well
+			VkDeviceSize blockOffset = offset;
+			while (level > 0)
+			{
+				const VkDeviceSize buddyOffset = blockOffset ^ GetBlockSize(level);
+				const auto buddy = m_FreeBlocks[level].find(buddyOffset);
+				if (buddy == m_FreeBlocks[level].end())
+				{
+					break;
+				}
+				m_FreeBlocks[level].erase(buddy);
+				blockOffset = std::min(blockOffset, buddyOffset);
+				--level;
+			}
+			m_FreeBlocks[level].insert(blockOffset);
+		}
+
+		bool BuddyAllocator::CanAllocate(VkDeviceSize size, VkDeviceSize alignment) const
+		{
+			uint32_t level;
+			if (size == 0 || !GetLevelForSize(size, alignment, level))
+			{
+				return false;
+			}
+			for (int32_t freeLevel = static_cast<int32_t>(level); freeLevel >= 0; --freeLevel)
+			{
+				if (!m_FreeBlocks[freeLevel].empty())
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		VkDeviceSize BuddyAllocator::GetLargestFreeBlock() const
+		{
+			for (uint32_t level = 0; level < m_LevelCount; ++level)
+			{
+				if (!m_FreeBlocks[level].empty())
+				{
+					return GetBlockSize(level);
+				}
+			}
+			return 0;
+		}
+
+		VkDeviceSize BuddyAllocator::GetAllocationSize(VkDeviceSize offset) const
+		{
+			const auto allocation = m_AllocatedLevels.find(offset);
+			return allocation == m_AllocatedLevels.end() ? 0 : GetBlockSize(allocation->second);
+		}
+
+		uint32_t BuddyAllocator::GetFreeBlockCount() const
+		{
+			size_t count = 0;
+			for (const auto& level : m_FreeBlocks)
+			{
+				count += level.size();
+			}
+			return static_cast<uint32_t>(count);
+		}
+	}
+}
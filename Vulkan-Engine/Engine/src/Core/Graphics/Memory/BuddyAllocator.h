@@ -0,0 +1,62 @@
+/***************************************************************************
+ * Filename		: BuddyAllocator.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Buddy sub-allocator used to split a single device memory
+ *				  block among many resources (CPU bookkeeping only).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <set>
+#include <vector>
+#include <unordered_map>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// Splits a power of two sized range into power of two sized blocks.
+		// Every block at level L is (size >> L) bytes and starts at a multiple of its own size,
+		// so any power of two alignment up to the block size is satisfied for free.
+		// This class never touches vulkan, it only tracks offsets (which keeps it testable on the cpu).
+		class BuddyAllocator
+		{
+		public:
+			BuddyAllocator(VkDeviceSize size, VkDeviceSize minBlockSize);
+			~BuddyAllocator() = default;
+		public:
+			// returns false if no free block large enough exists, otherwise writes the offset of the block
+			bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+			void Free(VkDeviceSize offset);
+			// true if a block of the requested size/alignment could currently be allocated
+			_NODISCARD bool CanAllocate(VkDeviceSize size, VkDeviceSize alignment) const;
+			_NODISCARD VkDeviceSize GetSize() const { return m_Size; }
+			_NODISCARD VkDeviceSize GetUsedSize() const { return m_UsedSize; }
+			_NODISCARD VkDeviceSize GetLargestFreeBlock() const;
+			_NODISCARD VkDeviceSize GetAllocationSize(VkDeviceSize offset) const;
+			_NODISCARD uint32_t GetAllocationCount() const { return static_cast<uint32_t>(m_AllocatedLevels.size()); }
+			_NODISCARD uint32_t GetFreeBlockCount() const;
+			_NODISCARD bool IsEmpty() const { return m_AllocatedLevels.empty(); }
+		private:
+			_NODISCARD VkDeviceSize GetBlockSize(uint32_t level) const { return m_Size >> level; }
+			_NODISCARD bool GetLevelForSize(VkDeviceSize size, VkDeviceSize alignment, uint32_t& level) const;
+		private:
+			VkDeviceSize m_Size;
+			VkDeviceSize m_MinBlockSize;
+			VkDeviceSize m_UsedSize = 0;
+			uint32_t m_LevelCount;
+			std::vector<std::set<VkDeviceSize>> m_FreeBlocks; // free block offsets per level (ordered so the lowest offset is reused first)
+			std::unordered_map<VkDeviceSize, uint32_t> m_AllocatedLevels; // offset -> level of every live allocation
+		};
+	}
+}
@@ -0,0 +1,453 @@
+/***************************************************************************
+ * Filename		: DeviceMemoryAllocator.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Sub-allocates resources from large device memory blocks
+ *				  instead of calling vkAllocateMemory per buffer / image.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "DeviceMemoryAllocator.h"
+
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static VkDeviceSize FloorPowerOfTwo(VkDeviceSize value)
+		{
+			VkDeviceSize result = 1;
+			while ((result << 1) <= value)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		DeviceMemoryAllocator::DeviceMemoryAllocator(VkDevice logicalDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize preferredBlockSize)
+			: DeviceMemoryAllocator(CreateDeviceCallbacks(logicalDevice), memoryProperties, preferredBlockSize)
+		{
+			m_LogicalDevice = logicalDevice;
+		}
+
+		DeviceMemoryAllocator::DeviceMemoryAllocator(const DeviceMemoryCallbacks& callbacks, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize preferredBlockSize)
+			: m_Callbacks(callbacks), m_MemoryProperties(memoryProperties), m_PreferredBlockSize(FloorPowerOfTwo(preferredBlockSize))
+		{
+			m_Pools.resize(static_cast<size_t>(m_MemoryProperties.memoryTypeCount) * 2);
+			m_TypeStatistics.resize(m_MemoryProperties.memoryTypeCount);
+		}
+
+		DeviceMemoryAllocator::~DeviceMemoryAllocator()
+		{
+			const MemoryStatistics total = GetTotalStatistics();
+			if (total.AllocationCount > 0)
+			{
+				VK_CORE_WARN("[GraphicsSystem::DeviceMemoryAllocator]: Destroyed with {0} live allocations ({1} bytes)!", total.AllocationCount, total.RequestedBytes);
+			}
+			for (auto& pool : m_Pools)
+			{
+				for (auto& block : pool.Blocks)
+				{
+					m_Callbacks.FreeBlock(block->Memory, block->MappedData != nullptr);
+				}
+				pool.Blocks.clear();
+			}
+		}
+
+		uint32_t DeviceMemoryAllocator::FindMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32_t typeFilter, VkMemoryPropertyFlags properties)
+		{
+			for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+			{
+				if ((typeFilter & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+				{
+					return i;
+				}
+			}
+			return UINT32_MAX;
+		}
+
+		DeviceMemoryCallbacks DeviceMemoryAllocator::CreateDeviceCallbacks(VkDevice logicalDevice)
+		{
+			DeviceMemoryCallbacks callbacks;
+			callbacks.AllocateBlock = [logicalDevice](uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory& memory, void** mappedData)
+			{
+				VkMemoryAllocateInfo allocInfo = {};
+				allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+				allocInfo.allocationSize = size;
+				allocInfo.memoryTypeIndex = memoryTypeIndex;
+				VkResult result = vkAllocateMemory(logicalDevice, &allocInfo, nullptr, &memory);
+				if (result == VK_SUCCESS && mappedData != nullptr)
+				{
+					// host visible blocks stay mapped for their whole lifetime (a memory object can only be mapped once)
+					result = vkMapMemory(logicalDevice, memory, 0, VK_WHOLE_SIZE, 0, mappedData);
+					if (result != VK_SUCCESS)
+					{
+						vkFreeMemory(logicalDevice, memory, nullptr);
+						memory = VK_NULL_HANDLE;
+					}
+				}
+				return result;
+			};
+			callbacks.FreeBlock = [logicalDevice](VkDeviceMemory memory, bool mapped)
+			{
+				if (mapped)
+				{
+					vkUnmapMemory(logicalDevice, memory);
+				}
+				vkFreeMemory(logicalDevice, memory, nullptr);
+			};
+			return callbacks;
+		}
+
+		VkDeviceSize DeviceMemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const
+		{
+			// small heaps (e.g. the 256MB host visible device local heap) get an eighth of the heap per block
+			const VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+			static constexpr VkDeviceSize smallHeapLimit = 1024ull * 1024 * 1024;
+			const VkDeviceSize blockSize = heapSize <= smallHeapLimit ? FloorPowerOfTwo(heapSize / 8) : m_PreferredBlockSize;
+			return std::max(std::min(blockSize, m_PreferredBlockSize), s_MinBlockSize);
+		}
+
+		bool DeviceMemoryAllocator::IsHostVisible(uint32_t memoryTypeIndex) const
+		{
+			return (m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+		}
+
+		DeviceAllocation DeviceMemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linearResource)
+		{
+			const uint32_t memoryTypeIndex = FindMemoryTypeIndex(m_MemoryProperties, requirements.memoryTypeBits, properties);
+			if (memoryTypeIndex == UINT32_MAX)
+			{
+				static const std::string message = "[GraphicsSystem::DeviceMemoryAllocator::Allocate]: Failed to find suitable memory type!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			const uint32_t poolIndex = memoryTypeIndex * 2 + (linearResource ? 0 : 1);
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			// large resources would waste most of a block, give them their own memory object.
+			// The buddy block of a request is max(size, alignment), so a large alignment counts as a large resource
+			if (std::max(requirements.size, requirements.alignment) > GetBlockSize(memoryTypeIndex) / 2)
+			{
+				return AllocateDedicated(memoryTypeIndex, poolIndex, requirements.size);
+			}
+			DeviceAllocation allocation;
+			if (!AllocateFromPool(memoryTypeIndex, poolIndex, requirements.size, requirements.alignment, allocation))
+			{
+				// a memory object starts at offset 0, which satisfies any alignment. Throws if the driver is out of memory too
+				VK_CORE_WARN("[GraphicsSystem::DeviceMemoryAllocator::Allocate]: No memory block for {0} bytes (alignment {1}), using a dedicated allocation",
+					requirements.size, requirements.alignment);
+				return AllocateDedicated(memoryTypeIndex, poolIndex, requirements.size);
+			}
+			return allocation;
+		}
+
+		DeviceAllocation DeviceMemoryAllocator::AllocateDedicated(uint32_t memoryTypeIndex, uint32_t poolIndex, VkDeviceSize size)
+		{
+			DeviceAllocation allocation;
+			const bool hostVisible = IsHostVisible(memoryTypeIndex);
+			if (m_Callbacks.AllocateBlock(memoryTypeIndex, size, allocation.Memory, hostVisible ? &allocation.MappedData : nullptr) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::DeviceMemoryAllocator::AllocateDedicated]: Failed to allocate dedicated device memory!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			allocation.Size = size;
+			allocation.MemoryTypeIndex = memoryTypeIndex;
+			allocation.PoolIndex = poolIndex;
+
+			MemoryStatistics& statistics = m_TypeStatistics[memoryTypeIndex];
+			statistics.BlockCount++;
+			statistics.DedicatedBlockCount++;
+			statistics.AllocationCount++;
+			statistics.ReservedBytes += size;
+			statistics.UsedBytes += size;
+			statistics.RequestedBytes += size;
+			return allocation;
+		}
+
+		bool DeviceMemoryAllocator::AllocateFromPool(uint32_t memoryTypeIndex, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, DeviceAllocation& allocation)
+		{
+			MemoryPool& pool = m_Pools[poolIndex];
+			MemoryStatistics& statistics = m_TypeStatistics[memoryTypeIndex];
+
+			MemoryBlock* target = nullptr;
+			VkDeviceSize offset = 0;
+			for (auto& block : pool.Blocks) // first fit over existing blocks keeps the older blocks dense
+			{
+				if (block->Allocator.Allocate(size, alignment, offset))
+				{
+					target = block.get();
+					break;
+				}
+			}
+
+			if (target == nullptr)
+			{
+				// place the request in the new block's bookkeeping first, a request the empty block can't hold (size or
+				// alignment above the block size) must not take the block's memory at offset 0
+				const VkDeviceSize blockSize = GetBlockSize(memoryTypeIndex);
+				BuddyAllocator blockAllocator(blockSize, s_MinBlockSize);
+				if (!blockAllocator.Allocate(size, alignment, offset))
+				{
+					return false;
+				}
+				VkDeviceMemory memory = VK_NULL_HANDLE;
+				void* mappedData = nullptr;
+				if (m_Callbacks.AllocateBlock(memoryTypeIndex, blockSize, memory, IsHostVisible(memoryTypeIndex) ? &mappedData : nullptr) != VK_SUCCESS)
+				{
+					return false;
+				}
+				pool.Blocks.push_back(CreateScope<MemoryBlock>(MemoryBlock{ pool.NextBlockId++, memory, mappedData, std::move(blockAllocator) }));
+				statistics.BlockCount++;
+				statistics.ReservedBytes += blockSize;
+				target = pool.Blocks.back().get();
+			}
+
+			allocation.Memory = target->Memory;
+			allocation.Offset = offset;
+			allocation.Size = size;
+			allocation.MappedData = target->MappedData ? static_cast<char*>(target->MappedData) + offset : nullptr;
+			allocation.MemoryTypeIndex = memoryTypeIndex;
+			allocation.PoolIndex = poolIndex;
+			allocation.BlockId = target->Id;
+
+			statistics.AllocationCount++;
+			statistics.UsedBytes += target->Allocator.GetAllocationSize(offset);
+			statistics.RequestedBytes += size;
+			return true;
+		}
+
+		void DeviceMemoryAllocator::Free(DeviceAllocation& allocation)
+		{
+			if (!allocation.IsValid())
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			FreeInternal(allocation);
+		}
+
+		void DeviceMemoryAllocator::FreeInternal(DeviceAllocation& allocation)
+		{
+			MemoryStatistics& statistics = m_TypeStatistics[allocation.MemoryTypeIndex];
+			if (allocation.IsDedicated())
+			{
+				m_Callbacks.FreeBlock(allocation.Memory, allocation.MappedData != nullptr);
+				statistics.BlockCount--;
+				statistics.DedicatedBlockCount--;
+				statistics.AllocationCount--;
+				statistics.ReservedBytes -= allocation.Size;
+				statistics.UsedBytes -= allocation.Size;
+				statistics.RequestedBytes -= allocation.Size;
+			}
+			else
+			{
+				MemoryBlock* block = FindBlock(allocation.PoolIndex, allocation.BlockId);
+				if (block == nullptr)
+				{
+					static const std::string message = "[GraphicsSystem::DeviceMemoryAllocator::Free]: Allocation does not belong to this allocator!";
+					VK_CORE_CRITICAL(message);
+					throw std::runtime_error(message);
+				}
+				statistics.AllocationCount--;
+				statistics.UsedBytes -= block->Allocator.GetAllocationSize(allocation.Offset);
+				statistics.RequestedBytes -= allocation.Size;
+				block->Allocator.Free(allocation.Offset);
+				// keep a single empty block around so that alloc / free patterns don't thrash the driver
+				ReleaseEmptyBlocks(allocation.PoolIndex, 1);
+			}
+			allocation = DeviceAllocation();
+		}
+
+		DeviceMemoryAllocator::MemoryBlock* DeviceMemoryAllocator::FindBlock(uint32_t poolIndex, uint32_t blockId)
+		{
+			for (auto& block : m_Pools[poolIndex].Blocks)
+			{
+				if (block->Id == blockId)
+				{
+					return block.get();
+				}
+			}
+			return nullptr;
+		}
+
+		void DeviceMemoryAllocator::ReleaseEmptyBlocks(uint32_t poolIndex, uint32_t blocksToKeep)
+		{
+			auto& blocks = m_Pools[poolIndex].Blocks;
+			MemoryStatistics& statistics = m_TypeStatistics[poolIndex / 2];
+			uint32_t emptyBlocks = 0;
+			for (auto it = blocks.begin(); it != blocks.end();)
+			{
+				if ((*it)->Allocator.IsEmpty() && ++emptyBlocks > blocksToKeep)
+				{
+					statistics.BlockCount--;
+					statistics.ReservedBytes -= (*it)->Allocator.GetSize();
+					m_Callbacks.FreeBlock((*it)->Memory, (*it)->MappedData != nullptr);
+					it = blocks.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		void DeviceMemoryAllocator::ReleaseEmptyBlocks()
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (uint32_t poolIndex = 0; poolIndex < m_Pools.size(); ++poolIndex)
+			{
+				ReleaseEmptyBlocks(poolIndex, 0);
+			}
+		}
+
+		DeviceAllocation DeviceMemoryAllocator::AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties)
+		{
+			VkMemoryRequirements memRequirements;
+			vkGetBufferMemoryRequirements(m_LogicalDevice, buffer, &memRequirements);
+			DeviceAllocation allocation = Allocate(memRequirements, properties, true);
+			vkBindBufferMemory(m_LogicalDevice, buffer, allocation.Memory, allocation.Offset);
+			return allocation;
+		}
+
+		DeviceAllocation DeviceMemoryAllocator::AllocateForImage(VkImage image, VkMemoryPropertyFlags properties, bool linearTiling)
+		{
+			VkMemoryRequirements memRequirements;
+			vkGetImageMemoryRequirements(m_LogicalDevice, image, &memRequirements);
+			DeviceAllocation allocation = Allocate(memRequirements, properties, linearTiling);
+			vkBindImageMemory(m_LogicalDevice, image, allocation.Memory, allocation.Offset);
+			return allocation;
+		}
+
+		std::vector<DefragmentationMove> DeviceMemoryAllocator::BeginDefragmentation(const std::vector<DeviceAllocation*>& movableAllocations)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			std::vector<DefragmentationMove> moves;
+
+			for (uint32_t poolIndex = 0; poolIndex < m_Pools.size(); ++poolIndex)
+			{
+				auto& blocks = m_Pools[poolIndex].Blocks;
+				if (blocks.size() < 2)
+				{
+					continue;
+				}
+
+				// fullest blocks first, allocations are moved from the back of this list to the front
+				std::vector<MemoryBlock*> ordered;
+				for (auto& block : blocks)
+				{
+					ordered.push_back(block.get());
+				}
+				std::stable_sort(ordered.begin(), ordered.end(), [](const MemoryBlock* a, const MemoryBlock* b)
+				{
+					return a->Allocator.GetUsedSize() > b->Allocator.GetUsedSize();
+				});
+
+				for (size_t source = ordered.size() - 1; source > 0; --source)
+				{
+					for (DeviceAllocation* allocation : movableAllocations)
+					{
+						if (allocation->PoolIndex != poolIndex || allocation->BlockId != ordered[source]->Id)
+						{
+							continue;
+						}
+						// request the same buddy size, which keeps the original alignment intact
+						const VkDeviceSize blockSize = ordered[source]->Allocator.GetAllocationSize(allocation->Offset);
+						for (size_t destination = 0; destination < source; ++destination)
+						{
+							VkDeviceSize offset;
+							if (!ordered[destination]->Allocator.Allocate(allocation->Size, blockSize, offset))
+							{
+								continue;
+							}
+							DeviceAllocation target = *allocation;
+							target.Memory = ordered[destination]->Memory;
+							target.Offset = offset;
+							target.BlockId = ordered[destination]->Id;
+							target.MappedData = ordered[destination]->MappedData ? static_cast<char*>(ordered[destination]->MappedData) + offset : nullptr;
+
+							MemoryStatistics& statistics = m_TypeStatistics[allocation->MemoryTypeIndex];
+							statistics.AllocationCount++;
+							statistics.UsedBytes += blockSize;
+							statistics.RequestedBytes += allocation->Size;
+							moves.push_back({ allocation, target });
+							break;
+						}
+					}
+				}
+			}
+			return moves;
+		}
+
+		void DeviceMemoryAllocator::CompleteDefragmentation(std::vector<DefragmentationMove>& moves)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (auto& move : moves)
+			{
+				FreeInternal(*move.Allocation);
+				*move.Allocation = move.Destination;
+			}
+			for (uint32_t poolIndex = 0; poolIndex < m_Pools.size(); ++poolIndex)
+			{
+				ReleaseEmptyBlocks(poolIndex, 0);
+			}
+			moves.clear();
+		}
+
+		MemoryStatistics DeviceMemoryAllocator::GetStatistics(uint32_t memoryTypeIndex) const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			MemoryStatistics statistics = m_TypeStatistics[memoryTypeIndex];
+			for (uint32_t pool = memoryTypeIndex * 2; pool < memoryTypeIndex * 2 + 2; ++pool)
+			{
+				for (const auto& block : m_Pools[pool].Blocks)
+				{
+					statistics.LargestFreeBlock = std::max(statistics.LargestFreeBlock, block->Allocator.GetLargestFreeBlock());
+				}
+			}
+			return statistics;
+		}
+
+		MemoryStatistics DeviceMemoryAllocator::GetTotalStatistics() const
+		{
+			MemoryStatistics total;
+			for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; ++i)
+			{
+				const MemoryStatistics statistics = GetStatistics(i);
+				total.BlockCount += statistics.BlockCount;
+				total.DedicatedBlockCount += statistics.DedicatedBlockCount;
+				total.AllocationCount += statistics.AllocationCount;
+				total.ReservedBytes += statistics.ReservedBytes;
+				total.UsedBytes += statistics.UsedBytes;
+				total.RequestedBytes += statistics.RequestedBytes;
+				total.LargestFreeBlock = std::max(total.LargestFreeBlock, statistics.LargestFreeBlock);
+			}
+			return total;
+		}
+
+		void DeviceMemoryAllocator::LogStatistics() const
+		{
+			VK_CORE_INFO("[GraphicsSystem::DeviceMemoryAllocator]: Memory usage per type:");
+			for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; ++i)
+			{
+				const MemoryStatistics statistics = GetStatistics(i);
+				if (statistics.BlockCount == 0)
+				{
+					continue;
+				}
+				VK_CORE_INFO("-> Type {0}: {1} blocks ({2} dedicated), {3} allocations, {4} / {5} bytes used ({6} requested), largest free block {7}",
+					i, statistics.BlockCount, statistics.DedicatedBlockCount, statistics.AllocationCount,
+					statistics.UsedBytes, statistics.ReservedBytes, statistics.RequestedBytes, statistics.LargestFreeBlock);
+			}
+		}
+	}
+}
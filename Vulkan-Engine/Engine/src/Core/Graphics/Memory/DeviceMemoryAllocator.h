@@ -0,0 +1,132 @@
+/***************************************************************************
+ * Filename		: DeviceMemoryAllocator.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Sub-allocates resources from large device memory blocks
+ *				  instead of calling vkAllocateMemory per buffer / image.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Core.h"
+#include "BuddyAllocator.h"
+
+#include <functional>
+#include <mutex>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// a region of device memory handed out to a single buffer or image
+		struct DeviceAllocation
+		{
+			VkDeviceMemory Memory = VK_NULL_HANDLE; // memory block the region lives in
+			VkDeviceSize Offset = 0; // offset to pass to vkBindBufferMemory / vkBindImageMemory
+			VkDeviceSize Size = 0; // size requested by the resource
+			void* MappedData = nullptr; // persistently mapped pointer to the region (host visible memory only)
+			uint32_t MemoryTypeIndex = UINT32_MAX;
+			uint32_t PoolIndex = UINT32_MAX;
+			uint32_t BlockId = UINT32_MAX; // UINT32_MAX -> dedicated allocation (owns its VkDeviceMemory)
+			_NODISCARD bool IsValid() const { return Memory != VK_NULL_HANDLE; }
+			_NODISCARD bool IsDedicated() const { return BlockId == UINT32_MAX; }
+		};
+
+		// usage numbers, either for a single memory type or summed across all of them
+		struct MemoryStatistics
+		{
+			uint32_t BlockCount = 0; // vkAllocateMemory calls currently alive (blocks + dedicated)
+			uint32_t DedicatedBlockCount = 0;
+			uint32_t AllocationCount = 0; // resources currently bound to memory
+			VkDeviceSize ReservedBytes = 0; // memory taken from the driver
+			VkDeviceSize UsedBytes = 0; // memory handed out to resources (includes buddy rounding)
+			VkDeviceSize RequestedBytes = 0; // memory the resources actually asked for
+			VkDeviceSize LargestFreeBlock = 0;
+		};
+
+		// hooks used to get memory blocks from the driver, swapped out for a mock when testing the bookkeeping on the cpu
+		struct DeviceMemoryCallbacks
+		{
+			// mappedData is non-null when the memory type is host visible, the block should then be mapped in full
+			std::function<VkResult(uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory& memory, void** mappedData)> AllocateBlock;
+			std::function<void(VkDeviceMemory memory, bool mapped)> FreeBlock;
+		};
+
+		// a resource that has to be copied to a new location to compact the memory blocks
+		struct DefragmentationMove
+		{
+			DeviceAllocation* Allocation; // updated to Destination when the defragmentation is completed
+			DeviceAllocation Destination; // the caller recreates / copies the resource into this region
+		};
+
+		class DeviceMemoryAllocator
+		{
+		public:
+			DeviceMemoryAllocator(VkDevice logicalDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize preferredBlockSize = s_DefaultBlockSize);
+			DeviceMemoryAllocator(const DeviceMemoryCallbacks& callbacks, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize preferredBlockSize = s_DefaultBlockSize);
+			~DeviceMemoryAllocator();
+			DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+			DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+		public:
+			// linearResource: buffers & linear images, kept apart from optimal images to respect bufferImageGranularity
+			DeviceAllocation Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linearResource);
+			void Free(DeviceAllocation& allocation);
+			// convenience wrappers that query the requirements, allocate and bind
+			DeviceAllocation AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties);
+			DeviceAllocation AllocateForImage(VkImage image, VkMemoryPropertyFlags properties, bool linearTiling = false);
+			// defragmentation: moves allocations out of the emptiest blocks into fuller ones
+			// 1. BeginDefragmentation reserves the destinations
+			// 2. caller copies each resource to its destination (and rebinds / recreates it)
+			// 3. CompleteDefragmentation releases the old regions and any block left empty
+			std::vector<DefragmentationMove> BeginDefragmentation(const std::vector<DeviceAllocation*>& movableAllocations);
+			void CompleteDefragmentation(std::vector<DefragmentationMove>& moves);
+			void ReleaseEmptyBlocks();
+			_NODISCARD MemoryStatistics GetStatistics(uint32_t memoryTypeIndex) const;
+			_NODISCARD MemoryStatistics GetTotalStatistics() const;
+			void LogStatistics() const;
+		public:
+			static uint32_t FindMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32_t typeFilter, VkMemoryPropertyFlags properties);
+			static DeviceMemoryCallbacks CreateDeviceCallbacks(VkDevice logicalDevice);
+			static constexpr VkDeviceSize s_DefaultBlockSize = 64ull * 1024 * 1024;
+			static constexpr VkDeviceSize s_MinBlockSize = 256;
+		private:
+			struct MemoryBlock
+			{
+				uint32_t Id;
+				VkDeviceMemory Memory;
+				void* MappedData;
+				BuddyAllocator Allocator;
+			};
+			struct MemoryPool
+			{
+				std::vector<Scope<MemoryBlock>> Blocks;
+				uint32_t NextBlockId = 0;
+			};
+		private:
+			_NODISCARD VkDeviceSize GetBlockSize(uint32_t memoryTypeIndex) const;
+			_NODISCARD bool IsHostVisible(uint32_t memoryTypeIndex) const;
+			DeviceAllocation AllocateDedicated(uint32_t memoryTypeIndex, uint32_t poolIndex, VkDeviceSize size);
+			bool AllocateFromPool(uint32_t memoryTypeIndex, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, DeviceAllocation& allocation);
+			void FreeInternal(DeviceAllocation& allocation);
+			MemoryBlock* FindBlock(uint32_t poolIndex, uint32_t blockId);
+			void ReleaseEmptyBlocks(uint32_t poolIndex, uint32_t blocksToKeep);
+		private:
+			VkDevice m_LogicalDevice = VK_NULL_HANDLE;
+			DeviceMemoryCallbacks m_Callbacks;
+			VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+			VkDeviceSize m_PreferredBlockSize;
+			std::vector<MemoryPool> m_Pools; // two per memory type, [type * 2 + 0] linear, [type * 2 + 1] optimal
+			std::vector<MemoryStatistics> m_TypeStatistics; // blocks, allocations and bytes per memory type
+			mutable std::mutex m_Mutex;
+		};
+	}
+}
@@ -0,0 +1,177 @@
+/***************************************************************************
+ * Filename		: GeometryPool.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Shared vertex / index buffers every mesh is sub-allocated
+ *				  from, so any number of meshes draw from one buffer pair.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "GeometryPool.h"
+
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static uint32_t RoundUpToPowerOfTwo(uint32_t value)
+		{
+			uint32_t result = GeometryPool::s_MinAllocation;
+			while (result < value)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		GeometryPool::GeometryPool(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t vertexStride, uint32_t frameCount, uint32_t vertexCapacity, uint32_t indexCapacity)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_VertexStride(vertexStride),
+			m_VertexRanges(RoundUpToPowerOfTwo(vertexCapacity), s_MinAllocation), m_IndexRanges(RoundUpToPowerOfTwo(indexCapacity), s_MinAllocation), m_FrameCount(frameCount)
+		{
+			m_VertexBuffer = CreateBuffer(m_VertexRanges.GetSize() * m_VertexStride, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_VertexAllocation);
+			m_IndexBuffer = CreateBuffer(m_IndexRanges.GetSize() * sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_IndexAllocation);
+			VK_CORE_INFO("[GraphicsSystem::GeometryPool]: Created {0} vertex ({1} MB) / {2} index ({3} MB) pool", m_VertexRanges.GetSize(),
+				m_VertexRanges.GetSize() * m_VertexStride / (1024 * 1024), m_IndexRanges.GetSize(), m_IndexRanges.GetSize() * sizeof(uint32_t) / (1024 * 1024));
+		}
+
+		GeometryPool::~GeometryPool()
+		{
+			vkDestroyBuffer(m_LogicalDevice, m_IndexBuffer, nullptr);
+			m_Allocator.Free(m_IndexAllocation);
+			vkDestroyBuffer(m_LogicalDevice, m_VertexBuffer, nullptr);
+			m_Allocator.Free(m_VertexAllocation);
+		}
+
+		VkBuffer GeometryPool::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, DeviceAllocation& allocation) const
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = size;
+			bufferInfo.usage = usage;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			VkBuffer buffer;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::GeometryPool::CreateBuffer]: Failed to create geometry buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			allocation = m_Allocator.AllocateForBuffer(buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			return buffer;
+		}
+
+		uint32_t GeometryPool::AddMesh(UploadContext& uploadContext, const void* vertexData, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+			const MeshLod* lods, uint32_t lodCount, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+		{
+			VkDeviceSize firstVertex;
+			VkDeviceSize firstIndex;
+			if (!m_VertexRanges.Allocate(vertexCount, 1, firstVertex))
+			{
+				static const std::string message = "[GraphicsSystem::GeometryPool::AddMesh]: Out of vertex space!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			if (!m_IndexRanges.Allocate(indexCount, 1, firstIndex))
+			{
+				m_VertexRanges.Free(firstVertex);
+				static const std::string message = "[GraphicsSystem::GeometryPool::AddMesh]: Out of index space!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			uint32_t meshId;
+			if (m_FreeMeshIds.empty())
+			{
+				meshId = static_cast<uint32_t>(m_Meshes.size());
+				m_Meshes.emplace_back();
+			}
+			else
+			{
+				meshId = m_FreeMeshIds.back();
+				m_FreeMeshIds.pop_back();
+			}
+			GeometryMesh& mesh = m_Meshes[meshId];
+			mesh.Allocation = { static_cast<uint32_t>(firstVertex), vertexCount, static_cast<uint32_t>(firstIndex), indexCount };
+			mesh.Lods.assign(lods, lods + lodCount);
+			if (mesh.Lods.empty())
+			{
+				mesh.Lods.push_back({ 0, indexCount, 0.0f });
+			}
+			mesh.Center = (boundsMin + boundsMax) * 0.5f;
+			mesh.Radius = glm::length(boundsMax - boundsMin) * 0.5f;
+			mesh.Bounds = Aabb(boundsMin, boundsMax);
+			mesh.Alive = true;
+
+			uploadContext.UploadBuffer(m_VertexBuffer, vertexData, static_cast<VkDeviceSize>(vertexCount) * m_VertexStride, firstVertex * m_VertexStride);
+			uploadContext.UploadBuffer(m_IndexBuffer, indices, static_cast<VkDeviceSize>(indexCount) * sizeof(uint32_t), firstIndex * sizeof(uint32_t));
+			return meshId;
+		}
+
+		bool GeometryPool::CanAddMesh(uint32_t vertexCount, uint32_t indexCount) const
+		{
+			return m_VertexRanges.CanAllocate(vertexCount, 1) && m_IndexRanges.CanAllocate(indexCount, 1);
+		}
+
+		void GeometryPool::RemoveMesh(uint32_t meshId)
+		{
+			GeometryMesh& mesh = m_Meshes[meshId];
+			if (!mesh.Alive)
+			{
+				return;
+			}
+			// draws recorded before this still read the ranges, a new mesh uploaded into them would show up in frames in flight
+			mesh.Alive = false;
+			m_RemovedMeshes.push_back({ meshId, m_SubmittedFrames });
+		}
+
+		void GeometryPool::BeginFrame(uint64_t submittedFrames)
+		{
+			// each frame waits for the fence of the frame m_FrameCount before it, so frames up to submittedFrames + 1 - m_FrameCount
+			// have finished, and a mesh removed after BeginFrame(SubmittedFrames) was drawn by frame SubmittedFrames + 1 at the latest
+			m_SubmittedFrames = submittedFrames;
+			size_t released = 0;
+			while (released < m_RemovedMeshes.size() && m_RemovedMeshes[released].SubmittedFrames + m_FrameCount <= submittedFrames)
+			{
+				ReleaseMesh(m_RemovedMeshes[released].MeshId);
+				++released;
+			}
+			m_RemovedMeshes.erase(m_RemovedMeshes.begin(), m_RemovedMeshes.begin() + released);
+		}
+
+		void GeometryPool::ReleaseMesh(uint32_t meshId)
+		{
+			GeometryMesh& mesh = m_Meshes[meshId];
+			m_VertexRanges.Free(mesh.Allocation.FirstVertex);
+			m_IndexRanges.Free(mesh.Allocation.FirstIndex);
+			mesh = GeometryMesh();
+			m_FreeMeshIds.push_back(meshId);
+		}
+
+		VkDrawIndexedIndirectCommand GeometryPool::GetDrawCommand(uint32_t meshId, uint32_t lod, uint32_t instanceCount, uint32_t firstInstance) const
+		{
+			const GeometryMesh& mesh = m_Meshes[meshId];
+			const MeshLod& range = mesh.Lods[std::min<size_t>(lod, mesh.Lods.size() - 1)];
+			VkDrawIndexedIndirectCommand command = {};
+			command.indexCount = range.IndexCount;
+			command.instanceCount = instanceCount;
+			command.firstIndex = mesh.Allocation.FirstIndex + range.FirstIndex;
+			command.vertexOffset = static_cast<int32_t>(mesh.Allocation.FirstVertex);
+			command.firstInstance = firstInstance;
+			return command;
+		}
+
+		void GeometryPool::LogStatistics() const
+		{
+			VK_CORE_INFO("[GraphicsSystem::GeometryPool]: {0} meshes, {1} / {2} vertices and {3} / {4} indices reserved",
+				GetMeshCount(), m_VertexRanges.GetUsedSize(), m_VertexRanges.GetSize(), m_IndexRanges.GetUsedSize(), m_IndexRanges.GetSize());
+		}
+	}
+}
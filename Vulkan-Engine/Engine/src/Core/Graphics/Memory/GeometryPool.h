@@ -0,0 +1,108 @@
+/***************************************************************************
+ * Filename		: GeometryPool.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Shared vertex / index buffers every mesh is sub-allocated
+ *				  from, so any number of meshes draw from one buffer pair.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "BuddyAllocator.h"
+#include "DeviceMemoryAllocator.h"
+#include "Core/Graphics/Mesh/MeshData.h"
+#include "Core/Graphics/Transfer/UploadContext.h"
+#include "Core/Scene/Aabb.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// element ranges of a mesh in the shared buffers
+		struct GeometryAllocation
+		{
+			uint32_t FirstVertex = 0; // vertexOffset of the mesh's draws, its indices are relative to it
+			uint32_t VertexCount = 0;
+			uint32_t FirstIndex = 0; // added to the index ranges of the mesh's levels of detail
+			uint32_t IndexCount = 0;
+		};
+
+		// draw record of a mesh in the pool
+		struct GeometryMesh
+		{
+			GeometryAllocation Allocation;
+			std::vector<MeshLod> Lods; // relative to Allocation.FirstIndex, level 0 first
+			glm::vec3 Center = glm::vec3(0.0f); // bounding sphere in model space
+			float Radius = 0.0f;
+			Aabb Bounds; // model space
+			bool Alive = false;
+		};
+
+		class GeometryPool
+		{
+		public:
+			// capacities are in elements and rounded up to powers of two, frameCount is the number of frames in flight.
+			// The buffers never grow (draws would have to rebind them), so the capacities have to cover every mesh alive at
+			// once, with room for the buddy blocks rounding each mesh up to a power of two
+			GeometryPool(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t vertexStride, uint32_t frameCount,
+				uint32_t vertexCapacity, uint32_t indexCapacity);
+			~GeometryPool();
+			GeometryPool(const GeometryPool&) = delete;
+			GeometryPool& operator=(const GeometryPool&) = delete;
+		public:
+			// sub-allocates the mesh and records the copies into the upload context, returns the mesh id.
+			// Without level of detail ranges the whole index data is level 0. Throws if the pool is full, see CanAddMesh.
+			uint32_t AddMesh(UploadContext& uploadContext, const void* vertexData, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+				const MeshLod* lods, uint32_t lodCount, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+			// true if AddMesh has room for the mesh right now, ranges of removed meshes come back once their frames finish
+			_NODISCARD bool CanAddMesh(uint32_t vertexCount, uint32_t indexCount) const;
+			// the mesh is no longer drawn, its ranges and id are reused once every frame that may have drawn it has finished
+			void RemoveMesh(uint32_t meshId);
+			// the current frame's fence has signaled, submittedFrames counts every frame submitted so far
+			void BeginFrame(uint64_t submittedFrames);
+			_NODISCARD const GeometryMesh& GetMesh(uint32_t meshId) const { return m_Meshes[meshId]; }
+			_NODISCARD VkDrawIndexedIndirectCommand GetDrawCommand(uint32_t meshId, uint32_t lod, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+			_NODISCARD VkBuffer GetVertexBuffer() const { return m_VertexBuffer; }
+			_NODISCARD VkBuffer GetIndexBuffer() const { return m_IndexBuffer; }
+			_NODISCARD uint32_t GetMeshCount() const { return static_cast<uint32_t>(m_Meshes.size() - m_FreeMeshIds.size() - m_RemovedMeshes.size()); }
+			void LogStatistics() const;
+		public:
+			static constexpr uint32_t s_MinAllocation = 256; // elements, smallest buddy block
+		private:
+			struct RemovedMesh
+			{
+				uint32_t MeshId;
+				uint64_t SubmittedFrames; // of the BeginFrame before the removal, the frame after it may still have drawn the mesh
+			};
+		private:
+			VkBuffer CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, DeviceAllocation& allocation) const;
+			void ReleaseMesh(uint32_t meshId);
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			uint32_t m_VertexStride;
+			VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+			DeviceAllocation m_VertexAllocation;
+			VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+			DeviceAllocation m_IndexAllocation;
+			BuddyAllocator m_VertexRanges; // offsets and sizes in vertices
+			BuddyAllocator m_IndexRanges; // offsets and sizes in indices
+			std::vector<GeometryMesh> m_Meshes; // indexed by mesh id
+			std::vector<uint32_t> m_FreeMeshIds;
+			std::vector<RemovedMesh> m_RemovedMeshes; // oldest first, waiting for the frames that may still draw them
+			uint32_t m_FrameCount;
+			uint64_t m_SubmittedFrames = 0;
+		};
+	}
+}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ * Filename		: UniformRingBuffer.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Persistently mapped uniform arena per frame in flight,
+ *				  bound once as a dynamic uniform buffer and addressed by offset.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "UniformRingBuffer.h"
+
+#include "Core/Logger/Log.h"
+
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		UniformRingBuffer::UniformRingBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment)
+			: m_LogicalDevice(logicalDevice), m_Allocator(&allocator), m_Alignment(std::max<VkDeviceSize>(minOffsetAlignment, 16)),
+			m_FrameSize(GetAlignedFrameSize(frameSize, minOffsetAlignment))
+		{
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = m_FrameSize * frameCount;
+			bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_Buffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::UniformRingBuffer]: Failed to create uniform buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			// rewritten every frame, the shaders read it straight from host memory
+			m_Allocation = m_Allocator->AllocateForBuffer(m_Buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			m_FrameEnd = m_FrameSize;
+		}
+
+		UniformRingBuffer::UniformRingBuffer(void* mappedData, uint32_t frameCount, VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment)
+			: m_Alignment(std::max<VkDeviceSize>(minOffsetAlignment, 16)), m_FrameSize(GetAlignedFrameSize(frameSize, minOffsetAlignment))
+		{
+			m_Allocation.MappedData = mappedData;
+			m_FrameEnd = m_FrameSize;
+		}
+
+		UniformRingBuffer::~UniformRingBuffer()
+		{
+			if (m_Allocator != nullptr)
+			{
+				vkDestroyBuffer(m_LogicalDevice, m_Buffer, nullptr);
+				m_Allocator->Free(m_Allocation);
+			}
+		}
+
+		VkDeviceSize UniformRingBuffer::GetAlignedFrameSize(VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment)
+		{
+			const VkDeviceSize alignment = std::max<VkDeviceSize>(minOffsetAlignment, 16);
+			return (frameSize + alignment - 1) / alignment * alignment;
+		}
+
+		void UniformRingBuffer::Begin(uint32_t frameIndex)
+		{
+			m_FrameIndex = frameIndex;
+			m_Head = frameIndex * m_FrameSize;
+			m_FrameEnd = m_Head + m_FrameSize;
+			m_Overflowed = false;
+		}
+
+		void* UniformRingBuffer::Allocate(VkDeviceSize size, uint32_t& dynamicOffset)
+		{
+			const VkDeviceSize alignedSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+			if (m_Head + alignedSize > m_FrameEnd)
+			{
+				if (!m_Overflowed)
+				{
+					VK_CORE_WARN("[GraphicsSystem::UniformRingBuffer::Allocate]: Frame region of {0} bytes is full, the rest of the frame's uniforms are dropped!", m_FrameSize);
+					m_Overflowed = true;
+				}
+				return nullptr;
+			}
+			dynamicOffset = static_cast<uint32_t>(m_Head);
+			m_Head += alignedSize;
+			return static_cast<char*>(m_Allocation.MappedData) + dynamicOffset;
+		}
+
+		bool UniformRingBuffer::Write(const void* data, VkDeviceSize size, uint32_t& dynamicOffset)
+		{
+			void* destination = Allocate(size, dynamicOffset);
+			if (destination == nullptr)
+			{
+				return false;
+			}
+			std::memcpy(destination, data, static_cast<size_t>(size));
+			return true;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ * Filename		: UniformRingBuffer.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Persistently mapped uniform arena per frame in flight,
+ *				  bound once as a dynamic uniform buffer and addressed by offset.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// a linear allocator over the frame's region: Begin rewinds it, every Allocate / Write bumps it by the size rounded
+		// up to minUniformBufferOffsetAlignment and returns the offset to pass to vkCmdBindDescriptorSets.
+		// Point the descriptor (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) at GetBuffer with offset 0 and the size of one block.
+		// Only write the region of a frame whose fence has signaled.
+		class UniformRingBuffer
+		{
+		public:
+			UniformRingBuffer(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, uint32_t frameCount, VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment);
+			// over caller owned host memory of frameCount * GetFrameSize bytes, without a buffer (GetBuffer is VK_NULL_HANDLE)
+			UniformRingBuffer(void* mappedData, uint32_t frameCount, VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment);
+			~UniformRingBuffer();
+			UniformRingBuffer(const UniformRingBuffer&) = delete;
+			UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+		public:
+			void Begin(uint32_t frameIndex);
+			// mapped pointer to write size bytes at -> nullptr (with a warning) once the frame's region is full
+			void* Allocate(VkDeviceSize size, uint32_t& dynamicOffset);
+			bool Write(const void* data, VkDeviceSize size, uint32_t& dynamicOffset);
+			template<typename T>
+			bool Write(const T& data, uint32_t& dynamicOffset) { return Write(&data, sizeof(T), dynamicOffset); }
+			_NODISCARD VkBuffer GetBuffer() const { return m_Buffer; }
+			_NODISCARD VkDeviceSize GetFrameSize() const { return m_FrameSize; }
+			_NODISCARD VkDeviceSize GetUsedSize() const { return m_Head - m_FrameIndex * m_FrameSize; } // of the current frame
+			_NODISCARD VkDeviceSize GetAlignment() const { return m_Alignment; }
+			// frameSize rounded up to the alignment the ring uses for minOffsetAlignment
+			_NODISCARD static VkDeviceSize GetAlignedFrameSize(VkDeviceSize frameSize, VkDeviceSize minOffsetAlignment);
+		private:
+			VkDevice m_LogicalDevice = VK_NULL_HANDLE;
+			DeviceMemoryAllocator* m_Allocator = nullptr; // null over caller owned memory
+			VkBuffer m_Buffer = VK_NULL_HANDLE;
+			DeviceAllocation m_Allocation; // persistently mapped
+			VkDeviceSize m_Alignment;
+			VkDeviceSize m_FrameSize; // multiple of m_Alignment, so every frame starts on a valid offset
+			uint32_t m_FrameIndex = 0;
+			VkDeviceSize m_Head = 0; // next free byte of the buffer
+			VkDeviceSize m_FrameEnd = 0;
+			bool m_Overflowed = false; // warn once per frame
+		};
+	}
+}
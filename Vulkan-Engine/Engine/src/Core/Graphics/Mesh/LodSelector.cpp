@@ -0,0 +1,46 @@
+/***************************************************************************
+ * Filename		: LodSelector.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Picks a mesh level of detail from its stored error and the
+ *				  size that error projects to on screen.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "LodSelector.h"
+
+#include <cmath>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		float LodSelector::GetProjectionScale(float fovY, float viewportHeight)
+		{
+			return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+		}
+
+		uint32_t LodSelector::SelectLod(const MeshLod* lods, uint32_t lodCount, float distance, float projectionScale, float errorScale, float maxPixelError)
+		{
+			if (lodCount == 0 || !(distance > 0.0f)) // inside the bounds, full detail
+			{
+				return 0;
+			}
+			// errors grow with the level, so the first level over the limit ends the search
+			const float maxError = maxPixelError * distance / (projectionScale * errorScale);
+			uint32_t selected = 0;
+			for (uint32_t lod = 1; lod < lodCount && lods[lod].Error <= maxError; ++lod)
+			{
+				selected = lod;
+			}
+			return selected;
+		}
+	}
+}
@@ -0,0 +1,40 @@
+/***************************************************************************
+ * Filename		: LodSelector.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Picks a mesh level of detail from its stored error and the
+ *				  size that error projects to on screen.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "MeshData.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		class LodSelector
+		{
+		public:
+			LodSelector() = delete;
+			~LodSelector() = delete;
+		public:
+			// pixels covered by one world unit at distance 1 for a perspective projection
+			_NODISCARD static float GetProjectionScale(float fovY, float viewportHeight);
+			// coarsest level whose error, seen from distance (world units to the closest point of the mesh bounds), covers at most
+			// maxPixelError pixels. errorScale converts model to world units (largest scale of the model matrix).
+			_NODISCARD static uint32_t SelectLod(const MeshLod* lods, uint32_t lodCount, float distance, float projectionScale,
+				float errorScale = 1.0f, float maxPixelError = s_DefaultMaxPixelError);
+		public:
+			static constexpr float s_DefaultMaxPixelError = 1.0f;
+		};
+	}
+}
@@ -0,0 +1,75 @@
+/***************************************************************************
+ * Filename		: MeshData.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Indexed triangle mesh with unique vertices, as produced by
+ *				  the importers, its meshlet clusters and levels of detail.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Graphics/Pipeline/Shaders/Vertex.h"
+#include "VertexKernels.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// a cluster of at most MeshletBuilder::s_MaxVertices vertices / s_MaxTriangles triangles with its culling bounds,
+		// laid out as vec3 + scalar rows so the array can be read as a std430 storage buffer
+		struct Meshlet
+		{
+			glm::vec3 Center = glm::vec3(0.0f); // bounding sphere
+			float Radius = 0.0f;
+			glm::vec3 ConeAxis = glm::vec3(0.0f); // normal cone, zero axis / cutoff 1 if the normals are too spread out to cull
+			float ConeCutoff = 1.0f; // sin of the cone half angle
+			glm::vec3 ConeApex = glm::vec3(0.0f);
+			uint32_t FirstIndex = 0; // the meshlet's triangles are contiguous in the mesh index buffer
+			uint32_t VertexOffset = 0; // into MeshletVertices
+			uint32_t VertexCount = 0;
+			uint32_t TriangleOffset = 0; // byte offset into MeshletTriangles, 4 byte aligned
+			uint32_t TriangleCount = 0;
+
+			// true if every triangle faces away from a camera at cameraPosition (same space as the vertices)
+			_NODISCARD bool IsBackfacing(const glm::vec3& cameraPosition) const
+			{
+				const glm::vec3 direction = ConeApex - cameraPosition;
+				return glm::dot(direction, ConeAxis) >= ConeCutoff * glm::length(direction);
+			}
+		};
+
+		// index range of one level of detail, all levels share the vertex buffer
+		struct MeshLod
+		{
+			uint32_t FirstIndex = 0;
+			uint32_t IndexCount = 0;
+			float Error = 0.0f; // estimated deviation from level 0 in model units
+		};
+
+		struct MeshData
+		{
+			std::vector<Vertex> Vertices;
+			std::vector<uint32_t> Indices; // triangle list, level 0 followed by the other levels of detail
+			std::vector<MeshLod> Lods; // empty until MeshSimplifier::BuildLodChain ran, then level 0 first
+			std::vector<Meshlet> Meshlets; // empty until MeshletBuilder::Build ran
+			std::vector<uint32_t> MeshletVertices; // meshlet local vertex -> index into Vertices
+			std::vector<uint8_t> MeshletTriangles; // 3 meshlet local vertex indices per triangle
+			glm::vec3 BoundsMin = glm::vec3(0.0f);
+			glm::vec3 BoundsMax = glm::vec3(0.0f);
+
+			void ComputeBounds()
+			{
+				VertexKernels::ComputeBounds(Vertices.data(), Vertices.size(), BoundsMin, BoundsMax);
+			}
+		};
+	}
+}
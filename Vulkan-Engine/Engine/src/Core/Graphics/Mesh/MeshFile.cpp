@@ -0,0 +1,278 @@
+/***************************************************************************
+ * Filename		: MeshFile.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Versioned binary mesh format (.vkmesh), memory mapped so
+ *				  the vertex / index data can be copied straight to staging.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "MeshFile.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+#include "Core/Utility/Hash.h"
+#include "MeshletBuilder.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjImporter.h"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint64_t MESH_DATA_ALIGNMENT = 16;
+
+		static uint64_t AlignOffset(uint64_t offset)
+		{
+			return (offset + MESH_DATA_ALIGNMENT - 1) & ~(MESH_DATA_ALIGNMENT - 1);
+		}
+
+		// true if the array of size bytes at offset is aligned, starts at or after begin and ends inside the file, moves begin to its end
+		static bool ValidateArray(uint64_t offset, uint64_t size, uint64_t fileSize, uint64_t& begin)
+		{
+			if (offset % MESH_DATA_ALIGNMENT != 0 || offset < begin || offset > fileSize || size > fileSize - offset)
+			{
+				return false;
+			}
+			begin = offset + size;
+			return true;
+		}
+
+		// the arrays are inside the file, checks that what they reference is inside the arrays: a corrupt index would
+		// read past the vertex buffer on the gpu, a corrupt meshlet past the mapped file
+		static bool ValidateContents(const MeshFileHeader& header, const uint8_t* data)
+		{
+			const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + header.IndexDataOffset);
+			if (header.IndexCount % 3 != 0 || std::any_of(indices, indices + header.IndexCount, [&header](uint32_t index) { return index >= header.VertexCount; }))
+			{
+				return false;
+			}
+
+			const MeshLod* lods = reinterpret_cast<const MeshLod*>(data + header.LodDataOffset);
+			for (uint32_t i = 0; i < header.LodCount; ++i)
+			{
+				if (lods[i].IndexCount % 3 != 0 || static_cast<uint64_t>(lods[i].FirstIndex) + lods[i].IndexCount > header.IndexCount)
+				{
+					return false;
+				}
+			}
+
+			const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(data + header.MeshletDataOffset);
+			const uint32_t* meshletVertices = reinterpret_cast<const uint32_t*>(data + header.MeshletVertexDataOffset);
+			const uint8_t* meshletTriangles = data + header.MeshletTriangleDataOffset;
+			if (std::any_of(meshletVertices, meshletVertices + header.MeshletVertexCount, [&header](uint32_t vertex) { return vertex >= header.VertexCount; }))
+			{
+				return false;
+			}
+			for (uint32_t i = 0; i < header.MeshletCount; ++i)
+			{
+				const Meshlet& meshlet = meshlets[i];
+				const uint64_t triangleBytes = static_cast<uint64_t>(meshlet.TriangleCount) * 3;
+				if (static_cast<uint64_t>(meshlet.VertexOffset) + meshlet.VertexCount > header.MeshletVertexCount ||
+					meshlet.TriangleOffset + triangleBytes > header.MeshletTriangleDataSize ||
+					meshlet.FirstIndex + triangleBytes > header.IndexCount)
+				{
+					return false;
+				}
+				const uint8_t* localIndices = meshletTriangles + meshlet.TriangleOffset;
+				if (std::any_of(localIndices, localIndices + triangleBytes, [&meshlet](uint8_t index) { return index >= meshlet.VertexCount; }))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		MeshFile::MeshFile(const std::string& filepath)
+			: m_File(CreateScope<IO::MappedFile>(filepath))
+		{
+			if (!m_File->IsOpen() || m_File->GetSize() < sizeof(MeshFileHeader))
+			{
+				return;
+			}
+			const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(m_File->GetData());
+			const uint64_t fileSize = m_File->GetSize();
+			uint64_t end = sizeof(MeshFileHeader);
+			if (header->Magic != s_Magic || header->Version != s_Version || header->VertexStride != sizeof(Vertex) || header->MeshletStride != sizeof(Meshlet) || header->LodStride != sizeof(MeshLod) ||
+				!ValidateArray(header->VertexDataOffset, static_cast<uint64_t>(header->VertexCount) * sizeof(Vertex), fileSize, end) ||
+				!ValidateArray(header->IndexDataOffset, static_cast<uint64_t>(header->IndexCount) * sizeof(uint32_t), fileSize, end) ||
+				!ValidateArray(header->MeshletDataOffset, static_cast<uint64_t>(header->MeshletCount) * sizeof(Meshlet), fileSize, end) ||
+				!ValidateArray(header->MeshletVertexDataOffset, static_cast<uint64_t>(header->MeshletVertexCount) * sizeof(uint32_t), fileSize, end) ||
+				!ValidateArray(header->MeshletTriangleDataOffset, header->MeshletTriangleDataSize, fileSize, end) ||
+				!ValidateArray(header->LodDataOffset, static_cast<uint64_t>(header->LodCount) * sizeof(MeshLod), fileSize, end) ||
+				!ValidateContents(*header, m_File->GetData()))
+			{
+				VK_CORE_WARN("[GraphicsSystem::MeshFile]: {0} is not a valid version {1} mesh file", filepath, s_Version);
+				return;
+			}
+			m_Data = m_File->GetData();
+			m_Header = header;
+		}
+
+		// an array of the mesh and the header field holding its offset in the file
+		struct MeshDataArray
+		{
+			const void* Data;
+			uint64_t Size;
+			uint64_t* Offset;
+		};
+
+		// fills header and the arrays in file order, each one placed at the next aligned offset. Returns the size of the file
+		static uint64_t LayoutMesh(const MeshData& mesh, uint64_t sourceHash, MeshFileHeader& header, std::array<MeshDataArray, 6>& arrays)
+		{
+			header = {};
+			header.Magic = MeshFile::s_Magic;
+			header.Version = MeshFile::s_Version;
+			header.SourceHash = sourceHash;
+			header.VertexStride = sizeof(Vertex);
+			header.VertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+			header.IndexCount = static_cast<uint32_t>(mesh.Indices.size());
+			header.MeshletStride = sizeof(Meshlet);
+			for (int i = 0; i < 3; ++i)
+			{
+				header.BoundsMin[i] = mesh.BoundsMin[i];
+				header.BoundsMax[i] = mesh.BoundsMax[i];
+			}
+			header.MeshletCount = static_cast<uint32_t>(mesh.Meshlets.size());
+			header.MeshletVertexCount = static_cast<uint32_t>(mesh.MeshletVertices.size());
+			header.MeshletTriangleDataSize = mesh.MeshletTriangles.size();
+			header.LodCount = static_cast<uint32_t>(mesh.Lods.size());
+			header.LodStride = sizeof(MeshLod);
+
+			arrays =
+			{ {
+				{ mesh.Vertices.data(), sizeof(Vertex) * mesh.Vertices.size(), &header.VertexDataOffset },
+				{ mesh.Indices.data(), sizeof(uint32_t) * mesh.Indices.size(), &header.IndexDataOffset },
+				{ mesh.Meshlets.data(), sizeof(Meshlet) * mesh.Meshlets.size(), &header.MeshletDataOffset },
+				{ mesh.MeshletVertices.data(), sizeof(uint32_t) * mesh.MeshletVertices.size(), &header.MeshletVertexDataOffset },
+				{ mesh.MeshletTriangles.data(), mesh.MeshletTriangles.size(), &header.MeshletTriangleDataOffset },
+				{ mesh.Lods.data(), sizeof(MeshLod) * mesh.Lods.size(), &header.LodDataOffset },
+			} };
+			uint64_t offset = sizeof(MeshFileHeader);
+			for (const MeshDataArray& array : arrays)
+			{
+				*array.Offset = AlignOffset(offset);
+				offset = *array.Offset + array.Size;
+			}
+			return offset;
+		}
+
+		MeshFile::MeshFile(const MeshData& mesh, uint64_t sourceHash)
+		{
+			MeshFileHeader header;
+			std::array<MeshDataArray, 6> arrays;
+			m_Memory.resize(static_cast<size_t>(LayoutMesh(mesh, sourceHash, header, arrays))); // zeroed, so the padding is too
+			std::memcpy(m_Memory.data(), &header, sizeof(header));
+			for (const MeshDataArray& array : arrays)
+			{
+				if (array.Size != 0)
+				{
+					std::memcpy(m_Memory.data() + *array.Offset, array.Data, static_cast<size_t>(array.Size));
+				}
+			}
+			m_Data = m_Memory.data();
+			m_Header = reinterpret_cast<const MeshFileHeader*>(m_Data);
+		}
+
+		bool MeshFile::Write(const std::string& filepath, const MeshData& mesh, uint64_t sourceHash)
+		{
+			MeshFileHeader header;
+			std::array<MeshDataArray, 6> arrays;
+			LayoutMesh(mesh, sourceHash, header, arrays);
+
+			std::error_code error;
+			const std::filesystem::path path(filepath);
+			if (path.has_parent_path())
+			{
+				std::filesystem::create_directories(path.parent_path(), error);
+			}
+			const std::filesystem::path temporaryPath = path.string() + ".tmp";
+			{
+				std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+				const char padding[MESH_DATA_ALIGNMENT] = {};
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				uint64_t offset = sizeof(header);
+				for (const MeshDataArray& array : arrays)
+				{
+					file.write(padding, static_cast<std::streamsize>(*array.Offset - offset));
+					file.write(reinterpret_cast<const char*>(array.Data), static_cast<std::streamsize>(array.Size));
+					offset = *array.Offset + array.Size;
+				}
+				file.flush();
+				if (!file)
+				{
+					VK_CORE_WARN("[GraphicsSystem::MeshFile::Write]: Failed to write {0}", temporaryPath.string());
+					file.close();
+					std::filesystem::remove(temporaryPath, error);
+					return false;
+				}
+			}
+			std::filesystem::rename(temporaryPath, path, error);
+			if (error)
+			{
+				VK_CORE_WARN("[GraphicsSystem::MeshFile::Write]: Failed to replace {0}: {1}", filepath, error.message());
+				std::filesystem::remove(temporaryPath, error);
+				return false;
+			}
+			return true;
+		}
+
+		uint64_t MeshFile::HashSourceFile(const std::string& filepath)
+		{
+			const IO::MappedFile source(filepath);
+			return source.IsOpen() ? HashBytes(source.GetData(), source.GetSize()) : 0;
+		}
+
+		Scope<MeshFile> MeshFile::LoadObj(const std::string& sourcePath, const std::string& cachePath)
+		{
+			const Timer loadTimer;
+			const uint64_t sourceHash = HashSourceFile(sourcePath);
+			Scope<MeshFile> meshFile = CreateScope<MeshFile>(cachePath);
+			if (meshFile->IsValid() && (meshFile->GetSourceHash() == sourceHash || sourceHash == 0))
+			{
+				if (sourceHash == 0)
+				{
+					VK_CORE_WARN("[GraphicsSystem::MeshFile::LoadObj]: {0} is missing, using the cached mesh", sourcePath);
+				}
+				VK_CORE_INFO("[GraphicsSystem::MeshFile::LoadObj]: Mapped {0} ({1} vertices, {2} indices, {3} meshlets, {4} levels of detail) in {5:.3f}ms",
+					cachePath, meshFile->GetVertexCount(), meshFile->GetIndexCount(), meshFile->GetMeshletCount(), meshFile->GetLodCount(), loadTimer.GetMilliseconds());
+				return meshFile;
+			}
+
+			// first load (or the obj changed): parse it once and keep the result for the next runs
+			meshFile.reset();
+			MeshData mesh = ObjImporter::Import(sourcePath);
+			MeshOptimizer::Optimize(mesh);
+			MeshletBuilder::Build(mesh);
+			MeshSimplifier::BuildLodChain(mesh);
+			const float importMilliseconds = loadTimer.GetMilliseconds();
+			if (!Write(cachePath, mesh, sourceHash))
+			{
+				// a read only or full drive shouldn't stop the mesh from loading, it is imported again next run
+				VK_CORE_WARN("[GraphicsSystem::MeshFile::LoadObj]: Failed to write the mesh cache {0}, using the imported mesh", cachePath);
+				return CreateScope<MeshFile>(mesh, sourceHash);
+			}
+			meshFile = CreateScope<MeshFile>(cachePath);
+			if (!meshFile->IsValid())
+			{
+				VK_CORE_WARN("[GraphicsSystem::MeshFile::LoadObj]: Failed to map the mesh cache {0} that was just written, using the imported mesh", cachePath);
+				return CreateScope<MeshFile>(mesh, sourceHash);
+			}
+			VK_CORE_INFO("[GraphicsSystem::MeshFile::LoadObj]: Imported {0} ({1} vertices, {2} indices) in {3:.3f}ms and cached it as {4}",
+				sourcePath, meshFile->GetVertexCount(), meshFile->GetIndexCount(), importMilliseconds, cachePath);
+			return meshFile;
+		}
+	}
+}
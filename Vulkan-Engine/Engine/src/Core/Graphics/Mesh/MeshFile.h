@@ -0,0 +1,101 @@
+/***************************************************************************
+ * Filename		: MeshFile.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Versioned binary mesh format (.vkmesh), memory mapped so
+ *				  the vertex / index data can be copied straight to staging.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/IO/MappedFile.h"
+#include "MeshData.h"
+
+#include <string>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// File layout: MeshFileHeader | vertices (Vertex[VertexCount]) | indices (uint32_t[IndexCount]) |
+		// meshlets (Meshlet[MeshletCount]) | meshlet vertices (uint32_t[MeshletVertexCount]) | meshlet triangles (uint8_t[MeshletTriangleDataSize]) |
+		// levels of detail (MeshLod[LodCount]),
+		// every array starts at a 16 byte aligned offset stored in the header.
+		struct MeshFileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t SourceHash; // content hash of the file the mesh was converted from
+			uint32_t VertexStride; // sizeof(Vertex) when written, a layout change invalidates the file
+			uint32_t VertexCount;
+			uint32_t IndexCount;
+			uint32_t MeshletStride; // sizeof(Meshlet) when written
+			float BoundsMin[3];
+			float BoundsMax[3];
+			uint64_t VertexDataOffset;
+			uint64_t IndexDataOffset;
+			uint32_t MeshletCount;
+			uint32_t MeshletVertexCount;
+			uint64_t MeshletTriangleDataSize; // bytes, 3 local indices per triangle and every meshlet padded to 4 bytes
+			uint64_t MeshletDataOffset;
+			uint64_t MeshletVertexDataOffset;
+			uint64_t MeshletTriangleDataOffset;
+			uint32_t LodCount;
+			uint32_t LodStride; // sizeof(MeshLod) when written
+			uint64_t LodDataOffset;
+		};
+
+		class MeshFile
+		{
+		public:
+			explicit MeshFile(const std::string& filepath); // maps the file and validates the header and the index / meshlet / lod ranges against the data
+			MeshFile(const MeshData& mesh, uint64_t sourceHash); // the same layout in memory, for a mesh whose cache couldn't be written
+			~MeshFile() = default;
+			MeshFile(const MeshFile&) = delete;
+			MeshFile& operator=(const MeshFile&) = delete;
+		public:
+			_NODISCARD bool IsValid() const { return m_Header != nullptr; }
+			_NODISCARD uint64_t GetSourceHash() const { return m_Header->SourceHash; }
+			_NODISCARD const Vertex* GetVertices() const { return reinterpret_cast<const Vertex*>(m_Data + m_Header->VertexDataOffset); }
+			_NODISCARD uint32_t GetVertexCount() const { return m_Header->VertexCount; }
+			_NODISCARD size_t GetVertexDataSize() const { return sizeof(Vertex) * m_Header->VertexCount; }
+			_NODISCARD const uint32_t* GetIndices() const { return reinterpret_cast<const uint32_t*>(m_Data + m_Header->IndexDataOffset); }
+			_NODISCARD uint32_t GetIndexCount() const { return m_Header->IndexCount; }
+			_NODISCARD size_t GetIndexDataSize() const { return sizeof(uint32_t) * m_Header->IndexCount; }
+			_NODISCARD glm::vec3 GetBoundsMin() const { return glm::vec3(m_Header->BoundsMin[0], m_Header->BoundsMin[1], m_Header->BoundsMin[2]); }
+			_NODISCARD glm::vec3 GetBoundsMax() const { return glm::vec3(m_Header->BoundsMax[0], m_Header->BoundsMax[1], m_Header->BoundsMax[2]); }
+			_NODISCARD const Meshlet* GetMeshlets() const { return reinterpret_cast<const Meshlet*>(m_Data + m_Header->MeshletDataOffset); }
+			_NODISCARD uint32_t GetMeshletCount() const { return m_Header->MeshletCount; }
+			_NODISCARD const uint32_t* GetMeshletVertices() const { return reinterpret_cast<const uint32_t*>(m_Data + m_Header->MeshletVertexDataOffset); }
+			_NODISCARD uint32_t GetMeshletVertexCount() const { return m_Header->MeshletVertexCount; }
+			_NODISCARD const uint8_t* GetMeshletTriangles() const { return m_Data + m_Header->MeshletTriangleDataOffset; }
+			_NODISCARD size_t GetMeshletTriangleDataSize() const { return static_cast<size_t>(m_Header->MeshletTriangleDataSize); }
+			_NODISCARD const MeshLod* GetLods() const { return reinterpret_cast<const MeshLod*>(m_Data + m_Header->LodDataOffset); }
+			_NODISCARD uint32_t GetLodCount() const { return m_Header->LodCount; }
+		public:
+			static bool Write(const std::string& filepath, const MeshData& mesh, uint64_t sourceHash); // atomic (temporary file + rename)
+			static uint64_t HashSourceFile(const std::string& filepath); // 0 if the file can't be read
+			// maps cachePath if it was converted from the current contents of sourcePath, otherwise imports the obj,
+			// writes the cache and maps that. If the cache can't be written the imported mesh is returned from memory.
+			// Throws if the source can't be imported.
+			static Scope<MeshFile> LoadObj(const std::string& sourcePath, const std::string& cachePath);
+		public:
+			static constexpr uint32_t s_Magic = 0x534d4b56; // "VKMS"
+			static constexpr uint32_t s_Version = 4; // 2: indices / vertices are cache, overdraw and fetch optimized, 3: meshlets, 4: levels of detail
+		private:
+			Scope<IO::MappedFile> m_File; // null for a mesh built in memory
+			std::vector<uint8_t> m_Memory; // the file contents when built in memory
+			const uint8_t* m_Data = nullptr; // the mapped file or m_Memory
+			const MeshFileHeader* m_Header = nullptr; // null if the file is missing or invalid
+		};
+	}
+}
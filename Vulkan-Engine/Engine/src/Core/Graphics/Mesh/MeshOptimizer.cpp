@@ -0,0 +1,327 @@
+/***************************************************************************
+ * Filename		: MeshOptimizer.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Offline index / vertex reordering for imported meshes,
+ *				  post-transform cache (Tipsify), overdraw and fetch order.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "MeshOptimizer.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint32_t INVALID_VERTEX = UINT32_MAX;
+
+		// FIFO post-transform cache, a vertex is cached while fewer than cacheSize misses happened since it was inserted
+		class FifoCacheSimulation
+		{
+		public:
+			FifoCacheSimulation(size_t vertexCount, uint32_t cacheSize)
+				: m_Timestamps(vertexCount, 0), m_Time(cacheSize + 1), m_CacheSize(cacheSize) {}
+			~FifoCacheSimulation() = default;
+
+			// returns true on a miss
+			inline bool Access(uint32_t vertex)
+			{
+				if (m_Time - m_Timestamps[vertex] > m_CacheSize)
+				{
+					m_Timestamps[vertex] = m_Time++;
+					return true;
+				}
+				return false;
+			}
+			inline uint32_t AccessTriangle(const uint32_t* triangle)
+			{
+				return (Access(triangle[0]) ? 1 : 0) + (Access(triangle[1]) ? 1 : 0) + (Access(triangle[2]) ? 1 : 0);
+			}
+			inline void Flush() { m_Time += m_CacheSize + 1; }
+		private:
+			std::vector<uint32_t> m_Timestamps;
+			uint32_t m_Time;
+			uint32_t m_CacheSize;
+		};
+
+		VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+		{
+			VertexCacheStatistics statistics = {};
+			const size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0 || vertexCount == 0)
+			{
+				return statistics;
+			}
+			FifoCacheSimulation cache(vertexCount, cacheSize);
+			for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				statistics.VerticesTransformed += cache.AccessTriangle(&indices[triangle * 3]);
+			}
+			statistics.ACMR = static_cast<float>(statistics.VerticesTransformed) / static_cast<float>(triangleCount);
+			statistics.ATVR = static_cast<float>(statistics.VerticesTransformed) / static_cast<float>(vertexCount);
+			return statistics;
+		}
+
+		void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+		{
+			const size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0)
+			{
+				return;
+			}
+
+			// vertex -> triangle adjacency (compressed rows), the live counts double as the triangles left to emit per vertex
+			std::vector<uint32_t> liveTriangles(vertexCount, 0);
+			for (const uint32_t index : indices)
+			{
+				++liveTriangles[index];
+			}
+			std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+			for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+			{
+				adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+			}
+			std::vector<uint32_t> adjacency(indices.size());
+			{
+				std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					adjacency[fillOffsets[indices[i]]++] = static_cast<uint32_t>(i / 3);
+				}
+			}
+
+			std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+			std::vector<bool> emitted(triangleCount, false);
+			std::vector<uint32_t> deadEndStack;
+			std::vector<uint32_t> candidates;
+			std::vector<uint32_t> output;
+			deadEndStack.reserve(indices.size());
+			output.reserve(indices.size());
+			uint32_t time = cacheSize + 1;
+			size_t scanCursor = 0;
+
+			// fans around one vertex at a time, emitting all of its remaining triangles
+			uint32_t fanningVertex = indices[0];
+			while (fanningVertex != INVALID_VERTEX)
+			{
+				candidates.clear();
+				for (uint32_t a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1]; ++a)
+				{
+					const uint32_t triangle = adjacency[a];
+					if (emitted[triangle])
+					{
+						continue;
+					}
+					for (uint32_t corner = 0; corner < 3; ++corner)
+					{
+						const uint32_t vertex = indices[triangle * 3 + corner];
+						output.push_back(vertex);
+						deadEndStack.push_back(vertex);
+						candidates.push_back(vertex);
+						--liveTriangles[vertex];
+						if (time - cacheTimestamps[vertex] > cacheSize)
+						{
+							cacheTimestamps[vertex] = time++;
+						}
+					}
+					emitted[triangle] = true;
+				}
+
+				// next fanning vertex: the oldest candidate that would still be in the cache after fanning around it
+				fanningVertex = INVALID_VERTEX;
+				int64_t bestPriority = -1;
+				for (const uint32_t vertex : candidates)
+				{
+					if (liveTriangles[vertex] == 0)
+					{
+						continue;
+					}
+					const int64_t age = static_cast<int64_t>(time) - cacheTimestamps[vertex];
+					const int64_t priority = age + 2 * static_cast<int64_t>(liveTriangles[vertex]) <= cacheSize ? age : 0;
+					if (priority > bestPriority)
+					{
+						bestPriority = priority;
+						fanningVertex = vertex;
+					}
+				}
+				if (fanningVertex != INVALID_VERTEX)
+				{
+					continue;
+				}
+
+				// dead end: go back to recently emitted vertices, then to any vertex with triangles left
+				while (!deadEndStack.empty() && fanningVertex == INVALID_VERTEX)
+				{
+					const uint32_t vertex = deadEndStack.back();
+					deadEndStack.pop_back();
+					if (liveTriangles[vertex] > 0)
+					{
+						fanningVertex = vertex;
+					}
+				}
+				while (scanCursor < vertexCount && fanningVertex == INVALID_VERTEX)
+				{
+					if (liveTriangles[scanCursor] > 0)
+					{
+						fanningVertex = static_cast<uint32_t>(scanCursor);
+					}
+					else
+					{
+						++scanCursor;
+					}
+				}
+			}
+			indices.swap(output);
+		}
+
+		void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float threshold, uint32_t cacheSize)
+		{
+			const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+			if (triangleCount < 2)
+			{
+				return;
+			}
+
+			// hard boundaries, triangles where the cache optimized order starts over (all three vertices miss)
+			FifoCacheSimulation cache(vertices.size(), cacheSize);
+			std::vector<uint32_t> hardBoundaries;
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				const uint32_t misses = cache.AccessTriangle(&indices[triangle * 3]);
+				if (triangle == 0 || misses == 3)
+				{
+					hardBoundaries.push_back(triangle);
+				}
+			}
+			hardBoundaries.push_back(triangleCount);
+
+			// soft boundaries, split a hard cluster wherever restarting the cache keeps its ACMR within the threshold
+			std::vector<uint32_t> clusters;
+			for (size_t hard = 0; hard + 1 < hardBoundaries.size(); ++hard)
+			{
+				const uint32_t begin = hardBoundaries[hard];
+				const uint32_t end = hardBoundaries[hard + 1];
+				cache.Flush();
+				uint32_t misses = 0;
+				for (uint32_t triangle = begin; triangle < end; ++triangle)
+				{
+					misses += cache.AccessTriangle(&indices[triangle * 3]);
+				}
+				const float clusterThreshold = threshold * static_cast<float>(misses) / static_cast<float>(end - begin);
+
+				cache.Flush();
+				clusters.push_back(begin);
+				uint32_t clusterStart = begin;
+				misses = 0;
+				for (uint32_t triangle = begin; triangle + 1 < end; ++triangle)
+				{
+					misses += cache.AccessTriangle(&indices[triangle * 3]);
+					if (static_cast<float>(misses) / static_cast<float>(triangle + 1 - clusterStart) <= clusterThreshold)
+					{
+						clusterStart = triangle + 1;
+						clusters.push_back(clusterStart);
+						misses = 0;
+						cache.Flush();
+					}
+				}
+			}
+			const size_t clusterCount = clusters.size();
+			clusters.push_back(triangleCount);
+
+			// view independent occlusion potential (Sander et al.), clusters far out along their own normal are drawn first
+			const auto GetTriangleArea = [&](uint32_t triangle, glm::vec3& centroid) -> glm::vec3
+			{
+				const glm::vec3& p0 = vertices[indices[triangle * 3 + 0]].Position;
+				const glm::vec3& p1 = vertices[indices[triangle * 3 + 1]].Position;
+				const glm::vec3& p2 = vertices[indices[triangle * 3 + 2]].Position;
+				centroid = (p0 + p1 + p2) / 3.0f;
+				return glm::cross(p1 - p0, p2 - p0); // area weighted normal
+			};
+			glm::vec3 meshCentroid(0.0f);
+			float meshArea = 0.0f;
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				glm::vec3 centroid;
+				const float area = glm::length(GetTriangleArea(triangle, centroid));
+				meshCentroid += centroid * area;
+				meshArea += area;
+			}
+			meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3(0.0f);
+
+			std::vector<float> sortKeys(clusterCount);
+			for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+			{
+				glm::vec3 clusterCentroid(0.0f);
+				glm::vec3 clusterNormal(0.0f);
+				float clusterArea = 0.0f;
+				for (uint32_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle)
+				{
+					glm::vec3 centroid;
+					const glm::vec3 normal = GetTriangleArea(triangle, centroid);
+					const float area = glm::length(normal);
+					clusterCentroid += centroid * area;
+					clusterNormal += normal;
+					clusterArea += area;
+				}
+				const float normalLength = glm::length(clusterNormal);
+				sortKeys[cluster] = clusterArea > 0.0f && normalLength > 0.0f ?
+					glm::dot(clusterCentroid / clusterArea - meshCentroid, clusterNormal / normalLength) : 0.0f;
+			}
+
+			std::vector<uint32_t> clusterOrder(clusterCount);
+			for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+			{
+				clusterOrder[cluster] = static_cast<uint32_t>(cluster);
+			}
+			std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+			std::vector<uint32_t> output;
+			output.reserve(indices.size());
+			for (const uint32_t cluster : clusterOrder)
+			{
+				output.insert(output.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+			}
+			indices.swap(output);
+		}
+
+		void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			std::vector<uint32_t> remap(vertices.size(), INVALID_VERTEX);
+			std::vector<Vertex> output;
+			output.reserve(vertices.size());
+			for (uint32_t& index : indices)
+			{
+				if (remap[index] == INVALID_VERTEX)
+				{
+					remap[index] = static_cast<uint32_t>(output.size());
+					output.push_back(vertices[index]);
+				}
+				index = remap[index];
+			}
+			vertices.swap(output);
+		}
+
+		void MeshOptimizer::Optimize(MeshData& mesh)
+		{
+			const Timer optimizeTimer;
+			const VertexCacheStatistics before = AnalyzeVertexCache(mesh.Indices, mesh.Vertices.size());
+			OptimizeVertexCache(mesh.Indices, mesh.Vertices.size());
+			OptimizeOverdraw(mesh.Indices, mesh.Vertices);
+			OptimizeVertexFetch(mesh.Vertices, mesh.Indices);
+			mesh.ComputeBounds(); // unreferenced vertices may have been dropped
+			const VertexCacheStatistics after = AnalyzeVertexCache(mesh.Indices, mesh.Vertices.size());
+			VK_CORE_INFO("[GraphicsSystem::MeshOptimizer]: ACMR {0:.3f} -> {1:.3f}, ATVR {2:.3f} -> {3:.3f} ({4} triangles) in {5:.3f}ms",
+				before.ACMR, after.ACMR, before.ATVR, after.ATVR, mesh.Indices.size() / 3, optimizeTimer.GetMilliseconds());
+		}
+	}
+}
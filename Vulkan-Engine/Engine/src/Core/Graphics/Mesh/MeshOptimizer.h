@@ -0,0 +1,57 @@
+/***************************************************************************
+ * Filename		: MeshOptimizer.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Offline index / vertex reordering for imported meshes,
+ *				  post-transform cache (Tipsify), overdraw and fetch order.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "MeshData.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		struct VertexCacheStatistics
+		{
+			uint32_t VerticesTransformed = 0; // cache misses
+			float ACMR = 0.0f; // average cache miss ratio, transformed vertices per triangle (0.5 - 3.0)
+			float ATVR = 0.0f; // average transform to vertex ratio, transformed vertices per unique vertex (1.0 is optimal)
+		};
+
+		// all passes keep the triangle set intact (same triangles, same winding), they only reorder
+		class MeshOptimizer
+		{
+		public:
+			MeshOptimizer() = delete;
+			~MeshOptimizer() = delete;
+		public:
+			// simulates a FIFO post-transform cache of cacheSize entries
+			_NODISCARD static VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = s_CacheSize);
+
+			// Tipsify (Sander, Nehab & Barczak 2007), linear time triangle reordering for the post-transform cache
+			static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = s_CacheSize);
+			// splits cache optimized indices into clusters that cost at most threshold x their ACMR to restart and sorts
+			// them outward facing first, so front geometry tends to be drawn before what it occludes. Run after OptimizeVertexCache.
+			static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float threshold = 1.05f, uint32_t cacheSize = s_CacheSize);
+			// renumbers vertices in order of first use so vertex fetches walk memory linearly, drops unreferenced vertices
+			static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+			// runs the three passes above and logs the cache statistics before and after
+			static void Optimize(MeshData& mesh);
+		public:
+			static constexpr uint32_t s_CacheSize = 16;
+		};
+	}
+}
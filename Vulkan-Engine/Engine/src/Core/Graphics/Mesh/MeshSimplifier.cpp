@@ -0,0 +1,409 @@
+/***************************************************************************
+ * Filename		: MeshSimplifier.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Quadric error metric edge collapse simplification and the
+ *				  level of detail chain built from it.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "MeshSimplifier.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint32_t INVALID_VERTEX = UINT32_MAX;
+		static constexpr double BORDER_WEIGHT = 10.0; // keeps open borders from shrinking inwards
+
+		enum class VertexKind : uint8_t
+		{
+			Manifold, // may collapse onto any neighbor
+			Border, // on exactly one open boundary loop, may only collapse along it
+			Locked // attribute seam, non-manifold edge or boundary junction
+		};
+
+		// sum of squared distances to a set of weighted planes, error(p) = p'Ap + 2b'p + c
+		struct Quadric
+		{
+			double A00 = 0.0, A01 = 0.0, A02 = 0.0, A11 = 0.0, A12 = 0.0, A22 = 0.0;
+			double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+			double C = 0.0;
+			double Weight = 0.0;
+
+			void AddPlane(const glm::vec3& normal, const glm::vec3& point, double weight)
+			{
+				const double a = normal.x, b = normal.y, c = normal.z;
+				const double d = -(a * point.x + b * point.y + c * point.z);
+				A00 += weight * a * a; A01 += weight * a * b; A02 += weight * a * c;
+				A11 += weight * b * b; A12 += weight * b * c; A22 += weight * c * c;
+				B0 += weight * a * d; B1 += weight * b * d; B2 += weight * c * d;
+				C += weight * d * d;
+				Weight += weight;
+			}
+			void Add(const Quadric& other)
+			{
+				A00 += other.A00; A01 += other.A01; A02 += other.A02; A11 += other.A11; A12 += other.A12; A22 += other.A22;
+				B0 += other.B0; B1 += other.B1; B2 += other.B2;
+				C += other.C;
+				Weight += other.Weight;
+			}
+			// weighted mean squared distance of point to the planes
+			_NODISCARD double GetError(const glm::vec3& point) const
+			{
+				const double x = point.x, y = point.y, z = point.z;
+				const double error = A00 * x * x + A11 * y * y + A22 * z * z + 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z) +
+					2.0 * (B0 * x + B1 * y + B2 * z) + C;
+				return Weight > 0.0 ? std::max(error, 0.0) / Weight : 0.0;
+			}
+		};
+
+		struct EdgeCollapse
+		{
+			double Cost;
+			uint32_t From;
+			uint32_t To;
+		};
+
+		// vertices with the same position (split by uv / color seams) map to their first occurrence
+		static std::vector<uint32_t> WeldPositions(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+		{
+			std::vector<uint32_t> canonical(vertices.size(), INVALID_VERTEX);
+			std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+			buckets.reserve(indices.size() / 3);
+			for (const uint32_t index : indices)
+			{
+				if (canonical[index] != INVALID_VERTEX)
+				{
+					continue;
+				}
+				const glm::vec3& position = vertices[index].Position;
+				uint32_t bits[3];
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					const float value = position[axis] == 0.0f ? 0.0f : position[axis]; // -0 == 0
+					std::memcpy(&bits[axis], &value, sizeof(float));
+				}
+				const uint64_t key = (static_cast<uint64_t>(bits[0]) * 73856093u) ^ (static_cast<uint64_t>(bits[1]) * 19349663u) ^ (static_cast<uint64_t>(bits[2]) * 83492791u);
+				std::vector<uint32_t>& bucket = buckets[key];
+				canonical[index] = index;
+				for (const uint32_t candidate : bucket)
+				{
+					if (vertices[candidate].Position == position)
+					{
+						canonical[index] = candidate;
+						break;
+					}
+				}
+				if (canonical[index] == index)
+				{
+					bucket.push_back(index);
+				}
+			}
+			return canonical;
+		}
+
+		std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, size_t targetIndexCount,
+			float& error, float maxError)
+		{
+			error = 0.0f;
+			std::vector<uint32_t> result(indices.begin(), indices.end() - indices.size() % 3);
+			if (result.size() <= targetIndexCount)
+			{
+				return result;
+			}
+			const size_t vertexCount = vertices.size();
+			const std::vector<uint32_t> canonical = WeldPositions(vertices, result);
+			std::vector<uint32_t> wedgeCounts(vertexCount, 0); // vertices sharing each position
+			for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+			{
+				if (canonical[vertex] != INVALID_VERTEX)
+				{
+					++wedgeCounts[canonical[vertex]];
+				}
+			}
+
+			// plane quadrics weighted by triangle area, collapses are evaluated on the welded positions
+			std::vector<Quadric> quadrics(vertexCount);
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				const glm::vec3& p0 = vertices[result[i]].Position;
+				const glm::vec3 normal = glm::cross(vertices[result[i + 1]].Position - p0, vertices[result[i + 2]].Position - p0);
+				const float doubleArea = glm::length(normal);
+				if (doubleArea > 0.0f)
+				{
+					for (uint32_t corner = 0; corner < 3; ++corner)
+					{
+						quadrics[canonical[result[i + corner]]].AddPlane(normal / doubleArea, p0, 0.5 * doubleArea);
+					}
+				}
+			}
+			// open edges also get a plane through the edge perpendicular to their triangle, so collapsing along the
+			// border is cheap while pulling it inwards is not
+			std::unordered_map<uint64_t, uint32_t> edgeUses;
+			edgeUses.reserve(result.size());
+			const auto edgeKey = [&](uint32_t a, uint32_t b)
+			{
+				const uint32_t weldedA = canonical[a];
+				const uint32_t weldedB = canonical[b];
+				return weldedA < weldedB ? (static_cast<uint64_t>(weldedA) << 32) | weldedB : (static_cast<uint64_t>(weldedB) << 32) | weldedA;
+			};
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				++edgeUses[edgeKey(result[i], result[i - i % 3 + (i + 1) % 3])];
+			}
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				const uint32_t a = result[i];
+				const uint32_t b = result[i - i % 3 + (i + 1) % 3];
+				if (edgeUses[edgeKey(a, b)] != 1)
+				{
+					continue;
+				}
+				const glm::vec3& p0 = vertices[result[i - i % 3]].Position;
+				const glm::vec3 normal = glm::cross(vertices[result[i - i % 3 + 1]].Position - p0, vertices[result[i - i % 3 + 2]].Position - p0);
+				const glm::vec3 edge = vertices[b].Position - vertices[a].Position;
+				const glm::vec3 borderNormal = glm::cross(edge, normal);
+				const float borderNormalLength = glm::length(borderNormal);
+				if (borderNormalLength > 0.0f)
+				{
+					const double weight = BORDER_WEIGHT * glm::dot(edge, edge);
+					quadrics[canonical[a]].AddPlane(borderNormal / borderNormalLength, vertices[a].Position, weight);
+					quadrics[canonical[b]].AddPlane(borderNormal / borderNormalLength, vertices[a].Position, weight);
+				}
+			}
+
+			std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+			std::vector<uint32_t> adjacency;
+			std::vector<VertexKind> kinds(vertexCount);
+			std::vector<bool> touched(vertexCount);
+			std::vector<uint32_t> remap(vertexCount);
+			std::vector<EdgeCollapse> collapses;
+
+			// triangles around the welded vertex a that also use the welded vertex b
+			const auto countSharedTriangles = [&](uint32_t a, uint32_t b)
+			{
+				uint32_t count = 0;
+				for (uint32_t i = adjacencyOffsets[a]; i < adjacencyOffsets[a + 1]; ++i)
+				{
+					const uint32_t* triangle = &result[adjacency[i] * 3];
+					count += canonical[triangle[0]] == b || canonical[triangle[1]] == b || canonical[triangle[2]] == b ? 1 : 0;
+				}
+				return count;
+			};
+
+			size_t triangleCount = result.size() / 3;
+			const size_t targetTriangleCount = targetIndexCount / 3;
+			const double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+			double largestCost = 0.0;
+			// every pass collapses the cheapest edges whose neighborhoods don't overlap, then rebuilds the topology
+			while (triangleCount > targetTriangleCount)
+			{
+				// welded vertex -> triangle adjacency (compressed rows)
+				std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+				for (const uint32_t index : result)
+				{
+					++adjacencyOffsets[canonical[index] + 1];
+				}
+				for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+				{
+					adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+				}
+				adjacency.resize(result.size());
+				{
+					std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+					for (size_t i = 0; i < result.size(); ++i)
+					{
+						adjacency[fillOffsets[canonical[result[i]]]++] = static_cast<uint32_t>(i / 3);
+					}
+				}
+
+				// classify by the edges around each welded vertex: open edges are used by one triangle, manifold ones by two
+				for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+				{
+					if (adjacencyOffsets[vertex] == adjacencyOffsets[vertex + 1])
+					{
+						continue;
+					}
+					uint32_t openEdges = 0;
+					bool manifold = wedgeCounts[vertex] == 1;
+					for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1] && manifold; ++i)
+					{
+						const uint32_t* triangle = &result[adjacency[i] * 3];
+						for (uint32_t corner = 0; corner < 3; ++corner)
+						{
+							const uint32_t neighbor = canonical[triangle[corner]];
+							if (neighbor != vertex)
+							{
+								const uint32_t shared = countSharedTriangles(static_cast<uint32_t>(vertex), neighbor);
+								openEdges += shared == 1 ? 1 : 0;
+								manifold = manifold && shared <= 2;
+							}
+						}
+					}
+					kinds[vertex] = !manifold ? VertexKind::Locked : openEdges == 0 ? VertexKind::Manifold : openEdges == 2 ? VertexKind::Border : VertexKind::Locked;
+				}
+
+				collapses.clear();
+				for (size_t i = 0; i < result.size(); i += 3)
+				{
+					for (uint32_t corner = 0; corner < 3; ++corner)
+					{
+						const uint32_t a = result[i + corner];
+						const uint32_t b = result[i + (corner + 1) % 3];
+						const uint32_t weldedA = canonical[a];
+						const uint32_t weldedB = canonical[b];
+						if (weldedA == weldedB)
+						{
+							continue;
+						}
+						const bool openEdge = (kinds[weldedA] == VertexKind::Border || kinds[weldedB] == VertexKind::Border) && countSharedTriangles(weldedA, weldedB) == 1;
+						if (kinds[weldedA] == VertexKind::Manifold || (kinds[weldedA] == VertexKind::Border && openEdge))
+						{
+							Quadric quadric = quadrics[weldedA];
+							quadric.Add(quadrics[weldedB]);
+							collapses.push_back({ quadric.GetError(vertices[b].Position), a, b });
+						}
+						if (kinds[weldedB] == VertexKind::Manifold || (kinds[weldedB] == VertexKind::Border && openEdge))
+						{
+							Quadric quadric = quadrics[weldedA];
+							quadric.Add(quadrics[weldedB]);
+							collapses.push_back({ quadric.GetError(vertices[a].Position), b, a });
+						}
+					}
+				}
+				std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& left, const EdgeCollapse& right)
+				{
+					return left.Cost != right.Cost ? left.Cost < right.Cost : left.From != right.From ? left.From < right.From : left.To < right.To;
+				});
+
+				std::fill(touched.begin(), touched.end(), false);
+				for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+				{
+					remap[vertex] = static_cast<uint32_t>(vertex);
+				}
+				size_t collapsed = 0;
+				for (const EdgeCollapse& collapse : collapses)
+				{
+					if (triangleCount <= targetTriangleCount || collapse.Cost > maxCost)
+					{
+						break;
+					}
+					const uint32_t from = canonical[collapse.From]; // manifold or border, so the only vertex at its position
+					const uint32_t to = canonical[collapse.To];
+					if (touched[from] || touched[to])
+					{
+						continue;
+					}
+					// reject collapses that flip a triangle, the ones using both vertices disappear
+					bool flips = false;
+					uint32_t removedTriangles = 0;
+					const glm::vec3& target = vertices[collapse.To].Position;
+					for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1] && !flips; ++i)
+					{
+						const uint32_t* triangle = &result[adjacency[i] * 3];
+						if (canonical[triangle[0]] == to || canonical[triangle[1]] == to || canonical[triangle[2]] == to)
+						{
+							++removedTriangles;
+							continue;
+						}
+						glm::vec3 corners[3] = { vertices[triangle[0]].Position, vertices[triangle[1]].Position, vertices[triangle[2]].Position };
+						const glm::vec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+						for (glm::vec3& corner : corners)
+						{
+							corner = corner == vertices[collapse.From].Position ? target : corner;
+						}
+						const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+						flips = glm::dot(before, after) <= 0.0f;
+					}
+					if (flips)
+					{
+						continue;
+					}
+
+					// the neighborhood is frozen for the rest of the pass so the flip test above stays valid
+					for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; ++i)
+					{
+						const uint32_t* triangle = &result[adjacency[i] * 3];
+						touched[canonical[triangle[0]]] = touched[canonical[triangle[1]]] = touched[canonical[triangle[2]]] = true;
+					}
+					remap[collapse.From] = collapse.To;
+					quadrics[to].Add(quadrics[from]);
+					largestCost = std::max(largestCost, collapse.Cost);
+					triangleCount -= removedTriangles;
+					++collapsed;
+				}
+				if (collapsed == 0)
+				{
+					break;
+				}
+
+				// drop the triangles that became degenerate, keeping the order of the rest
+				size_t write = 0;
+				for (size_t i = 0; i < result.size(); i += 3)
+				{
+					const uint32_t a = remap[result[i]];
+					const uint32_t b = remap[result[i + 1]];
+					const uint32_t c = remap[result[i + 2]];
+					if (canonical[a] != canonical[b] && canonical[b] != canonical[c] && canonical[a] != canonical[c])
+					{
+						result[write++] = a;
+						result[write++] = b;
+						result[write++] = c;
+					}
+				}
+				result.resize(write);
+				triangleCount = result.size() / 3;
+			}
+			error = static_cast<float>(std::sqrt(largestCost));
+			return result;
+		}
+
+		void MeshSimplifier::BuildLodChain(MeshData& mesh)
+		{
+			const Timer buildTimer;
+			mesh.Lods.clear();
+			mesh.Lods.push_back({ 0, static_cast<uint32_t>(mesh.Indices.size()), 0.0f });
+			std::vector<uint32_t> previous = mesh.Indices;
+			float accumulatedError = 0.0f;
+			while (mesh.Lods.size() < s_MaxLods)
+			{
+				const size_t targetTriangleCount = static_cast<size_t>(static_cast<float>(previous.size() / 3) * s_LodReduction);
+				if (targetTriangleCount < s_MinLodTriangles)
+				{
+					break;
+				}
+				float error = 0.0f;
+				std::vector<uint32_t> lod = Simplify(mesh.Vertices, previous, targetTriangleCount * 3, error);
+				if (static_cast<float>(lod.size()) > static_cast<float>(previous.size()) * s_MinLodReduction)
+				{
+					break; // mostly locked (seams / borders), further levels would cost memory without saving much
+				}
+				// every level is simplified from the previous one, so the error bound accumulates
+				accumulatedError += error;
+				MeshOptimizer::OptimizeVertexCache(lod, mesh.Vertices.size());
+				mesh.Lods.push_back({ static_cast<uint32_t>(mesh.Indices.size()), static_cast<uint32_t>(lod.size()), accumulatedError });
+				mesh.Indices.insert(mesh.Indices.end(), lod.begin(), lod.end());
+				previous.swap(lod);
+			}
+			VK_CORE_INFO("[GraphicsSystem::MeshSimplifier]: {0} levels of detail, {1} -> {2} triangles (error {3:.5f}) in {4:.3f}ms",
+				mesh.Lods.size(), mesh.Lods.front().IndexCount / 3, mesh.Lods.back().IndexCount / 3, mesh.Lods.back().Error, buildTimer.GetMilliseconds());
+		}
+	}
+}
@@ -0,0 +1,52 @@
+/***************************************************************************
+ * Filename		: MeshSimplifier.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Quadric error metric edge collapse simplification and the
+ *				  level of detail chain built from it.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "MeshData.h"
+
+#include <limits>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// collapses edges onto one of their existing vertices (Garland & Heckbert 1997), so every level of detail indexes
+		// the same vertex buffer. Vertices on attribute seams or non-manifold edges are locked, border vertices only
+		// move along the border. The output is deterministic for a given input.
+		class MeshSimplifier
+		{
+		public:
+			MeshSimplifier() = delete;
+			~MeshSimplifier() = delete;
+		public:
+			// simplifies the triangle list until at most targetIndexCount indices are left or the next collapse would exceed
+			// maxError. error receives the largest collapse error, an estimate of the distance (in model units) the
+			// simplified surface deviates from the input.
+			_NODISCARD static std::vector<uint32_t> Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, size_t targetIndexCount,
+				float& error, float maxError = std::numeric_limits<float>::max());
+
+			// appends the levels of detail after mesh.Indices (level 0) and fills mesh.Lods, every level halves the
+			// triangles of the previous one. Run after MeshletBuilder::Build, the meshlets only cover level 0.
+			static void BuildLodChain(MeshData& mesh);
+		public:
+			static constexpr uint32_t s_MaxLods = 8; // including level 0
+			static constexpr uint32_t s_MinLodTriangles = 64; // levels below this aren't worth a separate draw
+			static constexpr float s_LodReduction = 0.5f; // target triangle count relative to the previous level
+			static constexpr float s_MinLodReduction = 0.85f; // the chain ends once a level keeps more than this of the previous one
+		};
+	}
+}
@@ -0,0 +1,310 @@
+/***************************************************************************
+ * Filename		: MeshletBuilder.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Splits meshes into small clusters (meshlets) with bounding
+ *				  spheres and normal cones for cluster level culling.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "MeshletBuilder.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint32_t INVALID_TRIANGLE = UINT32_MAX;
+		static constexpr uint8_t INVALID_LOCAL_VERTEX = 0xff;
+		static constexpr float MIN_CONE_DOT = 0.1f; // wider cones (half angle > ~84 degrees) almost never cull
+
+		// Ritter's bounding sphere, then the radius is refit so float rounding can't leave a vertex outside
+		static void ComputeBoundingSphere(const std::vector<Vertex>& vertices, const uint32_t* meshletVertices, uint32_t count, Meshlet& meshlet)
+		{
+			uint32_t extremes[6] = {}; // min x, y, z, max x, y, z
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const glm::vec3& position = vertices[meshletVertices[i]].Position;
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (position[axis] < vertices[meshletVertices[extremes[axis]]].Position[axis])
+					{
+						extremes[axis] = i;
+					}
+					if (position[axis] > vertices[meshletVertices[extremes[axis + 3]]].Position[axis])
+					{
+						extremes[axis + 3] = i;
+					}
+				}
+			}
+			int widestAxis = 0;
+			float widestSpan = -1.0f;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float span = glm::distance(vertices[meshletVertices[extremes[axis]]].Position, vertices[meshletVertices[extremes[axis + 3]]].Position);
+				if (span > widestSpan)
+				{
+					widestAxis = axis;
+					widestSpan = span;
+				}
+			}
+			glm::vec3 center = (vertices[meshletVertices[extremes[widestAxis]]].Position + vertices[meshletVertices[extremes[widestAxis + 3]]].Position) * 0.5f;
+			float radius = widestSpan * 0.5f;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const glm::vec3& position = vertices[meshletVertices[i]].Position;
+				const float distance = glm::distance(position, center);
+				if (distance > radius)
+				{
+					const float grownRadius = (radius + distance) * 0.5f;
+					center += (position - center) * ((grownRadius - radius) / distance);
+					radius = grownRadius;
+				}
+			}
+			radius = 0.0f;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				radius = std::max(radius, glm::distance(vertices[meshletVertices[i]].Position, center));
+			}
+			meshlet.Center = center;
+			meshlet.Radius = radius;
+		}
+
+		// axis = average triangle normal, the apex is moved back along it until it lies behind every triangle plane so
+		// a camera seeing the apex within (90 degrees - half angle) of the axis sees all triangles from behind
+		static void ComputeNormalCone(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t triangleCount, Meshlet& meshlet)
+		{
+			meshlet.ConeAxis = glm::vec3(0.0f);
+			meshlet.ConeCutoff = 1.0f;
+			meshlet.ConeApex = meshlet.Center;
+
+			glm::vec3 normals[MeshletBuilder::s_MaxTriangles];
+			glm::vec3 normalSum(0.0f);
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				const glm::vec3& p0 = vertices[indices[triangle * 3 + 0]].Position;
+				const glm::vec3 normal = glm::cross(vertices[indices[triangle * 3 + 1]].Position - p0, vertices[indices[triangle * 3 + 2]].Position - p0);
+				const float area = glm::length(normal);
+				normals[triangle] = area > 0.0f ? normal / area : glm::vec3(0.0f); // degenerate triangles can't be seen and don't widen the cone
+				normalSum += normals[triangle];
+			}
+			const float normalSumLength = glm::length(normalSum);
+			if (!(normalSumLength > 0.0f))
+			{
+				return;
+			}
+			const glm::vec3 axis = normalSum / normalSumLength;
+			float minDot = 1.0f;
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				if (normals[triangle] != glm::vec3(0.0f))
+				{
+					minDot = std::min(minDot, glm::dot(axis, normals[triangle]));
+				}
+			}
+			if (minDot <= MIN_CONE_DOT)
+			{
+				return;
+			}
+			float apexDistance = 0.0f;
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				if (normals[triangle] != glm::vec3(0.0f))
+				{
+					const glm::vec3& p0 = vertices[indices[triangle * 3]].Position;
+					apexDistance = std::max(apexDistance, glm::dot(meshlet.Center - p0, normals[triangle]) / glm::dot(axis, normals[triangle]));
+				}
+			}
+			meshlet.ConeAxis = axis;
+			meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+			meshlet.ConeApex = meshlet.Center - axis * apexDistance;
+		}
+
+		void MeshletBuilder::Build(MeshData& mesh)
+		{
+			const Timer buildTimer;
+			mesh.Meshlets.clear();
+			mesh.MeshletVertices.clear();
+			mesh.MeshletTriangles.clear();
+			const size_t triangleCount = mesh.Indices.size() / 3;
+			const size_t vertexCount = mesh.Vertices.size();
+			if (triangleCount == 0)
+			{
+				return;
+			}
+			const std::vector<uint32_t>& indices = mesh.Indices;
+
+			// vertex -> triangle adjacency (compressed rows), emitted triangles are swapped out of the rows so the first
+			// liveTriangles[vertex] entries are the triangles left to emit around the vertex
+			std::vector<uint32_t> liveTriangles(vertexCount, 0);
+			for (const uint32_t index : indices)
+			{
+				++liveTriangles[index];
+			}
+			std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+			for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+			{
+				adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+			}
+			std::vector<uint32_t> adjacency(indices.size());
+			{
+				std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					adjacency[fillOffsets[indices[i]]++] = static_cast<uint32_t>(i / 3);
+				}
+			}
+			std::vector<glm::vec3> centroids(triangleCount);
+			for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				centroids[triangle] = (mesh.Vertices[indices[triangle * 3]].Position + mesh.Vertices[indices[triangle * 3 + 1]].Position +
+					mesh.Vertices[indices[triangle * 3 + 2]].Position) * (1.0f / 3.0f);
+			}
+
+			std::vector<uint8_t> localVertices(vertexCount, INVALID_LOCAL_VERTEX); // vertex -> index in the open meshlet
+			std::vector<bool> emitted(triangleCount, false);
+			std::vector<uint32_t> meshletVertices; // the open meshlet
+			std::vector<uint32_t> meshletTriangles;
+			std::vector<uint32_t> output;
+			meshletVertices.reserve(s_MaxVertices);
+			meshletTriangles.reserve(s_MaxTriangles);
+			output.reserve(indices.size());
+			glm::vec3 centroidSum(0.0f);
+			size_t scanCursor = 0;
+			uint32_t conesBuilt = 0;
+
+			const auto countNewVertices = [&](uint32_t triangle)
+			{
+				const uint32_t a = indices[triangle * 3];
+				const uint32_t b = indices[triangle * 3 + 1];
+				const uint32_t c = indices[triangle * 3 + 2];
+				return (localVertices[a] == INVALID_LOCAL_VERTEX ? 1u : 0u) +
+					(localVertices[b] == INVALID_LOCAL_VERTEX && b != a ? 1u : 0u) +
+					(localVertices[c] == INVALID_LOCAL_VERTEX && c != a && c != b ? 1u : 0u);
+			};
+			const auto addTriangle = [&](uint32_t triangle)
+			{
+				for (uint32_t corner = 0; corner < 3; ++corner)
+				{
+					const uint32_t vertex = indices[triangle * 3 + corner];
+					uint32_t* live = &adjacency[adjacencyOffsets[vertex]];
+					// a degenerate triangle is listed once per corner, so every corner removes one entry
+					std::swap(*std::find(live, live + liveTriangles[vertex], triangle), live[--liveTriangles[vertex]]);
+					if (localVertices[vertex] == INVALID_LOCAL_VERTEX)
+					{
+						localVertices[vertex] = static_cast<uint8_t>(meshletVertices.size());
+						meshletVertices.push_back(vertex);
+					}
+				}
+				emitted[triangle] = true;
+				meshletTriangles.push_back(triangle);
+				centroidSum += centroids[triangle];
+			};
+			const auto flushMeshlet = [&]()
+			{
+				Meshlet meshlet;
+				meshlet.FirstIndex = static_cast<uint32_t>(output.size());
+				meshlet.VertexOffset = static_cast<uint32_t>(mesh.MeshletVertices.size());
+				meshlet.VertexCount = static_cast<uint32_t>(meshletVertices.size());
+				meshlet.TriangleOffset = static_cast<uint32_t>(mesh.MeshletTriangles.size());
+				meshlet.TriangleCount = static_cast<uint32_t>(meshletTriangles.size());
+				for (const uint32_t triangle : meshletTriangles)
+				{
+					for (uint32_t corner = 0; corner < 3; ++corner)
+					{
+						output.push_back(indices[triangle * 3 + corner]);
+						mesh.MeshletTriangles.push_back(localVertices[indices[triangle * 3 + corner]]);
+					}
+				}
+				mesh.MeshletTriangles.resize((mesh.MeshletTriangles.size() + 3) & ~size_t(3), 0); // keeps the next meshlet readable as uint32
+				mesh.MeshletVertices.insert(mesh.MeshletVertices.end(), meshletVertices.begin(), meshletVertices.end());
+				ComputeBoundingSphere(mesh.Vertices, meshletVertices.data(), meshlet.VertexCount, meshlet);
+				ComputeNormalCone(mesh.Vertices, output.data() + meshlet.FirstIndex, meshlet.TriangleCount, meshlet);
+				conesBuilt += meshlet.ConeCutoff < 1.0f ? 1 : 0;
+				mesh.Meshlets.push_back(meshlet);
+
+				for (const uint32_t vertex : meshletVertices)
+				{
+					localVertices[vertex] = INVALID_LOCAL_VERTEX;
+				}
+				meshletVertices.clear();
+				meshletTriangles.clear();
+				centroidSum = glm::vec3(0.0f);
+			};
+
+			for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+			{
+				// best unemitted triangle sharing a vertex with the open meshlet: fewest new vertices, then closest. Triangles that
+				// are the last one around one of their vertices count as adding none, finishing vertices avoids leaving holes behind
+				uint32_t best = INVALID_TRIANGLE;
+				uint32_t bestCost = 4;
+				float bestDistance = std::numeric_limits<float>::max();
+				const glm::vec3 centroid = meshletTriangles.empty() ? glm::vec3(0.0f) : centroidSum / static_cast<float>(meshletTriangles.size());
+				for (const uint32_t vertex : meshletVertices)
+				{
+					for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex] + liveTriangles[vertex]; ++a)
+					{
+						const uint32_t triangle = adjacency[a];
+						const uint32_t* corners = &indices[triangle * 3];
+						const uint32_t cost = liveTriangles[corners[0]] == 1 || liveTriangles[corners[1]] == 1 || liveTriangles[corners[2]] == 1 ?
+							0 : countNewVertices(triangle);
+						const glm::vec3 offset = centroids[triangle] - centroid;
+						const float distance = glm::dot(offset, offset);
+						if (cost < bestCost || (cost == bestCost && distance < bestDistance))
+						{
+							best = triangle;
+							bestCost = cost;
+							bestDistance = distance;
+						}
+					}
+				}
+
+				// nothing connected is left: continue in the optimized order, nearby pieces (within twice the
+				// meshlet's extent) share the meshlet so meshes made of many small parts don't end up with tiny meshlets
+				bool startMeshlet = false;
+				if (best == INVALID_TRIANGLE)
+				{
+					while (emitted[scanCursor])
+					{
+						++scanCursor;
+					}
+					best = static_cast<uint32_t>(scanCursor);
+					if (!meshletTriangles.empty())
+					{
+						float extent = 0.0f;
+						for (const uint32_t vertex : meshletVertices)
+						{
+							extent = std::max(extent, glm::distance(mesh.Vertices[vertex].Position, centroid));
+						}
+						startMeshlet = glm::distance(centroids[best], centroid) > 2.0f * extent;
+					}
+				}
+				const uint32_t newVertices = countNewVertices(best);
+				if (startMeshlet || meshletVertices.size() + newVertices > s_MaxVertices || meshletTriangles.size() == s_MaxTriangles)
+				{
+					flushMeshlet(); // the triangle that didn't fit seeds the next meshlet
+				}
+				addTriangle(best);
+			}
+			flushMeshlet();
+			mesh.Indices.swap(output);
+
+			VK_CORE_INFO("[GraphicsSystem::MeshletBuilder]: {0} meshlets, {1:.1f} vertices / {2:.1f} triangles on average, {3} with a normal cone, in {4:.3f}ms",
+				mesh.Meshlets.size(), static_cast<float>(mesh.MeshletVertices.size()) / static_cast<float>(mesh.Meshlets.size()),
+				static_cast<float>(triangleCount) / static_cast<float>(mesh.Meshlets.size()), conesBuilt, buildTimer.GetMilliseconds());
+		}
+	}
+}
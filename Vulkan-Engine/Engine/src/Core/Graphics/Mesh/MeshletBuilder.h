@@ -0,0 +1,38 @@
+/***************************************************************************
+ * Filename		: MeshletBuilder.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Splits meshes into small clusters (meshlets) with bounding
+ *				  spheres and normal cones for cluster level culling.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "MeshData.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		class MeshletBuilder
+		{
+		public:
+			MeshletBuilder() = delete;
+			~MeshletBuilder() = delete;
+		public:
+			// grows each meshlet over shared edges from the (cache optimized) index order, preferring triangles that add the
+			// fewest vertices and lie closest to it. Rewrites mesh.Indices in meshlet order, run after MeshOptimizer::Optimize.
+			static void Build(MeshData& mesh);
+		public:
+			static constexpr uint32_t s_MaxVertices = 64;
+			static constexpr uint32_t s_MaxTriangles = 124; // the usual mesh shader limit (126) rounded down to a multiple of 4
+		};
+	}
+}
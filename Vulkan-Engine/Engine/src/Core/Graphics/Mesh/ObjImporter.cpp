@@ -0,0 +1,318 @@
+/***************************************************************************
+ * Filename		: ObjImporter.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Wavefront OBJ import through tinyobjloader, vertices are
+ *				  deduplicated into an indexed mesh.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "ObjImporter.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+#include "Core/Utility/Hash.h"
+#include "VertexKernels.h"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static_assert(sizeof(Vertex) == 8 * sizeof(float), "vertex hashing assumes Vertex has no padding");
+		static_assert(sizeof(tinyobj::index_t) == 3 * sizeof(int32_t), "VertexKernels::BuildObjVertices reads tinyobj::index_t as int triples");
+
+		static constexpr uint32_t DEDUPLICATE_CHUNK_SIZE = 1 << 16; // indices per job in the per index passes
+		static constexpr uint32_t BUILD_BLOCK_SIZE = 1 << 12; // vertices built in bulk at a time, small enough to stay in cache
+		static constexpr uint32_t EMPTY_SLOT = 0;
+
+		// single vertex for random access, bit identical to what VertexKernels::BuildObjVertices produces in bulk
+		static Vertex MakeVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& index)
+		{
+			Vertex vertex = {};
+			vertex.Position =
+			{
+				attrib.vertices[3 * index.vertex_index + 0],
+				attrib.vertices[3 * index.vertex_index + 1],
+				attrib.vertices[3 * index.vertex_index + 2]
+			};
+			if (index.texcoord_index >= 0)
+			{
+				vertex.TexCoord =
+				{
+					attrib.texcoords[2 * index.texcoord_index + 0],
+					1.0f - attrib.texcoords[2 * index.texcoord_index + 1] // flipping this as vulkan expects orientation where 0 means top of image
+				};
+			}
+			vertex.Color = { 1.0f, 1.0f, 1.0f };
+			return vertex;
+		}
+
+		// vertices that compare equal must hash equal, so -0.0 is hashed as 0.0
+		static uint64_t HashVertex(const Vertex& vertex)
+		{
+			float components[8];
+			std::memcpy(components, &vertex, sizeof(components));
+			for (float& component : components)
+			{
+				if (component == 0.0f)
+				{
+					component = 0.0f;
+				}
+			}
+			return HashBytes(components, sizeof(components));
+		}
+
+		static uint32_t NextPowerOfTwo(uint32_t value)
+		{
+			uint32_t result = 1;
+			while (result < value)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		static void BuildVertices(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::index_t>& indices, size_t first, size_t count, Vertex* output)
+		{
+			VertexKernels::BuildObjVertices(attrib.vertices.data(), attrib.texcoords.data(), reinterpret_cast<const int32_t*>(indices.data() + first), count, output);
+		}
+
+		static void DeduplicateSerial(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::index_t>& indices, MeshData& mesh)
+		{
+			std::unordered_map<Vertex, uint32_t> uniqueVertices = {};
+			std::vector<Vertex> block(BUILD_BLOCK_SIZE);
+			mesh.Indices.reserve(indices.size());
+			for (size_t first = 0; first < indices.size(); first += BUILD_BLOCK_SIZE)
+			{
+				const size_t count = std::min<size_t>(BUILD_BLOCK_SIZE, indices.size() - first);
+				BuildVertices(attrib, indices, first, count, block.data());
+				for (size_t i = 0; i < count; ++i)
+				{
+					// a single lookup, inserts the new index if the vertex hasn't been seen yet
+					const auto inserted = uniqueVertices.emplace(block[i], static_cast<uint32_t>(mesh.Vertices.size()));
+					if (inserted.second)
+					{
+						mesh.Vertices.push_back(block[i]); // only add the vertex if its unique
+					}
+					mesh.Indices.push_back(inserted.first->second);
+				}
+			}
+		}
+
+		// 1. hash every index's vertex and bucket the index positions into shards by the top hash bits (order preserving)
+		// 2. dedup every shard on its own in an open addressing table -> position of the first equal vertex for every index
+		// 3. number the first occurrences in index order (prefix sum) and remap every index to its first occurrence's number
+		// Numbering first occurrences in index order is exactly what the serial path does, so the output is identical.
+		static void DeduplicateParallel(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::index_t>& indices, MeshData& mesh)
+		{
+			const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+			const uint32_t chunkCount = (indexCount + DEDUPLICATE_CHUNK_SIZE - 1) / DEDUPLICATE_CHUNK_SIZE;
+			const uint32_t shardCount = std::min(256u, NextPowerOfTwo(JobSystem::GetThreadCount() * 4));
+			uint32_t shardBits = 0;
+			while ((1u << shardBits) < shardCount)
+			{
+				++shardBits;
+			}
+			const auto GetShard = [shardBits](uint64_t hash) { return shardBits == 0 ? 0u : static_cast<uint32_t>(hash >> (64 - shardBits)); };
+
+			// 1. hashes and per chunk shard histograms
+			std::vector<uint64_t> hashes(indexCount);
+			std::vector<uint32_t> shardOffsets(static_cast<size_t>(chunkCount) * shardCount, 0); // [chunk * shardCount + shard]
+			JobSystem::ParallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk)
+			{
+				std::vector<Vertex> block(BUILD_BLOCK_SIZE);
+				for (uint32_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+				{
+					uint32_t* histogram = &shardOffsets[static_cast<size_t>(chunk) * shardCount];
+					const uint32_t end = std::min(indexCount, (chunk + 1) * DEDUPLICATE_CHUNK_SIZE);
+					for (uint32_t first = chunk * DEDUPLICATE_CHUNK_SIZE; first < end; first += BUILD_BLOCK_SIZE)
+					{
+						const uint32_t count = std::min(BUILD_BLOCK_SIZE, end - first);
+						BuildVertices(attrib, indices, first, count, block.data());
+						for (uint32_t i = 0; i < count; ++i)
+						{
+							hashes[first + i] = HashVertex(block[i]);
+							++histogram[GetShard(hashes[first + i])];
+						}
+					}
+				}
+			});
+			// exclusive prefix sum, shard major so every shard's positions end up contiguous and in index order
+			std::vector<uint32_t> shardStarts(shardCount + 1, 0);
+			uint32_t runningOffset = 0;
+			for (uint32_t shard = 0; shard < shardCount; ++shard)
+			{
+				shardStarts[shard] = runningOffset;
+				for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+				{
+					uint32_t& offset = shardOffsets[static_cast<size_t>(chunk) * shardCount + shard];
+					const uint32_t count = offset;
+					offset = runningOffset;
+					runningOffset += count;
+				}
+			}
+			shardStarts[shardCount] = runningOffset;
+			std::vector<uint32_t> shardPositions(indexCount);
+			JobSystem::ParallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk)
+			{
+				for (uint32_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+				{
+					uint32_t* offsets = &shardOffsets[static_cast<size_t>(chunk) * shardCount];
+					const uint32_t end = std::min(indexCount, (chunk + 1) * DEDUPLICATE_CHUNK_SIZE);
+					for (uint32_t i = chunk * DEDUPLICATE_CHUNK_SIZE; i < end; ++i)
+					{
+						shardPositions[offsets[GetShard(hashes[i])]++] = i;
+					}
+				}
+			});
+
+			// 2. per shard dedup, the table stores position + 1 (0 = empty slot) and probes linearly
+			std::vector<uint32_t> firstOccurrences(indexCount);
+			JobSystem::ParallelFor(shardCount, 1, [&](uint32_t firstShard, uint32_t lastShard)
+			{
+				std::vector<uint32_t> table;
+				for (uint32_t shard = firstShard; shard < lastShard; ++shard)
+				{
+					const uint32_t begin = shardStarts[shard];
+					const uint32_t end = shardStarts[shard + 1];
+					const uint32_t mask = NextPowerOfTwo(std::max(16u, (end - begin) * 2)) - 1;
+					table.assign(static_cast<size_t>(mask) + 1, EMPTY_SLOT);
+					for (uint32_t p = begin; p < end; ++p)
+					{
+						const uint32_t position = shardPositions[p];
+						const uint64_t hash = hashes[position];
+						uint32_t slot = static_cast<uint32_t>(hash) & mask;
+						while (true)
+						{
+							const uint32_t entry = table[slot];
+							if (entry == EMPTY_SLOT)
+							{
+								table[slot] = position + 1;
+								firstOccurrences[position] = position; // positions arrive in index order, so this is the first use
+								break;
+							}
+							const uint32_t candidate = entry - 1;
+							if (hashes[candidate] == hash && MakeVertex(attrib, indices[candidate]) == MakeVertex(attrib, indices[position]))
+							{
+								firstOccurrences[position] = candidate;
+								break;
+							}
+							slot = (slot + 1) & mask;
+						}
+					}
+				}
+			});
+
+			// 3. number the first occurrences in index order, then remap
+			std::vector<uint32_t> chunkVertexStarts(chunkCount + 1, 0);
+			JobSystem::ParallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk)
+			{
+				for (uint32_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+				{
+					uint32_t uniqueCount = 0;
+					const uint32_t end = std::min(indexCount, (chunk + 1) * DEDUPLICATE_CHUNK_SIZE);
+					for (uint32_t i = chunk * DEDUPLICATE_CHUNK_SIZE; i < end; ++i)
+					{
+						uniqueCount += firstOccurrences[i] == i ? 1 : 0;
+					}
+					chunkVertexStarts[chunk + 1] = uniqueCount;
+				}
+			});
+			for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				chunkVertexStarts[chunk + 1] += chunkVertexStarts[chunk];
+			}
+			mesh.Vertices.resize(chunkVertexStarts[chunkCount]);
+			mesh.Indices.resize(indexCount);
+			std::vector<uint32_t>& vertexIds = shardPositions; // no longer needed, only written / read at first occurrences
+			JobSystem::ParallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk)
+			{
+				for (uint32_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+				{
+					uint32_t vertexId = chunkVertexStarts[chunk];
+					const uint32_t end = std::min(indexCount, (chunk + 1) * DEDUPLICATE_CHUNK_SIZE);
+					for (uint32_t i = chunk * DEDUPLICATE_CHUNK_SIZE; i < end; ++i)
+					{
+						if (firstOccurrences[i] == i)
+						{
+							mesh.Vertices[vertexId] = MakeVertex(attrib, indices[i]);
+							vertexIds[i] = vertexId++;
+						}
+					}
+				}
+			});
+			JobSystem::ParallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk)
+			{
+				const uint32_t begin = firstChunk * DEDUPLICATE_CHUNK_SIZE;
+				const uint32_t end = std::min(indexCount, lastChunk * DEDUPLICATE_CHUNK_SIZE);
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					mesh.Indices[i] = vertexIds[firstOccurrences[i]];
+				}
+			});
+		}
+
+		MeshData ObjImporter::Import(const std::string& filepath, ObjDeduplication deduplication, ObjImportStatistics* statistics)
+		{
+			const Timer parseTimer;
+			tinyobj::attrib_t attrib;
+			std::vector<tinyobj::shape_t> shapes;
+			std::vector<tinyobj::material_t> materials;
+			std::string warn, err;
+
+			if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str()))
+			{
+				VK_CORE_CRITICAL("{0}, {1}", warn.c_str(), err.c_str());
+				throw std::runtime_error(warn + err);
+			}
+			// every shape goes into the same mesh, so their indices are processed as one stream
+			std::vector<tinyobj::index_t> indices;
+			if (shapes.size() == 1)
+			{
+				indices.swap(shapes[0].mesh.indices);
+			}
+			else
+			{
+				for (const auto& shape : shapes)
+				{
+					indices.insert(indices.end(), shape.mesh.indices.begin(), shape.mesh.indices.end());
+				}
+			}
+			const float parseMilliseconds = parseTimer.GetMilliseconds();
+
+			const Timer deduplicateTimer;
+			if (deduplication == ObjDeduplication::Auto)
+			{
+				deduplication = indices.size() >= s_ParallelIndexThreshold && JobSystem::GetThreadCount() > 1 ? ObjDeduplication::Parallel : ObjDeduplication::Serial;
+			}
+			MeshData mesh;
+			if (deduplication == ObjDeduplication::Parallel)
+			{
+				DeduplicateParallel(attrib, indices, mesh);
+			}
+			else
+			{
+				DeduplicateSerial(attrib, indices, mesh);
+			}
+			mesh.ComputeBounds();
+
+			if (statistics)
+			{
+				statistics->ParseMilliseconds = parseMilliseconds;
+				statistics->DeduplicateMilliseconds = deduplicateTimer.GetMilliseconds();
+			}
+			return mesh;
+		}
+	}
+}
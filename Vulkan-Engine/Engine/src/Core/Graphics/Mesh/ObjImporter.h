@@ -0,0 +1,52 @@
+/***************************************************************************
+ * Filename		: ObjImporter.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Wavefront OBJ import through tinyobjloader, vertices are
+ *				  deduplicated into an indexed mesh.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "MeshData.h"
+
+#include <string>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		enum class ObjDeduplication
+		{
+			Auto = 0, // parallel for large meshes when the job system has workers
+			Serial,
+			Parallel
+		};
+
+		struct ObjImportStatistics
+		{
+			float ParseMilliseconds = 0.0f; // tinyobjloader
+			float DeduplicateMilliseconds = 0.0f;
+		};
+
+		class ObjImporter
+		{
+		public:
+			ObjImporter() = delete;
+			~ObjImporter() = delete;
+		public:
+			// throws if the file can't be parsed. Both deduplication paths produce identical vertices and indices
+			// (vertices in order of first use, as the serial path does).
+			static MeshData Import(const std::string& filepath, ObjDeduplication deduplication = ObjDeduplication::Auto, ObjImportStatistics* statistics = nullptr);
+		public:
+			static constexpr uint32_t s_ParallelIndexThreshold = 1 << 16; // Auto: below this the serial path is faster
+		};
+	}
+}
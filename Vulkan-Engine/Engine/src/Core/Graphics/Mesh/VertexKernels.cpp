@@ -0,0 +1,448 @@
+/***************************************************************************
+ * Filename		: VertexKernels.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Bulk vertex processing kernels for import / upload time
+ *				  transforms, AVX2 and SSE4.1 paths with a scalar fallback.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "VertexKernels.h"
+
+#if VKE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static_assert(sizeof(Vertex) == 8 * sizeof(float) && offsetof(Vertex, Color) == 12 && offsetof(Vertex, TexCoord) == 24,
+			"the simd kernels treat a Vertex as 8 floats: position, color, texcoord");
+		static_assert(sizeof(QuantizedVertex) == 4 * sizeof(uint32_t), "the simd kernels write a QuantizedVertex as 4 dwords");
+
+		static inline Vertex BuildObjVertex(const float* positions, const float* texcoords, const int32_t* indexTriple)
+		{
+			Vertex vertex = {};
+			const float* position = positions + 3 * static_cast<size_t>(indexTriple[0]);
+			vertex.Position = { position[0], position[1], position[2] };
+			if (indexTriple[2] >= 0)
+			{
+				const float* texcoord = texcoords + 2 * static_cast<size_t>(indexTriple[2]);
+				vertex.TexCoord = { texcoord[0], 1.0f - texcoord[1] }; // flipping this as vulkan expects orientation where 0 means top of image
+			}
+			vertex.Color = { 1.0f, 1.0f, 1.0f };
+			return vertex;
+		}
+
+		static inline uint32_t PackHalves(float low, float high)
+		{
+			return static_cast<uint32_t>(VertexQuantization::FloatToHalf(low)) | (static_cast<uint32_t>(VertexQuantization::FloatToHalf(high)) << 16);
+		}
+
+#if VKE_SIMD_X86
+		////////////////////////////////////////////
+		// SSE4.1, 4 vertices per iteration
+		////////////////////////////////////////////
+		// treats 4 vertices as two 4x4 float blocks (position + r, g + b + texcoord)
+		VKE_TARGET_SSE41 static inline void Transpose4x4(__m128& r0, __m128& r1, __m128& r2, __m128& r3)
+		{
+			const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+			const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+			const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+			const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+			r0 = _mm_movelh_ps(t0, t1);
+			r1 = _mm_movehl_ps(t1, t0);
+			r2 = _mm_movelh_ps(t2, t3);
+			r3 = _mm_movehl_ps(t3, t2);
+		}
+
+		VKE_TARGET_SSE41 static void BuildObjVerticesSSE41(const float* positions, const float* texcoords, const int32_t* indexTriples, size_t count, Vertex* output)
+		{
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 zero = _mm_setzero_ps();
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const int32_t* triple = indexTriples + 3 * i;
+				const float* p0 = positions + 3 * static_cast<size_t>(triple[0]);
+				const float* p1 = positions + 3 * static_cast<size_t>(triple[3]);
+				const float* p2 = positions + 3 * static_cast<size_t>(triple[6]);
+				const float* p3 = positions + 3 * static_cast<size_t>(triple[9]);
+				const int32_t t[4] = { triple[2], triple[5], triple[8], triple[11] };
+				const float u[4] = { t[0] >= 0 ? texcoords[2 * static_cast<size_t>(t[0])] : 0.0f, t[1] >= 0 ? texcoords[2 * static_cast<size_t>(t[1])] : 0.0f,
+					t[2] >= 0 ? texcoords[2 * static_cast<size_t>(t[2])] : 0.0f, t[3] >= 0 ? texcoords[2 * static_cast<size_t>(t[3])] : 0.0f };
+				const float v[4] = { t[0] >= 0 ? texcoords[2 * static_cast<size_t>(t[0]) + 1] : 0.0f, t[1] >= 0 ? texcoords[2 * static_cast<size_t>(t[1]) + 1] : 0.0f,
+					t[2] >= 0 ? texcoords[2 * static_cast<size_t>(t[2]) + 1] : 0.0f, t[3] >= 0 ? texcoords[2 * static_cast<size_t>(t[3]) + 1] : 0.0f };
+				const __m128 hasTexcoord = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t)), _mm_set1_epi32(-1)));
+
+				// low halves: position + r (3 float loads each, a 4 wide load could read past the end of the attribute array)
+				__m128 low0 = _mm_setr_ps(p0[0], p0[1], p0[2], 1.0f);
+				__m128 low1 = _mm_setr_ps(p1[0], p1[1], p1[2], 1.0f);
+				__m128 low2 = _mm_setr_ps(p2[0], p2[1], p2[2], 1.0f);
+				__m128 low3 = _mm_setr_ps(p3[0], p3[1], p3[2], 1.0f);
+				// high halves, built as the columns g, b, u, 1 - v and transposed into one (g, b, u, 1 - v) row per vertex
+				__m128 high0 = one;
+				__m128 high1 = one;
+				__m128 high2 = _mm_loadu_ps(u);
+				__m128 high3 = _mm_blendv_ps(zero, _mm_sub_ps(one, _mm_loadu_ps(v)), hasTexcoord);
+				Transpose4x4(high0, high1, high2, high3);
+
+				float* destination = reinterpret_cast<float*>(output + i);
+				_mm_storeu_ps(destination + 0, low0);
+				_mm_storeu_ps(destination + 4, high0);
+				_mm_storeu_ps(destination + 8, low1);
+				_mm_storeu_ps(destination + 12, high1);
+				_mm_storeu_ps(destination + 16, low2);
+				_mm_storeu_ps(destination + 20, high2);
+				_mm_storeu_ps(destination + 24, low3);
+				_mm_storeu_ps(destination + 28, high3);
+			}
+			for (; i < count; ++i)
+			{
+				output[i] = BuildObjVertex(positions, texcoords, indexTriples + 3 * i);
+			}
+		}
+
+		VKE_TARGET_SSE41 static void ComputeBoundsSSE41(const Vertex* vertices, size_t count, glm::vec3& boundsMin, glm::vec3& boundsMax)
+		{
+			const float* data = reinterpret_cast<const float*>(vertices);
+			__m128 min0 = _mm_loadu_ps(data);
+			__m128 max0 = min0;
+			__m128 min1 = min0;
+			__m128 max1 = min0;
+			size_t i = 0;
+			for (; i + 2 <= count; i += 2) // two independent chains keep both min / max ports busy
+			{
+				const __m128 a = _mm_loadu_ps(data + 8 * i);
+				const __m128 b = _mm_loadu_ps(data + 8 * i + 8);
+				min0 = _mm_min_ps(min0, a);
+				max0 = _mm_max_ps(max0, a);
+				min1 = _mm_min_ps(min1, b);
+				max1 = _mm_max_ps(max1, b);
+			}
+			for (; i < count; ++i)
+			{
+				const __m128 a = _mm_loadu_ps(data + 8 * i);
+				min0 = _mm_min_ps(min0, a);
+				max0 = _mm_max_ps(max0, a);
+			}
+			alignas(16) float minimum[4];
+			alignas(16) float maximum[4];
+			_mm_store_ps(minimum, _mm_min_ps(min0, min1));
+			_mm_store_ps(maximum, _mm_max_ps(max0, max1));
+			boundsMin = glm::vec3(minimum[0], minimum[1], minimum[2]);
+			boundsMax = glm::vec3(maximum[0], maximum[1], maximum[2]);
+		}
+
+		// clamp (nan -> low), scale and round to nearest even, as VertexQuantization::FloatToSnorm16 / FloatToUnorm8
+		VKE_TARGET_SSE41 static inline __m128i QuantizeSSE41(__m128 value, __m128 low, __m128 scale)
+		{
+			return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(value, low), _mm_set1_ps(1.0f)), scale));
+		}
+
+		// packs the quantized components of 4 vertices, one dword column each, into 4 QuantizedVertex rows
+		VKE_TARGET_SSE41 static inline void StoreQuantizedSSE41(QuantizedVertex* output, __m128i x, __m128i y, __m128i z, __m128i r, __m128i g, __m128i b, __m128i texcoords)
+		{
+			const __m128i low16 = _mm_set1_epi32(0xffff);
+			const __m128i column0 = _mm_or_si128(_mm_and_si128(x, low16), _mm_slli_epi32(y, 16));
+			const __m128i column1 = _mm_or_si128(_mm_and_si128(z, low16), _mm_set1_epi32(32767 << 16));
+			const __m128i column2 = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), _mm_set1_epi32(static_cast<int32_t>(0xff000000))));
+			const __m128i a = _mm_unpacklo_epi32(column0, column1);
+			const __m128i c = _mm_unpackhi_epi32(column0, column1);
+			const __m128i d = _mm_unpacklo_epi32(column2, texcoords);
+			const __m128i e = _mm_unpackhi_epi32(column2, texcoords);
+			__m128i* destination = reinterpret_cast<__m128i*>(output);
+			_mm_storeu_si128(destination + 0, _mm_unpacklo_epi64(a, d));
+			_mm_storeu_si128(destination + 1, _mm_unpackhi_epi64(a, d));
+			_mm_storeu_si128(destination + 2, _mm_unpacklo_epi64(c, e));
+			_mm_storeu_si128(destination + 3, _mm_unpackhi_epi64(c, e));
+		}
+
+		// no F16C below AVX2, the texcoords go through the scalar half conversion
+		VKE_TARGET_SSE41 static void QuantizeVerticesSSE41(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output)
+		{
+			const glm::vec3 inverseScale = glm::vec3(1.0f) / positionQuantization.Scale;
+			const __m128 biasX = _mm_set1_ps(positionQuantization.Bias.x);
+			const __m128 biasY = _mm_set1_ps(positionQuantization.Bias.y);
+			const __m128 biasZ = _mm_set1_ps(positionQuantization.Bias.z);
+			const __m128 inverseScaleX = _mm_set1_ps(inverseScale.x);
+			const __m128 inverseScaleY = _mm_set1_ps(inverseScale.y);
+			const __m128 inverseScaleZ = _mm_set1_ps(inverseScale.z);
+			const __m128 snormLow = _mm_set1_ps(-1.0f);
+			const __m128 snormScale = _mm_set1_ps(32767.0f);
+			const __m128 unormLow = _mm_setzero_ps();
+			const __m128 unormScale = _mm_set1_ps(255.0f);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* data = reinterpret_cast<const float*>(vertices + i);
+				__m128 x = _mm_loadu_ps(data + 0);
+				__m128 y = _mm_loadu_ps(data + 8);
+				__m128 z = _mm_loadu_ps(data + 16);
+				__m128 r = _mm_loadu_ps(data + 24);
+				Transpose4x4(x, y, z, r);
+				__m128 g = _mm_loadu_ps(data + 4);
+				__m128 b = _mm_loadu_ps(data + 12);
+				__m128 u = _mm_loadu_ps(data + 20);
+				__m128 v = _mm_loadu_ps(data + 28);
+				Transpose4x4(g, b, u, v);
+				alignas(16) float us[4];
+				alignas(16) float vs[4];
+				_mm_store_ps(us, u);
+				_mm_store_ps(vs, v);
+				const __m128i texcoords = _mm_setr_epi32(static_cast<int32_t>(PackHalves(us[0], vs[0])), static_cast<int32_t>(PackHalves(us[1], vs[1])),
+					static_cast<int32_t>(PackHalves(us[2], vs[2])), static_cast<int32_t>(PackHalves(us[3], vs[3])));
+
+				StoreQuantizedSSE41(output + i,
+					QuantizeSSE41(_mm_mul_ps(_mm_sub_ps(x, biasX), inverseScaleX), snormLow, snormScale),
+					QuantizeSSE41(_mm_mul_ps(_mm_sub_ps(y, biasY), inverseScaleY), snormLow, snormScale),
+					QuantizeSSE41(_mm_mul_ps(_mm_sub_ps(z, biasZ), inverseScaleZ), snormLow, snormScale),
+					QuantizeSSE41(r, unormLow, unormScale), QuantizeSSE41(g, unormLow, unormScale), QuantizeSSE41(b, unormLow, unormScale), texcoords);
+			}
+			for (; i < count; ++i)
+			{
+				output[i] = VertexQuantization::QuantizeVertex(vertices[i], positionQuantization);
+			}
+		}
+
+		////////////////////////////////////////////
+		// AVX2, 8 vertices per iteration, a Vertex is exactly one ymm register
+		////////////////////////////////////////////
+		// rows of 8 components <-> 8 vertices
+		VKE_TARGET_AVX2 static inline void Transpose8x8(__m256 rows[8])
+		{
+			const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+			const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+			const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+			const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+			const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+			const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+			const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+			const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+			const __m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+			const __m256 s1 = _mm256_shuffle_ps(t0, t2, 0xee);
+			const __m256 s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+			const __m256 s3 = _mm256_shuffle_ps(t1, t3, 0xee);
+			const __m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+			const __m256 s5 = _mm256_shuffle_ps(t4, t6, 0xee);
+			const __m256 s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+			const __m256 s7 = _mm256_shuffle_ps(t5, t7, 0xee);
+			rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+			rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+			rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+			rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+			rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+			rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+			rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+			rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+		}
+
+		VKE_TARGET_AVX2 static void BuildObjVerticesAVX2(const float* positions, const float* texcoords, const int32_t* indexTriples, size_t count, Vertex* output)
+		{
+			const __m256i tripleOffsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 zero = _mm256_setzero_ps();
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const int32_t* triples = indexTriples + 3 * i;
+				const __m256i positionIndices = _mm256_mullo_epi32(_mm256_i32gather_epi32(triples, tripleOffsets, 4), _mm256_set1_epi32(3));
+				const __m256i texcoordIndices = _mm256_i32gather_epi32(triples + 2, tripleOffsets, 4);
+				const __m256 hasTexcoord = _mm256_castsi256_ps(_mm256_cmpgt_epi32(texcoordIndices, _mm256_set1_epi32(-1)));
+				const __m256i texcoordOffsets = _mm256_slli_epi32(texcoordIndices, 1);
+
+				__m256 rows[8];
+				rows[0] = _mm256_i32gather_ps(positions + 0, positionIndices, 4);
+				rows[1] = _mm256_i32gather_ps(positions + 1, positionIndices, 4);
+				rows[2] = _mm256_i32gather_ps(positions + 2, positionIndices, 4);
+				rows[3] = one;
+				rows[4] = one;
+				rows[5] = one;
+				// masked lanes (no texcoord) are not read and stay 0
+				rows[6] = _mm256_mask_i32gather_ps(zero, texcoords + 0, texcoordOffsets, hasTexcoord, 4);
+				const __m256 v = _mm256_mask_i32gather_ps(zero, texcoords + 1, texcoordOffsets, hasTexcoord, 4);
+				rows[7] = _mm256_blendv_ps(zero, _mm256_sub_ps(one, v), hasTexcoord);
+				Transpose8x8(rows);
+				float* destination = reinterpret_cast<float*>(output + i);
+				for (int k = 0; k < 8; ++k)
+				{
+					_mm256_storeu_ps(destination + 8 * k, rows[k]);
+				}
+			}
+			for (; i < count; ++i)
+			{
+				output[i] = BuildObjVertex(positions, texcoords, indexTriples + 3 * i);
+			}
+		}
+
+		VKE_TARGET_AVX2 static void ComputeBoundsAVX2(const Vertex* vertices, size_t count, glm::vec3& boundsMin, glm::vec3& boundsMax)
+		{
+			const float* data = reinterpret_cast<const float*>(vertices);
+			__m256 min0 = _mm256_loadu_ps(data);
+			__m256 max0 = min0;
+			__m256 min1 = min0;
+			__m256 max1 = min0;
+			size_t i = 0;
+			for (; i + 2 <= count; i += 2)
+			{
+				const __m256 a = _mm256_loadu_ps(data + 8 * i);
+				const __m256 b = _mm256_loadu_ps(data + 8 * i + 8);
+				min0 = _mm256_min_ps(min0, a);
+				max0 = _mm256_max_ps(max0, a);
+				min1 = _mm256_min_ps(min1, b);
+				max1 = _mm256_max_ps(max1, b);
+			}
+			for (; i < count; ++i)
+			{
+				const __m256 a = _mm256_loadu_ps(data + 8 * i);
+				min0 = _mm256_min_ps(min0, a);
+				max0 = _mm256_max_ps(max0, a);
+			}
+			alignas(32) float minimum[8];
+			alignas(32) float maximum[8];
+			_mm256_store_ps(minimum, _mm256_min_ps(min0, min1));
+			_mm256_store_ps(maximum, _mm256_max_ps(max0, max1));
+			boundsMin = glm::vec3(minimum[0], minimum[1], minimum[2]);
+			boundsMax = glm::vec3(maximum[0], maximum[1], maximum[2]);
+		}
+
+		VKE_TARGET_AVX2 static inline __m256i QuantizeAVX2(__m256 value, __m256 low, __m256 scale)
+		{
+			return _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(value, low), _mm256_set1_ps(1.0f)), scale));
+		}
+
+		VKE_TARGET_AVX2 static void QuantizeVerticesAVX2(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output)
+		{
+			const glm::vec3 inverseScale = glm::vec3(1.0f) / positionQuantization.Scale;
+			const __m256 bias[3] = { _mm256_set1_ps(positionQuantization.Bias.x), _mm256_set1_ps(positionQuantization.Bias.y), _mm256_set1_ps(positionQuantization.Bias.z) };
+			const __m256 inverseScales[3] = { _mm256_set1_ps(inverseScale.x), _mm256_set1_ps(inverseScale.y), _mm256_set1_ps(inverseScale.z) };
+			const __m256 snormLow = _mm256_set1_ps(-1.0f);
+			const __m256 snormScale = _mm256_set1_ps(32767.0f);
+			const __m256 unormLow = _mm256_setzero_ps();
+			const __m256 unormScale = _mm256_set1_ps(255.0f);
+			const __m256i low16 = _mm256_set1_epi32(0xffff);
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* data = reinterpret_cast<const float*>(vertices + i);
+				__m256 rows[8];
+				for (int k = 0; k < 8; ++k)
+				{
+					rows[k] = _mm256_loadu_ps(data + 8 * k);
+				}
+				Transpose8x8(rows); // rows[component][vertex]
+
+				const __m256i x = QuantizeAVX2(_mm256_mul_ps(_mm256_sub_ps(rows[0], bias[0]), inverseScales[0]), snormLow, snormScale);
+				const __m256i y = QuantizeAVX2(_mm256_mul_ps(_mm256_sub_ps(rows[1], bias[1]), inverseScales[1]), snormLow, snormScale);
+				const __m256i z = QuantizeAVX2(_mm256_mul_ps(_mm256_sub_ps(rows[2], bias[2]), inverseScales[2]), snormLow, snormScale);
+				const __m256i r = QuantizeAVX2(rows[3], unormLow, unormScale);
+				const __m256i g = QuantizeAVX2(rows[4], unormLow, unormScale);
+				const __m256i b = QuantizeAVX2(rows[5], unormLow, unormScale);
+				const __m256i u = _mm256_cvtepu16_epi32(_mm256_cvtps_ph(rows[6], _MM_FROUND_TO_NEAREST_INT));
+				const __m256i v = _mm256_cvtepu16_epi32(_mm256_cvtps_ph(rows[7], _MM_FROUND_TO_NEAREST_INT));
+
+				// one dword column per QuantizedVertex member pair, then a 4x8 dword transpose into the vertex rows
+				const __m256i column0 = _mm256_or_si256(_mm256_and_si256(x, low16), _mm256_slli_epi32(y, 16));
+				const __m256i column1 = _mm256_or_si256(_mm256_and_si256(z, low16), _mm256_set1_epi32(32767 << 16));
+				const __m256i column2 = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)), _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_set1_epi32(static_cast<int32_t>(0xff000000))));
+				const __m256i column3 = _mm256_or_si256(u, _mm256_slli_epi32(v, 16));
+				const __m256i a = _mm256_unpacklo_epi32(column0, column1);
+				const __m256i c = _mm256_unpackhi_epi32(column0, column1);
+				const __m256i d = _mm256_unpacklo_epi32(column2, column3);
+				const __m256i e = _mm256_unpackhi_epi32(column2, column3);
+				const __m256i vertices04 = _mm256_unpacklo_epi64(a, d);
+				const __m256i vertices15 = _mm256_unpackhi_epi64(a, d);
+				const __m256i vertices26 = _mm256_unpacklo_epi64(c, e);
+				const __m256i vertices37 = _mm256_unpackhi_epi64(c, e);
+				__m256i* destination = reinterpret_cast<__m256i*>(output + i);
+				_mm256_storeu_si256(destination + 0, _mm256_permute2x128_si256(vertices04, vertices15, 0x20));
+				_mm256_storeu_si256(destination + 1, _mm256_permute2x128_si256(vertices26, vertices37, 0x20));
+				_mm256_storeu_si256(destination + 2, _mm256_permute2x128_si256(vertices04, vertices15, 0x31));
+				_mm256_storeu_si256(destination + 3, _mm256_permute2x128_si256(vertices26, vertices37, 0x31));
+			}
+			for (; i < count; ++i)
+			{
+				output[i] = VertexQuantization::QuantizeVertex(vertices[i], positionQuantization);
+			}
+		}
+#endif
+
+		void VertexKernels::BuildObjVertices(const float* positions, const float* texcoords, const int32_t* indexTriples, size_t count, Vertex* output, SimdLevel level)
+		{
+			level = std::min(level, CpuFeatures::GetSimdLevel());
+#if VKE_SIMD_X86
+			if (level == SimdLevel::AVX2)
+			{
+				BuildObjVerticesAVX2(positions, texcoords, indexTriples, count, output);
+				return;
+			}
+			if (level == SimdLevel::SSE41)
+			{
+				BuildObjVerticesSSE41(positions, texcoords, indexTriples, count, output);
+				return;
+			}
+#endif
+			for (size_t i = 0; i < count; ++i)
+			{
+				output[i] = BuildObjVertex(positions, texcoords, indexTriples + 3 * i);
+			}
+		}
+
+		void VertexKernels::ComputeBounds(const Vertex* vertices, size_t count, glm::vec3& boundsMin, glm::vec3& boundsMax, SimdLevel level)
+		{
+			if (count == 0)
+			{
+				boundsMin = boundsMax = glm::vec3(0.0f);
+				return;
+			}
+			level = std::min(level, CpuFeatures::GetSimdLevel());
+#if VKE_SIMD_X86
+			if (level == SimdLevel::AVX2)
+			{
+				ComputeBoundsAVX2(vertices, count, boundsMin, boundsMax);
+				return;
+			}
+			if (level == SimdLevel::SSE41)
+			{
+				ComputeBoundsSSE41(vertices, count, boundsMin, boundsMax);
+				return;
+			}
+#endif
+			boundsMin = boundsMax = vertices[0].Position;
+			for (size_t i = 0; i < count; ++i)
+			{
+				boundsMin = glm::min(boundsMin, vertices[i].Position);
+				boundsMax = glm::max(boundsMax, vertices[i].Position);
+			}
+		}
+
+		void VertexKernels::QuantizeVertices(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output, SimdLevel level)
+		{
+			level = std::min(level, CpuFeatures::GetSimdLevel());
+#if VKE_SIMD_X86
+			if (level == SimdLevel::AVX2)
+			{
+				QuantizeVerticesAVX2(vertices, count, positionQuantization, output);
+				return;
+			}
+			if (level == SimdLevel::SSE41)
+			{
+				QuantizeVerticesSSE41(vertices, count, positionQuantization, output);
+				return;
+			}
+#endif
+			for (size_t i = 0; i < count; ++i)
+			{
+				output[i] = VertexQuantization::QuantizeVertex(vertices[i], positionQuantization);
+			}
+		}
+	}
+}
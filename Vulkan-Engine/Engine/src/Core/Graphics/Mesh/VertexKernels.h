@@ -0,0 +1,45 @@
+/***************************************************************************
+ * Filename		: VertexKernels.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Bulk vertex processing kernels for import / upload time
+ *				  transforms, AVX2 and SSE4.1 paths with a scalar fallback.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Utility/CpuFeatures.h"
+#include "VertexQuantization.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// every level produces bit identical output (for inputs without nans), the level parameter only exists
+		// so the paths can be benchmarked / compared against each other. Levels above the supported one are clamped.
+		class VertexKernels
+		{
+		public:
+			VertexKernels() = delete;
+			~VertexKernels() = delete;
+		public:
+			// de-interleaves obj attributes into vertices: indexTriples holds (position, normal, texcoord) indices
+			// as in tinyobj::index_t, texcoords are flipped to (u, 1 - v), (0, 0) without a texcoord, color is white
+			static void BuildObjVertices(const float* positions, const float* texcoords, const int32_t* indexTriples, size_t count, Vertex* output,
+				SimdLevel level = CpuFeatures::GetSimdLevel());
+			// zero bounds for an empty range
+			static void ComputeBounds(const Vertex* vertices, size_t count, glm::vec3& boundsMin, glm::vec3& boundsMax,
+				SimdLevel level = CpuFeatures::GetSimdLevel());
+			// same conversion as VertexQuantization::QuantizeVertex
+			static void QuantizeVertices(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output,
+				SimdLevel level = CpuFeatures::GetSimdLevel());
+		};
+	}
+}
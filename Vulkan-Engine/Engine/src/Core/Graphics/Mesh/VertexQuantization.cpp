@@ -0,0 +1,180 @@
+/***************************************************************************
+ * Filename		: VertexQuantization.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Conversion kernels between full precision vertices and
+ *				  the packed vertex buffer formats (half, snorm, unorm, oct).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "VertexQuantization.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "VertexKernels.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint32_t QUANTIZE_BATCH_SIZE = 4096; // vertices per job
+
+		uint16_t VertexQuantization::FloatToHalf(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			const uint32_t magnitude = bits & 0x7fffffff;
+
+			if (magnitude >= 0x7f800000) // infinity / nan (keeps nan quiet)
+			{
+				return static_cast<uint16_t>(sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0));
+			}
+			if (magnitude >= 0x477ff000) // >= 65520 rounds past the largest half (65504)
+			{
+				return static_cast<uint16_t>(sign | 0x7c00);
+			}
+			if (magnitude < 0x38800000) // below 2^-14, half denormal (units of 2^-24)
+			{
+				const uint32_t exponent = magnitude >> 23;
+				if (exponent < 102) // below 2^-25, rounds to zero
+				{
+					return static_cast<uint16_t>(sign);
+				}
+				const uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+				const uint32_t shift = 126 - exponent;
+				uint32_t half = mantissa >> shift;
+				const uint32_t remainder = mantissa & ((1u << shift) - 1);
+				const uint32_t halfway = 1u << (shift - 1);
+				if (remainder > halfway || (remainder == halfway && (half & 1)))
+				{
+					++half;
+				}
+				return static_cast<uint16_t>(sign | half);
+			}
+			// normal, rebias the exponent (127 -> 15) and round the 13 dropped mantissa bits, a carry correctly bumps the exponent
+			uint32_t half = (magnitude - 0x38000000) >> 13;
+			const uint32_t remainder = magnitude & 0x1fff;
+			if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+			{
+				++half;
+			}
+			return static_cast<uint16_t>(sign | half);
+		}
+
+		float VertexQuantization::HalfToFloat(uint16_t value)
+		{
+			const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+			const uint32_t exponent = (value >> 10) & 0x1f;
+			const uint32_t mantissa = value & 0x3ff;
+			if (exponent == 0)
+			{
+				const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+				return sign ? -magnitude : magnitude;
+			}
+			const uint32_t bits = exponent == 31 ?
+				sign | 0x7f800000 | (mantissa << 13) :
+				sign | ((exponent + 112) << 23) | (mantissa << 13);
+			float result;
+			std::memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+
+		int16_t VertexQuantization::FloatToSnorm16(float value)
+		{
+			const float clamped = value >= -1.0f ? (value <= 1.0f ? value : 1.0f) : -1.0f; // nan -> -1
+			return static_cast<int16_t>(std::nearbyint(clamped * 32767.0f)); // round to nearest even, as cvtps2dq in the simd kernels
+		}
+
+		uint8_t VertexQuantization::FloatToUnorm8(float value)
+		{
+			const float clamped = value >= 0.0f ? (value <= 1.0f ? value : 1.0f) : 0.0f; // nan -> 0
+			return static_cast<uint8_t>(std::nearbyint(clamped * 255.0f));
+		}
+
+		OctNormal16 VertexQuantization::EncodeOctahedral(const glm::vec3& normal)
+		{
+			const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+			if (length == 0.0f)
+			{
+				return { 0, 0 };
+			}
+			float x = normal.x / length;
+			float y = normal.y / length;
+			if (normal.z < 0.0f) // fold the lower hemisphere over the diagonals
+			{
+				const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+				const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+				x = foldedX;
+				y = foldedY;
+			}
+			return { FloatToSnorm16(x), FloatToSnorm16(y) };
+		}
+
+		glm::vec3 VertexQuantization::DecodeOctahedral(const OctNormal16& encoded)
+		{
+			const float x = Snorm16ToFloat(encoded.X);
+			const float y = Snorm16ToFloat(encoded.Y);
+			glm::vec3 normal(x, y, 1.0f - std::abs(x) - std::abs(y));
+			if (normal.z < 0.0f)
+			{
+				normal.x = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+				normal.y = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			}
+			return glm::normalize(normal);
+		}
+
+		PositionQuantization VertexQuantization::ComputePositionQuantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+		{
+			PositionQuantization positionQuantization;
+			positionQuantization.Bias = (boundsMin + boundsMax) * 0.5f;
+			positionQuantization.Scale = (boundsMax - boundsMin) * 0.5f;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (!(positionQuantization.Scale[axis] > 0.0f)) // flat along this axis, every position equals the bias
+				{
+					positionQuantization.Scale[axis] = 1.0f;
+				}
+			}
+			return positionQuantization;
+		}
+
+		QuantizedVertex VertexQuantization::QuantizeVertex(const Vertex& vertex, const PositionQuantization& positionQuantization)
+		{
+			// multiplies by the reciprocal like the simd kernels, so every path rounds the same way
+			const glm::vec3 position = (vertex.Position - positionQuantization.Bias) * (glm::vec3(1.0f) / positionQuantization.Scale);
+			QuantizedVertex quantized;
+			quantized.Position = { FloatToSnorm16(position.x), FloatToSnorm16(position.y), FloatToSnorm16(position.z), 32767 };
+			quantized.Color = { FloatToUnorm8(vertex.Color.x), FloatToUnorm8(vertex.Color.y), FloatToUnorm8(vertex.Color.z), 255 };
+			quantized.TexCoord = { FloatToHalf(vertex.TexCoord.x), FloatToHalf(vertex.TexCoord.y) };
+			return quantized;
+		}
+
+		Vertex VertexQuantization::DequantizeVertex(const QuantizedVertex& vertex, const PositionQuantization& positionQuantization)
+		{
+			Vertex dequantized;
+			dequantized.Position = glm::vec3(Snorm16ToFloat(vertex.Position.X), Snorm16ToFloat(vertex.Position.Y), Snorm16ToFloat(vertex.Position.Z)) *
+				positionQuantization.Scale + positionQuantization.Bias;
+			dequantized.Color = glm::vec3(Unorm8ToFloat(vertex.Color.X), Unorm8ToFloat(vertex.Color.Y), Unorm8ToFloat(vertex.Color.Z));
+			dequantized.TexCoord = glm::vec2(HalfToFloat(vertex.TexCoord.X), HalfToFloat(vertex.TexCoord.Y));
+			return dequantized;
+		}
+
+		void VertexQuantization::QuantizeVertices(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output)
+		{
+			JobSystem::ParallelFor(static_cast<uint32_t>(count), QUANTIZE_BATCH_SIZE, [&](uint32_t first, uint32_t last)
+			{
+				VertexKernels::QuantizeVertices(vertices + first, last - first, positionQuantization, output + first);
+			});
+		}
+	}
+}
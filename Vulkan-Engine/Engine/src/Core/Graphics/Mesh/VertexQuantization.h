@@ -0,0 +1,69 @@
+/***************************************************************************
+ * Filename		: VertexQuantization.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Conversion kernels between full precision vertices and
+ *				  the packed vertex buffer formats (half, snorm, unorm, oct).
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Graphics/Pipeline/Shaders/Vertex.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// maps the mesh bounds to [-1, 1]: position = quantized * Scale + Bias
+		struct PositionQuantization
+		{
+			glm::vec3 Scale = glm::vec3(1.0f);
+			glm::vec3 Bias = glm::vec3(0.0f);
+
+			// applied before the model matrix, model * dequantization
+			_NODISCARD glm::mat4 GetDequantizationMatrix() const
+			{
+				glm::mat4 matrix(1.0f);
+				matrix[0][0] = Scale.x;
+				matrix[1][1] = Scale.y;
+				matrix[2][2] = Scale.z;
+				matrix[3] = glm::vec4(Bias, 1.0f);
+				return matrix;
+			}
+		};
+
+		// error bounds of a round trip (encode -> what the vertex fetch decodes):
+		// snorm16 position |error| <= 0.5 * Scale / 32767 per axis (+ float rounding), unorm8 color <= 0.5 / 255,
+		// half texcoord <= 2^-11 relative (2^-12 absolute in [0.5, 1]), octahedral normal < 0.0001 radians
+		class VertexQuantization
+		{
+		public:
+			VertexQuantization() = delete;
+			~VertexQuantization() = delete;
+		public:
+			// ieee 754 binary16, round to nearest even, overflow to infinity, nan preserved
+			_NODISCARD static uint16_t FloatToHalf(float value);
+			_NODISCARD static float HalfToFloat(uint16_t value);
+			_NODISCARD static int16_t FloatToSnorm16(float value); // clamped to [-1, 1]
+			_NODISCARD static float Snorm16ToFloat(int16_t value) { return std::max(static_cast<float>(value) / 32767.0f, -1.0f); }
+			_NODISCARD static uint8_t FloatToUnorm8(float value); // clamped to [0, 1]
+			_NODISCARD static float Unorm8ToFloat(uint8_t value) { return static_cast<float>(value) / 255.0f; }
+			// octahedral mapping of a unit vector onto [-1, 1]^2 (Cigolle et al. 2014), a zero vector encodes as +z
+			_NODISCARD static OctNormal16 EncodeOctahedral(const glm::vec3& normal);
+			_NODISCARD static glm::vec3 DecodeOctahedral(const OctNormal16& encoded);
+
+			_NODISCARD static PositionQuantization ComputePositionQuantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+			_NODISCARD static QuantizedVertex QuantizeVertex(const Vertex& vertex, const PositionQuantization& positionQuantization);
+			_NODISCARD static Vertex DequantizeVertex(const QuantizedVertex& vertex, const PositionQuantization& positionQuantization);
+			// splits large meshes across the job system, output must hold count vertices
+			static void QuantizeVertices(const Vertex* vertices, size_t count, const PositionQuantization& positionQuantization, QuantizedVertex* output);
+		};
+	}
+}
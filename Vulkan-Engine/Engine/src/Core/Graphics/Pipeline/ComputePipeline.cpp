@@ -0,0 +1,82 @@
+/***************************************************************************
+ * Filename		: ComputePipeline.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Compute pipeline and its layout created from a single
+ *				  compute shader, used by gpu side passes such as culling.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "ComputePipeline.h"
+
+#include "Core/Logger/Log.h"
+#include "Shaders/Shader.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		ComputePipeline::ComputePipeline(VkDevice logicalDevice, VkPipelineCache pipelineCache, const std::string& shaderPath,
+			VkDescriptorSetLayout descriptorSetLayout, uint32_t pushConstantSize)
+			: m_LogicalDevice(logicalDevice)
+		{
+			VkPushConstantRange pushConstantRange = {};
+			pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			pushConstantRange.offset = 0;
+			pushConstantRange.size = pushConstantSize;
+
+			VkPipelineLayoutCreateInfo layoutInfo = {};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			layoutInfo.setLayoutCount = 1;
+			layoutInfo.pSetLayouts = &descriptorSetLayout;
+			layoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+			layoutInfo.pPushConstantRanges = pushConstantSize > 0 ? &pushConstantRange : nullptr;
+			if (vkCreatePipelineLayout(m_LogicalDevice, &layoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::ComputePipeline]: Failed to create compute pipeline layout!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			const Shader computeShader(shaderPath, &m_LogicalDevice); // the module is only needed until the pipeline exists
+			VkComputePipelineCreateInfo pipelineInfo = {};
+			pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+			pipelineInfo.stage.module = computeShader.GetShaderModule();
+			pipelineInfo.stage.pName = "main";
+			pipelineInfo.layout = m_PipelineLayout;
+			if (vkCreateComputePipelines(m_LogicalDevice, pipelineCache, 1, &pipelineInfo, nullptr, &m_Pipeline) != VK_SUCCESS)
+			{
+				vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr);
+				static const std::string message = "[GraphicsSystem::ComputePipeline]: Failed to create compute pipeline!";
+				VK_CORE_CRITICAL("{0} -> Shader: {1}", message, shaderPath);
+				throw std::runtime_error(message);
+			}
+		}
+
+		ComputePipeline::~ComputePipeline()
+		{
+			vkDestroyPipeline(m_LogicalDevice, m_Pipeline, nullptr);
+			vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr);
+		}
+
+		void ComputePipeline::Bind(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet) const
+		{
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+		}
+
+		void ComputePipeline::PushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const
+		{
+			vkCmdPushConstants(commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, size, data);
+		}
+	}
+}
@@ -0,0 +1,48 @@
+/***************************************************************************
+ * Filename		: ComputePipeline.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Compute pipeline and its layout created from a single
+ *				  compute shader, used by gpu side passes such as culling.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		class ComputePipeline
+		{
+		public:
+			// the layout has a single descriptor set and an optional push constant range starting at offset 0
+			ComputePipeline(VkDevice logicalDevice, VkPipelineCache pipelineCache, const std::string& shaderPath,
+				VkDescriptorSetLayout descriptorSetLayout, uint32_t pushConstantSize = 0);
+			~ComputePipeline();
+			ComputePipeline(const ComputePipeline&) = delete;
+			ComputePipeline& operator=(const ComputePipeline&) = delete;
+		public:
+			void Bind(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet) const;
+			void PushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const;
+			_NODISCARD VkPipeline GetPipeline() const { return m_Pipeline; }
+			_NODISCARD VkPipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
+			// workgroups needed to cover count invocations
+			_NODISCARD static uint32_t GetGroupCount(uint32_t count, uint32_t groupSize) { return (count + groupSize - 1) / groupSize; }
+		private:
+			VkDevice m_LogicalDevice;
+			VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+			VkPipeline m_Pipeline = VK_NULL_HANDLE;
+		};
+	}
+}
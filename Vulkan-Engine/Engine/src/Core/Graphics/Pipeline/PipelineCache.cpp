@@ -0,0 +1,196 @@
+/***************************************************************************
+ * Filename		: PipelineCache.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: VkPipelineCache persisted to disk between runs, discarded
+ *				  when it was written by a different device or driver.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "PipelineCache.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Utility/Hash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		static constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x43505856; // "VXPC"
+		static constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 2; // 2: checksum computed with HashBytes
+
+		struct PipelineCacheFileHeader
+		{
+			uint32_t Magic;
+			uint32_t FileVersion;
+			uint64_t DataSize;
+			uint64_t Checksum; // of the data following the header, catches truncated or partially written files
+		};
+
+		// header the driver writes at the start of the cache data (VkPipelineCacheHeaderVersionOne)
+		struct PipelineCacheDataHeader
+		{
+			uint32_t HeaderSize;
+			uint32_t HeaderVersion;
+			uint32_t VendorID;
+			uint32_t DeviceID;
+			uint8_t PipelineCacheUUID[VK_UUID_SIZE];
+		};
+
+		// "Cache/PipelineCache.bin" -> "Cache/PipelineCache_<vendor>_<device>_<uuid>.bin", one file per gpu and driver
+		// so that switching between them doesn't discard the cache of the other
+		static std::string GetDeviceFilepath(const std::string& filepath, const VkPhysicalDeviceProperties& properties)
+		{
+			std::ostringstream suffix;
+			suffix << std::hex << std::setfill('0') << '_' << std::setw(4) << properties.vendorID << '_' << std::setw(4) << properties.deviceID << '_';
+			for (uint32_t i = 0; i < VK_UUID_SIZE; ++i)
+			{
+				suffix << std::setw(2) << static_cast<uint32_t>(properties.pipelineCacheUUID[i]);
+			}
+			const std::filesystem::path path(filepath);
+			return (path.parent_path() / (path.stem().string() + suffix.str() + path.extension().string())).string();
+		}
+
+		PipelineCache::PipelineCache(VkDevice logicalDevice, VkPhysicalDevice physicalDevice, const std::string& filepath)
+			: m_LogicalDevice(logicalDevice)
+		{
+			vkGetPhysicalDeviceProperties(physicalDevice, &m_DeviceProperties);
+			m_Filepath = GetDeviceFilepath(filepath, m_DeviceProperties);
+			const std::vector<uint8_t> cacheData = LoadCacheData();
+
+			VkPipelineCacheCreateInfo cacheInfo = {};
+			cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+			cacheInfo.initialDataSize = cacheData.size();
+			cacheInfo.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+			if (vkCreatePipelineCache(m_LogicalDevice, &cacheInfo, nullptr, &m_PipelineCache) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::PipelineCache::PipelineCache]: Failed to create pipeline cache!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			VK_CORE_INFO("[GraphicsSystem::PipelineCache]: Created pipeline cache with {0} bytes of initial data", cacheData.size());
+		}
+
+		PipelineCache::~PipelineCache()
+		{
+			vkDestroyPipelineCache(m_LogicalDevice, m_PipelineCache, nullptr);
+		}
+
+		void PipelineCache::Save() const
+		{
+			size_t dataSize = 0;
+			if (vkGetPipelineCacheData(m_LogicalDevice, m_PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::Save]: No pipeline cache data to save");
+				return;
+			}
+			std::vector<uint8_t> cacheData(dataSize);
+			if (vkGetPipelineCacheData(m_LogicalDevice, m_PipelineCache, &dataSize, cacheData.data()) != VK_SUCCESS)
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::Save]: Failed to retrieve pipeline cache data");
+				return;
+			}
+			cacheData.resize(dataSize);
+
+			PipelineCacheFileHeader header;
+			header.Magic = PIPELINE_CACHE_MAGIC;
+			header.FileVersion = PIPELINE_CACHE_FILE_VERSION;
+			header.DataSize = cacheData.size();
+			header.Checksum = HashBytes(cacheData.data(), cacheData.size());
+
+			std::error_code error;
+			const std::filesystem::path path(m_Filepath);
+			if (path.has_parent_path())
+			{
+				std::filesystem::create_directories(path.parent_path(), error);
+			}
+			const std::filesystem::path temporaryPath = path.string() + ".tmp";
+			{
+				std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(cacheData.data()), static_cast<std::streamsize>(cacheData.size()));
+				file.flush();
+				if (!file)
+				{
+					VK_CORE_WARN("[GraphicsSystem::PipelineCache::Save]: Failed to write {0}", temporaryPath.string());
+					file.close();
+					std::filesystem::remove(temporaryPath, error);
+					return;
+				}
+			}
+			std::filesystem::rename(temporaryPath, path, error); // replaces the existing file in one step
+			if (error)
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::Save]: Failed to replace {0}: {1}", m_Filepath, error.message());
+				std::filesystem::remove(temporaryPath, error);
+				return;
+			}
+			VK_CORE_INFO("[GraphicsSystem::PipelineCache::Save]: Saved {0} bytes to {1}", cacheData.size(), m_Filepath);
+		}
+
+		std::vector<uint8_t> PipelineCache::LoadCacheData() const
+		{
+			std::ifstream file(m_Filepath, std::ios::binary | std::ios::ate);
+			if (!file.is_open())
+			{
+				return {}; // first run
+			}
+			const std::streamoff fileSize = file.tellg();
+			PipelineCacheFileHeader header;
+			if (fileSize < static_cast<std::streamoff>(sizeof(header)))
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::LoadCacheData]: {0} is truncated, discarding it", m_Filepath);
+				return {};
+			}
+			file.seekg(0);
+			file.read(reinterpret_cast<char*>(&header), sizeof(header));
+			if (header.Magic != PIPELINE_CACHE_MAGIC || header.FileVersion != PIPELINE_CACHE_FILE_VERSION ||
+				header.DataSize != static_cast<uint64_t>(fileSize) - sizeof(header))
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::LoadCacheData]: {0} has an invalid header, discarding it", m_Filepath);
+				return {};
+			}
+			std::vector<uint8_t> cacheData(static_cast<size_t>(header.DataSize));
+			file.read(reinterpret_cast<char*>(cacheData.data()), static_cast<std::streamsize>(cacheData.size()));
+			if (!file || HashBytes(cacheData.data(), cacheData.size()) != header.Checksum)
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::LoadCacheData]: {0} is corrupt, discarding it", m_Filepath);
+				return {};
+			}
+			if (!IsCompatible(cacheData))
+			{
+				VK_CORE_WARN("[GraphicsSystem::PipelineCache::LoadCacheData]: {0} was written by a different device or driver, discarding it", m_Filepath);
+				return {};
+			}
+			return cacheData;
+		}
+
+		bool PipelineCache::IsCompatible(const std::vector<uint8_t>& cacheData) const
+		{
+			// drivers are supposed to reject foreign data themselves, but not all of them do so safely
+			PipelineCacheDataHeader dataHeader;
+			if (cacheData.size() < sizeof(dataHeader))
+			{
+				return false;
+			}
+			std::memcpy(&dataHeader, cacheData.data(), sizeof(dataHeader));
+			return dataHeader.HeaderSize >= sizeof(dataHeader) &&
+				dataHeader.HeaderVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+				dataHeader.VendorID == m_DeviceProperties.vendorID &&
+				dataHeader.DeviceID == m_DeviceProperties.deviceID &&
+				std::memcmp(dataHeader.PipelineCacheUUID, m_DeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/***************************************************************************
+ * Filename		: PipelineCache.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: VkPipelineCache persisted to disk between runs, discarded
+ *				  when it was written by a different device or driver.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// File layout: PipelineCacheFileHeader followed by the data returned by vkGetPipelineCacheData.
+		// The data is only handed to the driver if the checksum matches and its own header
+		// (VkPipelineCacheHeaderVersionOne) names this vendor, device and pipelineCacheUUID.
+		// Vendor, device and pipelineCacheUUID are also appended to the file name, every gpu / driver keeps its own file.
+		class PipelineCache
+		{
+		public:
+			PipelineCache(VkDevice logicalDevice, VkPhysicalDevice physicalDevice, const std::string& filepath);
+			~PipelineCache();
+			PipelineCache(const PipelineCache&) = delete;
+			PipelineCache& operator=(const PipelineCache&) = delete;
+		public:
+			void Save() const; // writes to a temporary file which then replaces the old one, so a crash never leaves a torn cache
+			_NODISCARD VkPipelineCache GetPipelineCache() const { return m_PipelineCache; }
+		private:
+			std::vector<uint8_t> LoadCacheData() const; // empty if the file is missing, corrupt or stale
+			bool IsCompatible(const std::vector<uint8_t>& cacheData) const;
+		private:
+			VkDevice m_LogicalDevice;
+			VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+			VkPhysicalDeviceProperties m_DeviceProperties;
+			std::string m_Filepath;
+		};
+	}
+}
@@ -23,41 +23,54 @@ namespace Vulkan_Engine
 	namespace Graphics
 	{
 		Shader::Shader(const std::string& filename, VkDevice* logicalDevice)
+			: Shader(ReadSpirv(filename), logicalDevice)
+		{
+		}
+
+		Shader::Shader(const std::vector<uint32_t>& code, VkDevice* logicalDevice)
 			: m_LogicalDevice(logicalDevice)
 		{
-			// move away from constructor 
+			m_Reflection = ShaderReflection(code.data(), code.size());
+			CreateShaderModule(code);
+		}
+
+		Shader::~Shader()
+		{
+			vkDestroyShaderModule(*m_LogicalDevice, m_ShaderModule, nullptr);
+		}	
+
+		std::vector<uint32_t> Shader::ReadSpirv(const std::string& filename)
+		{
 			std::ifstream file(filename, std::ios::ate | std::ios::binary);
 			if (!file.is_open()) 
 			{
-				static const std::string message = "[GraphicsSystem::Shader::Constructor]: Failed to open shader file!";
+				static const std::string message = "[GraphicsSystem::Shader::ReadSpirv]: Failed to open shader file!";
 				VK_CORE_CRITICAL("{0} -> In file:  {1} ", message, filename);
 				throw std::runtime_error(message);
 			}
-			const size_t fileSize = (size_t)file.tellg();
-			m_ShaderData = std::vector<char>(fileSize);
+			const size_t fileSize = static_cast<size_t>(file.tellg());
+			if (fileSize == 0 || fileSize % sizeof(uint32_t) != 0)
+			{
+				static const std::string message = "[GraphicsSystem::Shader::ReadSpirv]: Shader file is not a whole number of SPIR-V words!";
+				VK_CORE_CRITICAL("{0} -> In file:  {1} ({2} bytes)", message, filename, fileSize);
+				throw std::runtime_error(message);
+			}
+			// read straight into the words, a char buffer is not guaranteed to be 4 byte aligned
+			std::vector<uint32_t> code(fileSize / sizeof(uint32_t));
 			file.seekg(0);
-			file.read(m_ShaderData.data(), fileSize);
-			file.close();
-
-			// move to init
-			CreateShaderModule();
+			file.read(reinterpret_cast<char*>(code.data()), fileSize);
+			return code;
 		}
 
-		Shader::~Shader()
-		{
-			vkDestroyShaderModule(*m_LogicalDevice, m_ShaderModule, nullptr);
-		}	
-
-		void Shader::CreateShaderModule()
+		void Shader::CreateShaderModule(const std::vector<uint32_t>& code)
 		{
 			VkShaderModuleCreateInfo createInfo = {};
 			createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			createInfo.codeSize = m_ShaderData.size();
-			// note, ensure that data matches alignment 
-			createInfo.pCode = reinterpret_cast<const uint32_t*>(m_ShaderData.data()); // reinterpret due to bytecode usage vs char usage
+			createInfo.codeSize = code.size() * sizeof(uint32_t); // in bytes
+			createInfo.pCode = code.data();
 			if (vkCreateShaderModule(*m_LogicalDevice, &createInfo, nullptr, &m_ShaderModule) != VK_SUCCESS) 
 			{
-				static const std::string message = "[GraphicsSystem::Shader::Constructor]: Failed to create shader module!";
+				static const std::string message = "[GraphicsSystem::Shader::CreateShaderModule]: Failed to create shader module!";
 				VK_CORE_CRITICAL(message);
 				throw std::runtime_error(message);
 			}
@@ -16,6 +16,11 @@
 
 #include <vulkan/vulkan.h>
 
+#include "ShaderReflection.h"
+
+#include <string>
+#include <vector>
+
 namespace Vulkan_Engine
 {
 	namespace Graphics
@@ -25,15 +30,22 @@ namespace Vulkan_Engine
 		public:
 			Shader() = delete;
 			Shader(const std::string& filename, VkDevice* logicalDevice);
+			Shader(const std::vector<uint32_t>& code, VkDevice* logicalDevice); // code is only read during construction
 			~Shader();
+			Shader(const Shader&) = delete;
+			Shader& operator=(const Shader&) = delete;
+		public:
+			// the whole file as 32 bit words, so pCode is aligned as vkCreateShaderModule requires
+			static std::vector<uint32_t> ReadSpirv(const std::string& filename);
 		public:
 			_NODISCARD VkShaderModule GetShaderModule() const { return m_ShaderModule; }
+			_NODISCARD const ShaderReflection& GetReflection() const { return m_Reflection; }
 		private:
-			void CreateShaderModule();
+			void CreateShaderModule(const std::vector<uint32_t>& code);
 		private:
-			std::vector<char> m_ShaderData;
 			VkDevice* m_LogicalDevice;
 			VkShaderModule  m_ShaderModule;
+			ShaderReflection m_Reflection; // interface of the module, used to derive and validate the pipeline layouts
 		};
 	}
 }
\ No newline at end of file
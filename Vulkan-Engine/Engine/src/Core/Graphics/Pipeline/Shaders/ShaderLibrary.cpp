@@ -0,0 +1,213 @@
+/***************************************************************************
+ * Filename		: ShaderLibrary.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Caches shader modules by the hash of their SPIR-V and derives
+ *				  descriptor set / pipeline layouts from their reflection.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "ShaderLibrary.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Utility/Hash.h"
+#include "Core/Graphics/Descriptors/DescriptorLayoutCache.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		namespace
+		{
+			// SPIR-V only knows uniform and storage buffers, a dynamic offset is decided by the layout
+			bool IsCompatibleType(VkDescriptorType reflected, VkDescriptorType layout)
+			{
+				if (reflected == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+				{
+					return layout == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || layout == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+				}
+				if (reflected == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+				{
+					return layout == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER || layout == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+				}
+				return reflected == layout;
+			}
+		}
+
+		ShaderLibrary::ShaderLibrary(VkDevice logicalDevice)
+			: m_LogicalDevice(logicalDevice)
+		{
+		}
+
+		const Shader& ShaderLibrary::Load(const std::string& filename)
+		{
+			std::error_code error;
+			const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filename, error);
+			const uintmax_t size = error ? 0 : std::filesystem::file_size(filename, error);
+			const auto file = m_Files.find(filename);
+			if (!error && file != m_Files.end() && file->second.WriteTime == writeTime && file->second.Size == size)
+			{
+				++m_HitCount;
+				return *m_Shaders.at(file->second.Hash);
+			}
+
+			// throws when the file is missing, like loading a Shader directly
+			const std::vector<uint32_t> code = Shader::ReadSpirv(filename);
+			const uint64_t hash = HashBytes(code.data(), code.size() * sizeof(uint32_t));
+			auto shader = m_Shaders.find(hash);
+			if (shader != m_Shaders.end())
+			{
+				++m_HitCount;
+			}
+			else
+			{
+				shader = m_Shaders.emplace(hash, CreateScope<Shader>(code, &m_LogicalDevice)).first;
+			}
+			if (!error)
+			{
+				m_Files[filename] = { writeTime, size, hash };
+			}
+			return *shader->second;
+		}
+
+		VkPipelineLayout ShaderLibrary::CreatePipelineLayout(const std::vector<const Shader*>& shaders, DescriptorLayoutCache& layoutCache, const PipelineLayoutOptions& options) const
+		{
+			std::vector<const ShaderReflection*> reflections;
+			reflections.reserve(shaders.size());
+			for (const Shader* shader : shaders)
+			{
+				reflections.push_back(&shader->GetReflection());
+			}
+			const ShaderInterface shaderInterface = MergeReflections(reflections, options.DynamicUniformBuffers);
+			const std::map<uint32_t, std::map<uint32_t, VkDescriptorSetLayoutBinding>>& sets = shaderInterface.Sets;
+			const VkPushConstantRange& pushConstantRange = shaderInterface.PushConstantRange;
+
+			uint32_t setCount = sets.empty() ? 0 : sets.rbegin()->first + 1;
+			if (!options.SetLayouts.empty())
+			{
+				setCount = std::max(setCount, options.SetLayouts.rbegin()->first + 1);
+			}
+			std::vector<VkDescriptorSetLayout> setLayouts(setCount);
+			for (uint32_t set = 0; set < setCount; ++set)
+			{
+				static const std::map<uint32_t, VkDescriptorSetLayoutBinding> noBindings;
+				const auto reflectedSet = sets.find(set);
+				const std::map<uint32_t, VkDescriptorSetLayoutBinding>& bindings = reflectedSet != sets.end() ? reflectedSet->second : noBindings;
+				const auto ownLayout = options.SetLayouts.find(set);
+				if (ownLayout == options.SetLayouts.end())
+				{
+					// a set no stage uses (a gap) still needs a layout, the empty one
+					std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+					layoutBindings.reserve(bindings.size());
+					for (const auto& binding : bindings)
+					{
+						if (binding.second.descriptorCount == 0)
+						{
+							static const std::string message = "[GraphicsSystem::ShaderLibrary::CreatePipelineLayout]: Runtime sized descriptor arrays need a set layout from the caller!";
+							VK_CORE_CRITICAL("{0} -> set {1}, binding {2}", message, set, binding.first);
+							throw std::runtime_error(message);
+						}
+						layoutBindings.push_back(binding.second);
+					}
+					setLayouts[set] = layoutCache.GetLayout(layoutBindings);
+					continue;
+				}
+
+				setLayouts[set] = ownLayout->second;
+				const std::vector<VkDescriptorSetLayoutBinding>* ownBindings = layoutCache.GetBindings(ownLayout->second);
+				if (ownBindings == nullptr)
+				{
+					VK_CORE_WARN("[GraphicsSystem::ShaderLibrary::CreatePipelineLayout]: Layout of set {0} was not created by the layout cache, its bindings are not validated", set);
+					continue;
+				}
+				for (const auto& binding : bindings)
+				{
+					const VkDescriptorSetLayoutBinding& reflected = binding.second;
+					const auto own = std::find_if(ownBindings->begin(), ownBindings->end(),
+						[&reflected](const VkDescriptorSetLayoutBinding& candidate) { return candidate.binding == reflected.binding; });
+					// the layout's array may be larger than the shader's, a runtime array takes any size
+					if (own == ownBindings->end() || !IsCompatibleType(reflected.descriptorType, own->descriptorType)
+						|| (reflected.descriptorCount != 0 && own->descriptorCount < reflected.descriptorCount) || (own->stageFlags & reflected.stageFlags) != reflected.stageFlags)
+					{
+						static const std::string message = "[GraphicsSystem::ShaderLibrary::CreatePipelineLayout]: Set layout does not match the shaders!";
+						VK_CORE_CRITICAL("{0} -> set {1}, binding {2}", message, set, binding.first);
+						throw std::runtime_error(message);
+					}
+				}
+			}
+
+			VkPipelineLayoutCreateInfo layoutInfo = {};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			layoutInfo.setLayoutCount = setCount;
+			layoutInfo.pSetLayouts = setLayouts.data();
+			layoutInfo.pushConstantRangeCount = pushConstantRange.stageFlags != 0 ? 1 : 0;
+			layoutInfo.pPushConstantRanges = pushConstantRange.stageFlags != 0 ? &pushConstantRange : nullptr;
+			VkPipelineLayout pipelineLayout;
+			if (vkCreatePipelineLayout(m_LogicalDevice, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::ShaderLibrary::CreatePipelineLayout]: Failed to create pipeline layout!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			return pipelineLayout;
+		}
+
+		ShaderInterface ShaderLibrary::MergeReflections(const std::vector<const ShaderReflection*>& reflections, bool dynamicUniformBuffers)
+		{
+			ShaderInterface shaderInterface;
+			for (const ShaderReflection* reflection : reflections)
+			{
+				for (const ShaderBinding& binding : reflection->GetBindings())
+				{
+					VkDescriptorType type = binding.Type;
+					if (dynamicUniformBuffers && type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+					{
+						type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+					}
+					const auto merged = shaderInterface.Sets[binding.Set].emplace(binding.Binding, VkDescriptorSetLayoutBinding{ binding.Binding, type, binding.Count, 0, nullptr });
+					VkDescriptorSetLayoutBinding& layoutBinding = merged.first->second;
+					if (layoutBinding.descriptorType != type)
+					{
+						static const std::string message = "[GraphicsSystem::ShaderLibrary::MergeReflections]: Shader stages declare different descriptor types for one binding!";
+						VK_CORE_CRITICAL("{0} -> set {1}, binding {2}", message, binding.Set, binding.Binding);
+						throw std::runtime_error(message);
+					}
+					// a runtime array (count 0) stays runtime sized
+					if (layoutBinding.descriptorCount != 0)
+					{
+						layoutBinding.descriptorCount = binding.Count == 0 ? 0 : std::max(layoutBinding.descriptorCount, binding.Count);
+					}
+					layoutBinding.stageFlags |= reflection->GetStage();
+				}
+				if (reflection->HasPushConstants())
+				{
+					shaderInterface.PushConstantRange.stageFlags |= reflection->GetStage();
+					shaderInterface.PushConstantRange.size = std::max(shaderInterface.PushConstantRange.size, reflection->GetPushConstantSize());
+				}
+			}
+			return shaderInterface;
+		}
+
+		void ShaderLibrary::ValidateVertexInputs(const Shader& vertexShader, const std::vector<VkVertexInputAttributeDescription>& attributes)
+		{
+			for (const ShaderInput& input : vertexShader.GetReflection().GetInputs())
+			{
+				const auto attribute = std::find_if(attributes.begin(), attributes.end(),
+					[&input](const VkVertexInputAttributeDescription& candidate) { return candidate.location == input.Location; });
+				if (attribute == attributes.end())
+				{
+					static const std::string message = "[GraphicsSystem::ShaderLibrary::ValidateVertexInputs]: Vertex shader input has no vertex attribute!";
+					VK_CORE_CRITICAL("{0} -> location {1}", message, input.Location);
+					throw std::runtime_error(message);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+ * Filename		: ShaderLibrary.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Caches shader modules by the hash of their SPIR-V and derives
+ *				  descriptor set / pipeline layouts from their reflection.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/Core.h"
+#include "Shader.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		class DescriptorLayoutCache;
+
+		struct PipelineLayoutOptions
+		{
+			bool DynamicUniformBuffers = false; // reflected uniform buffers become VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+			// sets whose layout the caller already owns (e.g. created with binding flags), checked against the shaders instead of derived
+			std::map<uint32_t, VkDescriptorSetLayout> SetLayouts;
+		};
+
+		// what a pipeline's stages declare together, the input of its layout
+		struct ShaderInterface
+		{
+			std::map<uint32_t, std::map<uint32_t, VkDescriptorSetLayoutBinding>> Sets; // by set, then binding
+			VkPushConstantRange PushConstantRange = {}; // stageFlags is 0 when no stage declares a block
+		};
+
+		// modules live as long as the library, so pipelines rebuilt on a resize reuse them. A file is only read again
+		// once its size or write time changes, and a file with the same SPIR-V as an earlier one shares its module.
+		class ShaderLibrary
+		{
+		public:
+			explicit ShaderLibrary(VkDevice logicalDevice);
+			~ShaderLibrary() = default;
+			ShaderLibrary(const ShaderLibrary&) = delete;
+			ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+		public:
+			const Shader& Load(const std::string& filename);
+			// set layouts come from layoutCache, the push constant range covers the largest block of every stage declaring one.
+			// The caller destroys the returned layout
+			VkPipelineLayout CreatePipelineLayout(const std::vector<const Shader*>& shaders, DescriptorLayoutCache& layoutCache, const PipelineLayoutOptions& options = {}) const;
+			// the same binding seen by two stages is one binding with both stage flags. Throws when the stages disagree on its type
+			static ShaderInterface MergeReflections(const std::vector<const ShaderReflection*>& reflections, bool dynamicUniformBuffers = false);
+			// every input of the vertex shader needs an attribute at its location, formats may differ (normalized / quantized attributes)
+			static void ValidateVertexInputs(const Shader& vertexShader, const std::vector<VkVertexInputAttributeDescription>& attributes);
+			_NODISCARD uint32_t GetModuleCount() const { return static_cast<uint32_t>(m_Shaders.size()); }
+			_NODISCARD uint32_t GetHitCount() const { return m_HitCount; }
+		private:
+			struct FileEntry
+			{
+				std::filesystem::file_time_type WriteTime;
+				uintmax_t Size = 0;
+				uint64_t Hash = 0; // of the SPIR-V, key into m_Shaders
+			};
+		private:
+			VkDevice m_LogicalDevice; // Shader keeps a pointer to it
+			std::unordered_map<uint64_t, Scope<Shader>> m_Shaders;
+			std::unordered_map<std::string, FileEntry> m_Files;
+			uint32_t m_HitCount = 0; // loads answered without creating a module
+		};
+	}
+}
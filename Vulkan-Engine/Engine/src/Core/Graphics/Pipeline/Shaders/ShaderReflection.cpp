@@ -0,0 +1,392 @@
+/***************************************************************************
+ * Filename		: ShaderReflection.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Reads the interface of a SPIR-V module (stage, descriptor bindings,
+ *				  push constant block and vertex inputs), pipeline layouts are derived from it.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "ShaderReflection.h"
+
+#include "Core/Logger/Log.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		namespace
+		{
+			// the few SPIR-V enums used below (spirv.h of the SPIR-V 1.0 specification)
+			constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+			constexpr uint32_t SPIRV_HEADER_WORDS = 5;
+			enum SpirvOp : uint32_t
+			{
+				OpEntryPoint = 15, OpTypeInt = 21, OpTypeFloat = 22, OpTypeVector = 23, OpTypeMatrix = 24,
+				OpTypeImage = 25, OpTypeSampler = 26, OpTypeSampledImage = 27, OpTypeArray = 28, OpTypeRuntimeArray = 29,
+				OpTypeStruct = 30, OpTypePointer = 32, OpConstant = 43, OpVariable = 59, OpDecorate = 71, OpMemberDecorate = 72
+			};
+			enum SpirvDecoration : uint32_t
+			{
+				DecorationBlock = 2, DecorationBufferBlock = 3, DecorationArrayStride = 6, DecorationMatrixStride = 7, DecorationBuiltIn = 11,
+				DecorationLocation = 30, DecorationBinding = 33, DecorationDescriptorSet = 34, DecorationOffset = 35
+			};
+			enum SpirvStorageClass : uint32_t
+			{
+				StorageClassUniformConstant = 0, StorageClassInput = 1, StorageClassUniform = 2, StorageClassPushConstant = 9, StorageClassStorageBuffer = 12
+			};
+			enum SpirvDim : uint32_t { DimBuffer = 5, DimSubpassData = 6 };
+
+			struct SpirvType
+			{
+				uint32_t Opcode = 0;
+				std::vector<uint32_t> Operands; // the instruction's words after the result id
+			};
+
+			class SpirvModule
+			{
+			public:
+				std::unordered_map<uint32_t, SpirvType> Types;
+				std::unordered_map<uint32_t, uint32_t> Constants; // 32 bit scalar constants (array lengths)
+				std::unordered_map<uint32_t, uint32_t> ArrayStrides;
+				std::unordered_map<uint64_t, uint32_t> MemberOffsets; // (struct << 32 | member)
+				std::unordered_map<uint64_t, uint32_t> MatrixStrides; // (struct << 32 | member)
+				std::unordered_set<uint32_t> BufferBlocks; // structs decorated BufferBlock (storage buffers before SPIR-V 1.3)
+			public:
+				// size of a type as laid out in a block, explicit strides win over the tightly packed size
+				uint32_t GetSize(uint32_t typeId, uint32_t matrixStride = 0) const
+				{
+					const auto type = Types.find(typeId);
+					if (type == Types.end())
+					{
+						return 0;
+					}
+					const std::vector<uint32_t>& operands = type->second.Operands;
+					switch (type->second.Opcode)
+					{
+					case OpTypeInt:
+					case OpTypeFloat:
+						return operands[0] / 8;
+					case OpTypeVector:
+						return GetSize(operands[0]) * operands[1];
+					case OpTypeMatrix:
+						return (matrixStride > 0 ? matrixStride : GetSize(operands[0])) * operands[1];
+					case OpTypeArray:
+					{
+						const auto length = Constants.find(operands[1]);
+						const auto stride = ArrayStrides.find(typeId);
+						const uint32_t count = length != Constants.end() ? length->second : 0;
+						return count * (stride != ArrayStrides.end() ? stride->second : GetSize(operands[0]));
+					}
+					case OpTypeStruct:
+					{
+						uint32_t size = 0;
+						for (uint32_t member = 0; member < static_cast<uint32_t>(operands.size()); ++member)
+						{
+							const uint64_t key = (static_cast<uint64_t>(typeId) << 32) | member;
+							const auto offset = MemberOffsets.find(key);
+							const auto memberMatrixStride = MatrixStrides.find(key);
+							const uint32_t memberSize = GetSize(operands[member], memberMatrixStride != MatrixStrides.end() ? memberMatrixStride->second : 0);
+							size = std::max(size, (offset != MemberOffsets.end() ? offset->second : size) + memberSize);
+						}
+						return size;
+					}
+					default:
+						return 0;
+					}
+				}
+
+				// the descriptor a uniform / storage variable of the pointee type is bound to, count is 0 for runtime arrays
+				bool GetDescriptorType(uint32_t typeId, uint32_t storageClass, VkDescriptorType& descriptorType, uint32_t& count) const
+				{
+					auto type = Types.find(typeId);
+					count = 1;
+					if (type != Types.end() && (type->second.Opcode == OpTypeArray || type->second.Opcode == OpTypeRuntimeArray))
+					{
+						const auto length = type->second.Opcode == OpTypeArray ? Constants.find(type->second.Operands[1]) : Constants.end();
+						count = length != Constants.end() ? length->second : 0;
+						type = Types.find(type->second.Operands[0]);
+					}
+					if (type == Types.end())
+					{
+						return false;
+					}
+					const std::vector<uint32_t>& operands = type->second.Operands;
+					switch (type->second.Opcode)
+					{
+					case OpTypeSampledImage:
+						descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+						return true;
+					case OpTypeSampler:
+						descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+						return true;
+					case OpTypeImage: // (sampled type, dim, depth, arrayed, multisampled, sampled, format), sampled 2 -> read / write
+						if (operands.size() < 6)
+						{
+							return false;
+						}
+						if (operands[1] == DimSubpassData)
+						{
+							descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+						}
+						else if (operands[1] == DimBuffer)
+						{
+							descriptorType = operands[5] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+						}
+						else
+						{
+							descriptorType = operands[5] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+						}
+						return true;
+					case OpTypeStruct:
+						descriptorType = storageClass == StorageClassStorageBuffer || BufferBlocks.count(type->first) > 0 ?
+							VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+						return true;
+					default:
+						return false;
+					}
+				}
+
+				// one input per location, a matrix takes a location per column and an array one per element
+				void AddInputs(uint32_t typeId, uint32_t location, std::vector<ShaderInput>& inputs) const
+				{
+					const auto type = Types.find(typeId);
+					if (type == Types.end())
+					{
+						return;
+					}
+					const std::vector<uint32_t>& operands = type->second.Operands;
+					switch (type->second.Opcode)
+					{
+					case OpTypeMatrix:
+					case OpTypeArray:
+					{
+						const auto length = type->second.Opcode == OpTypeArray ? Constants.find(operands[1]) : Constants.end();
+						const uint32_t count = type->second.Opcode == OpTypeMatrix ? operands[1] : (length != Constants.end() ? length->second : 0);
+						for (uint32_t i = 0; i < count; ++i)
+						{
+							AddInputs(operands[0], location + i, inputs);
+						}
+						break;
+					}
+					case OpTypeVector:
+						inputs.push_back({ location, GetInputFormat(operands[0], operands[1]) });
+						break;
+					case OpTypeInt:
+					case OpTypeFloat:
+						inputs.push_back({ location, GetInputFormat(typeId, 1) });
+						break;
+					default:
+						break;
+					}
+				}
+			private:
+				VkFormat GetInputFormat(uint32_t scalarTypeId, uint32_t componentCount) const
+				{
+					static const VkFormat floatFormats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+					static const VkFormat intFormats[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+					static const VkFormat uintFormats[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+					const auto scalar = Types.find(scalarTypeId);
+					if (scalar == Types.end() || componentCount < 1 || componentCount > 4 || scalar->second.Operands.empty() || scalar->second.Operands[0] != 32)
+					{
+						return VK_FORMAT_UNDEFINED; // 64 / 16 bit inputs aren't used by the engine
+					}
+					if (scalar->second.Opcode == OpTypeFloat)
+					{
+						return floatFormats[componentCount - 1];
+					}
+					const bool isSigned = scalar->second.Operands.size() > 1 && scalar->second.Operands[1] != 0; // (width, signedness)
+					return isSigned ? intFormats[componentCount - 1] : uintFormats[componentCount - 1];
+				}
+			};
+
+			struct SpirvVariable
+			{
+				uint32_t PointerType;
+				uint32_t Id;
+				uint32_t StorageClass;
+			};
+
+			VkShaderStageFlagBits GetStageFromExecutionModel(uint32_t executionModel)
+			{
+				switch (executionModel)
+				{
+				case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+				case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+				case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+				case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+				case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+				case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+				default: return VK_SHADER_STAGE_ALL;
+				}
+			}
+		}
+
+		ShaderReflection::ShaderReflection(const uint32_t* code, size_t wordCount)
+		{
+			if (wordCount < SPIRV_HEADER_WORDS || code[0] != SPIRV_MAGIC)
+			{
+				static const std::string message = "[GraphicsSystem::ShaderReflection]: Shader code is not a SPIR-V module!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			SpirvModule module;
+			std::vector<uint32_t> pushConstantPointers; // pointer types of push constant variables
+			std::vector<SpirvVariable> variables; // resource and input variables, resolved once every type and decoration is known
+			std::unordered_map<uint32_t, uint32_t> descriptorSets;
+			std::unordered_map<uint32_t, uint32_t> bindings;
+			std::unordered_map<uint32_t, uint32_t> locations;
+			std::unordered_set<uint32_t> builtIns;
+			bool hasEntryPoint = false;
+			for (size_t word = SPIRV_HEADER_WORDS; word < wordCount;)
+			{
+				const uint32_t instructionWords = code[word] >> 16;
+				const uint32_t opcode = code[word] & 0xFFFF;
+				if (instructionWords == 0 || word + instructionWords > wordCount)
+				{
+					static const std::string message = "[GraphicsSystem::ShaderReflection]: Shader code has a truncated instruction!";
+					VK_CORE_CRITICAL(message);
+					throw std::runtime_error(message);
+				}
+				const uint32_t* operands = code + word + 1;
+				const uint32_t operandCount = instructionWords - 1;
+				switch (opcode)
+				{
+				case OpEntryPoint:
+					if (!hasEntryPoint && operandCount >= 2)
+					{
+						m_Stage = GetStageFromExecutionModel(operands[0]);
+						hasEntryPoint = true;
+					}
+					break;
+				case OpTypeInt:
+				case OpTypeFloat:
+				case OpTypeVector:
+				case OpTypeMatrix:
+				case OpTypeImage:
+				case OpTypeSampler:
+				case OpTypeSampledImage:
+				case OpTypeArray:
+				case OpTypeRuntimeArray:
+				case OpTypeStruct:
+				case OpTypePointer:
+					if (operandCount >= 1)
+					{
+						module.Types[operands[0]] = { opcode, std::vector<uint32_t>(operands + 1, operands + operandCount) };
+					}
+					break;
+				case OpConstant:
+					if (operandCount >= 3)
+					{
+						module.Constants[operands[1]] = operands[2];
+					}
+					break;
+				case OpVariable:
+					if (operandCount >= 3 && operands[2] == StorageClassPushConstant)
+					{
+						pushConstantPointers.push_back(operands[0]);
+					}
+					else if (operandCount >= 3 && (operands[2] == StorageClassUniformConstant || operands[2] == StorageClassUniform ||
+						operands[2] == StorageClassStorageBuffer || operands[2] == StorageClassInput))
+					{
+						variables.push_back({ operands[0], operands[1], operands[2] });
+					}
+					break;
+				case OpDecorate:
+					if (operandCount >= 2 && operands[1] == DecorationBufferBlock)
+					{
+						module.BufferBlocks.insert(operands[0]);
+					}
+					else if (operandCount >= 2 && operands[1] == DecorationBuiltIn)
+					{
+						builtIns.insert(operands[0]);
+					}
+					else if (operandCount >= 3)
+					{
+						switch (operands[1])
+						{
+						case DecorationArrayStride: module.ArrayStrides[operands[0]] = operands[2]; break;
+						case DecorationDescriptorSet: descriptorSets[operands[0]] = operands[2]; break;
+						case DecorationBinding: bindings[operands[0]] = operands[2]; break;
+						case DecorationLocation: locations[operands[0]] = operands[2]; break;
+						default: break;
+						}
+					}
+					break;
+				case OpMemberDecorate:
+					if (operandCount >= 4)
+					{
+						const uint64_t key = (static_cast<uint64_t>(operands[0]) << 32) | operands[1];
+						if (operands[2] == DecorationOffset)
+						{
+							module.MemberOffsets[key] = operands[3];
+						}
+						else if (operands[2] == DecorationMatrixStride)
+						{
+							module.MatrixStrides[key] = operands[3];
+						}
+					}
+					break;
+				default:
+					break;
+				}
+				word += instructionWords;
+			}
+			// a stage has at most one push constant block, its variable points to the block's struct
+			for (const uint32_t pointerId : pushConstantPointers)
+			{
+				const auto pointer = module.Types.find(pointerId);
+				if (pointer != module.Types.end() && pointer->second.Opcode == OpTypePointer && pointer->second.Operands.size() >= 2)
+				{
+					m_PushConstantSize = std::max(m_PushConstantSize, module.GetSize(pointer->second.Operands[1]));
+				}
+			}
+			for (const SpirvVariable& variable : variables)
+			{
+				const auto pointer = module.Types.find(variable.PointerType);
+				if (pointer == module.Types.end() || pointer->second.Opcode != OpTypePointer || pointer->second.Operands.size() < 2)
+				{
+					continue;
+				}
+				const uint32_t pointeeType = pointer->second.Operands[1];
+				if (variable.StorageClass == StorageClassInput)
+				{
+					// fragment / compute inputs come from earlier stages or built-ins, not vertex attributes
+					const auto location = locations.find(variable.Id);
+					if (m_Stage == VK_SHADER_STAGE_VERTEX_BIT && location != locations.end() && builtIns.count(variable.Id) == 0)
+					{
+						module.AddInputs(pointeeType, location->second, m_Inputs);
+					}
+					continue;
+				}
+				ShaderBinding binding;
+				if (!module.GetDescriptorType(pointeeType, variable.StorageClass, binding.Type, binding.Count))
+				{
+					continue;
+				}
+				const auto set = descriptorSets.find(variable.Id);
+				const auto bindingIndex = bindings.find(variable.Id);
+				binding.Set = set != descriptorSets.end() ? set->second : 0;
+				binding.Binding = bindingIndex != bindings.end() ? bindingIndex->second : 0;
+				m_Bindings.push_back(binding);
+			}
+			std::sort(m_Bindings.begin(), m_Bindings.end(), [](const ShaderBinding& a, const ShaderBinding& b)
+			{
+				return a.Set != b.Set ? a.Set < b.Set : a.Binding < b.Binding;
+			});
+			std::sort(m_Inputs.begin(), m_Inputs.end(), [](const ShaderInput& a, const ShaderInput& b) { return a.Location < b.Location; });
+		}
+	}
+}
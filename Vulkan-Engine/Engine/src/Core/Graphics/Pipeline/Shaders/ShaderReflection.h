@@ -0,0 +1,63 @@
+/***************************************************************************
+ * Filename		: ShaderReflection.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Reads the interface of a SPIR-V module (stage, descriptor bindings,
+ *				  push constant block and vertex inputs), pipeline layouts are derived from it.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		struct ShaderBinding
+		{
+			uint32_t Set = 0;
+			uint32_t Binding = 0;
+			VkDescriptorType Type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; // SPIR-V can't tell dynamic buffers apart, they reflect as the plain type
+			uint32_t Count = 1; // array length, 0 for a runtime sized array (descriptor indexing)
+		};
+
+		struct ShaderInput
+		{
+			uint32_t Location = 0;
+			VkFormat Format = VK_FORMAT_UNDEFINED; // 32 bit components, a matrix or array takes one location per column / element
+		};
+
+		// walks the module's instructions once, only the types and decorations the interface needs are kept.
+		// Throws on anything that isn't a SPIR-V module.
+		class ShaderReflection
+		{
+		public:
+			ShaderReflection() = default;
+			ShaderReflection(const uint32_t* code, size_t wordCount);
+			~ShaderReflection() = default;
+		public:
+			_NODISCARD VkShaderStageFlagBits GetStage() const { return m_Stage; } // of the first entry point
+			_NODISCARD uint32_t GetPushConstantSize() const { return m_PushConstantSize; } // bytes up to the end of the last member, 0 without a block
+			_NODISCARD bool HasPushConstants() const { return m_PushConstantSize > 0; }
+			_NODISCARD const std::vector<ShaderBinding>& GetBindings() const { return m_Bindings; } // ordered by set, then binding
+			_NODISCARD const std::vector<ShaderInput>& GetInputs() const { return m_Inputs; } // vertex stage only, built-ins excluded, ordered by location
+		private:
+			VkShaderStageFlagBits m_Stage = VK_SHADER_STAGE_ALL;
+			uint32_t m_PushConstantSize = 0;
+			std::vector<ShaderBinding> m_Bindings;
+			std::vector<ShaderInput> m_Inputs;
+		};
+	}
+}
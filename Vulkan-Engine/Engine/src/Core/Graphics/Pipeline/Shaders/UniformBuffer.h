@@ -30,5 +30,13 @@ namespace Vulkan_Engine
 			UniformBuffer() = default;
 			~UniformBuffer() = default;
 		};
+
+		// push_constant block of Shader.vert, pushed with every draw of the classic pipeline
+		struct DrawPushConstants
+		{
+			glm::mat4 Model;
+		};
+
+		static_assert(sizeof(DrawPushConstants) <= 128, "128 bytes is the smallest maxPushConstantsSize a device may report");
 	}
 }
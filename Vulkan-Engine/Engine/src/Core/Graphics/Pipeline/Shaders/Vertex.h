@@ -4,72 +4,81 @@
 #include <glm/gtx/hash.hpp>
 #include <glm/glm.hpp>
 
-#include <vulkan/vulkan.h>
-
-#include <array>
+#include "VertexLayout.h"
 
 namespace Vulkan_Engine
 {
 	namespace Graphics
 	{
+		// full precision vertex, used by the importer / mesh processing and kept in the binary mesh files
 		struct Vertex
 		{
-			//TODO: Change the format type depending on size of types in struct
-			glm::vec3 Position; 
+			glm::vec3 Position;
 			glm::vec3 Color;
 			glm::vec2 TexCoord;
 
-			// describes at which rate to load data from memory throughout the vertices
-			// specifies the number of bytes between data entries, and whether to move
-			// to the next data entry after each vertex or after each instance
-			static VkVertexInputBindingDescription GetBindingDescription()
+			bool operator==(const Vertex& other) const
 			{
-				VkVertexInputBindingDescription bindingDescription = {};
-				bindingDescription.binding = 0; // index of this binding description in the array of bindings 
-				bindingDescription.stride = sizeof(Vertex); // number of bytes from one entry to the next
-				bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX; // vertex || instance 
-				return bindingDescription;
+				return Position == other.Position && Color == other.Color && TexCoord == other.TexCoord;
 			}
+		};
 
-			// two of these structures used (as using 2 attributes, POSITION & COLOR)
-			// describes how to extract vertex attributes from a chunk of vertex data originating from a binding description.
-			static std::array<VkVertexInputAttributeDescription, 3> GetAttributeDescriptions()
-			{
-				std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = {};
+		// 16 byte vertex buffer format (half of Vertex), converted from Vertex by VertexQuantization on upload.
+		// positions are relative to the mesh bounds: Position * scale + bias, with the scale / bias folded into the model matrix,
+		// so the same shader inputs (vec3 / vec3 / vec2) read both formats
+		struct QuantizedVertex
+		{
+			Snorm16x4 Position; // w unused
+			Unorm8x4 Color; // a unused
+			Half2 TexCoord;
+		};
 
-				// position attribute per-vertex description
-				attributeDescriptions[0].binding = 0; // which binding the per vertex data comes from (binding 0 above)
-				attributeDescriptions[0].location = 0; // location derivative of the input in the vertex shader (location = 0 in shader)
-				// float: VK_FORMAT_R32_SFLOAT
-				// vec2 : VK_FORMAT_R32G32_SFLOAT
-				// vec3 : VK_FORMAT_R32G32B32_SFLOAT
-				// vec4 : VK_FORMAT_R32G32B32A32_SFLOAT
-				//todo: note, match the bit width
-				// ivec2  : VK_FORMAT_R32G32_SINT,       a 2-component vector of 32-bit signed integers
-				// uvec4  : VK_FORMAT_R32G32B32A32_UINT, a 4 - component vector of 32 - bit unsigned integers
-				// double : VK_FORMAT_R64_SFLOAT,        a double - precision(64 - bit) float
-				attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT; // byte size of attribute data 
-				attributeDescriptions[0].offset = offsetof(Vertex, Position); // number of bytes since start of per-vertex data to read from
+		// per instance input (second binding, VK_VERTEX_INPUT_RATE_INSTANCE), locations follow the vertex attributes.
+		// Transform already contains the mesh's vertex dequantization, so instances of different meshes can share a buffer
+		struct InstanceData
+		{
+			glm::mat4 Transform; // one vec4 attribute per column
+			uint32_t MaterialId;
+			uint32_t Padding[3]; // keeps the transforms of consecutive instances 16 byte aligned
+		};
 
-				// color attribute per-vertex description
-				attributeDescriptions[1].binding = 0;
-				attributeDescriptions[1].location = 1;
-				attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-				attributeDescriptions[1].offset = offsetof(Vertex, Color);
+		template<> struct VertexAttributes<Vertex>
+		{
+			static constexpr std::array<VertexAttribute, 3> Attributes =
+			{
+				VK_VERTEX_ATTRIBUTE(Vertex, Position, 0),
+				VK_VERTEX_ATTRIBUTE(Vertex, Color, 1),
+				VK_VERTEX_ATTRIBUTE(Vertex, TexCoord, 2)
+			};
+		};
 
-				attributeDescriptions[2].binding = 0;
-				attributeDescriptions[2].location = 2;
-				attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-				attributeDescriptions[2].offset = offsetof(Vertex, TexCoord);
-				
-				return attributeDescriptions;
-			}
+		template<> struct VertexAttributes<QuantizedVertex>
+		{
+			static constexpr std::array<VertexAttribute, 3> Attributes =
+			{
+				VK_VERTEX_ATTRIBUTE(QuantizedVertex, Position, 0),
+				VK_VERTEX_ATTRIBUTE(QuantizedVertex, Color, 1),
+				VK_VERTEX_ATTRIBUTE(QuantizedVertex, TexCoord, 2)
+			};
+		};
 
-			bool operator==(const Vertex& other) const
+		template<> struct VertexAttributes<InstanceData>
+		{
+			static constexpr std::array<VertexAttribute, 5> Attributes =
 			{
-				return Position == other.Position && Color == other.Color && TexCoord == other.TexCoord;
-			}
+				MakeVertexAttribute<glm::vec4>(3, offsetof(InstanceData, Transform)),
+				MakeVertexAttribute<glm::vec4>(4, offsetof(InstanceData, Transform) + sizeof(glm::vec4)),
+				MakeVertexAttribute<glm::vec4>(5, offsetof(InstanceData, Transform) + 2 * sizeof(glm::vec4)),
+				MakeVertexAttribute<glm::vec4>(6, offsetof(InstanceData, Transform) + 3 * sizeof(glm::vec4)),
+				VK_VERTEX_ATTRIBUTE(InstanceData, MaterialId, 7)
+			};
 		};
+
+		static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex is expected to be tightly packed");
+		static_assert(sizeof(InstanceData) == 80, "InstanceData is expected to be tightly packed");
+		static_assert(VertexLayout<Vertex>::IsValid(), "invalid Vertex layout");
+		static_assert(VertexLayout<QuantizedVertex>::IsValid(), "invalid QuantizedVertex layout");
+		static_assert(VertexLayout<InstanceData>::IsValid(), "invalid InstanceData layout");
 	}
 }
 
@@ -80,9 +89,9 @@ namespace std
 	{
 		size_t operator()(Vulkan_Engine::Graphics::Vertex const& vertex) const
 		{
-			return ((hash<glm::vec3>()(vertex.Position) 
+			return ((hash<glm::vec3>()(vertex.Position)
 				^ (hash<glm::vec3>()(vertex.Color) << 1)) >> 1)
 				^ (hash<glm::vec2>()(vertex.TexCoord) << 1);
 		}
 	};
-}
\ No newline at end of file
+}
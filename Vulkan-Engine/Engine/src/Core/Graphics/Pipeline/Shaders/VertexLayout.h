@@ -0,0 +1,120 @@
+/***************************************************************************
+ * Filename		: VertexLayout.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Compile time vertex layout descriptions, generates the
+ *				  vulkan binding / attribute descriptions of a vertex type.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// packed attribute storage types, the matching VkFormat does the decoding in the vertex fetch.
+		// 3 component 8 / 16 bit formats aren't guaranteed to support VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT, so those are padded to 4
+		struct Half2 { uint16_t X, Y; }; // VK_FORMAT_R16G16_SFLOAT
+		struct Snorm16x4 { int16_t X, Y, Z, W; }; // VK_FORMAT_R16G16B16A16_SNORM, decoded as max(c / 32767, -1)
+		struct Unorm8x4 { uint8_t X, Y, Z, W; }; // VK_FORMAT_R8G8B8A8_UNORM, decoded as c / 255
+		struct OctNormal16 { int16_t X, Y; }; // VK_FORMAT_R16G16_SNORM, octahedral encoded unit vector (decoded in the shader)
+
+		// storage type -> vulkan format, unsupported attribute types fail to compile
+		template<typename T> struct VertexAttributeFormat;
+		template<> struct VertexAttributeFormat<float> { static constexpr VkFormat Format = VK_FORMAT_R32_SFLOAT; };
+		template<> struct VertexAttributeFormat<uint32_t> { static constexpr VkFormat Format = VK_FORMAT_R32_UINT; };
+		template<> struct VertexAttributeFormat<glm::vec2> { static constexpr VkFormat Format = VK_FORMAT_R32G32_SFLOAT; };
+		template<> struct VertexAttributeFormat<glm::vec3> { static constexpr VkFormat Format = VK_FORMAT_R32G32B32_SFLOAT; };
+		template<> struct VertexAttributeFormat<glm::vec4> { static constexpr VkFormat Format = VK_FORMAT_R32G32B32A32_SFLOAT; };
+		template<> struct VertexAttributeFormat<Half2> { static constexpr VkFormat Format = VK_FORMAT_R16G16_SFLOAT; };
+		template<> struct VertexAttributeFormat<Snorm16x4> { static constexpr VkFormat Format = VK_FORMAT_R16G16B16A16_SNORM; };
+		template<> struct VertexAttributeFormat<Unorm8x4> { static constexpr VkFormat Format = VK_FORMAT_R8G8B8A8_UNORM; };
+		template<> struct VertexAttributeFormat<OctNormal16> { static constexpr VkFormat Format = VK_FORMAT_R16G16_SNORM; };
+
+		struct VertexAttribute
+		{
+			uint32_t Location; // layout(location = N) in the vertex shader
+			VkFormat Format;
+			uint32_t Offset; // bytes from the start of the vertex
+			uint32_t Size;
+		};
+
+		template<typename T>
+		constexpr VertexAttribute MakeVertexAttribute(uint32_t location, size_t offset)
+		{
+			return { location, VertexAttributeFormat<T>::Format, static_cast<uint32_t>(offset), static_cast<uint32_t>(sizeof(T)) };
+		}
+
+		// specialized for every vertex type (after its definition, offsetof needs a complete type):
+		// template<> struct VertexAttributes<MyVertex> { static constexpr std::array<VertexAttribute, N> Attributes = { VK_VERTEX_ATTRIBUTE(MyVertex, Member, 0), ... }; };
+		template<typename TVertex> struct VertexAttributes;
+
+		template<typename TVertex>
+		class VertexLayout
+		{
+		public:
+			static constexpr size_t s_AttributeCount = VertexAttributes<TVertex>::Attributes.size();
+
+			// describes at which rate to load data from memory, the number of bytes between data entries
+			// and whether to move to the next data entry after each vertex or after each instance
+			static constexpr VkVertexInputBindingDescription GetBindingDescription(uint32_t binding = 0, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX)
+			{
+				return { binding, static_cast<uint32_t>(sizeof(TVertex)), inputRate };
+			}
+
+			// describes how to extract every attribute from a chunk of vertex data originating from the binding above
+			static constexpr std::array<VkVertexInputAttributeDescription, s_AttributeCount> GetAttributeDescriptions(uint32_t binding = 0)
+			{
+				std::array<VkVertexInputAttributeDescription, s_AttributeCount> attributeDescriptions = {};
+				for (size_t i = 0; i < s_AttributeCount; ++i)
+				{
+					const VertexAttribute& attribute = VertexAttributes<TVertex>::Attributes[i];
+					attributeDescriptions[i].location = attribute.Location;
+					attributeDescriptions[i].binding = binding;
+					attributeDescriptions[i].format = attribute.Format;
+					attributeDescriptions[i].offset = attribute.Offset;
+				}
+				return attributeDescriptions;
+			}
+
+			// every attribute inside the stride, no two attributes sharing a location or overlapping
+			static constexpr bool IsValid()
+			{
+				const auto& attributes = VertexAttributes<TVertex>::Attributes;
+				for (size_t i = 0; i < s_AttributeCount; ++i)
+				{
+					if (attributes[i].Offset + attributes[i].Size > sizeof(TVertex))
+					{
+						return false;
+					}
+					for (size_t j = i + 1; j < s_AttributeCount; ++j)
+					{
+						const bool overlapping = attributes[i].Offset < attributes[j].Offset + attributes[j].Size && attributes[j].Offset < attributes[i].Offset + attributes[i].Size;
+						if (attributes[i].Location == attributes[j].Location || overlapping)
+						{
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#define VK_VERTEX_ATTRIBUTE(VertexType, Member, Location) ::Vulkan_Engine::Graphics::MakeVertexAttribute<decltype(VertexType::Member)>(Location, offsetof(VertexType, Member))
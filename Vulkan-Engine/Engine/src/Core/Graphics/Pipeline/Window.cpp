@@ -18,6 +18,10 @@
 #include "Core/Timers/Timestep.h"
 #include "Core/Events/ApplicationEvent.h"
 #include "Core/Graphics/Utility/VulkanUtility.h"
+#include "Core/Graphics/Mesh/LodSelector.h"
+#include "Core/Graphics/Mesh/VertexQuantization.h"
+#include "Core/Graphics/Culling/Frustum.h"
+#include "Core/Jobs/JobSystem.h"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -25,12 +29,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <chrono>
+#include <filesystem>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
 
 #define ROTATION_MULTIPLIER 1.f
 
@@ -39,14 +42,39 @@ const int WIDTH = 800;
 const int HEIGHT = 600;
 
 const std::string MODEL_PATH = "../Resources/Models/chalet.obj";
+const std::string MODEL_CACHE_PATH = "../Resources/Cache/chalet.vkmesh"; // binary mesh converted from MODEL_PATH on first load
 const std::string TEXTURE_PATH = "../Resources/Textures/chalet.jpg";
+const std::string PIPELINE_CACHE_PATH = "../Resources/Cache/PipelineCache.bin";
+
+const glm::vec3 CAMERA_POSITION = glm::vec3(2.0f, 2.0f, 2.0f);
+const float CAMERA_FOV_Y = glm::radians(45.0f);
+const uint32_t MAX_INDIRECT_DRAWS = 4096; // indirect draw records per frame in flight
+const uint32_t GEOMETRY_VERTEX_CAPACITY = 1u << 20; // vertices of every mesh loaded at once, the shared vertex buffer doesn't grow
+const uint32_t GEOMETRY_INDEX_CAPACITY = 1u << 22; // indices of every mesh loaded at once, levels of detail included
+#if INSTANCED_RENDERING
+const std::string INSTANCED_VERTEX_SHADER_PATH = "../Resources/Shaders/SPV/Instanced.spv";
+const uint32_t MAX_INSTANCES = 16384; // instance buffer entries per frame in flight
+#endif
+#if BINDLESS_DESCRIPTORS
+const std::string BINDLESS_FRAGMENT_SHADER_PATH = "../Resources/Shaders/SPV/Bindless.spv";
+const uint32_t MAX_BINDLESS_TEXTURES = 4096; // size of the texture array, lowered to the device's limits
+const uint32_t MAX_MATERIALS = 4096; // entries of the material buffer
+#endif
 
 const int MAX_FRAMES_IN_FLIGHT = 2; // number of frames that should be processed concurrently 
+const VkDeviceSize UNIFORM_FRAME_SIZE = 256 * 1024; // bytes of uniform blocks per frame in flight
+const uint32_t RECORD_TIMING_FRAMES = 1000; // number of frames the command recording time is averaged over before logging
 
 namespace Vulkan_Engine
 {
 	namespace Graphics
 	{
+#if QUANTIZE_VERTICES
+		using BufferVertex = QuantizedVertex; // vertex format in the vertex buffer
+#else
+		using BufferVertex = Vertex;
+#endif
+
 		Window::Window()
 		{
 			InitWindow();
@@ -67,24 +95,45 @@ namespace Vulkan_Engine
 			vkDeviceWaitIdle(m_LogicalDevice); // wait for operations in a specific command queue to be finished
 			
 			CleanupSwapChain();
+			vkDestroySwapchainKHR(m_LogicalDevice, m_SwapChain, nullptr);
+			for (RetiredSwapChain& retired : m_RetiredSwapChains)
+			{
+				DestroyRetiredSwapChain(retired); // the device is idle
+			}
+			m_RetiredSwapChains.clear();
+			vkDestroyPipeline(m_LogicalDevice, m_GraphicsPipeline, nullptr); // destroy the graphics pipeline 
+			vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr); // pipeline layout  (data passed to shaders)
+			vkDestroyRenderPass(m_LogicalDevice, m_RenderPass, nullptr); // destroy the render pass 
 
 			vkDestroySampler(m_LogicalDevice, m_TextureSampler, nullptr); // destroy texture sampler
 			vkDestroyImageView(m_LogicalDevice, m_TextureImageView, nullptr); // destroy image views
 			vkDestroyImage(m_LogicalDevice, m_TextureImage, nullptr); // destroy image 
-			vkFreeMemory(m_LogicalDevice, m_TextureImageMemory, nullptr); // destroy image memory 
+			m_MemoryAllocator->Free(m_TextureImageAllocation); // release image memory 
 			
-			vkDestroyDescriptorSetLayout(m_LogicalDevice, m_DescriptorSetLayout, nullptr); // clean up descriptor binding sets
-			vkDestroyBuffer(m_LogicalDevice, m_IndexBuffer, nullptr); // destroy index buffer
-			vkFreeMemory(m_LogicalDevice, m_IndexBufferMemory, nullptr); // free memory assigned to index buffer 
-			vkDestroyBuffer(m_LogicalDevice, m_VertexBuffer, nullptr); // destroy the vertex buffer
-			vkFreeMemory(m_LogicalDevice, m_VertexBufferMemory, nullptr); // free the memory assigned to the buffer 			
+			m_GpuCuller.reset(); // destroy the culling pipelines, buffers and depth pyramid
+			m_IndirectDraws.reset(); // destroy the indirect draw records
+			m_InstanceBuffer.reset(); // destroy the per instance vertex data
+			m_UniformBuffer.reset(); // destroy the uniform arena
+			m_BindlessDescriptors.reset(); // destroy the texture / material set and the material buffer
+			m_DescriptorAllocator->LogStatistics();
+			m_DescriptorAllocator.reset(); // destroys every descriptor pool, which frees the sets
+			m_DescriptorLayoutCache.reset(); // destroys every descriptor set layout
+			m_GeometryPool->LogStatistics();
+			m_GeometryPool.reset(); // destroy the shared vertex and index buffers
 			for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
 			{
 				vkDestroySemaphore(m_LogicalDevice, m_RenderFinishedSemaphores[i], nullptr); // clean up render semaphore
 				vkDestroySemaphore(m_LogicalDevice, m_ImageAvailableSemaphores[i], nullptr); // clean up image semaphore 
 				vkDestroyFence(m_LogicalDevice, m_InFlightFences[i], nullptr); // clean up fences 
 			}
-			vkDestroyCommandPool(m_LogicalDevice, m_CommandPool, nullptr); // destroy the command pool 			
+			m_PipelineCache->Save(); // every pipeline created this run is in the cache now
+			m_PipelineCache.reset();
+			m_ShaderLibrary.reset(); // destroy the cached shader modules
+			m_CommandRecorder.reset(); // joins the recording threads and destroys their pools
+			m_FrameCommandPools.clear(); // destroy the per frame command pools
+			m_UploadContext.reset(); // releases the staging ring (before the allocator it was allocated from)
+			m_MemoryAllocator->LogStatistics();
+			m_MemoryAllocator.reset(); // releases every memory block (must happen before the device is destroyed)
 			vkDestroyDevice(m_LogicalDevice, nullptr); // clean logical device 
 			if (s_EnableValidationLayers) 
 			{
@@ -170,12 +219,27 @@ namespace Vulkan_Engine
 			CreateVulkanWindowSurface();
 			InitVulkanPhysicalDevice();
 			InitVulkanLogicalDevice();
+			CreateMemoryAllocator();
+			CreateUploadContext();
+			CreatePipelineCache();
+			CreateShaderLibrary();
 			CreateVulkanSwapChain();
 			CreateVulkanImageViews();
 			CreateGraphicsRenderPass();
+			CreateDescriptorAllocator(); // layout cache and the pools every descriptor set comes from
 			CreateDescriptorSetLayout(); // create descriptor set layouts 
+#if INSTANCED_RENDERING
+			m_InstancedRendering = std::filesystem::exists(INSTANCED_VERTEX_SHADER_PATH);
+			if (!m_InstancedRendering)
+			{
+				VK_CORE_WARN("[GraphicsSystem::Window::InitVulkan]: Instanced vertex shader is missing (run Compile_GLSL_to_SPV), drawing one record per object");
+			}
+#endif
+#if BINDLESS_DESCRIPTORS
+			CreateBindlessDescriptors(); // the pipeline layout includes its set
+#endif
 			CreateGraphicsPipeline();
-			CreateCommandPool();
+			CreateFrameCommandPools();
 			CreateColorResources();
 			CreateDepthResources();
 			CreateFramebuffers();
@@ -185,12 +249,16 @@ namespace Vulkan_Engine
 #if LOAD_MODEL
 			LoadModel();
 #endif
-			CreateVertexBuffer(); // vertex buffer creation
-			CreateIndexBuffer(); // index buffer creation
+			CreateGeometry(); // geometry pool and the mesh's vertex / index uploads
+#if GPU_CULLING
+			CreateGpuCulling();
+#endif
+			m_UploadContext->Submit(); // texture, vertex and index uploads go to the gpu in a single submission
+#if LOAD_MODEL
+			m_Mesh.reset(); // the mesh data has been copied to staging, unmap the file
+#endif
 			CreateUniformBuffers(); // uniform buffer creation
-			CreateDescriptorPool();
 			CreateDescriptorSets();
-			CreateCommandBuffers();
 			////////////////////
 			CreateSyncObjects(); 
 		}
@@ -293,6 +361,10 @@ namespace Vulkan_Engine
 			{
 				extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);  // add debugging utility extension
 			}
+			if (IsInstanceExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME))
+			{
+				extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME); // required by the timeline semaphore device extension
+			}
 			// Extension existence implied by availability of validation layers...
 			VK_CORE_TRACE("[Graphics System::Window::CreateVulkanInstance]: ALL Required Extensions List:"); 
 			for (uint32_t i = 0; i < extensions.size(); i++)
@@ -344,7 +416,8 @@ namespace Vulkan_Engine
 
 			// specify the queues to be created (we require multiple of these to create a queue for each family)
 			std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-			std::set<uint32_t> uniqueQueueFamilies = { indices.GraphicsFamily.value(), indices.PresentFamily.value() };
+			// transfer & compute fall back to the graphics family, so they only add a queue when the device has a dedicated family
+			std::set<uint32_t> uniqueQueueFamilies = { indices.GraphicsFamily.value(), indices.PresentFamily.value(), indices.GetTransferFamily(), indices.GetComputeFamily() };
 			static const float queuePriority = 1.0f;
 			for (uint32_t queueFamily : uniqueQueueFamilies) // for all family queues 
 			{
@@ -357,19 +430,65 @@ namespace Vulkan_Engine
 			}
 			
 			// specify features of device being used
+			VkPhysicalDeviceFeatures supportedFeatures;
+			vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
 			VkPhysicalDeviceFeatures deviceFeatures = {}; //TODO: Come back to this
 			deviceFeatures.samplerAnisotropy = VK_TRUE; // request anisotropic filtering to be enabled 
 			deviceFeatures.sampleRateShading = VK_TRUE; //TODO: Toggle me -> assists in smoothing aliasing inside geometry
+			deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect; // many indirect draws in one call (optional, one call per draw otherwise)
+			deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance; // indirect records starting past instance 0 (optional, instanced batches are drawn directly otherwise)
 			
+			// timeline semaphores track upload completion with a single counter instead of a fence per batch (optional)
+			std::vector<const char*> deviceExtensions = s_DeviceExtensions;
+			VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = {};
+			timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+			timelineFeatures.timelineSemaphore = VK_TRUE;
+			m_TimelineSemaphoresEnabled = IsInstanceExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) 
+				&& IsDeviceExtensionAvailable(m_PhysicalDevice, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+			if (m_TimelineSemaphoresEnabled)
+			{
+				deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+			}
+			// the gpu reads the indirect draw count from a buffer (optional, the cpu side count is used otherwise)
+			const bool drawIndirectCountEnabled = IsDeviceExtensionAvailable(m_PhysicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+			if (drawIndirectCountEnabled)
+			{
+				deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+			}
+#if BINDLESS_DESCRIPTORS
+			// textures and materials indexed from one update after bind set (optional, the classic per draw set otherwise)
+			VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+			indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+			indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			m_MaxBindlessTextures = MAX_BINDLESS_TEXTURES;
+			m_DescriptorIndexingEnabled = BindlessDescriptors::IsSupported(m_VkInstance, m_PhysicalDevice, m_MaxBindlessTextures);
+			if (m_DescriptorIndexingEnabled)
+			{
+				deviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+				deviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+				indexingFeatures.pNext = m_TimelineSemaphoresEnabled ? &timelineFeatures : nullptr;
+			}
+#endif
+
 			// create the logical device info
 			VkDeviceCreateInfo createInfo = {};
 			createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+			createInfo.pNext = m_TimelineSemaphoresEnabled ? &timelineFeatures : nullptr;
+#if BINDLESS_DESCRIPTORS
+			if (m_DescriptorIndexingEnabled)
+			{
+				createInfo.pNext = &indexingFeatures; // followed by the timeline features
+			}
+#endif
 			createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 			createInfo.pQueueCreateInfos = queueCreateInfos.data();
 			createInfo.pEnabledFeatures = &deviceFeatures;
 			// setup swap chain extensions
-			createInfo.enabledExtensionCount = s_DeviceExtensions.size();
-			createInfo.ppEnabledExtensionNames = s_DeviceExtensions.data();
+			createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+			createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
 			if (s_EnableValidationLayers) 
 			{
@@ -389,8 +508,55 @@ namespace Vulkan_Engine
 				VK_CORE_CRITICAL(message);
 				throw std::runtime_error(message);
 			}
+			const PFN_vkCmdDrawIndexedIndirectCountKHR drawIndexedIndirectCount = drawIndirectCountEnabled ?
+				reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(vkGetDeviceProcAddr(m_LogicalDevice, "vkCmdDrawIndexedIndirectCountKHR")) : nullptr;
+			m_DrawList.SetIndirectSupport(deviceFeatures.multiDrawIndirect == VK_TRUE, drawIndexedIndirectCount);
+			m_DrawIndirectFirstInstance = deviceFeatures.drawIndirectFirstInstance == VK_TRUE;
+			VK_CORE_INFO("[GraphicsSystem::Window::InitVulkanLogicalDevice]: Indirect draws -> multi draw {0}, draw count {1}, first instance {2}",
+				deviceFeatures.multiDrawIndirect == VK_TRUE, drawIndexedIndirectCount != nullptr, m_DrawIndirectFirstInstance);
 			vkGetDeviceQueue(m_LogicalDevice, indices.GraphicsFamily.value(), 0, &m_GraphicsQueueHandle);
 			vkGetDeviceQueue(m_LogicalDevice, indices.PresentFamily.value(), 0, &m_PresentQueueHandle);
+			vkGetDeviceQueue(m_LogicalDevice, indices.GetTransferFamily(), 0, &m_TransferQueueHandle); // graphics queue if no dedicated transfer family
+			vkGetDeviceQueue(m_LogicalDevice, indices.GetComputeFamily(), 0, &m_ComputeQueueHandle);
+			VK_CORE_INFO("[GraphicsSystem::Window::InitVulkanLogicalDevice]: Queue families -> graphics {0}, present {1}, transfer {2}, compute {3}",
+				indices.GraphicsFamily.value(), indices.PresentFamily.value(), indices.GetTransferFamily(), indices.GetComputeFamily());
+		}
+
+		void Window::CreateMemoryAllocator()
+		{
+			// every buffer & image is placed in a large block instead of owning a VkDeviceMemory,
+			// which keeps us far below maxMemoryAllocationCount and avoids a driver call per resource
+			VkPhysicalDeviceMemoryProperties memProperties;
+			vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memProperties);
+			m_MemoryAllocator = CreateScope<DeviceMemoryAllocator>(m_LogicalDevice, memProperties);
+		}
+
+		void Window::CreateUploadContext()
+		{
+			// static data is copied through one persistently mapped staging ring and submitted in batches,
+			// rather than creating a staging buffer and waiting for the queue to idle for every resource.
+			// copies run on the dedicated transfer queue when there is one, so streaming does not compete with rendering
+			const QueueFamilyIndices indices = FindQueueFamilies(m_PhysicalDevice, m_WindowSurface);
+			UploadQueueInfo queues;
+			queues.TransferQueue = m_TransferQueueHandle;
+			queues.TransferFamily = indices.GetTransferFamily();
+			queues.GraphicsQueue = m_GraphicsQueueHandle;
+			queues.GraphicsFamily = indices.GraphicsFamily.value();
+			queues.TimelineSemaphores = m_TimelineSemaphoresEnabled;
+			m_UploadContext = CreateScope<UploadContext>(m_LogicalDevice, *m_MemoryAllocator, queues);
+		}
+
+		void Window::CreatePipelineCache()
+		{
+			// the data of the previous run is reused as long as it was written by this device and driver,
+			// so pipelines (also the ones rebuilt when the swap chain is recreated) skip most of the shader compilation
+			m_PipelineCache = CreateScope<PipelineCache>(m_LogicalDevice, m_PhysicalDevice, PIPELINE_CACHE_PATH);
+		}
+
+		void Window::CreateShaderLibrary()
+		{
+			// CreateGraphicsPipeline runs again on every resize, the modules are created on the first call only
+			m_ShaderLibrary = CreateScope<ShaderLibrary>(m_LogicalDevice);
 		}
 
 		void Window::CreateVulkanSwapChain()
@@ -452,7 +618,10 @@ namespace Vulkan_Engine
 			createInfo.clipped = VK_TRUE; // do we care about the color of pixels that are obscured? (other windows infront?) (only turn off when need predictability)
 
 			// 
-			createInfo.oldSwapchain = VK_NULL_HANDLE; //TODO: Come back to this when dealing with swapchain recreations (when swapchains become invalid)
+			// when recreating, the old swap chain is handed over so the presentation engine can reuse its resources
+			// and keep presenting until the new one is used, RecreateSwapChain keeps it in the retire list until its frames have finished.
+			const VkSwapchainKHR oldSwapChain = m_SwapChain;
+			createInfo.oldSwapchain = oldSwapChain; // VK_NULL_HANDLE on first creation
 			if (vkCreateSwapchainKHR(m_LogicalDevice, &createInfo, nullptr, &m_SwapChain) != VK_SUCCESS) 
 			{
 				static const std::string message = "[GraphicsSystem::Window::CreateVulkanSwapChain]: Failed to create swap chain!";
@@ -561,7 +730,11 @@ namespace Vulkan_Engine
 			depthAttachment.format = FindDepthFormat(m_PhysicalDevice);
 			depthAttachment.samples = m_MsaaSamples;
 			depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+#if GPU_CULLING
+			depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // reduced into the depth pyramid after the pass
+#else
 			depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+#endif
 			depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 			depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 			depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -598,10 +771,11 @@ namespace Vulkan_Engine
 			dependency.srcSubpass = VK_SUBPASS_EXTERNAL; // indices of dependency  (external -> implciit subpass before (or after in dstSubpass) render pass)
 			dependency.dstSubpass = 0; // index 0 is the subpass created above, which is the only existing subpass currently (must always be higher than srcSubpass to prevent cycles in dependency graphh)
 			// operations to wait on & stages in which these operations occur 
-			dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
 			dependency.srcAccessMask = 0;
-			dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT; // wait on reading writing of color attachments
+			dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+			// wait on reading writing of color attachments, and the depth clear on the previous frame's depth reads
+			dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 			
 			std::array<VkAttachmentDescription, 3> attachments = { colorAttachment, depthAttachment, colorAttachmentResolve };
 
@@ -625,9 +799,34 @@ namespace Vulkan_Engine
 
 		void Window::CreateGraphicsPipeline()
 		{
-			//TODO: Maybe something like this? Shader::SetActiveLogicalDevice(m_LogicalDevice); 
-			const Shader vertexShader("../Resources/Shaders/SPV/Vert.spv", &m_LogicalDevice);
-			const Shader fragmentShader("../Resources/Shaders/SPV/Frag.spv", &m_LogicalDevice);
+#if INSTANCED_RENDERING
+			const Shader& vertexShader = m_ShaderLibrary->Load(m_InstancedRendering ? INSTANCED_VERTEX_SHADER_PATH : "../Resources/Shaders/SPV/Vert.spv");
+#else
+			const Shader& vertexShader = m_ShaderLibrary->Load("../Resources/Shaders/SPV/Vert.spv");
+#endif
+#if BINDLESS_DESCRIPTORS
+			const Shader& fragmentShader = m_ShaderLibrary->Load(m_BindlessDescriptors ? BINDLESS_FRAGMENT_SHADER_PATH : "../Resources/Shaders/SPV/Frag.spv");
+#else
+			const Shader& fragmentShader = m_ShaderLibrary->Load("../Resources/Shaders/SPV/Frag.spv");
+#endif
+			// a stage that declares a push constant block has to agree with DrawPushConstants, SPIR-V compiled from an older
+			// Shader.vert has no block and keeps reading the model matrix from the uniform buffer
+			m_PushConstantStages = 0;
+			for (const Shader* shader : { &vertexShader, &fragmentShader })
+			{
+				const ShaderReflection& reflection = shader->GetReflection();
+				if (!reflection.HasPushConstants())
+				{
+					continue;
+				}
+				if (reflection.GetPushConstantSize() != sizeof(DrawPushConstants))
+				{
+					static const std::string message = "[GraphicsSystem::Window::CreateGraphicsPipeline]: Shader push constant block does not match DrawPushConstants!";
+					VK_CORE_CRITICAL("{0} -> {1} bytes in the shader, {2} bytes on the cpu", message, reflection.GetPushConstantSize(), sizeof(DrawPushConstants));
+					throw std::runtime_error(message);
+				}
+				m_PushConstantStages |= reflection.GetStage();
+			}
 
 			// create vertex shader info 
 			VkPipelineShaderStageCreateInfo vertShaderStageInfo = {};
@@ -652,16 +851,27 @@ namespace Vulkan_Engine
 			// 1. Vertex Input
 			////////////////////////////////////////////
 			// https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkPipelineVertexInputStateCreateInfo.html
-			//todo: this section should be abstracted along with the vertex abstraction
-			auto bindingDescription = Vertex::GetBindingDescription();
-			auto attributeDescriptions = Vertex::GetAttributeDescriptions();
+			// binding 1 (instanced shader only): transform and material of every instance, advanced once per instance
+			constexpr std::array<VkVertexInputBindingDescription, 2> bindingDescriptions =
+			{
+				VertexLayout<BufferVertex>::GetBindingDescription(),
+				VertexLayout<InstanceData>::GetBindingDescription(1, VK_VERTEX_INPUT_RATE_INSTANCE)
+			};
+			constexpr auto vertexAttributeDescriptions = VertexLayout<BufferVertex>::GetAttributeDescriptions();
+			constexpr auto instanceAttributeDescriptions = VertexLayout<InstanceData>::GetAttributeDescriptions(1);
+			std::vector<VkVertexInputAttributeDescription> attributeDescriptions(vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
+			if (m_InstancedRendering)
+			{
+				attributeDescriptions.insert(attributeDescriptions.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
+			}
+			ShaderLibrary::ValidateVertexInputs(vertexShader, attributeDescriptions);
 			VkPipelineVertexInputStateCreateInfo vertexInputInfo = {}; // format of the vertex data to pass to vertex shader 
 			vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 			// bindings: spacing between data and wheter data is per-vertex or per-instance
-			vertexInputInfo.vertexBindingDescriptionCount = 1; 
-			vertexInputInfo.pVertexBindingDescriptions = &bindingDescription; // points to array of structs that contain the descriptions of the data
+			vertexInputInfo.vertexBindingDescriptionCount = m_InstancedRendering ? 2 : 1; 
+			vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data(); // points to array of structs that contain the descriptions of the data
 			// attributes: type of attributes and which binding to load them from & at which offset 
-			vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());;
+			vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
 			vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
 			////////////////////////////////////////////
@@ -683,28 +893,16 @@ namespace Vulkan_Engine
 			////////////////////////////////////////////
 			// 3. Viewports & Scissors 
 			////////////////////////////////////////////
-			// assign a window viewport to render entire window to
-			VkViewport viewport = {};
-			viewport.x = 0.0f; // bottom left x
-			viewport.y = 0.0f; // bottom left y
-			viewport.width = (float)m_SwapChainExtent.width; // top right x
-			viewport.height = (float)m_SwapChainExtent.height; // top right y
-			viewport.minDepth = 0.0f; // framebuffer value range min
-			viewport.maxDepth = 1.0f; // framebuffer value range max
-
-			// define scissorm for entire window 
-			VkRect2D scissor = {};
-			scissor.offset = { 0, 0 };
-			scissor.extent = m_SwapChainExtent;
-
+			// the viewport and scissor are dynamic state (set every frame in RecordFrameCommandBuffer),
+			// so the pipeline does not depend on the swap chain extent and survives window resizes.
 			// https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkPipelineViewportStateCreateInfo.html
 			// It is possible to use multiple viewports and scissor rectangles on some graphics cards, so its members reference an array of them. Using multiple requires enabling a GPU feature (see logical device creation).
 			VkPipelineViewportStateCreateInfo viewportState = {};
 			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 			viewportState.viewportCount = 1; 
-			viewportState.pViewports = &viewport; 
+			viewportState.pViewports = nullptr; // dynamic
 			viewportState.scissorCount = 1;  
-			viewportState.pScissors = &scissor;
+			viewportState.pScissors = nullptr; // dynamic
 
 			////////////////////////////////////////////
 			// 4. Rasterizer
@@ -798,12 +996,11 @@ namespace Vulkan_Engine
 			// size of the viewport, line width and blend constants.
 			// VkPipelineDynamicStateCreateInfo
 			// This will cause the configuration of these values to be ignored and user will be required to specify the data at drawing time
-			//TODO: Return to this in the future, can be substituted by nullptr if doesn't exist 
-			//VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_LINE_WIDTH };
-			//VkPipelineDynamicStateCreateInfo dynamicState = {};
-			//dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-			//dynamicState.dynamicStateCount = 2;
-			//dynamicState.pDynamicStates = dynamicStates;
+			const std::array<VkDynamicState, 2> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+			VkPipelineDynamicStateCreateInfo dynamicState = {};
+			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+			dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+			dynamicState.pDynamicStates = dynamicStates.data();
 
 			////////////////////////////////////////////
 			// 9. Pipeline Layout 
@@ -811,19 +1008,16 @@ namespace Vulkan_Engine
 			// https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkPipelineLayout.html
 			// uniform values (passed to shaders) must be specified during pipeline creation (VkPipelineLayout)
 			// Push Constants: ways to pass dynamic data to shaders
-			VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
-			pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-			pipelineLayoutInfo.setLayoutCount = 1; // Optional
-			pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout; // descriptor layouts set (TODO: Return for desc pools / sets)
-			pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
-			pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
-
-			if (vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS) 
+			// the layout follows the reflection of both stages, the push constant range covers the blocks validated above.
+			// Set 0 and the bindless set 1 are allocated from layouts the engine created, so they are checked instead of derived
+			PipelineLayoutOptions layoutOptions;
+			layoutOptions.DynamicUniformBuffers = true;
+			layoutOptions.SetLayouts[0] = m_DescriptorSetLayout;
+			if (m_BindlessDescriptors)
 			{
-				static const std::string message = "[GraphicsSystem::Window::CreateGraphicsPipeline]: Failed to create pipeline layout!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
+				layoutOptions.SetLayouts[BindlessDescriptors::s_SetIndex] = m_BindlessDescriptors->GetDescriptorSetLayout();
 			}
+			m_PipelineLayout = m_ShaderLibrary->CreatePipelineLayout({ &vertexShader, &fragmentShader }, *m_DescriptorLayoutCache, layoutOptions);
 
 			////////////////////////////////////////////
 			// 10. Create the pipeline 
@@ -853,7 +1047,7 @@ namespace Vulkan_Engine
 			pipelineInfo.pMultisampleState = &multisampling;
 			pipelineInfo.pDepthStencilState = &depthStencil;
 			pipelineInfo.pColorBlendState = &colorBlending;
-			pipelineInfo.pDynamicState = nullptr; // Optional
+			pipelineInfo.pDynamicState = &dynamicState; // viewport & scissor
 			pipelineInfo.layout = m_PipelineLayout;
 			pipelineInfo.renderPass = m_RenderPass;
 			pipelineInfo.subpass = 0; // only running a single pass
@@ -863,9 +1057,8 @@ namespace Vulkan_Engine
 			pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 			pipelineInfo.basePipelineIndex = -1; // Optional
 
-			//todo: Notice definition and usages of pipeline cache, implement these in the future 
 			// A pipeline cache can be used to store and reuse data relevant to pipeline creation across multiple calls to vkCreateGraphicsPipelines and even across program executions if the cache is stored to a file.
-			if (vkCreateGraphicsPipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) 
+			if (vkCreateGraphicsPipelines(m_LogicalDevice, m_PipelineCache->GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) 
 			{
 				static const std::string message = "[GraphicsSystem::Window::CreateGraphicsPipeline]: Failed to create pipeline pipeline!";
 				VK_CORE_CRITICAL(message);
@@ -901,127 +1094,281 @@ namespace Vulkan_Engine
 			}
 		}
 
-		void Window::CreateCommandPool()
+		void Window::CreateFrameCommandPools()
 		{
 			// Command buffers are executed by submitting them on one of the device queues,
 			// like the graphics and presentation queues we retrieved.
 			// Each command pool can only allocate command buffers that are submitted on a single type of queue
-			QueueFamilyIndices queueFamilyIndices = FindQueueFamilies(m_PhysicalDevice, m_WindowSurface);
-			VkCommandPoolCreateInfo poolInfo = {};
-			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-			poolInfo.queueFamilyIndex = queueFamilyIndices.GraphicsFamily.value(); // graphics family -> as recording commands for drawing 
-			// VK_COMMAND_POOL_CREATE_TRANSIENT_BIT				: Hint that command buffers are rerecorded with new commands very often (may change memory allocation behavior)
-			// VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT	: Allow command buffers to be rerecorded individually, without this flag they all have to be reset together
-			poolInfo.flags = 0; // Optional
-
-			if (vkCreateCommandPool(m_LogicalDevice, &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS) 
+			// Every frame in flight owns a transient pool, which is reset in one call once that frame's fence has signaled,
+			// so the frame's command buffer is re-recorded from the draw list every frame instead of being baked per swap chain image.
+			const QueueFamilyIndices queueFamilyIndices = FindQueueFamilies(m_PhysicalDevice, m_WindowSurface);
+			m_FrameCommandPools.clear();
+			for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
 			{
-				static const std::string message = "[GraphicsSystem::Window::CreateCommandPool]: Failed to create Command Pool!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
+				m_FrameCommandPools.push_back(CreateScope<FrameCommandPool>(m_LogicalDevice, queueFamilyIndices.GraphicsFamily.value())); // graphics family -> as recording commands for drawing 
 			}
+			// draw lists too large for one thread are split into secondary command buffers, each thread records from its own pools
+			m_CommandRecorder = CreateScope<ParallelCommandRecorder>(m_LogicalDevice, queueFamilyIndices.GraphicsFamily.value(), MAX_FRAMES_IN_FLIGHT);
 		}
 
-		void Window::CreateCommandBuffers()
+		void Window::BuildDrawList()
 		{
-			m_CommandBuffers.resize(m_SwapChainFramebuffers.size());
-
-			VkCommandBufferAllocateInfo allocInfo = {};
-			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			allocInfo.commandPool = m_CommandPool;
-			// level: specifies if the allocated command buffers are primary or secondary command buffers.
-			// VK_COMMAND_BUFFER_LEVEL_PRIMARY		: Can be submitted to a queue for execution, but cannot be called from other command buffers.
-			// VK_COMMAND_BUFFER_LEVEL_SECONDARY	: Cannot be submitted directly, but can be called from primary command buffers. (helpful to reuse common operations from primary command buffers.)
-			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-			allocInfo.commandBufferCount = (uint32_t)m_CommandBuffers.size();
-			if (vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, m_CommandBuffers.data()) != VK_SUCCESS) 
-			{
-				static const std::string message = "[GraphicsSystem::Window::CreateCommandBuffers]: Failed to allocate Command Buffers!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
+			m_DrawList.Clear();
+			DrawCommand command;
+			command.Pipeline = m_GraphicsPipeline;
+			command.PipelineLayout = m_PipelineLayout;
+			command.DescriptorSet = m_DescriptorSet;
+			command.DynamicOffsetCount = 1;
+			command.DynamicOffset = m_UniformOffset; // this frame's block of the uniform arena
+			command.VertexBuffer = m_GeometryPool->GetVertexBuffer();
+			command.IndexBuffer = m_GeometryPool->GetIndexBuffer();
+			command.IndexType = VK_INDEX_TYPE_UINT32;
+			command.BindlessSet = m_BindlessDescriptors ? m_BindlessDescriptors->GetDescriptorSet() : VK_NULL_HANDLE; // every texture and material, never rebound
+			// every live scene object is a candidate, with its bounding sphere in world space
+			m_CullingBounds.Clear();
+			m_CandidateObjects.clear();
+			for (uint32_t objectId = 0; objectId < m_Scene.GetObjectCapacity(); ++objectId)
+			{
+				const SceneObject& object = m_Scene.GetSceneObject(objectId);
+				if (object.Alive)
+				{
+					const GeometryMesh& mesh = m_GeometryPool->GetMesh(object.MeshId);
+					m_CullingBounds.Add(TransformBoundingSphere(object.Transform, mesh.Center, mesh.Radius));
+					m_CandidateObjects.push_back(objectId);
+				}
+			}
+			if (!m_GpuCuller)
+			{
+				// cpu frustum culling, only the visible objects get an indirect record
+				FrustumCuller::Cull(Frustum::FromMatrix(m_ProjectionMatrix * m_ViewMatrix), m_CullingBounds, m_Visibility);
+			}
+			// the frame's fence has signaled, so its regions of the indirect and instance buffers are free to overwrite
+			if (m_GpuCuller)
+			{
+				m_GpuCuller->Begin(static_cast<uint32_t>(m_CurrentFrame), m_ViewMatrix, m_ProjectionMatrix);
 			}
+			else
+			{
+				m_IndirectDraws->Begin(static_cast<uint32_t>(m_CurrentFrame));
+			}
+			const auto addDraw = [this](const VkDrawIndexedIndirectCommand& drawCommand, const glm::vec4& boundingSphere)
+			{
+				if (m_GpuCuller)
+				{
+					m_GpuCuller->Add(drawCommand, boundingSphere);
+				}
+				else
+				{
+					m_IndirectDraws->Add(drawCommand);
+				}
+			};
+			// level of detail from the distance between the camera and each object's bounding sphere
+			const float projectionScale = LodSelector::GetProjectionScale(CAMERA_FOV_Y, static_cast<float>(m_SwapChainExtent.height));
+			// without instancing, a vertex shader with the push constant block gets one direct draw per object and its transform pushed
+			const bool pushTransforms = !m_InstancedRendering && m_PushConstantStages != 0;
+			m_InstanceBatcher.Clear();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_CandidateObjects.size()); ++i)
+			{
+				if (!m_GpuCuller && !FrustumCuller::IsVisible(m_Visibility, i))
+				{
+					continue;
+				}
+				const uint32_t objectId = m_CandidateObjects[i];
+				const SceneObject& object = m_Scene.GetSceneObject(objectId);
+				const GeometryMesh& mesh = m_GeometryPool->GetMesh(object.MeshId);
+				const glm::vec4 boundingSphere(m_CullingBounds.GetCenterX()[i], m_CullingBounds.GetCenterY()[i], m_CullingBounds.GetCenterZ()[i], m_CullingBounds.GetRadius()[i]);
+				const float distance = glm::distance(glm::vec3(boundingSphere), CAMERA_POSITION) - boundingSphere.w;
+				const uint32_t lod = LodSelector::SelectLod(mesh.Lods.data(), static_cast<uint32_t>(mesh.Lods.size()), distance, projectionScale);
+				if (objectId == m_ObjectId && lod != m_SelectedLod)
+				{
+					VK_CORE_TRACE("[GraphicsSystem::Window::BuildDrawList]: Switched to level of detail {0} ({1} triangles)", lod, mesh.Lods[lod].IndexCount / 3);
+					m_SelectedLod = lod;
+				}
+				if (m_InstancedRendering)
+				{
+					m_InstanceBatcher.Add(object.MeshId, lod, object.Transform * m_VertexDequantization, object.MaterialId, object.WorldBounds);
+				}
+				else if (pushTransforms)
+				{
+					const VkDrawIndexedIndirectCommand drawCommand = m_GeometryPool->GetDrawCommand(object.MeshId, lod);
+					DrawCommand objectCommand = command;
+					objectCommand.IndexCount = drawCommand.indexCount;
+					objectCommand.FirstIndex = drawCommand.firstIndex;
+					objectCommand.VertexOffset = drawCommand.vertexOffset;
+					DrawPushConstants pushConstants;
+					pushConstants.Model = object.Transform * m_VertexDequantization;
+					m_DrawList.Add(objectCommand, &pushConstants, sizeof(pushConstants), m_PushConstantStages);
+				}
+				else
+				{
+					addDraw(m_GeometryPool->GetDrawCommand(object.MeshId, lod), boundingSphere);
+				}
+			}
+			if (pushTransforms)
+			{
+				return; // every object is its own direct draw, the indirect records stay empty
+			}
+			if (m_InstancedRendering)
+			{
+				// one record per (mesh, level of detail), the gpu culler tests the sphere around the whole batch
+				m_InstanceBatcher.Build();
+				const uint32_t instanceCount = m_InstanceBuffer->Write(static_cast<uint32_t>(m_CurrentFrame), m_InstanceBatcher.GetInstances());
+				command.InstanceBuffer = m_InstanceBuffer->GetBuffer();
+				command.InstanceOffset = m_InstanceBuffer->GetOffset();
+				for (const InstanceBatch& batch : m_InstanceBatcher.GetBatches())
+				{
+					if (batch.FirstInstance >= instanceCount)
+					{
+						break; // the rest didn't fit in the instance buffer
+					}
+					const uint32_t batchCount = std::min(batch.InstanceCount, instanceCount - batch.FirstInstance);
+					const VkDrawIndexedIndirectCommand drawCommand = m_GeometryPool->GetDrawCommand(batch.MeshId, batch.Lod, batchCount, batch.FirstInstance);
+					if (m_DrawIndirectFirstInstance)
+					{
+						const glm::vec4 boundingSphere(batch.Bounds.GetCenter(), glm::length(batch.Bounds.GetExtents()));
+						addDraw(drawCommand, boundingSphere);
+					}
+					else
+					{
+						// an indirect record has to start at instance 0 without the feature, a direct draw takes any first instance
+						DrawCommand batchCommand = command;
+						batchCommand.IndexCount = drawCommand.indexCount;
+						batchCommand.InstanceCount = drawCommand.instanceCount;
+						batchCommand.FirstIndex = drawCommand.firstIndex;
+						batchCommand.VertexOffset = drawCommand.vertexOffset;
+						batchCommand.FirstInstance = drawCommand.firstInstance;
+						m_DrawList.Add(batchCommand);
+					}
+				}
+				if (!m_DrawIndirectFirstInstance)
+				{
+					return; // every batch is its own direct draw, the indirect records stay empty
+				}
+			}
+			if (m_GpuCuller)
+			{
+				// the compute pass compacts the visible draws, the draw count is read from its output
+				m_GpuCuller->End();
+				command.IndirectBuffer = m_GpuCuller->GetDrawBuffer();
+				command.IndirectOffset = m_GpuCuller->GetCommandOffset();
+				command.DrawCount = m_GpuCuller->GetDrawCount();
+				command.CountBuffer = m_GpuCuller->GetDrawBuffer();
+				command.CountOffset = m_GpuCuller->GetCountOffset();
+			}
+			else
+			{
+				m_IndirectDraws->End();
+				command.IndirectBuffer = m_IndirectDraws->GetBuffer();
+				command.IndirectOffset = m_IndirectDraws->GetCommandOffset();
+				command.DrawCount = m_IndirectDraws->GetDrawCount();
+				command.CountBuffer = m_IndirectDraws->GetBuffer();
+				command.CountOffset = m_IndirectDraws->GetCountOffset();
+			}
+			m_DrawList.Add(command);
+		}
+
+		VkCommandBuffer Window::RecordFrameCommandBuffer(uint32_t imageIndex)
+		{
+			const Timer recordTimer;
+			BuildDrawList();
+			const VkCommandBuffer commandBuffer = m_FrameCommandPools[m_CurrentFrame]->GetPrimaryCommandBuffer();
 
 			////////////////////////////////////////////////////////////////
 			// Starting command buffer recording
 			////////////////////////////////////////////////////////////////
-			// If the command buffer was already recorded once, then a call to vkBeginCommandBuffer will implicitly reset it.
-			// It's not possible to append commands to a buffer at a later time.
-			for (size_t i = 0; i < m_CommandBuffers.size(); i++) 
-			{
-				VkCommandBufferBeginInfo beginInfo = {};
-				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-				// Flags: VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT: The command buffer will be rerecorded right after executing it once.
-				// Flags: VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT : This is a secondary command buffer that will be entirely within a single render pass.
-				// Flags: VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT : The command buffer can be resubmitted while it is also already pending execution.
-				beginInfo.flags = 0; // how are we going to use the command buffer 
-				beginInfo.pInheritanceInfo = nullptr; // only relevant for secondary command buffers. It specifies which state to inherit from the calling primary command buffers.
-				if (vkBeginCommandBuffer(m_CommandBuffers[i], &beginInfo) != VK_SUCCESS)
-				{
-					static const std::string message = "[GraphicsSystem::Window::CreateCommandBuffers]: Failed to begin recording command buffers!";
-					VK_CORE_CRITICAL(message);
-					throw std::runtime_error(message);
-				}
-				
-				////////////////////////////////////////////////////////////////
-				// Starting command buffer recording
-				////////////////////////////////////////////////////////////////
+			// The pool was reset at the start of the frame, so the buffer is recorded from scratch.
+			VkCommandBufferBeginInfo beginInfo = {};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			// Flags: VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT: The command buffer will be rerecorded right after executing it once.
+			// Flags: VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT : This is a secondary command buffer that will be entirely within a single render pass.
+			// Flags: VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT : The command buffer can be resubmitted while it is also already pending execution.
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			beginInfo.pInheritanceInfo = nullptr; // only relevant for secondary command buffers. It specifies which state to inherit from the calling primary command buffers.
+			if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::Window::RecordFrameCommandBuffer]: Failed to begin recording command buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			if (m_GpuCuller)
+			{
+				m_GpuCuller->RecordCulling(commandBuffer); // writes the indirect draws recorded below
+			}
 
-				std::array<VkClearValue, 2> clearValues = {};
-				clearValues[0].color = { 0.0f, 0.0f, 0.0f, 1.0f };
-				clearValues[1].depthStencil = { 1.0f, 0 };
-				
-				VkRenderPassBeginInfo renderPassInfo = {};
-				renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-				renderPassInfo.renderPass = m_RenderPass; // the render pass 
-				renderPassInfo.framebuffer = m_SwapChainFramebuffers[i]; // attachments to bind to the render pass (color attachments)
-				// define size of render area 
-				renderPassInfo.renderArea.offset = { 0, 0 };
-				renderPassInfo.renderArea.extent = m_SwapChainExtent;
-				// define the clear color used in "VK_ATTACHMENT_LOAD_OP_CLEAR" -> used as load operation for the color attachments 
-				VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
-				renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-				renderPassInfo.pClearValues = clearValues.data();
-				// beginning the render pass
-				// All of the functions that record commands can be recognized by their **** vkCmd **** prefix
-				// They all return void, so there will be no error handling until we've finished recording.
-				// @ Param 1: For every command is always the command buffer to record the command to.
-				// @ Param 2: Specifies the details of the render pass we've just provided.
-				// @ Param 3: Controls how the drawing commands within the render pass will be provided. It can have one of two values:
-				//1. VK_SUBPASS_CONTENTS_INLINE						: The render pass commands will be embedded in the primary command buffer itselfand no secondary command buffers will be executed.
-				//2. VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS	: The render pass commands will be executed from secondary command buffers.
-
-				vkCmdBeginRenderPass(m_CommandBuffers[i], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-				// @ Param 2: graphics or compute pipeline? 
-				vkCmdBindPipeline(m_CommandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline); // bind graphics pipeline
-
-				////////////////////////////////
-				//// Vertex buffer binding 
-				////////////////////////////////
-				// @Param: vertexCount: Even though we don't have a vertex buffer, we technically still have 3 vertices to draw.
-				// @Param: instanceCount : Used for instanced rendering, use 1 if you're not doing that.
-				// @Param: firstVertex : Used as an offset into the vertex buffer, defines the lowest value of gl_VertexIndex.
-				// @Param: firstInstance : Used as an offset for instanced rendering, defines the lowest value of gl_InstanceIndex.
-				VkBuffer vertexBuffers[] = { m_VertexBuffer };
-				VkDeviceSize offsets[] = { 0 };
-				vkCmdBindVertexBuffers(m_CommandBuffers[i], 0, 1, vertexBuffers, offsets); // binds vertex buffer to bindings
-				vkCmdBindDescriptorSets(m_CommandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 1, &m_DescriptorSets[i], 0, nullptr);
-				vkCmdBindIndexBuffer(m_CommandBuffers[i], m_IndexBuffer, 0, VK_INDEX_TYPE_UINT32);  //TODO: Change this depending on number of indices
-
-				// This draws primitive vertices 
-				//vkCmdDraw(m_CommandBuffers[i], static_cast<uint32_t>(m_Vertices.size()), 1, 0, 0); 
-
-				vkCmdDrawIndexed(m_CommandBuffers[i], static_cast<uint32_t>(m_Indices.size()), 1, 0, 0, 0);
-				
-				// end the render pass 
-				vkCmdEndRenderPass(m_CommandBuffers[i]);
-				if (vkEndCommandBuffer(m_CommandBuffers[i]) != VK_SUCCESS) 
+			std::array<VkClearValue, 2> clearValues = {};
+			clearValues[0].color = { 0.0f, 0.0f, 0.0f, 1.0f };
+			clearValues[1].depthStencil = { 1.0f, 0 };
+			
+			VkRenderPassBeginInfo renderPassInfo = {};
+			renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+			renderPassInfo.renderPass = m_RenderPass; // the render pass 
+			renderPassInfo.framebuffer = m_SwapChainFramebuffers[imageIndex]; // attachments to bind to the render pass (color attachments)
+			// define size of render area 
+			renderPassInfo.renderArea.offset = { 0, 0 };
+			renderPassInfo.renderArea.extent = m_SwapChainExtent;
+			// define the clear color used in "VK_ATTACHMENT_LOAD_OP_CLEAR" -> used as load operation for the color attachments 
+			renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+			renderPassInfo.pClearValues = clearValues.data();
+			// @ Param 3: Controls how the drawing commands within the render pass will be provided. It can have one of two values:
+			//1. VK_SUBPASS_CONTENTS_INLINE						: The render pass commands will be embedded in the primary command buffer itselfand no secondary command buffers will be executed.
+			//2. VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS	: The render pass commands will be executed from secondary command buffers.
+			// dynamic state, covers the whole swap chain extent
+			VkViewport viewport = {};
+			viewport.x = 0.0f; // bottom left x
+			viewport.y = 0.0f; // bottom left y
+			viewport.width = static_cast<float>(m_SwapChainExtent.width); // top right x
+			viewport.height = static_cast<float>(m_SwapChainExtent.height); // top right y
+			viewport.minDepth = 0.0f; // framebuffer value range min
+			viewport.maxDepth = 1.0f; // framebuffer value range max
+			VkRect2D scissor = {};
+			scissor.offset = { 0, 0 };
+			scissor.extent = m_SwapChainExtent;
+
+			if (m_DrawList.GetSize() > ParallelCommandRecorder::s_MinDrawsPerThread)
+			{
+				// secondary buffers don't inherit any bound state, so every range rebinds what it uses
+				VkCommandBufferInheritanceInfo inheritanceInfo = {};
+				inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+				inheritanceInfo.renderPass = m_RenderPass;
+				inheritanceInfo.subpass = 0;
+				inheritanceInfo.framebuffer = m_SwapChainFramebuffers[imageIndex]; // optional, but lets the driver optimize for it
+				const std::vector<VkCommandBuffer>& secondaryBuffers = m_CommandRecorder->Record(static_cast<uint32_t>(m_CurrentFrame), m_DrawList, inheritanceInfo, viewport, scissor);
+				vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+				vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaryBuffers.size()), secondaryBuffers.data());
+			}
+			else
+			{
+				vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+				vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+				vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+				m_DrawList.Record(commandBuffer); // binds pipeline, descriptor sets, vertex & index buffers as they change between draws
+			}
+			vkCmdEndRenderPass(commandBuffer);
+			if (m_GpuCuller)
+			{
+				m_GpuCuller->RecordDepthPyramid(commandBuffer); // occluders for the next frame
+			}
+			if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) 
+			{
+				static const std::string message = "[GraphicsSystem::Window::RecordFrameCommandBuffer]: Failed to record command buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+
+			m_RecordTimings.AddSample(recordTimer.GetMilliseconds());
+			if (m_RecordTimings.GetCount() == RECORD_TIMING_FRAMES)
+			{
+				VK_CORE_TRACE("[GraphicsSystem::Window::RecordFrameCommandBuffer]: {0} draws, record time avg {1:.3f}ms, min {2:.3f}ms, max {3:.3f}ms",
+					m_DrawList.GetSize(), m_RecordTimings.GetAverage(), m_RecordTimings.GetMin(), m_RecordTimings.GetMax());
+				if (m_GpuCuller)
 				{
-					static const std::string message = "[GraphicsSystem::Window::CreateCommandBuffers]: Failed to record command buffer!";
-					VK_CORE_CRITICAL(message);
-					throw std::runtime_error(message);
+					const CullStatistics& statistics = m_GpuCuller->GetStatistics();
+					VK_CORE_TRACE("[GraphicsSystem::Window::RecordFrameCommandBuffer]: Gpu culling -> {0} visible, {1} frustum culled, {2} occlusion culled",
+						statistics.VisibleCount, statistics.FrustumCulledCount, statistics.OcclusionCulledCount);
 				}
+				m_RecordTimings.Reset();
 			}
-
+			return commandBuffer;
 		}
 
 		void Window::CreateSyncObjects()
@@ -1054,6 +1401,12 @@ namespace Vulkan_Engine
 		void Window::RenderFrame(const Timestep deltaTime)
 		{
 			vkWaitForFences(m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+			ReleaseRetiredSwapChains(); // the fence may have been the last frame using an old swap chain
+			m_UploadContext->Update(); // recycle staging space of finished uploads
+			m_FrameCommandPools[m_CurrentFrame]->Reset(); // the fence guarantees the gpu is done with this frame's command buffers
+			m_CommandRecorder->Reset(static_cast<uint32_t>(m_CurrentFrame));
+			m_DescriptorAllocator->BeginFrame(static_cast<uint32_t>(m_CurrentFrame)); // releases the frame's transient descriptor sets
+			m_GeometryPool->BeginFrame(m_SubmittedFrames); // reuses the ranges of meshes no frame in flight draws anymore
 			
 			// 1. Acquire an image from the swap chain (Swap chain is extension feature)
 			uint32_t imageIndex; // final param in acquire function -> specifies index of swap chain image that has become available (VkImage) in m_SwapChainImages
@@ -1081,7 +1434,8 @@ namespace Vulkan_Engine
 			// Mark the image as now being in use by this frame
 			m_ImagesInFlight[imageIndex] = m_InFlightFences[m_CurrentFrame];
 
-			UpdateUniformBuffer(imageIndex, deltaTime); //todo: This obviously shouldn't stay here...
+			UpdateUniformBuffer(deltaTime); //todo: This obviously shouldn't stay here...
+			const VkCommandBuffer commandBuffer = RecordFrameCommandBuffer(imageIndex);
 			
 			// 2. Execute the command buffer with that image as attachment in the framebuffer
 			// Queue submission and synchronization is configured through parameters in the VkSubmitInfo structure.
@@ -1093,7 +1447,7 @@ namespace Vulkan_Engine
 			submitInfo.pWaitSemaphores = waitSemaphores;
 			submitInfo.pWaitDstStageMask = waitStages;
 			submitInfo.commandBufferCount = 1;
-			submitInfo.pCommandBuffers = &m_CommandBuffers[imageIndex]; // which command buffers to submit for execution
+			submitInfo.pCommandBuffers = &commandBuffer; // which command buffers to submit for execution
 			VkSemaphore signalSemaphores[] = { m_RenderFinishedSemaphores[m_CurrentFrame] };
 			// The signalSemaphoreCount and pSignalSemaphores parameters specify which semaphores to signal once the command buffer(s) have finished execution
 			submitInfo.signalSemaphoreCount = 1;
@@ -1108,6 +1462,7 @@ namespace Vulkan_Engine
 				VK_CORE_CRITICAL(message);
 				throw std::runtime_error(message);
 			}
+			++m_SubmittedFrames;
 			// 3. Return the image to the swap chain for presentation
 			VkPresentInfoKHR presentInfo = {};
 			presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -1154,31 +1509,21 @@ namespace Vulkan_Engine
 			// msaa data 
 			vkDestroyImageView(m_LogicalDevice, m_ColorImageView, nullptr);
 			vkDestroyImage(m_LogicalDevice, m_ColorImage, nullptr);
-			vkFreeMemory(m_LogicalDevice, m_ColorImageMemory, nullptr);
+			m_MemoryAllocator->Free(m_ColorImageAllocation);
 			// depth data
 			vkDestroyImageView(m_LogicalDevice, m_DepthImageView, nullptr);
 			vkDestroyImage(m_LogicalDevice, m_DepthImage, nullptr);
-			vkFreeMemory(m_LogicalDevice, m_DepthImageMemory, nullptr);
+			m_MemoryAllocator->Free(m_DepthImageAllocation);
 			//framebuffers
 			for (auto framebuffer : m_SwapChainFramebuffers)
 			{
 				vkDestroyFramebuffer(m_LogicalDevice, framebuffer, nullptr); // destroy the framebuffers
 			}
-			vkFreeCommandBuffers(m_LogicalDevice, m_CommandPool, static_cast<uint32_t>(m_CommandBuffers.size()), m_CommandBuffers.data());
-			vkDestroyPipeline(m_LogicalDevice, m_GraphicsPipeline, nullptr); // destroy the graphics pipeline 
-			vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr); // pipeline layout  (data passed to shaders)
-			vkDestroyRenderPass(m_LogicalDevice, m_RenderPass, nullptr); // destroy the render pass 
 			for (auto imageView : m_SwapChainImageViews)  // destroy all the image views 
 			{
 				vkDestroyImageView(m_LogicalDevice, imageView, nullptr);
 			}
-			vkDestroySwapchainKHR(m_LogicalDevice, m_SwapChain, nullptr);
-			for (size_t i = 0; i < m_SwapChainImages.size(); i++) // cleanup uniform buffers 
-			{
-				vkDestroyBuffer(m_LogicalDevice, m_UniformBuffers[i], nullptr); 
-				vkFreeMemory(m_LogicalDevice, m_UniformBuffersMemory[i], nullptr);
-			}
-			vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+			// the swap chain itself is destroyed in Cleanup, RecreateSwapChain retires all of this instead (RetireSwapChain)
 		}
 
 		void Window::RecreateSwapChain()
@@ -1191,102 +1536,140 @@ namespace Vulkan_Engine
 				glfwGetFramebufferSize(m_Window, &width, &height);
 				glfwWaitEvents();
 			}
-			vkDeviceWaitIdle(m_LogicalDevice); // in case resources are still in use 
-			CleanupSwapChain();
-			CreateVulkanSwapChain();
+			const Timer resizeTimer; // resize latency: from the old swap chain being retired to the new one being ready
+			// no device wait, frames in flight keep their swap chain, attachments and framebuffers until their fences have signaled
+			const VkFormat oldFormat = m_SwapChainImageFormat;
+			RetireSwapChain();
+			CreateVulkanSwapChain(); // hands the old swap chain over as oldSwapchain
 			CreateVulkanImageViews(); // based on swap chain images 
-			CreateGraphicsRenderPass(); // depends on format of swap chain images (even though format may not change, should still be caught)
-			CreateGraphicsPipeline(); // viewport and scissor size  (Can be avoided by using dynamic state for viewports and scissor rectnagles)
+			// the pipeline uses dynamic viewport & scissor, so only a format change requires a new render pass (and pipeline)
+			if (m_SwapChainImageFormat != oldFormat)
+			{
+				RetiredSwapChain& retired = m_RetiredSwapChains.back();
+				retired.RenderPass = m_RenderPass;
+				retired.GraphicsPipeline = m_GraphicsPipeline;
+				retired.PipelineLayout = m_PipelineLayout;
+				CreateGraphicsRenderPass();
+				CreateGraphicsPipeline();
+			}
 			CreateColorResources();
 			CreateDepthResources();
 			CreateFramebuffers(); // depend on swap chain images
-			CreateUniformBuffers();  // uniform buffer recreation (as depend on number of swap chain images)
-			CreateDescriptorPool();
-			CreateDescriptorSets(); 
-			CreateCommandBuffers(); // depend on swap chain images 
+			// the uniform arena and its descriptor set exist per frame in flight, not per swap chain image, so they are kept
+			m_ImagesInFlight.assign(m_SwapChainImages.size(), VK_NULL_HANDLE); // no frame has used the new images yet
+
+			const float resizeMilliseconds = resizeTimer.GetMilliseconds();
+			m_ResizeTimings.AddSample(resizeMilliseconds);
+			VK_CORE_INFO("[GraphicsSystem::Window::RecreateSwapChain]: Resized to {0}x{1} in {2:.3f}ms (avg {3:.3f}ms, max {4:.3f}ms over {5} resizes)",
+				m_SwapChainExtent.width, m_SwapChainExtent.height, resizeMilliseconds, m_ResizeTimings.GetAverage(), m_ResizeTimings.GetMax(), m_ResizeTimings.GetCount());
 		}
 
-		void Window::CreateVertexBuffer()
+		void Window::RetireSwapChain()
 		{
-			const VkDeviceSize bufferSize = sizeof(m_Vertices[0]) * m_Vertices.size();
-
-			VkBuffer stagingBuffer; // used for mapping and copying vertex data 
-			VkDeviceMemory stagingBufferMemory;
-			CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-			void* data;
-			vkMapMemory(m_LogicalDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
-			memcpy(data, m_Vertices.data(), (size_t)bufferSize);
-			vkUnmapMemory(m_LogicalDevice, stagingBufferMemory);
-
-			// VK_BUFFER_USAGE_TRANSFER_SRC_BIT: Buffer can be used as source in a memory transfer operation.	
-			// VK_BUFFER_USAGE_TRANSFER_DST_BIT : Buffer can be used as destination in a memory transfer operation.
-			CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_VertexBuffer, m_VertexBufferMemory);
-			CopyBuffer(stagingBuffer, m_VertexBuffer, bufferSize);
-
-			// clean staging buffers
-			vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-			vkFreeMemory(m_LogicalDevice, stagingBufferMemory, nullptr);
-			
-			//VkBufferCreateInfo bufferInfo = {};
-			//bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			//bufferInfo.size = sizeof(m_Vertices[0]) * m_Vertices.size(); // total size of all Vertex data (bytes)
-			//bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT; // for which purposes the data in buffer is used (multiple purposes possible)
-			//bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // owned by a specific queue family, or shared  (used by graphics queue here, so exclusive access)
-			//bufferInfo.flags = 0; // configures sparse buffer memory, not used currently. 
-
-			//if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_VertexBuffer) != VK_SUCCESS) 
-			//{
-			//	static const std::string message = "[GraphicsSystem::Window::CreateVertexBuffer]: Failed to create vertex buffer!";
-			//	VK_CORE_CRITICAL(message);
-			//	throw std::runtime_error(message);
-			//}
+			RetiredSwapChain retired;
+			retired.SwapChain = m_SwapChain; // stays m_SwapChain until CreateVulkanSwapChain replaces it
+			retired.ImageViews = std::move(m_SwapChainImageViews);
+			retired.Framebuffers = std::move(m_SwapChainFramebuffers);
+			retired.ColorImage = m_ColorImage;
+			retired.ColorImageAllocation = m_ColorImageAllocation;
+			retired.ColorImageView = m_ColorImageView;
+			retired.DepthImage = m_DepthImage;
+			retired.DepthImageAllocation = m_DepthImageAllocation;
+			retired.DepthImageView = m_DepthImageView;
+			retired.SubmittedFrames = m_SubmittedFrames;
+			m_SwapChainImageViews.clear();
+			m_SwapChainFramebuffers.clear();
+			m_RetiredSwapChains.push_back(std::move(retired));
+		}
 
-			//////////////////////////////////////////////////////////////////
-			//// Query buffer memory requirements
-			//////////////////////////////////////////////////////////////////
-			//// size: The size of the required amount of memory in bytes, may differ from bufferInfo.size.
-			//// alignment : The offset in bytes where the buffer begins in the allocated region of memory, depends on bufferInfo.usage and bufferInfo.flags.
-			//// memoryTypeBits : Bit field of the memory types that are suitable for the buffer.
-			//VkMemoryRequirements memRequirements;
-			//vkGetBufferMemoryRequirements(m_LogicalDevice, m_VertexBuffer, &memRequirements);
-
-			//VkMemoryAllocateInfo allocInfo = {};
-			//allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			//allocInfo.allocationSize = memRequirements.size;
-			//allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_PhysicalDevice);
-			//if (vkAllocateMemory(m_LogicalDevice, &allocInfo, nullptr, &m_VertexBufferMemory) != VK_SUCCESS) 
-			//{
-			//	static const std::string message = "[GraphicsSystem::Window::CreateVertexBuffer]: Failed to allocate vertex buffer memory!";
-			//	VK_CORE_CRITICAL(message);
-			//	throw std::runtime_error(message);
-			//}
-			
-			// associate memory buffer memory with the buffer
-			//todo: Note: If the offset is non - zero, then it is required to be divisible by memRequirements.alignment.
-			//VkBindBufferMemory(m_LogicalDevice, m_VertexBuffer, m_VertexBufferMemory, 0); // no offset as memory region allocated specifically for this vertex memory 
+		void Window::DestroyRetiredSwapChain(RetiredSwapChain& retired)
+		{
+			for (auto framebuffer : retired.Framebuffers)
+			{
+				vkDestroyFramebuffer(m_LogicalDevice, framebuffer, nullptr);
+			}
+			for (auto imageView : retired.ImageViews)
+			{
+				vkDestroyImageView(m_LogicalDevice, imageView, nullptr);
+			}
+			vkDestroyImageView(m_LogicalDevice, retired.ColorImageView, nullptr);
+			vkDestroyImage(m_LogicalDevice, retired.ColorImage, nullptr);
+			m_MemoryAllocator->Free(retired.ColorImageAllocation);
+			vkDestroyImageView(m_LogicalDevice, retired.DepthImageView, nullptr);
+			vkDestroyImage(m_LogicalDevice, retired.DepthImage, nullptr);
+			m_MemoryAllocator->Free(retired.DepthImageAllocation);
+			vkDestroyPipeline(m_LogicalDevice, retired.GraphicsPipeline, nullptr);
+			vkDestroyPipelineLayout(m_LogicalDevice, retired.PipelineLayout, nullptr);
+			vkDestroyRenderPass(m_LogicalDevice, retired.RenderPass, nullptr);
+			vkDestroySwapchainKHR(m_LogicalDevice, retired.SwapChain, nullptr); // already retired as oldSwapchain, its images are released
+		}
 
-			////////////////////////////////////////////////////////////////
-			// Filling the vertex buffer
-			////////////////////////////////////////////////////////////////
-			// https://en.wikipedia.org/wiki/Memory-mapped_I/O
-			//void* data;
-			// VK_WHOLE_SIZE maps all of memory, rather than just bufferinfo.size
-			// the last parameter specifies the output for the pointer to the mapped memory 
-			//vkMapMemory(m_LogicalDevice, m_VertexBufferMemory, 0, bufferSize, 0, &data);
-
-			// can now memcpy the vertex data to the mapped memoryand unmap it again using vkUnmapMemory.
-			// Unfortunately the driver may not immediately copy the data into the buffer memory,
-			// for example because of caching.
-			// It is also possible that writes to the buffer are not visible in the mapped memory yet.
-			// There are two ways to deal with that problem : [USING @1 IN THE CURRENT IMPLEMENTATION]
-			// @1: Use a memory heap that is host coherent, indicated with VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-			// @": Call vkFlushMappedMemoryRanges to after writing to the mapped memory, and call vkInvalidateMappedMemoryRanges before reading from the mapped memory
-			//memcpy(data, m_Vertices.data(), (size_t)bufferSize);
-			//vkUnmapMemory(m_LogicalDevice, m_VertexBufferMemory);
+		void Window::ReleaseRetiredSwapChains()
+		{
+			// called after waiting for the current frame's fence, so every frame up to m_SubmittedFrames - MAX_FRAMES_IN_FLIGHT has finished
+			// (each frame waited for the fence of the one MAX_FRAMES_IN_FLIGHT before it), the retired resources were last used by
+			// frame SubmittedFrames - 1
+			while (!m_RetiredSwapChains.empty() && m_RetiredSwapChains.front().SubmittedFrames + MAX_FRAMES_IN_FLIGHT <= m_SubmittedFrames + 1)
+			{
+				DestroyRetiredSwapChain(m_RetiredSwapChains.front());
+				m_RetiredSwapChains.erase(m_RetiredSwapChains.begin());
+			}
+		}
+
+		void Window::CreateGeometry()
+		{
+#if LOAD_MODEL
+			const Vertex* vertices = m_Mesh->GetVertices(); // points into the mapped mesh file
+			const uint32_t vertexCount = static_cast<uint32_t>(m_Mesh->GetVertexCount());
+			const uint32_t* indices = m_Mesh->GetIndices();
+			const uint32_t indexCount = m_Mesh->GetIndexCount();
+			const MeshLod* lods = m_Mesh->GetLods();
+			const uint32_t lodCount = m_Mesh->GetLodCount();
+			const glm::vec3 boundsMin = m_Mesh->GetBoundsMin();
+			const glm::vec3 boundsMax = m_Mesh->GetBoundsMax();
+#else
+			const Vertex* vertices = m_Vertices.data();
+			const uint32_t vertexCount = static_cast<uint32_t>(m_Vertices.size());
+			const uint32_t* indices = m_Indices.data();
+			const uint32_t indexCount = static_cast<uint32_t>(m_Indices.size());
+			const MeshLod* lods = nullptr; // the whole index data is level 0
+			const uint32_t lodCount = 0;
+			glm::vec3 boundsMin = m_Vertices[0].Position;
+			glm::vec3 boundsMax = m_Vertices[0].Position;
+			for (const Vertex& vertex : m_Vertices)
+			{
+				boundsMin = glm::min(boundsMin, vertex.Position);
+				boundsMax = glm::max(boundsMax, vertex.Position);
+			}
+#endif
+#if QUANTIZE_VERTICES
+			// positions are stored relative to the bounds, the scale / bias is folded into the model matrix
+			const PositionQuantization positionQuantization = VertexQuantization::ComputePositionQuantization(boundsMin, boundsMax);
+			std::vector<QuantizedVertex> quantizedVertices(vertexCount);
+			VertexQuantization::QuantizeVertices(vertices, vertexCount, positionQuantization, quantizedVertices.data());
+			m_VertexDequantization = positionQuantization.GetDequantizationMatrix();
+			const void* vertexData = quantizedVertices.data(); // staged right away, so it doesn't have to outlive this function
+#else
+			const void* vertexData = vertices; // copied straight to staging
+#endif
+			// every mesh is sub-allocated from one vertex / index buffer pair, so draws never rebind them
+			m_GeometryPool = CreateScope<GeometryPool>(m_LogicalDevice, *m_MemoryAllocator, static_cast<uint32_t>(sizeof(BufferVertex)), MAX_FRAMES_IN_FLIGHT,
+				std::max(GEOMETRY_VERTEX_CAPACITY, vertexCount), std::max(GEOMETRY_INDEX_CAPACITY, indexCount));
+			// the buffers are device local, so the data goes through the staging ring and is copied on the gpu
+			m_MeshId = m_GeometryPool->AddMesh(*m_UploadContext, vertexData, vertexCount, indices, indexCount, lods, lodCount, boundsMin, boundsMax);
+			m_ObjectId = m_Scene.AddObject(m_MeshId, m_ModelMatrix, m_GeometryPool->GetMesh(m_MeshId).Bounds);
+			m_Scene.Update();
+			m_IndirectDraws = CreateScope<IndirectDrawBuffer>(m_LogicalDevice, *m_MemoryAllocator, MAX_FRAMES_IN_FLIGHT, MAX_INDIRECT_DRAWS);
+#if INSTANCED_RENDERING
+			if (m_InstancedRendering)
+			{
+				m_InstanceBuffer = CreateScope<InstanceBuffer>(m_LogicalDevice, *m_MemoryAllocator, MAX_FRAMES_IN_FLIGHT, MAX_INSTANCES);
+			}
+#endif
 		}
 
-		//TODO (#2): The right way to allocate memory for a large number of objects at the same time is to create a custom allocator that splits up a single allocation among many different objects by using the offset parameters that we've seen in many functions.
-		void Window::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+		// memory comes from the device memory allocator, which splits a single allocation among many different objects by using the offset parameters
+		void Window::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, DeviceAllocation& bufferAllocation)
 		{
 			VkBufferCreateInfo bufferInfo = {};
 			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -1299,89 +1682,7 @@ namespace Vulkan_Engine
 				VK_CORE_CRITICAL(message);
 				throw std::runtime_error(message);
 			}
-			VkMemoryRequirements memRequirements;
-			vkGetBufferMemoryRequirements(m_LogicalDevice, buffer, &memRequirements);
-			VkMemoryAllocateInfo allocInfo = {};
-			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			allocInfo.allocationSize = memRequirements.size;
-			allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties, m_PhysicalDevice);
-			if (vkAllocateMemory(m_LogicalDevice, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) 
-			{
-				static const std::string message = "[GraphicsSystem::Window::CreateBuffer]: Failed to allocate buffer memory!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
-			}
-			vkBindBufferMemory(m_LogicalDevice, buffer, bufferMemory, 0);
-		}
-
-		void Window::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
-		{
-			const VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-			VkBufferCopy copyRegion = {};
-			copyRegion.size = size;
-			vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-
-			EndSingleTimeCommands(commandBuffer);
-			
-			//// vertex buffer is device local, so it can't be mapped using VkMapMemory, so we copy data from the staging buffer to it.
-			//// copies the contents from one buffer to another
-
-			//VkCommandBufferAllocateInfo allocInfo = {};
-			//allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			//allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-			//allocInfo.commandPool = m_CommandPool;
-			//allocInfo.commandBufferCount = 1;
-
-			//VkCommandBuffer commandBuffer;
-			//vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &commandBuffer);
-
-			//VkCommandBufferBeginInfo beginInfo = {};
-			//beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			//beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // inform driver about copy intent (single usage) 
-
-			//// temporarily record transfer commands (single copy command) 
-			//vkBeginCommandBuffer(commandBuffer, &beginInfo);
-			//VkBufferCopy copyRegion = {};
-			//copyRegion.srcOffset = 0; // Optional
-			//copyRegion.dstOffset = 0; // Optional
-			//copyRegion.size = size;  // can't just copy entire buffer
-			//vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion); // tranfers contents of the buffer
-			//vkEndCommandBuffer(commandBuffer);
-
-			//// immediately submit the copy commands to be executed 
-			//VkSubmitInfo submitInfo = {};
-			//submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			//submitInfo.commandBufferCount = 1;
-			//submitInfo.pCommandBuffers = &commandBuffer;
-
-			////TODO (#1): Using fences here will provide driver optimization opportunities if creating multiple buffers...
-			//vkQueueSubmit(m_GraphicsQueueHandle, 1, &submitInfo, VK_NULL_HANDLE); 
-			//vkQueueWaitIdle(m_GraphicsQueueHandle); // waiting for the transfer queue to become idle
-
-			//vkFreeCommandBuffers(m_LogicalDevice, m_CommandPool, 1, &commandBuffer); // clean command buffer
-
-		}
-
-		void Window::CreateIndexBuffer()
-		{
-			const VkDeviceSize bufferSize = sizeof(m_Indices[0]) * m_Indices.size();
-
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingBufferMemory;
-			CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-
-			void* data;
-			vkMapMemory(m_LogicalDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
-			memcpy(data, m_Indices.data(), (size_t)bufferSize);
-			vkUnmapMemory(m_LogicalDevice, stagingBufferMemory);
-
-			CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_IndexBuffer, m_IndexBufferMemory);
-
-			CopyBuffer(stagingBuffer, m_IndexBuffer, bufferSize);
-
-			vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-			vkFreeMemory(m_LogicalDevice, stagingBufferMemory, nullptr);
+			bufferAllocation = m_MemoryAllocator->AllocateForBuffer(buffer, properties); // allocates and binds at the (aligned) offset of the region
 		}
 
 		void Window::CreateDescriptorSetLayout()
@@ -1389,7 +1690,7 @@ namespace Vulkan_Engine
 			// uniform buffer layout binding
 			VkDescriptorSetLayoutBinding uboLayoutBinding = {}; // used to describe every binding 
 			uboLayoutBinding.binding = 0; // location of binding 
-			uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; // binding a uniform buffer 
+			uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; // binding a uniform buffer, the offset is given when binding the set
 			uboLayoutBinding.descriptorCount = 1; // specifies number descriptor types in this binding (can contain multiple)
 			uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // where in the pipeline is the descriptor being used (VK_SHADER_STAGE_ALL_GRAPHICS)
 			uboLayoutBinding.pImmutableSamplers = nullptr; //TODO: this is to do with image sampling 
@@ -1402,139 +1703,86 @@ namespace Vulkan_Engine
 			samplerLayoutBinding.pImmutableSamplers = nullptr;
 			samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
-			std::array<VkDescriptorSetLayoutBinding, 2> bindings = { uboLayoutBinding, samplerLayoutBinding };
-
-			
-			VkDescriptorSetLayoutCreateInfo layoutInfo = {};
-			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-			layoutInfo.bindingCount = bindings.size();
-			layoutInfo.pBindings = bindings.data();
+			// owned by the cache, which destroys it on cleanup
+			m_DescriptorSetLayout = m_DescriptorLayoutCache->GetLayout({ uboLayoutBinding, samplerLayoutBinding });
+		}
 
-			if (vkCreateDescriptorSetLayout(m_LogicalDevice, &layoutInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS) 
-			{
-				static const std::string message = "[GraphicsSystem::Window::CreataDescriptorSetLayout]: Failed to create descriptor set layout!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
-			}
+		void Window::CreateDescriptorAllocator()
+		{
+			// pools are created as sets are allocated (and grow when one fills up), so no set count is fixed up front
+			m_DescriptorLayoutCache = CreateScope<DescriptorLayoutCache>(m_LogicalDevice);
+			m_DescriptorAllocator = CreateScope<DescriptorAllocator>(m_LogicalDevice, MAX_FRAMES_IN_FLIGHT);
 		}
 
 		void Window::CreateUniformBuffers()
 		{
-			const VkDeviceSize bufferSize = sizeof(UniformBuffer);
-			
-			m_UniformBuffers.resize(m_SwapChainImages.size());
-			m_UniformBuffersMemory.resize(m_SwapChainImages.size());
-
-			for (size_t i = 0; i < m_SwapChainImages.size(); i++) 
-			{
-				CreateBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_UniformBuffers[i], m_UniformBuffersMemory[i]);
-			}
+			// dynamic offsets have to be multiples of minUniformBufferOffsetAlignment
+			VkPhysicalDeviceProperties physicalDeviceProperties;
+			vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+			m_UniformBuffer = CreateScope<UniformRingBuffer>(m_LogicalDevice, *m_MemoryAllocator, MAX_FRAMES_IN_FLIGHT, UNIFORM_FRAME_SIZE,
+				physicalDeviceProperties.limits.minUniformBufferOffsetAlignment);
 		}
 
-		void Window::CreateDescriptorPool()
+		void Window::CreateDescriptorSets()
 		{
-			// define which descriptor types our sets contain & how many of them
-			std::array<VkDescriptorPoolSize, 2> poolSizes = {};
-			poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; // pool 0 is for the uniform buffer
-			poolSizes[0].descriptorCount = static_cast<uint32_t>(m_SwapChainImages.size());
-			poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; // pool 1 is for the image sampler 
-			poolSizes[1].descriptorCount = static_cast<uint32_t>(m_SwapChainImages.size());
-			
-			// references the pool size 
-			VkDescriptorPoolCreateInfo poolInfo = {};
-			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-			poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-			poolInfo.pPoolSizes = poolSizes.data();
-			poolInfo.maxSets = static_cast<uint32_t>(m_SwapChainImages.size());; // max number of sets to be allocated
-
-			if (vkCreateDescriptorPool(m_LogicalDevice, &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+			m_DescriptorSet = m_DescriptorAllocator->Allocate(m_DescriptorSetLayout, GetDescriptorWrites(m_UniformBuffer->GetBuffer()));
+			if (m_BindlessDescriptors)
 			{
-				static const std::string message = "[GraphicsSystem::Window::CreataDescriptorSetLayout]: Failed to create descriptor pool!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
+				// the scene's objects use material 0 (SceneObject::MaterialId)
+				MaterialData material;
+				material.AlbedoTexture = m_BindlessDescriptors->AddTexture(m_TextureImageView, m_TextureSampler);
+				m_BindlessDescriptors->AddMaterial(material);
 			}
 		}
 
-		void Window::CreateDescriptorSets()
+#if BINDLESS_DESCRIPTORS
+		void Window::CreateBindlessDescriptors()
 		{
-			std::vector<VkDescriptorSetLayout> layouts(m_SwapChainImages.size(), m_DescriptorSetLayout); // set of descriptor layouts 
-			VkDescriptorSetAllocateInfo allocInfo = {};
-			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			allocInfo.descriptorPool = m_DescriptorPool;
-			allocInfo.descriptorSetCount = static_cast<uint32_t>(m_SwapChainImages.size());
-			allocInfo.pSetLayouts = layouts.data();
-
-			m_DescriptorSets.resize(m_SwapChainImages.size());
-			if (vkAllocateDescriptorSets(m_LogicalDevice, &allocInfo, m_DescriptorSets.data()) != VK_SUCCESS) 
+			// the material id reaches the fragment shader through the instance data, so the set needs the instanced vertex shader
+			if (!m_DescriptorIndexingEnabled || !m_InstancedRendering)
 			{
-				static const std::string message = "[GraphicsSystem::Window::CreataDescriptorSetLayout]: Failed to allocate descriptor set!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
+				VK_CORE_WARN("[GraphicsSystem::Window::CreateBindlessDescriptors]: Descriptor indexing {0}, instancing {1} -> drawing with the classic descriptor set",
+					m_DescriptorIndexingEnabled, m_InstancedRendering);
+				return;
 			}
-
-			// populate every descriptor in pool created above
-			for (size_t i = 0; i < m_SwapChainImages.size(); i++) 
-			{				
-				VkDescriptorBufferInfo bufferInfo = {}; // buffer info
-				bufferInfo.buffer = m_UniformBuffers[i];
-				bufferInfo.offset = 0;
-				bufferInfo.range = sizeof(UniformBuffer);
-
-				VkDescriptorImageInfo imageInfo = {}; // image info 
-				imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-				imageInfo.imageView = m_TextureImageView;
-				imageInfo.sampler = m_TextureSampler;
-
-				std::array<VkWriteDescriptorSet, 2> descriptorWrites = {};
-
-				descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				descriptorWrites[0].dstSet = m_DescriptorSets[i];
-				descriptorWrites[0].dstBinding = 0;
-				descriptorWrites[0].dstArrayElement = 0;
-				descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-				descriptorWrites[0].descriptorCount = 1;
-				descriptorWrites[0].pBufferInfo = &bufferInfo;
-
-				descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				descriptorWrites[1].dstSet = m_DescriptorSets[i];
-				descriptorWrites[1].dstBinding = 1;
-				descriptorWrites[1].dstArrayElement = 0;
-				descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-				descriptorWrites[1].descriptorCount = 1;
-				descriptorWrites[1].pImageInfo = &imageInfo;
-
-				vkUpdateDescriptorSets(m_LogicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
-				
-				//VkWriteDescriptorSet descriptorWrite = {};
-				//descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				//descriptorWrite.dstSet = m_DescriptorSets[i]; // set to update
-				//descriptorWrite.dstBinding = 0; // destination binding of set 
-				//descriptorWrite.dstArrayElement = 0; // at which index to start from 
-				//descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; 
-				//descriptorWrite.descriptorCount = 1; // how many array elements to update
-				//descriptorWrite.pBufferInfo = &bufferInfo; // buffer data
-				//descriptorWrite.pImageInfo = nullptr; // image data
-				//descriptorWrite.pTexelBufferView = nullptr; // buffer views
-				//vkUpdateDescriptorSets(m_LogicalDevice, 1, &descriptorWrite, 0, nullptr);
+			if (!std::filesystem::exists(BINDLESS_FRAGMENT_SHADER_PATH))
+			{
+				VK_CORE_WARN("[GraphicsSystem::Window::CreateBindlessDescriptors]: Bindless fragment shader is missing (run Compile_GLSL_to_SPV), drawing with the classic descriptor set");
+				return;
 			}
+			m_BindlessDescriptors = CreateScope<BindlessDescriptors>(m_LogicalDevice, *m_MemoryAllocator, *m_DescriptorLayoutCache, m_MaxBindlessTextures, MAX_MATERIALS);
+			VK_CORE_INFO("[GraphicsSystem::Window::CreateBindlessDescriptors]: Bindless descriptors -> {0} textures, {1} materials", m_MaxBindlessTextures, MAX_MATERIALS);
+		}
+#endif
+
+		DescriptorWrites Window::GetDescriptorWrites(VkBuffer uniformBuffer) const
+		{
+			DescriptorWrites writes;
+			writes.WriteBuffer(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, uniformBuffer, 0, sizeof(UniformBuffer)); // the dynamic offset is added on top when the set is bound
+			writes.WriteImage(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_TextureImageView, m_TextureSampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			return writes;
 		}
 
-		void Window::UpdateUniformBuffer(uint32_t imageIndex, const Timestep deltaTime)
+		void Window::UpdateUniformBuffer(const Timestep deltaTime)
 		{
 			static auto startTime = std::chrono::high_resolution_clock::now();
 
 			const auto currentTime = std::chrono::high_resolution_clock::now();
 			const float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
 			UniformBuffer ubo = {};
-			ubo.Model = glm::rotate(glm::mat4(1.0f), time * ROTATION_MULTIPLIER * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-			ubo.View = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-			ubo.Projection = glm::perspective(glm::radians(45.0f), float(m_WindowData.Properties.Width) / float(m_WindowData.Properties.Height), 0.1f, 10.0f);
+			m_ModelMatrix = glm::rotate(glm::mat4(1.0f), time * ROTATION_MULTIPLIER * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+			ubo.Model = m_ModelMatrix * m_VertexDequantization; // only read by shaders without the instance buffer / push constant transforms
+			ubo.View = glm::lookAt(CAMERA_POSITION, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+			ubo.Projection = glm::perspective(CAMERA_FOV_Y, float(m_WindowData.Properties.Width) / float(m_WindowData.Properties.Height), 0.1f, 10.0f);
 			ubo.Projection[1][1] *= -1;
-
-			void* data;
-			vkMapMemory(m_LogicalDevice, m_UniformBuffersMemory[imageIndex], 0, sizeof(ubo), 0, &data);
-			memcpy(data, &ubo, sizeof(ubo));
-			vkUnmapMemory(m_LogicalDevice, m_UniformBuffersMemory[imageIndex]);
+			m_ViewMatrix = ubo.View; // the cull pass builds its frustum from the same camera
+			m_ProjectionMatrix = ubo.Projection;
+			m_Scene.SetTransform(m_ObjectId, m_ModelMatrix);
+			m_Scene.Update(); // refits the scene hierarchy to the moved object
+
+			// the frame's fence has signaled, so its arena is rewound and written linearly through the persistent mapping
+			m_UniformBuffer->Begin(static_cast<uint32_t>(m_CurrentFrame));
+			m_UniformBuffer->Write(ubo, m_UniformOffset);
 		}
 
 		void Window::CreateTextureImage()
@@ -1542,7 +1790,6 @@ namespace Vulkan_Engine
 			// load image data from file using stbi 
 			int texWidth, texHeight, texChannels;
 			stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-			VkDeviceSize imageSize = texWidth * texHeight * 4; //TODO: Deal with this isue 
 
 			// value for mip map levels (possible ones) can be queried upon texture information gathering
 			m_MipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
@@ -1554,23 +1801,9 @@ namespace Vulkan_Engine
 				throw std::runtime_error(message);
 			}
 
-			// transfer data from image pixels to VkImage object
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingBufferMemory;
-			// create host visible memory buffer
-			CreateBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-			// directly copy pixel values from image to buffer
-			void* data;
-			vkMapMemory(m_LogicalDevice, stagingBufferMemory, 0, imageSize, 0, &data);
-			memcpy(data, pixels, static_cast<size_t>(imageSize));
-			vkUnmapMemory(m_LogicalDevice, stagingBufferMemory);
-
-			// clean up image data 
-			stbi_image_free(pixels);
-
 			// create the image
 			// VK_IMAGE_USAGE_TRANSFER_SRC_BIT -> As using VkCmdBlit (a transfer operation), using texture as both source and destination of a transfer
-			CreateImage(texWidth, texHeight, m_MipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageMemory);
+			CreateImage(texWidth, texHeight, m_MipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageAllocation);
 
 			// copy the staging buffer to texture image
 			// 1. Transition the texture image to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
@@ -1579,21 +1812,21 @@ namespace Vulkan_Engine
 			
 			TransitionImageLayout(m_TextureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_MipLevels);
 
-			CopyBufferToImage(stagingBuffer, m_TextureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+			// pixels are copied into the staging ring straight away, so the image data can be freed once recorded
+			m_UploadContext->UploadImage(m_TextureImage, pixels, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), 4);
+			stbi_image_free(pixels);
+			// blits need a graphics queue, so the image is handed over before generating the mip chain
+			m_UploadContext->TransferImageOwnership(m_TextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_MipLevels);
 
 			// prepare texture data for shader access
 			//TODO: Removed this transition, as adding it in other pipeline barriers.
 			//TransitionImageLayout(m_TextureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_MipLevels);
 
-			// cleanup staging buffer memory 
-			vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-			vkFreeMemory(m_LogicalDevice, stagingBufferMemory, nullptr);
-
 			GenerateMipmaps(m_TextureImage, VK_FORMAT_R8G8B8A8_UNORM, texWidth, texHeight, m_MipLevels);
 
 		}
 
-		void Window::CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory)
+		void Window::CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, DeviceAllocation& imageAllocation)
 		{
 			VkImageCreateInfo imageInfo = {};
 			imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -1617,27 +1850,12 @@ namespace Vulkan_Engine
 				throw std::runtime_error(message);
 			}
 
-			VkMemoryRequirements memRequirements;
-			vkGetImageMemoryRequirements(m_LogicalDevice, image, &memRequirements);
-
-			VkMemoryAllocateInfo allocInfo = {};
-			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			allocInfo.allocationSize = memRequirements.size;
-			allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties, m_PhysicalDevice);
-
-			if (vkAllocateMemory(m_LogicalDevice, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) 
-			{
-				static const std::string message = "[GraphicsSystem::Window::CreateImage]: Failed to allocate image memory!";
-				VK_CORE_CRITICAL(message);
-				throw std::runtime_error(message);
-			}
-
-			vkBindImageMemory(m_LogicalDevice, image, imageMemory, 0);
+			imageAllocation = m_MemoryAllocator->AllocateForImage(image, properties, tiling == VK_IMAGE_TILING_LINEAR);
 		}
 
 		void Window::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels)
 		{
-			VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+			const VkCommandBuffer commandBuffer = m_UploadContext->GetTransferCommandBuffer(); // recorded into the current upload batch (transfer queue)
 
 			// used to synchronize access to thge resources 
 			VkImageMemoryBarrier barrier = {};
@@ -1687,44 +1905,8 @@ namespace Vulkan_Engine
 				0, nullptr,
 				1, &barrier
 			);
-			
-			EndSingleTimeCommands(commandBuffer);
 		}
 
-		void Window::CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
-		{
-			VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-			// used to specify which part of the buffer is going to be copied to which part of the image 
-			VkBufferImageCopy region = {};
-			region.bufferOffset = 0;
-			region.bufferRowLength = 0;
-			region.bufferImageHeight = 0;
-			
-			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			region.imageSubresource.mipLevel = 0;
-			region.imageSubresource.baseArrayLayer = 0;
-			region.imageSubresource.layerCount = 1;
-			
-			region.imageOffset = { 0, 0, 0 };
-			region.imageExtent = {
-				width,
-				height,
-				1
-			};
-
-			// buffer to image copy operations enqueue
-			vkCmdCopyBufferToImage(
-				commandBuffer,
-				buffer,
-				image,
-				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-				1,
-				&region
-			);
-			
-			EndSingleTimeCommands(commandBuffer);
-		}
 
 		void Window::CreateTextureImageView()
 		{
@@ -1806,7 +1988,7 @@ namespace Vulkan_Engine
 				throw std::runtime_error(message);
 			}
 			
-			const VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+			const VkCommandBuffer commandBuffer = m_UploadContext->GetGraphicsCommandBuffer(); // blits run on the graphics queue once the copy is acquired
 
 			VkImageMemoryBarrier barrier = {}; // will be reused for multiple transitions
 			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -1885,99 +2067,51 @@ namespace Vulkan_Engine
 				0, nullptr,
 				0, nullptr,
 				1, &barrier);
-			
-			EndSingleTimeCommands(commandBuffer);
 		}
 
-		VkCommandBuffer Window::BeginSingleTimeCommands()
+#if GPU_CULLING
+		void Window::CreateGpuCulling()
 		{
-			VkCommandBufferAllocateInfo allocInfo = {};
-			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-			allocInfo.commandPool = m_CommandPool;
-			allocInfo.commandBufferCount = 1;
-
-			VkCommandBuffer commandBuffer;
-			vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &commandBuffer);
-
-			VkCommandBufferBeginInfo beginInfo = {};
-			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-			vkBeginCommandBuffer(commandBuffer, &beginInfo);
-
-			return commandBuffer;
+			if (m_PushConstantStages != 0 && !m_InstancedRendering)
+			{
+				VK_CORE_INFO("[GraphicsSystem::Window::CreateGpuCulling]: Transforms are pushed per draw, which the compacted indirect draws can't carry, drawing without gpu culling");
+				return;
+			}
+			if (m_InstancedRendering && !m_DrawIndirectFirstInstance)
+			{
+				VK_CORE_INFO("[GraphicsSystem::Window::CreateGpuCulling]: No drawIndirectFirstInstance, instanced batches are drawn directly and culled on the cpu");
+				return;
+			}
+			if (!GpuCuller::AreShadersAvailable())
+			{
+				VK_CORE_WARN("[GraphicsSystem::Window::CreateGpuCulling]: Culling shaders are missing (run Compile_GLSL_to_SPV), drawing without gpu culling");
+				return;
+			}
+			m_GpuCuller = CreateScope<GpuCuller>(m_LogicalDevice, *m_MemoryAllocator, m_PipelineCache->GetPipelineCache(), MAX_FRAMES_IN_FLIGHT, MAX_INDIRECT_DRAWS);
+			m_GpuCuller->SetDepthImage(m_DepthImage, m_DepthImageView, FindDepthFormat(m_PhysicalDevice), m_SwapChainExtent, m_MsaaSamples);
 		}
+#endif
 
-		void Window::EndSingleTimeCommands(VkCommandBuffer commandBuffer)
-		{
-			vkEndCommandBuffer(commandBuffer);
-
-			VkSubmitInfo submitInfo = {};
-			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.commandBufferCount = 1;
-			submitInfo.pCommandBuffers = &commandBuffer;
-
-			vkQueueSubmit(m_GraphicsQueueHandle, 1, &submitInfo, VK_NULL_HANDLE);
-			vkQueueWaitIdle(m_GraphicsQueueHandle);
-
-			vkFreeCommandBuffers(m_LogicalDevice, m_CommandPool, 1, &commandBuffer);
-		}
-		
 		void Window::CreateDepthResources()
 		{
 			VkFormat depthFormat = FindDepthFormat(m_PhysicalDevice);
-			CreateImage(m_SwapChainExtent.width, m_SwapChainExtent.height,1, m_MsaaSamples, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_DepthImage, m_DepthImageMemory);
+#if GPU_CULLING
+			const VkImageUsageFlags depthUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT; // read by the depth pyramid build
+#else
+			const VkImageUsageFlags depthUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+#endif
+			CreateImage(m_SwapChainExtent.width, m_SwapChainExtent.height,1, m_MsaaSamples, depthFormat, VK_IMAGE_TILING_OPTIMAL, depthUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_DepthImage, m_DepthImageAllocation);
 			m_DepthImageView = CreateImageView(m_DepthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 1);
+			if (m_GpuCuller) // recreated with the swap chain, the pyramid follows the new extent
+			{
+				m_GpuCuller->SetDepthImage(m_DepthImage, m_DepthImageView, depthFormat, m_SwapChainExtent, m_MsaaSamples);
+			}
 		}
 #if LOAD_MODEL
 		void Window::LoadModel()
 		{
-			tinyobj::attrib_t attrib;
-			std::vector<tinyobj::shape_t> shapes;
-			std::vector<tinyobj::material_t> materials;
-			std::string warn, err;
-
-			if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str())) 
-			{
-				VK_CORE_CRITICAL("{0}, {1}",warn.c_str(), err.c_str());
-				throw std::runtime_error(warn + err);
-			}
-
-			std::unordered_map<Vertex, uint32_t> uniqueVertices = {};
-
-			for (const auto& shape : shapes) 
-			{
-				for (const auto& index : shape.mesh.indices) {
-					Vertex vertex = {};
-
-					vertex.Position =
-					{
-					attrib.vertices[3 * index.vertex_index + 0],
-					attrib.vertices[3 * index.vertex_index + 1],
-					attrib.vertices[3 * index.vertex_index + 2]
-					};
-
-					vertex.TexCoord =
-					{
-						attrib.texcoords[2 * index.texcoord_index + 0],
-						1.0f - attrib.texcoords[2 * index.texcoord_index + 1] // flipping this as vulkan expects orientation where 0 means top of image
-					};
-
-					vertex.Color = { 1.0f, 1.0f, 1.0f };
-					
-					//m_Vertices.push_back(vertex); // assuming every vertex is unique
-
-					if (uniqueVertices.count(vertex) == 0)  // check if a vertex exists in our map
-					{
-						uniqueVertices[vertex] = static_cast<uint32_t>(m_Vertices.size());
-						m_Vertices.push_back(vertex); // only add the vertex if its unique
-					}
-
-					m_Indices.push_back(uniqueVertices[vertex]);
-					//m_Indices.push_back(m_Indices.size());
-				}
-			}
+			// the obj is only parsed when there is no up to date binary mesh for it
+			m_Mesh = MeshFile::LoadObj(MODEL_PATH, MODEL_CACHE_PATH);
 		}
 #endif
 		
@@ -2001,7 +2135,7 @@ namespace Vulkan_Engine
 		{
 			VkFormat colorFormat = m_SwapChainImageFormat;
 
-			CreateImage(m_SwapChainExtent.width, m_SwapChainExtent.height, 1, m_MsaaSamples, colorFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_ColorImage, m_ColorImageMemory);
+			CreateImage(m_SwapChainExtent.width, m_SwapChainExtent.height, 1, m_MsaaSamples, colorFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_ColorImage, m_ColorImageAllocation);
 			m_ColorImageView = CreateImageView(m_ColorImage, colorFormat, VK_IMAGE_ASPECT_COLOR_BIT, 1);
 		}
 
@@ -19,12 +19,36 @@
 #include <GLFW/glfw3.h>
 
 #include "Core/Events/Event.h"
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+#include "Core/Graphics/Transfer/UploadContext.h"
+#include "Core/Graphics/Memory/GeometryPool.h"
+#include "Core/Graphics/Memory/UniformRingBuffer.h"
+#include "Core/Graphics/Commands/DrawList.h"
+#include "Core/Graphics/Commands/IndirectDrawBuffer.h"
+#include "Core/Graphics/Commands/InstanceBatcher.h"
+#include "Core/Graphics/Commands/InstanceBuffer.h"
+#include "Core/Graphics/Descriptors/BindlessDescriptors.h"
+#include "Core/Graphics/Descriptors/DescriptorAllocator.h"
+#include "Core/Graphics/Descriptors/DescriptorLayoutCache.h"
+#include "Core/Graphics/Culling/GpuCuller.h"
+#include "Core/Graphics/Culling/FrustumCuller.h"
+#include "Core/Scene/Scene.h"
+#include "Core/Graphics/Commands/FrameCommandPool.h"
+#include "Core/Graphics/Commands/ParallelCommandRecorder.h"
+#include "Core/Timers/Timer.h"
+#include "Core/Graphics/Mesh/MeshFile.h"
+#include "PipelineCache.h"
 
 #include "Shaders/Shader.h"
+#include "Shaders/ShaderLibrary.h"
 #include "Shaders/Vertex.h"
 #include "Shaders/UniformBuffer.h"
 
 #define LOAD_MODEL 0
+#define QUANTIZE_VERTICES 1 // uploads the 16 byte QuantizedVertex instead of the 32 byte Vertex
+#define GPU_CULLING 1 // frustum and hi-z occlusion culling in a compute pass before the draws
+#define INSTANCED_RENDERING 1 // objects sharing a mesh and level of detail are drawn by one record, transforms come from an instance buffer
+#define BINDLESS_DESCRIPTORS 1 // textures and materials are indexed from one descriptor set bound once, instead of a set per material
 
 namespace Vulkan_Engine
 {
@@ -73,6 +97,24 @@ namespace Vulkan_Engine
 			_NODISCARD GLFWwindow* GetWindow() const { return m_Window; }
 			void SetEventCallback(const EventCallbackFunction& callback);
 			void SetVSync(const bool enabled);
+		private:
+			// resources replaced by RecreateSwapChain that frames still in flight may reference
+			struct RetiredSwapChain
+			{
+				VkSwapchainKHR SwapChain = VK_NULL_HANDLE;
+				std::vector<VkImageView> ImageViews;
+				std::vector<VkFramebuffer> Framebuffers;
+				VkImage ColorImage = VK_NULL_HANDLE;
+				DeviceAllocation ColorImageAllocation;
+				VkImageView ColorImageView = VK_NULL_HANDLE;
+				VkImage DepthImage = VK_NULL_HANDLE;
+				DeviceAllocation DepthImageAllocation;
+				VkImageView DepthImageView = VK_NULL_HANDLE;
+				VkRenderPass RenderPass = VK_NULL_HANDLE; // the pipeline objects are only retired when the surface format changed
+				VkPipeline GraphicsPipeline = VK_NULL_HANDLE;
+				VkPipelineLayout PipelineLayout = VK_NULL_HANDLE;
+				uint64_t SubmittedFrames = 0; // frames submitted before it was retired, the last of them is the last user
+			};
 		private:
 			void InitWindow();
 			// glfw 
@@ -88,53 +130,62 @@ namespace Vulkan_Engine
 			std::vector<const char*> GetAllRequiredExtensions() const;
 			void InitVulkanPhysicalDevice();
 			void InitVulkanLogicalDevice();
+			void CreateMemoryAllocator();
+			void CreateUploadContext();
+			void CreatePipelineCache();
+			void CreateShaderLibrary();
 			void CreateVulkanSwapChain(); 
 			void CreateVulkanImageViews();
 			void CreateGraphicsRenderPass(); 
 			void CreateGraphicsPipeline();
 			void CreateFramebuffers();
-			void CreateCommandPool();
-			void CreateCommandBuffers();
+			void CreateFrameCommandPools();
+			void BuildDrawList();
+			VkCommandBuffer RecordFrameCommandBuffer(uint32_t imageIndex);
 			///////////////////////////////
 			void CreateSyncObjects();
 			void RenderFrame(const Timestep deltaTime);
 			///////////////////////////////
 			//// Everything that has to do with swap chain recreation
 			///////////////////////////////
-			void CleanupSwapChain();
+			void CleanupSwapChain(); // extent dependent resources: swap chain image views, msaa / depth images and framebuffers (device idle)
 			void RecreateSwapChain();
+			void RetireSwapChain(); // moves the swap chain and its extent dependent resources to m_RetiredSwapChains
+			void DestroyRetiredSwapChain(RetiredSwapChain& retired);
+			void ReleaseRetiredSwapChains(); // destroys the retired swap chains no frame in flight uses anymore
 			///////////////////////////////
 			// Vertex buffer data
 			///////////////////////////////
-			void CreateVertexBuffer();  // does not depend on swap chain
-			void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory); // abstracted buffer creation function 
-			void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
-			void CreateIndexBuffer();
+			void CreateGeometry(); // does not depend on swap chain
+			void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, DeviceAllocation& bufferAllocation); // abstracted buffer creation function 
 			///////////////////////////////
 			// Descriptor layouts (uniform buffers)
 			///////////////////////////////
+			void CreateDescriptorAllocator(); // before any layout or set is created
 			void CreateDescriptorSetLayout();
-			void CreateUniformBuffers();
-			void CreateDescriptorPool();
+			void CreateUniformBuffers(); // does not depend on swap chain (one arena per frame in flight)
 			void CreateDescriptorSets();
-			void UpdateUniformBuffer(uint32_t imageIndex, const Timestep deltaTime);
+			DescriptorWrites GetDescriptorWrites(VkBuffer uniformBuffer) const; // a uniform arena and the texture
+#if BINDLESS_DESCRIPTORS
+			void CreateBindlessDescriptors(); // before the pipeline, skipped without descriptor indexing or instancing
+#endif
+			void UpdateUniformBuffer(const Timestep deltaTime);
 			///////////////////////////////
 			// Texture Mapping 
 			///////////////////////////////
 			void CreateTextureImage();
-			void CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
+			void CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, DeviceAllocation& imageAllocation);
 			void TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels);
-			void CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
 			void CreateTextureImageView();
 			void CreateTextureSampler();
 			VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels);
 			// mip map generation
 			void GenerateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
-			// recording and executing command buffer abstractions 
-			VkCommandBuffer BeginSingleTimeCommands();
-			void EndSingleTimeCommands(VkCommandBuffer commandBuffer);
 			// depth buffer stuff
 			void CreateDepthResources();
+#if GPU_CULLING
+			void CreateGpuCulling(); // after the depth resources, skipped if the compute shaders are missing
+#endif
 			// msaa utility functions
 			VkSampleCountFlagBits GetMaxUsableSampleCount();
 			void CreateColorResources(); 
@@ -148,31 +199,48 @@ namespace Vulkan_Engine
 			VkDebugUtilsMessengerEXT m_DebugCallbackMessenger;
 			VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
 			VkDevice m_LogicalDevice;
+			Scope<DeviceMemoryAllocator> m_MemoryAllocator; // sub-allocates every buffer and image from large memory blocks
+			Scope<UploadContext> m_UploadContext; // batches staging copies into fence tracked submissions
+			Scope<PipelineCache> m_PipelineCache; // loaded at startup and saved on cleanup, speeds up pipeline creation
+			Scope<ShaderLibrary> m_ShaderLibrary; // shader modules kept across swap chain recreation, derives the pipeline layout
 			VkQueue m_GraphicsQueueHandle; // handle for graphics queue
 			VkQueue m_PresentQueueHandle; // handle for presentation queue
+			VkQueue m_TransferQueueHandle; // handle for the dedicated transfer queue (graphics queue if the device has none)
+			VkQueue m_ComputeQueueHandle; // handle for the async compute queue (graphics queue if the device has none)
+			bool m_TimelineSemaphoresEnabled = false; // VK_KHR_timeline_semaphore
+			bool m_DescriptorIndexingEnabled = false; // VK_EXT_descriptor_indexing with the features BindlessDescriptors relies on
+			bool m_DrawIndirectFirstInstance = false; // the drawIndirectFirstInstance feature, indirect records may start past instance 0
+			uint32_t m_MaxBindlessTextures = 0; // texture array size, clamped to the device's update after bind limits
 			VkSurfaceKHR m_WindowSurface;// window surface (create directly after instance creation as can affect physical device)
-			VkSwapchainKHR m_SwapChain;
+			VkSwapchainKHR m_SwapChain = VK_NULL_HANDLE;
 			std::vector<VkImage> m_SwapChainImages;
 			std::vector<VkImageView> m_SwapChainImageViews; // describes how to access an image, and which part of the image to access.
 			VkFormat m_SwapChainImageFormat;
 			VkExtent2D m_SwapChainExtent;
 			VkRenderPass m_RenderPass;
-			VkDescriptorSetLayout m_DescriptorSetLayout; // descriptor set layout (combines all descriptor bindings)
+			Scope<DescriptorLayoutCache> m_DescriptorLayoutCache; // owns every descriptor set layout
+			Scope<DescriptorAllocator> m_DescriptorAllocator; // growable descriptor pools, persistent and per frame sets
+			VkDescriptorSetLayout m_DescriptorSetLayout; // descriptor set layout (combines all descriptor bindings), owned by the layout cache
 			VkPipelineLayout m_PipelineLayout;
 			VkPipeline m_GraphicsPipeline;
+			VkShaderStageFlags m_PushConstantStages = 0; // stages reading DrawPushConstants, 0 if the shaders were compiled without the block
 			std::vector<VkFramebuffer> m_SwapChainFramebuffers;
-			VkCommandPool m_CommandPool;
-			std::vector<VkCommandBuffer> m_CommandBuffers;
+			std::vector<Scope<FrameCommandPool>> m_FrameCommandPools; // one transient pool per frame in flight
+			Scope<ParallelCommandRecorder> m_CommandRecorder; // records large draw lists into secondary command buffers on several threads
+			DrawList m_DrawList; // rebuilt every frame
+			TimerStatistics m_RecordTimings; // cpu time spent building and recording the frame command buffer
+			TimerStatistics m_ResizeTimings; // time RecreateSwapChain takes, logged on every resize
 			//////////////////////////////////////////////// (each frame should have its own) 
 			std::vector<VkSemaphore> m_ImageAvailableSemaphores; // signal image has been acquired & ready for rendering
 			std::vector<VkSemaphore> m_RenderFinishedSemaphores; // signal that rendering has finished & presentation can happen
 			std::vector<VkFence> m_InFlightFences; // used for cpu <-> gpu synchronization
 			std::vector<VkFence> m_ImagesInFlight; // used to track for each swap chain image, if a frame in flight is currently using it
 			size_t m_CurrentFrame = 0; // frame index used to keep track of the current frame for correct semaphore usage
+			uint64_t m_SubmittedFrames = 0; // frame k waits for the fence of frame k - MAX_FRAMES_IN_FLIGHT, which orders the retire list
+			std::vector<RetiredSwapChain> m_RetiredSwapChains; // replaced on resize, destroyed once the frames recorded with them have finished
 #if LOAD_MODEL
 			// model loading
-			std::vector<Vertex> m_Vertices;
-			std::vector<uint32_t> m_Indices;
+			Scope<MeshFile> m_Mesh; // memory mapped, released once the vertex and index data is in staging
 			// load model function
 			void LoadModel();
 #else
@@ -194,30 +262,43 @@ namespace Vulkan_Engine
 				4, 5, 6, 6, 7, 4
 			};
 #endif
-			VkBuffer m_VertexBuffer; // does not depend on swap chain 
-			VkDeviceMemory m_VertexBufferMemory; // stores handle to buffer memory
-			VkBuffer m_IndexBuffer; // handle to index buffer 
-			VkDeviceMemory m_IndexBufferMemory;  // handle to index memory
-			std::vector<VkBuffer> m_UniformBuffers;
-			std::vector<VkDeviceMemory> m_UniformBuffersMemory;
-			VkDescriptorPool m_DescriptorPool;
-			std::vector<VkDescriptorSet> m_DescriptorSets;
+			Scope<GeometryPool> m_GeometryPool; // shared vertex / index buffers, does not depend on swap chain
+			uint32_t m_MeshId = 0; // the mesh's draw record in the geometry pool
+			Scene m_Scene; // world space objects and their bounding volume hierarchy
+			uint32_t m_ObjectId = 0; // the mesh's object in m_Scene
+			Scope<IndirectDrawBuffer> m_IndirectDraws; // draw records read by vkCmdDrawIndexedIndirect(Count)
+			Scope<GpuCuller> m_GpuCuller; // replaces the cpu written draw records when gpu culling is available
+			CullingBounds m_CullingBounds; // world space spheres of this frame's objects, culled on the cpu without the gpu culler
+			std::vector<uint8_t> m_Visibility; // FrustumCuller output, one bit per object in m_CullingBounds
+			std::vector<uint32_t> m_CandidateObjects; // scene object of every sphere in m_CullingBounds
+			bool m_InstancedRendering = false; // INSTANCED_RENDERING and the instanced vertex shader was found
+			InstanceBatcher m_InstanceBatcher; // this frame's visible objects grouped by mesh and level of detail
+			Scope<InstanceBuffer> m_InstanceBuffer; // per instance transforms and materials (vertex binding 1)
+			uint32_t m_SelectedLod = 0; // last frame's level, only used to log switches
+			glm::mat4 m_ModelMatrix = glm::mat4(1.0f); // this frame's model transform, without the vertex dequantization
+			glm::mat4 m_ViewMatrix = glm::mat4(1.0f); // this frame's camera, as written to the uniform buffer
+			glm::mat4 m_ProjectionMatrix = glm::mat4(1.0f);
+			glm::mat4 m_VertexDequantization = glm::mat4(1.0f); // maps quantized positions back to model space, applied before the model matrix
+			Scope<UniformRingBuffer> m_UniformBuffer; // every uniform block of a frame, bound through a dynamic offset
+			uint32_t m_UniformOffset = 0; // dynamic offset of this frame's UniformBuffer block
+			VkDescriptorSet m_DescriptorSet; // shared by every frame, the dynamic offset selects the frame's uniforms
+			Scope<BindlessDescriptors> m_BindlessDescriptors; // set 1 of the instanced pipeline, null when drawing with the classic set
 			// texture mapping stuff
 			// mipmap generation data
 			uint32_t m_MipLevels; // "mip chain"
 			VkImage m_TextureImage;
-			VkDeviceMemory m_TextureImageMemory;
+			DeviceAllocation m_TextureImageAllocation;
 			VkImageView m_TextureImageView;
 			VkSampler m_TextureSampler;
 			// depth buffer data
 			VkImage m_DepthImage;
-			VkDeviceMemory m_DepthImageMemory;
+			DeviceAllocation m_DepthImageAllocation;
 			VkImageView m_DepthImageView;
 
 			// multisampling variables (use the image, memory and view to sample the data in an off screen buffer)
 			VkSampleCountFlagBits m_MsaaSamples;
 			VkImage m_ColorImage;
-			VkDeviceMemory m_ColorImageMemory;
+			DeviceAllocation m_ColorImageAllocation;
 			VkImageView m_ColorImageView;
 		};
 	}
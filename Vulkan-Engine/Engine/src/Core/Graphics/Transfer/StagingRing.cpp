@@ -0,0 +1,77 @@
+/***************************************************************************
+ * Filename		: StagingRing.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Ring allocator over a persistently mapped staging buffer,
+ *				  regions are recycled once the batch using them retires.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "StagingRing.h"
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		StagingRing::StagingRing(VkDeviceSize capacity)
+			: m_Capacity(capacity)
+		{
+		}
+
+		bool StagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+		{
+			if (size == 0 || size > m_Capacity)
+			{
+				return false;
+			}
+			VkDeviceSize start = (m_Head + alignment - 1) / alignment * alignment;
+			if (start + size > m_Capacity)
+			{
+				start = 0; // not enough room before the end, skip the tail of the buffer and wrap
+			}
+			// free space is always the contiguous (circular) range after the head, so the padding
+			// before start plus the region itself has to fit into it
+			const VkDeviceSize padding = start >= m_Head ? start - m_Head : m_Capacity - m_Head;
+			const VkDeviceSize required = padding + size;
+			if (required > m_Capacity - m_Used)
+			{
+				return false;
+			}
+			m_Used += required;
+			m_OpenBatchSize += required;
+			m_Head = (start + size) % m_Capacity;
+			offset = start;
+			return true;
+		}
+
+		void StagingRing::CloseBatch(uint64_t batchId)
+		{
+			if (m_OpenBatchSize == 0)
+			{
+				return;
+			}
+			m_ClosedBatches.push_back({ batchId, m_OpenBatchSize });
+			m_OpenBatchSize = 0;
+		}
+
+		void StagingRing::Retire(uint64_t completedBatchId)
+		{
+			while (!m_ClosedBatches.empty() && m_ClosedBatches.front().BatchId <= completedBatchId)
+			{
+				m_Used -= m_ClosedBatches.front().Size;
+				m_ClosedBatches.pop_front();
+			}
+			if (m_Used == 0)
+			{
+				m_Head = 0; // ring is empty, restart at the front to avoid needless wrapping
+			}
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/***************************************************************************
+ * Filename		: StagingRing.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Ring allocator over a persistently mapped staging buffer,
+ *				  regions are recycled once the batch using them retires.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// Offsets are handed out in order and wrap around at the end of the buffer.
+		// Everything allocated between two CloseBatch calls belongs to that batch,
+		// and is only reused once Retire is called with an id >= the batch id.
+		// This class only does the bookkeeping, the buffer itself is owned by the UploadContext.
+		class StagingRing
+		{
+		public:
+			explicit StagingRing(VkDeviceSize capacity);
+			~StagingRing() = default;
+		public:
+			// returns false if the ring is too full right now (retire older batches and try again)
+			bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+			void CloseBatch(uint64_t batchId); // regions allocated since the last close now belong to batchId
+			void Retire(uint64_t completedBatchId); // releases every closed batch with an id <= completedBatchId
+			_NODISCARD VkDeviceSize GetCapacity() const { return m_Capacity; }
+			_NODISCARD VkDeviceSize GetUsedSize() const { return m_Used; }
+			_NODISCARD bool HasOpenRegions() const { return m_OpenBatchSize > 0; }
+			_NODISCARD bool HasClosedBatches() const { return !m_ClosedBatches.empty(); }
+			_NODISCARD uint64_t GetOldestBatch() const { return m_ClosedBatches.front().BatchId; }
+		private:
+			struct ClosedBatch
+			{
+				uint64_t BatchId;
+				VkDeviceSize Size; // bytes (including alignment / wrap padding) owned by the batch
+			};
+		private:
+			VkDeviceSize m_Capacity;
+			VkDeviceSize m_Head = 0; // next free byte
+			VkDeviceSize m_Used = 0; // bytes owned by open + closed batches
+			VkDeviceSize m_OpenBatchSize = 0;
+			std::deque<ClosedBatch> m_ClosedBatches; // oldest first
+		};
+	}
+}
@@ -0,0 +1,484 @@
+/***************************************************************************
+ * Filename		: UploadContext.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Batches buffer / image uploads through a persistently
+ *				  mapped staging ring into submissions on the transfer queue.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "UploadContext.h"
+
+#include "Core/Logger/Log.h"
+
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// vkCmdCopyBufferToImage requires the buffer offset to be a multiple of the texel size and of 4
+		static constexpr VkDeviceSize s_StagingAlignment = 16;
+
+		UploadContext::UploadContext(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, const UploadQueueInfo& queues, VkDeviceSize stagingCapacity)
+			: m_LogicalDevice(logicalDevice), m_Allocator(allocator), m_Queues(queues), m_DedicatedTransfer(queues.TransferFamily != queues.GraphicsFamily), m_Ring(stagingCapacity)
+		{
+			m_TransferCommandPool = CreateCommandPool(m_Queues.TransferFamily);
+			if (m_DedicatedTransfer)
+			{
+				m_GraphicsCommandPool = CreateCommandPool(m_Queues.GraphicsFamily);
+			}
+
+			if (m_Queues.TimelineSemaphores)
+			{
+				m_WaitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(m_LogicalDevice, "vkWaitSemaphoresKHR");
+				m_GetSemaphoreCounterValue = (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(m_LogicalDevice, "vkGetSemaphoreCounterValueKHR");
+				VkSemaphoreTypeCreateInfoKHR timelineInfo = {};
+				timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+				timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+				timelineInfo.initialValue = 0;
+				VkSemaphoreCreateInfo semaphoreInfo = {};
+				semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				semaphoreInfo.pNext = &timelineInfo;
+				if (m_WaitSemaphores == nullptr || m_GetSemaphoreCounterValue == nullptr 
+					|| vkCreateSemaphore(m_LogicalDevice, &semaphoreInfo, nullptr, &m_TransferTimeline) != VK_SUCCESS
+					|| (m_DedicatedTransfer && vkCreateSemaphore(m_LogicalDevice, &semaphoreInfo, nullptr, &m_GraphicsTimeline) != VK_SUCCESS))
+				{
+					VK_CORE_WARN("[GraphicsSystem::UploadContext]: Timeline semaphore unavailable, tracking uploads with fences");
+					m_Queues.TimelineSemaphores = false;
+				}
+			}
+
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = stagingCapacity;
+			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (vkCreateBuffer(m_LogicalDevice, &bufferInfo, nullptr, &m_StagingBuffer) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::UploadContext::UploadContext]: Failed to create staging buffer!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			// mapped once for the lifetime of the context, coherent so no flushes are needed before submitting
+			m_StagingAllocation = m_Allocator.AllocateForBuffer(m_StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			VK_CORE_INFO("[GraphicsSystem::UploadContext]: Created {0} MB staging ring ({1} transfer queue, {2})", stagingCapacity / (1024 * 1024),
+				m_DedicatedTransfer ? "dedicated" : "graphics", m_Queues.TimelineSemaphores ? "timeline semaphore" : "fences");
+		}
+
+		UploadContext::~UploadContext()
+		{
+			WaitIdle();
+			if (m_OpenBatch.TransferCommandBuffer != VK_NULL_HANDLE)
+			{
+				// recorded but never submitted, just drop it
+				vkEndCommandBuffer(m_OpenBatch.TransferCommandBuffer);
+				if (m_OpenBatch.GraphicsRecording)
+				{
+					vkEndCommandBuffer(m_OpenBatch.GraphicsCommandBuffer);
+				}
+				m_FreeBatches.push_back(m_OpenBatch);
+			}
+			for (UploadBatch& batch : m_FreeBatches)
+			{
+				vkDestroyFence(m_LogicalDevice, batch.Fence, nullptr);
+				vkDestroySemaphore(m_LogicalDevice, batch.TransferSemaphore, nullptr);
+			}
+			vkDestroySemaphore(m_LogicalDevice, m_TransferTimeline, nullptr);
+			vkDestroySemaphore(m_LogicalDevice, m_GraphicsTimeline, nullptr);
+			vkDestroyCommandPool(m_LogicalDevice, m_TransferCommandPool, nullptr); // frees every command buffer
+			vkDestroyCommandPool(m_LogicalDevice, m_GraphicsCommandPool, nullptr);
+			vkDestroyBuffer(m_LogicalDevice, m_StagingBuffer, nullptr);
+			m_Allocator.Free(m_StagingAllocation);
+		}
+
+		void UploadContext::UploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset)
+		{
+			// data bigger than the ring is streamed in chunks, each chunk retiring older batches if needed
+			const VkDeviceSize chunkSize = m_Ring.GetCapacity() / 2;
+			const char* source = static_cast<const char*>(data);
+			for (VkDeviceSize copied = 0; copied < size; copied += chunkSize)
+			{
+				const VkDeviceSize copySize = std::min(chunkSize, size - copied);
+				const VkDeviceSize stagingOffset = Stage(source + copied, copySize, s_StagingAlignment);
+
+				VkBufferCopy copyRegion = {};
+				copyRegion.srcOffset = stagingOffset;
+				copyRegion.dstOffset = dstOffset + copied;
+				copyRegion.size = copySize;
+				vkCmdCopyBuffer(GetTransferCommandBuffer(), m_StagingBuffer, dstBuffer, 1, &copyRegion);
+			}
+			if (!m_DedicatedTransfer)
+			{
+				return; // made visible by the memory barrier at the end of the batch
+			}
+			// release on the transfer queue, acquire on the graphics queue (the acquire makes the copy visible)
+			VkBufferMemoryBarrier barrier = {};
+			barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = 0;
+			barrier.srcQueueFamilyIndex = m_Queues.TransferFamily;
+			barrier.dstQueueFamilyIndex = m_Queues.GraphicsFamily;
+			barrier.buffer = dstBuffer;
+			barrier.offset = dstOffset;
+			barrier.size = size;
+			vkCmdPipelineBarrier(GetTransferCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(GetGraphicsCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+				0, 0, nullptr, 1, &barrier, 0, nullptr);
+		}
+
+		void UploadContext::UploadImage(VkImage dstImage, const void* data, uint32_t width, uint32_t height, uint32_t texelSize)
+		{
+			// split into bands of whole rows so that large images never need more than half the ring at once
+			const VkDeviceSize rowSize = static_cast<VkDeviceSize>(width) * texelSize;
+			const uint32_t rowsPerBand = static_cast<uint32_t>(std::max<VkDeviceSize>(1, (m_Ring.GetCapacity() / 2) / rowSize));
+			const char* source = static_cast<const char*>(data);
+			for (uint32_t row = 0; row < height; row += rowsPerBand)
+			{
+				const uint32_t bandHeight = std::min(rowsPerBand, height - row);
+				const VkDeviceSize stagingOffset = Stage(source + row * rowSize, bandHeight * rowSize, s_StagingAlignment);
+
+				VkBufferImageCopy region = {};
+				region.bufferOffset = stagingOffset;
+				region.bufferRowLength = 0; // tightly packed
+				region.bufferImageHeight = 0;
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.mipLevel = 0;
+				region.imageSubresource.baseArrayLayer = 0;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset = { 0, static_cast<int32_t>(row), 0 };
+				region.imageExtent = { width, bandHeight, 1 };
+				vkCmdCopyBufferToImage(GetTransferCommandBuffer(), m_StagingBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+			}
+		}
+
+		void UploadContext::TransferImageOwnership(VkImage image, VkImageLayout layout, uint32_t mipLevels)
+		{
+			if (!m_DedicatedTransfer)
+			{
+				return; // same queue, nothing to hand over
+			}
+			// layouts have to match in the release and acquire barriers, so no transition happens here
+			VkImageMemoryBarrier barrier = {};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = 0;
+			barrier.oldLayout = layout;
+			barrier.newLayout = layout;
+			barrier.srcQueueFamilyIndex = m_Queues.TransferFamily;
+			barrier.dstQueueFamilyIndex = m_Queues.GraphicsFamily;
+			barrier.image = image;
+			barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			barrier.subresourceRange.baseMipLevel = 0;
+			barrier.subresourceRange.levelCount = mipLevels;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = 1;
+			vkCmdPipelineBarrier(GetTransferCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(GetGraphicsCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+				0, 0, nullptr, 0, nullptr, 1, &barrier);
+		}
+
+		VkCommandBuffer UploadContext::GetTransferCommandBuffer()
+		{
+			if (m_OpenBatch.TransferCommandBuffer != VK_NULL_HANDLE)
+			{
+				return m_OpenBatch.TransferCommandBuffer;
+			}
+			if (!m_FreeBatches.empty())
+			{
+				m_OpenBatch = m_FreeBatches.back();
+				m_FreeBatches.pop_back();
+			}
+			else
+			{
+				VkCommandBufferAllocateInfo allocInfo = {};
+				allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				allocInfo.commandPool = m_TransferCommandPool;
+				allocInfo.commandBufferCount = 1;
+				VkResult result = vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &m_OpenBatch.TransferCommandBuffer);
+				if (result == VK_SUCCESS && m_DedicatedTransfer)
+				{
+					allocInfo.commandPool = m_GraphicsCommandPool;
+					result = vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &m_OpenBatch.GraphicsCommandBuffer);
+				}
+				if (result == VK_SUCCESS && !m_Queues.TimelineSemaphores)
+				{
+					VkFenceCreateInfo fenceInfo = {};
+					fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+					result = vkCreateFence(m_LogicalDevice, &fenceInfo, nullptr, &m_OpenBatch.Fence);
+					if (result == VK_SUCCESS && m_DedicatedTransfer)
+					{
+						VkSemaphoreCreateInfo semaphoreInfo = {};
+						semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+						result = vkCreateSemaphore(m_LogicalDevice, &semaphoreInfo, nullptr, &m_OpenBatch.TransferSemaphore);
+					}
+				}
+				if (result != VK_SUCCESS)
+				{
+					static const std::string message = "[GraphicsSystem::UploadContext::GetTransferCommandBuffer]: Failed to create upload batch!";
+					VK_CORE_CRITICAL(message);
+					throw std::runtime_error(message);
+				}
+			}
+			m_OpenBatch.Id = m_NextBatchId;
+
+			VkCommandBufferBeginInfo beginInfo = {};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			vkBeginCommandBuffer(m_OpenBatch.TransferCommandBuffer, &beginInfo);
+			return m_OpenBatch.TransferCommandBuffer;
+		}
+
+		VkCommandBuffer UploadContext::GetGraphicsCommandBuffer()
+		{
+			if (!m_DedicatedTransfer)
+			{
+				return GetTransferCommandBuffer();
+			}
+			GetTransferCommandBuffer(); // make sure the batch is open
+			if (!m_OpenBatch.GraphicsRecording)
+			{
+				VkCommandBufferBeginInfo beginInfo = {};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				vkBeginCommandBuffer(m_OpenBatch.GraphicsCommandBuffer, &beginInfo);
+				m_OpenBatch.GraphicsRecording = true;
+			}
+			return m_OpenBatch.GraphicsCommandBuffer;
+		}
+
+		uint64_t UploadContext::Submit()
+		{
+			if (m_OpenBatch.TransferCommandBuffer == VK_NULL_HANDLE)
+			{
+				return 0;
+			}
+			const uint64_t batchId = m_OpenBatch.Id;
+			const bool graphicsSubmission = m_OpenBatch.GraphicsRecording;
+			// make every write in the batch visible to the vertex input and shader stages of later submissions,
+			// only on a graphics capable queue (with a dedicated transfer queue the acquire barriers already do this for the copies)
+			const VkCommandBuffer lastCommandBuffer = graphicsSubmission ? m_OpenBatch.GraphicsCommandBuffer : m_OpenBatch.TransferCommandBuffer;
+			if (!m_DedicatedTransfer || graphicsSubmission)
+			{
+				VkMemoryBarrier barrier = {};
+				barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+				vkCmdPipelineBarrier(lastCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					0, 1, &barrier, 0, nullptr, 0, nullptr);
+			}
+			vkEndCommandBuffer(m_OpenBatch.TransferCommandBuffer);
+			if (graphicsSubmission)
+			{
+				vkEndCommandBuffer(m_OpenBatch.GraphicsCommandBuffer);
+			}
+
+			// timeline: copies signal n on the transfer timeline, the acquire signals the next value of the graphics timeline,
+			//           a single timeline shared by both queues could be signaled out of order by batches that skip the graphics queue
+			// binary:   copies signal the batch semaphore, the last submission signals the fence
+			const uint64_t copiedValue = batchId;
+			VkTimelineSemaphoreSubmitInfoKHR transferTimelineInfo = {};
+			transferTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+			transferTimelineInfo.signalSemaphoreValueCount = 1;
+			transferTimelineInfo.pSignalSemaphoreValues = &copiedValue;
+
+			VkSubmitInfo transferSubmitInfo = {};
+			transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			transferSubmitInfo.commandBufferCount = 1;
+			transferSubmitInfo.pCommandBuffers = &m_OpenBatch.TransferCommandBuffer;
+			if (m_Queues.TimelineSemaphores)
+			{
+				transferSubmitInfo.pNext = &transferTimelineInfo;
+				transferSubmitInfo.signalSemaphoreCount = 1;
+				transferSubmitInfo.pSignalSemaphores = &m_TransferTimeline;
+				m_OpenBatch.CompletionTimeline = m_TransferTimeline;
+				m_OpenBatch.CompletionValue = copiedValue;
+			}
+			else if (graphicsSubmission)
+			{
+				transferSubmitInfo.signalSemaphoreCount = 1;
+				transferSubmitInfo.pSignalSemaphores = &m_OpenBatch.TransferSemaphore;
+			}
+			const VkFence transferFence = m_Queues.TimelineSemaphores || graphicsSubmission ? VK_NULL_HANDLE : m_OpenBatch.Fence;
+			VkResult result = vkQueueSubmit(m_Queues.TransferQueue, 1, &transferSubmitInfo, transferFence);
+
+			if (result == VK_SUCCESS && graphicsSubmission)
+			{
+				// ownership acquire (and mip generation) waits for the copies on the transfer queue
+				const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+				const uint64_t acquiredValue = m_GraphicsTimelineValue + 1;
+				VkTimelineSemaphoreSubmitInfoKHR graphicsTimelineInfo = {};
+				graphicsTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+				graphicsTimelineInfo.waitSemaphoreValueCount = 1;
+				graphicsTimelineInfo.pWaitSemaphoreValues = &copiedValue;
+				graphicsTimelineInfo.signalSemaphoreValueCount = 1;
+				graphicsTimelineInfo.pSignalSemaphoreValues = &acquiredValue;
+
+				VkSubmitInfo graphicsSubmitInfo = {};
+				graphicsSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				graphicsSubmitInfo.waitSemaphoreCount = 1;
+				graphicsSubmitInfo.pWaitDstStageMask = &waitStage;
+				graphicsSubmitInfo.commandBufferCount = 1;
+				graphicsSubmitInfo.pCommandBuffers = &m_OpenBatch.GraphicsCommandBuffer;
+				if (m_Queues.TimelineSemaphores)
+				{
+					graphicsSubmitInfo.pNext = &graphicsTimelineInfo;
+					graphicsSubmitInfo.pWaitSemaphores = &m_TransferTimeline;
+					graphicsSubmitInfo.signalSemaphoreCount = 1;
+					graphicsSubmitInfo.pSignalSemaphores = &m_GraphicsTimeline;
+				}
+				else
+				{
+					graphicsSubmitInfo.pWaitSemaphores = &m_OpenBatch.TransferSemaphore;
+				}
+				result = vkQueueSubmit(m_Queues.GraphicsQueue, 1, &graphicsSubmitInfo, m_Queues.TimelineSemaphores ? VK_NULL_HANDLE : m_OpenBatch.Fence);
+				if (result == VK_SUCCESS && m_Queues.TimelineSemaphores)
+				{
+					// the graphics queue signals last, it waited for the copies
+					m_GraphicsTimelineValue = acquiredValue;
+					m_OpenBatch.CompletionTimeline = m_GraphicsTimeline;
+					m_OpenBatch.CompletionValue = acquiredValue;
+				}
+			}
+			if (result != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::UploadContext::Submit]: Failed to submit upload batch!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			m_Ring.CloseBatch(batchId);
+			m_InFlightBatches.push_back(m_OpenBatch);
+			m_OpenBatch = {};
+			++m_NextBatchId;
+			return batchId;
+		}
+
+		void UploadContext::Update()
+		{
+			while (!m_InFlightBatches.empty() && IsBatchComplete(m_InFlightBatches.front()))
+			{
+				RecycleBatch(m_InFlightBatches.front());
+				m_InFlightBatches.pop_front();
+			}
+		}
+
+		void UploadContext::Wait(uint64_t batchId)
+		{
+			if (m_OpenBatch.TransferCommandBuffer != VK_NULL_HANDLE && batchId >= m_OpenBatch.Id)
+			{
+				Submit();
+			}
+			while (!m_InFlightBatches.empty() && m_InFlightBatches.front().Id <= batchId)
+			{
+				WaitForBatch(m_InFlightBatches.front());
+				RecycleBatch(m_InFlightBatches.front());
+				m_InFlightBatches.pop_front();
+			}
+		}
+
+		void UploadContext::WaitIdle()
+		{
+			if (!m_InFlightBatches.empty())
+			{
+				Wait(m_InFlightBatches.back().Id);
+			}
+		}
+
+		VkCommandPool UploadContext::CreateCommandPool(uint32_t queueFamilyIndex) const
+		{
+			VkCommandPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			poolInfo.queueFamilyIndex = queueFamilyIndex;
+			poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+			VkCommandPool commandPool;
+			if (vkCreateCommandPool(m_LogicalDevice, &poolInfo, nullptr, &commandPool) != VK_SUCCESS)
+			{
+				static const std::string message = "[GraphicsSystem::UploadContext::CreateCommandPool]: Failed to create upload command pool!";
+				VK_CORE_CRITICAL(message);
+				throw std::runtime_error(message);
+			}
+			return commandPool;
+		}
+
+		VkDeviceSize UploadContext::Stage(const void* data, VkDeviceSize size, VkDeviceSize alignment)
+		{
+			VkDeviceSize offset = 0;
+			while (!m_Ring.Allocate(size, alignment, offset))
+			{
+				// ring is full, the open batch has to be flushed so its regions can eventually be retired
+				if (m_InFlightBatches.empty())
+				{
+					Submit();
+				}
+				if (m_InFlightBatches.empty())
+				{
+					static const std::string message = "[GraphicsSystem::UploadContext::Stage]: Upload does not fit into the staging ring!";
+					VK_CORE_CRITICAL(message);
+					throw std::runtime_error(message);
+				}
+				Wait(m_InFlightBatches.front().Id);
+			}
+			memcpy(static_cast<char*>(m_StagingAllocation.MappedData) + offset, data, size);
+			return offset;
+		}
+
+		bool UploadContext::IsBatchComplete(const UploadBatch& batch) const
+		{
+			if (m_Queues.TimelineSemaphores)
+			{
+				uint64_t value = 0;
+				m_GetSemaphoreCounterValue(m_LogicalDevice, batch.CompletionTimeline, &value);
+				return value >= batch.CompletionValue;
+			}
+			return vkGetFenceStatus(m_LogicalDevice, batch.Fence) == VK_SUCCESS;
+		}
+
+		void UploadContext::WaitForBatch(const UploadBatch& batch) const
+		{
+			if (m_Queues.TimelineSemaphores)
+			{
+				VkSemaphoreWaitInfoKHR waitInfo = {};
+				waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+				waitInfo.semaphoreCount = 1;
+				waitInfo.pSemaphores = &batch.CompletionTimeline;
+				waitInfo.pValues = &batch.CompletionValue;
+				m_WaitSemaphores(m_LogicalDevice, &waitInfo, UINT64_MAX);
+				return;
+			}
+			vkWaitForFences(m_LogicalDevice, 1, &batch.Fence, VK_TRUE, UINT64_MAX);
+		}
+
+		void UploadContext::RecycleBatch(UploadBatch& batch)
+		{
+			// batches are recycled oldest first even when a later one finished earlier on the other queue,
+			// so everything up to this id has executed and its staging regions can be reused
+			m_CompletedBatchId = std::max(m_CompletedBatchId, batch.Id);
+			m_Ring.Retire(m_CompletedBatchId);
+			if (batch.Fence != VK_NULL_HANDLE)
+			{
+				vkResetFences(m_LogicalDevice, 1, &batch.Fence);
+			}
+			vkResetCommandBuffer(batch.TransferCommandBuffer, 0);
+			if (batch.GraphicsCommandBuffer != VK_NULL_HANDLE)
+			{
+				vkResetCommandBuffer(batch.GraphicsCommandBuffer, 0);
+			}
+			batch.GraphicsRecording = false;
+			batch.CompletionTimeline = VK_NULL_HANDLE;
+			batch.CompletionValue = 0;
+			m_FreeBatches.push_back(batch);
+		}
+	}
+}
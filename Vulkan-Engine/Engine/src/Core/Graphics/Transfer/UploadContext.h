@@ -0,0 +1,111 @@
+/***************************************************************************
+ * Filename		: UploadContext.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Batches buffer / image uploads through a persistently
+ *				  mapped staging ring into submissions on the transfer queue.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "StagingRing.h"
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+
+#include <deque>
+
+namespace Vulkan_Engine
+{
+	namespace Graphics
+	{
+		// queues the uploads run on, transfer and graphics are the same queue when the device has no dedicated transfer family
+		struct UploadQueueInfo
+		{
+			VkQueue TransferQueue = VK_NULL_HANDLE;
+			uint32_t TransferFamily = 0;
+			VkQueue GraphicsQueue = VK_NULL_HANDLE;
+			uint32_t GraphicsFamily = 0;
+			bool TimelineSemaphores = false; // VK_KHR_timeline_semaphore enabled on the device (fences + binary semaphores otherwise)
+		};
+
+		// Usage:
+		// 1. UploadBuffer / UploadImage copy the data into the staging ring and record the copy into the open batch
+		// 2. GetTransferCommandBuffer records extra copy work (layout transitions), GetGraphicsCommandBuffer records
+		//    work that needs a graphics queue (mip blits) and runs after ownership of the uploaded resources is acquired
+		// 3. Submit sends the batch: copies on the transfer queue, then the ownership acquire on the graphics queue
+		// 4. Update is called once per frame to recycle staging space of finished batches
+		class UploadContext
+		{
+		public:
+			UploadContext(VkDevice logicalDevice, DeviceMemoryAllocator& allocator, const UploadQueueInfo& queues, VkDeviceSize stagingCapacity = s_DefaultStagingCapacity);
+			~UploadContext();
+			UploadContext(const UploadContext&) = delete;
+			UploadContext& operator=(const UploadContext&) = delete;
+		public:
+			// buffer is handed over to the graphics queue once the copy is done
+			void UploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+			// image must be in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL when the batch executes, data is tightly packed rows
+			void UploadImage(VkImage dstImage, const void* data, uint32_t width, uint32_t height, uint32_t texelSize);
+			// hands the image over to the graphics queue (layout is kept), call once all copies into it are recorded
+			void TransferImageOwnership(VkImage image, VkImageLayout layout, uint32_t mipLevels);
+			VkCommandBuffer GetTransferCommandBuffer(); // begins a new batch if none is open
+			VkCommandBuffer GetGraphicsCommandBuffer(); // same command buffer as the transfer one without a dedicated transfer queue
+			uint64_t Submit(); // returns the id of the submitted batch (0 if there was nothing to submit)
+			void Update(); // retires finished batches without blocking
+			void Wait(uint64_t batchId); // blocks until the batch has executed
+			void WaitIdle();
+			_NODISCARD bool IsComplete(uint64_t batchId) const { return batchId <= m_CompletedBatchId; }
+			_NODISCARD bool HasDedicatedTransferQueue() const { return m_DedicatedTransfer; }
+		public:
+			static constexpr VkDeviceSize s_DefaultStagingCapacity = 32ull * 1024 * 1024;
+		private:
+			struct UploadBatch
+			{
+				VkCommandBuffer TransferCommandBuffer = VK_NULL_HANDLE;
+				VkCommandBuffer GraphicsCommandBuffer = VK_NULL_HANDLE; // ownership acquire + graphics work (dedicated transfer only)
+				bool GraphicsRecording = false;
+				VkFence Fence = VK_NULL_HANDLE; // signaled by the last submission of the batch (no timeline semaphores only)
+				VkSemaphore TransferSemaphore = VK_NULL_HANDLE; // orders the graphics submission after the copies (no timeline semaphores only)
+				VkSemaphore CompletionTimeline = VK_NULL_HANDLE; // timeline of the queue that executes the batch last
+				uint64_t CompletionValue = 0; // reached by CompletionTimeline once the batch has executed
+				uint64_t Id = 0;
+			};
+		private:
+			VkCommandPool CreateCommandPool(uint32_t queueFamilyIndex) const;
+			VkDeviceSize Stage(const void* data, VkDeviceSize size, VkDeviceSize alignment); // returns the offset in the staging buffer
+			_NODISCARD bool IsBatchComplete(const UploadBatch& batch) const;
+			void WaitForBatch(const UploadBatch& batch) const;
+			void RecycleBatch(UploadBatch& batch);
+		private:
+			VkDevice m_LogicalDevice;
+			DeviceMemoryAllocator& m_Allocator;
+			UploadQueueInfo m_Queues;
+			bool m_DedicatedTransfer;
+			VkCommandPool m_TransferCommandPool = VK_NULL_HANDLE;
+			VkCommandPool m_GraphicsCommandPool = VK_NULL_HANDLE; // only created with a dedicated transfer queue
+			// one timeline per queue so that every timeline only ever increases in submission order,
+			// batch n signals n on the transfer timeline, graphics submissions count up on their own timeline
+			VkSemaphore m_TransferTimeline = VK_NULL_HANDLE;
+			VkSemaphore m_GraphicsTimeline = VK_NULL_HANDLE;
+			uint64_t m_GraphicsTimelineValue = 0;
+			PFN_vkWaitSemaphoresKHR m_WaitSemaphores = nullptr;
+			PFN_vkGetSemaphoreCounterValueKHR m_GetSemaphoreCounterValue = nullptr;
+			VkBuffer m_StagingBuffer = VK_NULL_HANDLE;
+			DeviceAllocation m_StagingAllocation;
+			StagingRing m_Ring;
+			UploadBatch m_OpenBatch; // batch currently being recorded (TransferCommandBuffer null if none)
+			std::deque<UploadBatch> m_InFlightBatches; // submitted, oldest first
+			std::vector<UploadBatch> m_FreeBatches; // command buffers + sync objects ready for reuse
+			uint64_t m_NextBatchId = 1;
+			uint64_t m_CompletedBatchId = 0;
+		};
+	}
+}
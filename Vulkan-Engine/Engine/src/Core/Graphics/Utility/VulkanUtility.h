@@ -113,7 +113,12 @@ namespace Vulkan_Engine
 		{
 			std::optional<uint32_t> GraphicsFamily; 
 			std::optional<uint32_t> PresentFamily;   // used to ensure that a device can present images ot the surface created (queue specific feature)
+			std::optional<uint32_t> TransferFamily;  // dedicated transfer family (no graphics), copies run alongside rendering
+			std::optional<uint32_t> ComputeFamily;   // async compute family (compute without graphics)
 			_NODISCARD bool IsComplete() const { return GraphicsFamily.has_value() && PresentFamily.has_value(); }
+			// families to use, falling back to the graphics family when the device has no dedicated one
+			_NODISCARD uint32_t GetTransferFamily() const { return TransferFamily.value_or(GraphicsFamily.value()); }
+			_NODISCARD uint32_t GetComputeFamily() const { return ComputeFamily.value_or(GraphicsFamily.value()); }
 		};
 
 		// 1: Verify that queue family has capability of presenting to chosen window surface
@@ -123,21 +128,33 @@ namespace Vulkan_Engine
 			// Assign index to queue families that could be found
 			auto queueFamilies = GetVulkanData<VkQueueFamilyProperties>(vkGetPhysicalDeviceQueueFamilyProperties, device);
 
-			int i = 0;
+			uint32_t i = 0;
 			for (const auto& queueFamily : queueFamilies) {
-				if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) 
+				if (!indices.IsComplete())
 				{
-					indices.GraphicsFamily = i;
-				}
-				VkBool32 presentSupport = false;
-				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport); // checks if the queue supports the surface
-				if (presentSupport) 
-				{
-					indices.PresentFamily = i;
+					if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+					{
+						indices.GraphicsFamily = i;
+					}
+					VkBool32 presentSupport = false;
+					vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport); // checks if the queue supports the surface
+					if (presentSupport)
+					{
+						indices.PresentFamily = i;
+					}
 				}
-				if (indices.IsComplete()) 
+				if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
 				{
-					break;
+					// prefer a transfer only family (the dma engine) over a compute family that can also copy
+					const bool transferOnly = !(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT);
+					if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && (!indices.TransferFamily.has_value() || transferOnly))
+					{
+						indices.TransferFamily = i;
+					}
+					if ((queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !indices.ComputeFamily.has_value())
+					{
+						indices.ComputeFamily = i;
+					}
 				}
 				i++;
 			}
@@ -145,6 +162,33 @@ namespace Vulkan_Engine
 			return indices;
 		}
 
+		// optional extensions, only enabled when present
+		inline bool IsInstanceExtensionAvailable(const char* extensionName)
+		{
+			const auto availableExtensions = GetVulkanData<VkExtensionProperties>(vkEnumerateInstanceExtensionProperties, nullptr);
+			for (const auto& extension : availableExtensions)
+			{
+				if (strcmp(extension.extensionName, extensionName) == 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		inline bool IsDeviceExtensionAvailable(VkPhysicalDevice device, const char* extensionName)
+		{
+			const auto availableExtensions = GetVulkanData<VkExtensionProperties>(vkEnumerateDeviceExtensionProperties, device, nullptr);
+			for (const auto& extension : availableExtensions)
+			{
+				if (strcmp(extension.extensionName, extensionName) == 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
 		// used in swap chain verifications
 		bool CheckDeviceExtensionSupport(VkPhysicalDevice device)
 		{
@@ -0,0 +1,101 @@
+/***************************************************************************
+ * Filename		: MappedFile.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Read only memory mapping of a whole file.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Vulkan_Engine
+{
+	namespace IO
+	{
+#ifdef _WIN32
+		MappedFile::MappedFile(const std::string& filepath)
+		{
+			const HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return;
+			}
+			m_FileHandle = file;
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+			{
+				return;
+			}
+			m_MappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_MappingHandle == nullptr)
+			{
+				return;
+			}
+			m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+			m_Size = m_Data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+		}
+
+		MappedFile::~MappedFile()
+		{
+			if (m_Data)
+			{
+				UnmapViewOfFile(m_Data);
+			}
+			if (m_MappingHandle)
+			{
+				CloseHandle(m_MappingHandle);
+			}
+			if (m_FileHandle)
+			{
+				CloseHandle(m_FileHandle);
+			}
+		}
+#else
+		MappedFile::MappedFile(const std::string& filepath)
+		{
+			const int file = open(filepath.c_str(), O_RDONLY);
+			if (file < 0)
+			{
+				return;
+			}
+			struct stat fileStat;
+			if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+			{
+				void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+				if (data != MAP_FAILED)
+				{
+					m_Data = static_cast<const uint8_t*>(data);
+					m_Size = static_cast<size_t>(fileStat.st_size);
+				}
+			}
+			close(file); // the mapping keeps the file referenced
+		}
+
+		MappedFile::~MappedFile()
+		{
+			if (m_Data)
+			{
+				munmap(const_cast<uint8_t*>(m_Data), m_Size);
+			}
+		}
+#endif
+	}
+}
@@ -0,0 +1,46 @@
+/***************************************************************************
+ * Filename		: MappedFile.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Read only memory mapping of a whole file.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Vulkan_Engine
+{
+	namespace IO
+	{
+		// The file contents are paged in by the os on first access, nothing is read up front.
+		// IsOpen() is false if the file doesn't exist or can't be mapped (empty files can't be mapped either).
+		class MappedFile
+		{
+		public:
+			explicit MappedFile(const std::string& filepath);
+			~MappedFile();
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+		public:
+			_NODISCARD bool IsOpen() const { return m_Data != nullptr; }
+			_NODISCARD const uint8_t* GetData() const { return m_Data; }
+			_NODISCARD size_t GetSize() const { return m_Size; }
+		private:
+			const uint8_t* m_Data = nullptr;
+			size_t m_Size = 0;
+#ifdef _WIN32
+			void* m_FileHandle = nullptr;
+			void* m_MappingHandle = nullptr;
+#endif
+		};
+	}
+}
@@ -0,0 +1,213 @@
+/***************************************************************************
+ * Filename		: JobSystem.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Work-stealing job scheduler shared by every engine system,
+ *				  with job counters, dependencies and a parallel for.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "JobSystem.h"
+
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	uint32_t JobSystem::s_ThreadCount = 1;
+	std::vector<Scope<JobSystem::WorkerQueue>> JobSystem::s_Queues;
+	std::vector<std::thread> JobSystem::s_Workers;
+	std::atomic<uint32_t> JobSystem::s_QueuedJobs{ 0 };
+	std::atomic<bool> JobSystem::s_Running{ false };
+	std::mutex JobSystem::s_SleepMutex;
+	std::condition_variable JobSystem::s_WakeCondition;
+
+	static thread_local uint32_t s_ThreadIndex = 0;
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+		s_ThreadCount = workerCount + 1;
+		for (uint32_t i = 0; i < s_ThreadCount; ++i)
+		{
+			s_Queues.push_back(CreateScope<WorkerQueue>());
+		}
+		s_Running = true;
+		s_ThreadIndex = 0;
+		for (uint32_t i = 1; i < s_ThreadCount; ++i)
+		{
+			s_Workers.emplace_back(&JobSystem::WorkerLoop, i);
+		}
+		VK_CORE_INFO("[JobSystem]: Started {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_SleepMutex);
+			s_Running = false;
+		}
+		s_WakeCondition.notify_all();
+		for (std::thread& worker : s_Workers)
+		{
+			worker.join();
+		}
+		s_Workers.clear();
+		s_Queues.clear();
+		s_ThreadCount = 1;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+	void JobSystem::Execute(Job job, JobCounter* counter)
+	{
+		if (counter)
+		{
+			counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+		}
+		Push({ std::move(job), counter });
+	}
+
+	void JobSystem::ExecuteAfter(JobCounter& dependency, Job job, JobCounter* counter)
+	{
+		if (counter)
+		{
+			counter->m_Pending.fetch_add(1, std::memory_order_relaxed); // counted straight away, so waiting on it also waits for the dependency
+		}
+		{
+			std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+			if (dependency.m_Pending.load(std::memory_order_acquire) != 0)
+			{
+				dependency.m_Continuations.push_back({ std::move(job), counter });
+				return;
+			}
+		}
+		Push({ std::move(job), counter });
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)>& function)
+	{
+		batchSize = std::max(1u, batchSize);
+		JobCounter counter;
+		for (uint32_t first = 0; first < count; first += batchSize)
+		{
+			const uint32_t last = std::min(count, first + batchSize);
+			Execute([&function, first, last]() { function(first, last); }, &counter);
+		}
+		Wait(counter);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!TryRunJob(s_ThreadIndex))
+			{
+				std::this_thread::yield(); // the remaining jobs are running on other threads
+			}
+		}
+		std::lock_guard<std::mutex> lock(counter.m_Mutex); // the thread that completed the last job may still be inside the counter
+	}
+
+	void JobSystem::WorkerLoop(uint32_t threadIndex)
+	{
+		s_ThreadIndex = threadIndex;
+		while (s_Running)
+		{
+			if (!TryRunJob(threadIndex))
+			{
+				std::unique_lock<std::mutex> lock(s_SleepMutex);
+				s_WakeCondition.wait(lock, [] { return s_QueuedJobs.load() != 0 || !s_Running; });
+			}
+		}
+	}
+
+	void JobSystem::Push(QueuedJob&& job)
+	{
+		if (s_Queues.empty())
+		{
+			// not initialized, run on the calling thread
+			job.Function();
+			Complete(job.Counter);
+			return;
+		}
+		WorkerQueue& queue = *s_Queues[s_ThreadIndex];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+		s_QueuedJobs.fetch_add(1);
+		{
+			std::lock_guard<std::mutex> lock(s_SleepMutex); // a worker between its predicate check and sleeping can't miss the notify
+		}
+		s_WakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryRunJob(uint32_t threadIndex)
+	{
+		QueuedJob job;
+		bool found = false;
+		{
+			WorkerQueue& queue = *s_Queues[threadIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				found = true;
+			}
+		}
+		for (uint32_t i = 1; !found && i < s_ThreadCount; ++i)
+		{
+			WorkerQueue& victim = *s_Queues[(threadIndex + i) % s_ThreadCount];
+			std::lock_guard<std::mutex> lock(victim.Mutex);
+			if (!victim.Jobs.empty())
+			{
+				job = std::move(victim.Jobs.front()); // oldest job, usually the largest piece of remaining work
+				victim.Jobs.pop_front();
+				found = true;
+			}
+		}
+		if (!found)
+		{
+			return false;
+		}
+		s_QueuedJobs.fetch_sub(1);
+		job.Function();
+		Complete(job.Counter);
+		return true;
+	}
+
+	void JobSystem::Complete(JobCounter* counter)
+	{
+		if (!counter)
+		{
+			return;
+		}
+		std::vector<QueuedJob> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter->m_Mutex);
+			if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				continuations.swap(counter->m_Continuations);
+			}
+		}
+		for (QueuedJob& continuation : continuations)
+		{
+			Push(std::move(continuation));
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Filename		: JobSystem.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Work-stealing job scheduler shared by every engine system,
+ *				  with job counters, dependencies and a parallel for.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Core/Core.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	using Job = std::function<void()>;
+
+	class JobCounter;
+
+	struct QueuedJob
+	{
+		Job Function;
+		JobCounter* Counter = nullptr; // decremented once the job has run
+	};
+
+	// Counts the jobs that still have to run, incremented when a job is scheduled with it.
+	// Only destroy a counter once JobSystem::Wait on it has returned.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+	public:
+		_NODISCARD bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+	private:
+		friend class JobSystem;
+		std::atomic<uint32_t> m_Pending{ 0 };
+		std::mutex m_Mutex; // guards the continuations and the transition to zero
+		std::vector<QueuedJob> m_Continuations; // jobs scheduled with ExecuteAfter, queued once the counter reaches zero
+	};
+
+	// Every worker owns a deque: it pushes and pops its own jobs at the back (newest first, still cache hot),
+	// idle workers steal from the front of the others. Thread index 0 is the thread that called Init (main thread),
+	// which runs jobs while it is blocked in Wait. Only the main thread and the workers may schedule jobs.
+	// Before Init (or after Shutdown) jobs run inline on the calling thread.
+	class JobSystem
+	{
+	public:
+		static void Init(uint32_t workerCount = 0); // 0 -> one worker per hardware thread besides the main thread
+		static void Shutdown(); // joins the workers, every job must have completed
+		static void Execute(Job job, JobCounter* counter = nullptr);
+		static void ExecuteAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr); // runs once dependency reaches zero
+		// splits [0, count) into batches of batchSize and calls function(first, last) for each batch, returns once all have run
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)>& function);
+		static void Wait(JobCounter& counter); // runs queued jobs until the counter reaches zero
+		_NODISCARD static uint32_t GetThreadCount() { return s_ThreadCount; } // workers + main thread
+		_NODISCARD static uint32_t GetThreadIndex(); // 0 for the main thread, [1, GetThreadCount()) for the workers
+	private:
+		struct WorkerQueue
+		{
+			std::mutex Mutex;
+			std::deque<QueuedJob> Jobs;
+		};
+	private:
+		static void WorkerLoop(uint32_t threadIndex);
+		static void Push(QueuedJob&& job);
+		static bool TryRunJob(uint32_t threadIndex); // pops from its own queue first, then steals
+		static void Complete(JobCounter* counter);
+	private:
+		static uint32_t s_ThreadCount;
+		static std::vector<Scope<WorkerQueue>> s_Queues; // one per thread index
+		static std::vector<std::thread> s_Workers;
+		static std::atomic<uint32_t> s_QueuedJobs; // jobs sitting in any queue, workers sleep while this is zero
+		static std::atomic<bool> s_Running;
+		static std::mutex s_SleepMutex;
+		static std::condition_variable s_WakeCondition;
+	};
+}
@@ -0,0 +1,92 @@
+/***************************************************************************
+ * Filename		: Aabb.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Axis aligned bounding box used by the scene index, with
+ *				  the ray and box overlap tests its queries are built on.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Vulkan_Engine
+{
+	// a default constructed box is empty (min > max), expanding it by anything gives that thing's bounds
+	struct Aabb
+	{
+		glm::vec3 Min = glm::vec3(FLT_MAX);
+		glm::vec3 Max = glm::vec3(-FLT_MAX);
+	public:
+		Aabb() = default;
+		Aabb(const glm::vec3& min, const glm::vec3& max) : Min(min), Max(max) {}
+
+		inline void Expand(const glm::vec3& point) { Min = glm::min(Min, point); Max = glm::max(Max, point); }
+		inline void Expand(const Aabb& other) { Min = glm::min(Min, other.Min); Max = glm::max(Max, other.Max); }
+		_NODISCARD inline bool IsEmpty() const { return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z; }
+		_NODISCARD inline glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		_NODISCARD inline glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; } // half size
+		_NODISCARD inline float GetSurfaceArea() const // 0 for an empty box
+		{
+			if (IsEmpty())
+			{
+				return 0.0f;
+			}
+			const glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+		_NODISCARD inline bool Overlaps(const Aabb& other) const
+		{
+			return Min.x <= other.Max.x && Max.x >= other.Min.x && Min.y <= other.Max.y && Max.y >= other.Min.y &&
+				Min.z <= other.Max.z && Max.z >= other.Min.z;
+		}
+		// slab test, inverseDirection is 1 / direction (infinities for axis parallel rays are fine).
+		// Returns the entry distance clamped to 0 if the ray hits the box within [0, maxDistance], FLT_MAX otherwise.
+		_NODISCARD inline float IntersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) const
+		{
+			if (IsEmpty()) // the min / max below would swap the inverted slabs into a valid looking interval
+			{
+				return FLT_MAX;
+			}
+			const glm::vec3 t0 = (Min - origin) * inverseDirection;
+			const glm::vec3 t1 = (Max - origin) * inverseDirection;
+			const glm::vec3 tNear = glm::min(t0, t1);
+			const glm::vec3 tFar = glm::max(t0, t1);
+			const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+			const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+			return entry <= exit ? entry : FLT_MAX;
+		}
+
+		_NODISCARD static inline Aabb FromSphere(const glm::vec4& sphere)
+		{
+			return Aabb(glm::vec3(sphere) - glm::vec3(sphere.w), glm::vec3(sphere) + glm::vec3(sphere.w));
+		}
+		// bounds of the box's 8 transformed corners without transforming them (Arvo 1990), affine transforms only
+		_NODISCARD static inline Aabb Transform(const glm::mat4& transform, const Aabb& box)
+		{
+			if (box.IsEmpty())
+			{
+				return box;
+			}
+			const glm::vec3 center = glm::vec3(transform * glm::vec4(box.GetCenter(), 1.0f));
+			const glm::vec3 extents = box.GetExtents();
+			glm::vec3 transformedExtents(0.0f);
+			for (int column = 0; column < 3; ++column)
+			{
+				transformedExtents += glm::abs(glm::vec3(transform[column])) * extents[column];
+			}
+			return Aabb(center - transformedExtents, center + transformedExtents);
+		}
+	};
+}
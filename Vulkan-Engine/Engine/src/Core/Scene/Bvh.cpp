@@ -0,0 +1,395 @@
+/***************************************************************************
+ * Filename		: Bvh.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Bounding volume hierarchy over object bounds, built with
+ *				  the binned surface area heuristic and refit in place.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Bvh.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	static constexpr uint32_t CENTROID_BATCH_SIZE = 16384; // objects per job
+	static constexpr uint32_t QUERY_STACK_SIZE = 64; // reserved up front, deeper trees grow the stack
+
+	void Bvh::Build(const std::vector<Aabb>& objectBounds, bool parallel)
+	{
+		Clear();
+		if (objectBounds.empty())
+		{
+			return;
+		}
+		const uint32_t objectCount = static_cast<uint32_t>(objectBounds.size());
+		m_ObjectBounds = objectBounds;
+		m_ObjectIndices.resize(objectCount);
+		m_Centroids.resize(objectCount);
+		const auto computeCentroids = [this](uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = first; i < last; ++i)
+			{
+				m_ObjectIndices[i] = i;
+				m_Centroids[i] = m_ObjectBounds[i].IsEmpty() ? glm::vec3(0.0f) : m_ObjectBounds[i].GetCenter();
+			}
+		};
+		if (parallel)
+		{
+			JobSystem::ParallelFor(objectCount, CENTROID_BATCH_SIZE, computeCentroids);
+		}
+		else
+		{
+			computeCentroids(0, objectCount);
+		}
+
+		// a binary tree with at least one object per leaf has at most 2n - 1 nodes, so the nodes never move while
+		// jobs are writing them
+		m_Nodes.resize(2 * static_cast<size_t>(objectCount) - 1);
+		m_NodeCount = 1;
+		BuildNode(0, 0, objectCount, parallel);
+		m_Nodes.resize(m_NodeCount.load());
+		m_Centroids.clear();
+		m_Centroids.shrink_to_fit();
+	}
+
+	void Bvh::BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, bool parallel)
+	{
+		BvhNode& node = m_Nodes[nodeIndex];
+		Aabb centroidBounds;
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			node.Bounds.Expand(m_ObjectBounds[m_ObjectIndices[i]]);
+			centroidBounds.Expand(m_Centroids[m_ObjectIndices[i]]);
+		}
+		if (count == 1)
+		{
+			node.First = first;
+			node.Count = count;
+			return;
+		}
+
+		// binned surface area heuristic, the split planes lie between the s_BinCount bins of every axis' centroid range.
+		// All three axes are binned in one pass over the objects, the object accesses are what the build is bound by
+		// small nodes get fewer bins, evaluating the planes would otherwise cost more than the objects
+		const uint32_t binCount = std::min(s_BinCount, count);
+		glm::vec3 binScales(0.0f);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const float extent = centroidBounds.Max[axis] - centroidBounds.Min[axis];
+			binScales[axis] = extent > 0.0f ? static_cast<float>(binCount) / extent : 0.0f; // 0 -> every centroid on the same plane
+		}
+		Aabb binBounds[3][s_BinCount];
+		uint32_t binCounts[3][s_BinCount] = {};
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			const uint32_t object = m_ObjectIndices[i];
+			const Aabb& bounds = m_ObjectBounds[object];
+			const glm::vec3 binPositions = (m_Centroids[object] - centroidBounds.Min) * binScales;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const uint32_t bin = std::min(binCount - 1, static_cast<uint32_t>(binPositions[axis]));
+				binBounds[axis][bin].Expand(bounds);
+				++binCounts[axis][bin];
+			}
+		}
+
+		int bestAxis = -1;
+		uint32_t bestSplit = 0;
+		float bestCost = FLT_MAX;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (binScales[axis] == 0.0f)
+			{
+				continue;
+			}
+			// sweep from the right for the area / count right of every plane, then from the left to evaluate them
+			float rightAreas[s_BinCount];
+			uint32_t rightCounts[s_BinCount];
+			Aabb rightBounds;
+			uint32_t rightCount = 0;
+			for (uint32_t split = binCount - 1; split > 0; --split)
+			{
+				rightBounds.Expand(binBounds[axis][split]);
+				rightCount += binCounts[axis][split];
+				rightAreas[split] = rightBounds.GetSurfaceArea();
+				rightCounts[split] = rightCount;
+			}
+			Aabb leftBounds;
+			uint32_t leftCount = 0;
+			for (uint32_t split = 1; split < binCount; ++split)
+			{
+				leftBounds.Expand(binBounds[axis][split - 1]);
+				leftCount += binCounts[axis][split - 1];
+				if (leftCount == 0 || rightCounts[split] == 0)
+				{
+					continue;
+				}
+				const float cost = leftBounds.GetSurfaceArea() * leftCount + rightAreas[split] * rightCounts[split];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		const float nodeArea = node.Bounds.GetSurfaceArea();
+		const float splitCost = s_TraversalCost + (nodeArea > 0.0f ? bestCost / nodeArea : 0.0f);
+		if (count <= s_MaxLeafObjects && (bestAxis < 0 || static_cast<float>(count) <= splitCost))
+		{
+			node.First = first;
+			node.Count = count;
+			return;
+		}
+
+		uint32_t leftCount = count / 2; // coincident centroids, any split is as good as another
+		if (bestAxis >= 0)
+		{
+			// same bin computation as above, so both sides are non empty
+			const float binScale = binScales[bestAxis];
+			const float binMin = centroidBounds.Min[bestAxis];
+			uint32_t* const begin = m_ObjectIndices.data() + first;
+			uint32_t* const middle = std::partition(begin, begin + count, [&](uint32_t object)
+			{
+				return std::min(binCount - 1, static_cast<uint32_t>((m_Centroids[object][bestAxis] - binMin) * binScale)) < bestSplit;
+			});
+			leftCount = static_cast<uint32_t>(middle - begin);
+		}
+
+		const uint32_t children = m_NodeCount.fetch_add(2);
+		node.First = children;
+		node.Count = 0;
+		if (parallel && count >= s_ParallelObjects)
+		{
+			JobCounter counter;
+			JobSystem::Execute([this, children, first, leftCount, parallel]() { BuildNode(children, first, leftCount, parallel); }, &counter);
+			BuildNode(children + 1, first + leftCount, count - leftCount, parallel);
+			JobSystem::Wait(counter);
+		}
+		else
+		{
+			BuildNode(children, first, leftCount, parallel);
+			BuildNode(children + 1, first + leftCount, count - leftCount, parallel);
+		}
+	}
+
+	void Bvh::Refit(const std::vector<Aabb>& objectBounds)
+	{
+		VK_CORE_ASSERT(objectBounds.size() == m_ObjectBounds.size(), "[Bvh::Refit]: Object count changed, rebuild instead");
+		m_ObjectBounds = objectBounds;
+		for (size_t nodeIndex = m_Nodes.size(); nodeIndex-- > 0;)
+		{
+			BvhNode& node = m_Nodes[nodeIndex];
+			node.Bounds = Aabb();
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+				{
+					node.Bounds.Expand(m_ObjectBounds[m_ObjectIndices[i]]);
+				}
+			}
+			else
+			{
+				node.Bounds.Expand(m_Nodes[node.First].Bounds);
+				node.Bounds.Expand(m_Nodes[node.First + 1].Bounds);
+			}
+		}
+	}
+
+	void Bvh::Clear()
+	{
+		m_Nodes.clear();
+		m_ObjectIndices.clear();
+		m_ObjectBounds.clear();
+		m_NodeCount = 0;
+	}
+
+	void Bvh::QueryFrustum(const Graphics::Frustum& frustum, std::vector<uint32_t>& objects) const
+	{
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+		std::vector<uint32_t> stack;
+		stack.reserve(QUERY_STACK_SIZE);
+		stack.push_back(0);
+		while (!stack.empty())
+		{
+			const BvhNode& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			if (node.Bounds.IsEmpty())
+			{
+				continue;
+			}
+			const Graphics::FrustumTest test = frustum.ClassifyAabb(node.Bounds);
+			if (test == Graphics::FrustumTest::Outside)
+			{
+				continue;
+			}
+			if (test == Graphics::FrustumTest::Inside) // no further plane tests below this node
+			{
+				AppendSubtree(static_cast<uint32_t>(&node - m_Nodes.data()), objects);
+			}
+			else if (node.IsLeaf())
+			{
+				for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+				{
+					const Aabb& bounds = m_ObjectBounds[m_ObjectIndices[i]];
+					if (!bounds.IsEmpty() && frustum.ClassifyAabb(bounds) != Graphics::FrustumTest::Outside)
+					{
+						objects.push_back(m_ObjectIndices[i]);
+					}
+				}
+			}
+			else
+			{
+				stack.push_back(node.First);
+				stack.push_back(node.First + 1);
+			}
+		}
+	}
+
+	void Bvh::QueryBox(const Aabb& box, std::vector<uint32_t>& objects) const
+	{
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+		std::vector<uint32_t> stack;
+		stack.reserve(QUERY_STACK_SIZE);
+		stack.push_back(0);
+		while (!stack.empty())
+		{
+			const BvhNode& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			if (!node.Bounds.Overlaps(box)) // also false for empty bounds
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+				{
+					if (m_ObjectBounds[m_ObjectIndices[i]].Overlaps(box))
+					{
+						objects.push_back(m_ObjectIndices[i]);
+					}
+				}
+			}
+			else
+			{
+				stack.push_back(node.First);
+				stack.push_back(node.First + 1);
+			}
+		}
+	}
+
+	bool Bvh::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, BvhRayHit& hit) const
+	{
+		hit = BvhRayHit();
+		if (m_Nodes.empty())
+		{
+			return false;
+		}
+		const glm::vec3 inverseDirection = glm::vec3(1.0f) / direction;
+		float closest = maxDistance;
+		std::vector<uint32_t> stack;
+		stack.reserve(QUERY_STACK_SIZE);
+		stack.push_back(0);
+		while (!stack.empty())
+		{
+			const BvhNode& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			// children were tested when they were pushed, a closer hit since then may rule them out
+			if (node.Bounds.IntersectRay(origin, inverseDirection, closest) == FLT_MAX)
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+				{
+					const float distance = m_ObjectBounds[m_ObjectIndices[i]].IntersectRay(origin, inverseDirection, closest);
+					if (distance < hit.Distance)
+					{
+						hit.Object = m_ObjectIndices[i];
+						hit.Distance = distance;
+						closest = distance;
+					}
+				}
+				continue;
+			}
+			// the nearer child is popped first, so its hits can prune the farther one
+			uint32_t nearChild = node.First;
+			uint32_t farChild = node.First + 1;
+			float nearDistance = m_Nodes[nearChild].Bounds.IntersectRay(origin, inverseDirection, closest);
+			float farDistance = m_Nodes[farChild].Bounds.IntersectRay(origin, inverseDirection, closest);
+			if (farDistance < nearDistance)
+			{
+				std::swap(nearChild, farChild);
+				std::swap(nearDistance, farDistance);
+			}
+			if (farDistance != FLT_MAX)
+			{
+				stack.push_back(farChild);
+			}
+			if (nearDistance != FLT_MAX)
+			{
+				stack.push_back(nearChild);
+			}
+		}
+		return hit.Object != UINT32_MAX;
+	}
+
+	float Bvh::GetCost() const
+	{
+		if (m_Nodes.empty() || !(m_Nodes[0].Bounds.GetSurfaceArea() > 0.0f))
+		{
+			return 0.0f;
+		}
+		float cost = 0.0f;
+		for (const BvhNode& node : m_Nodes)
+		{
+			cost += node.Bounds.GetSurfaceArea() * (node.IsLeaf() ? static_cast<float>(node.Count) : s_TraversalCost);
+		}
+		return cost / m_Nodes[0].Bounds.GetSurfaceArea();
+	}
+
+	void Bvh::AppendSubtree(uint32_t nodeIndex, std::vector<uint32_t>& objects) const
+	{
+		std::vector<uint32_t> stack;
+		stack.reserve(QUERY_STACK_SIZE);
+		stack.push_back(nodeIndex);
+		while (!stack.empty())
+		{
+			const BvhNode& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+				{
+					if (!m_ObjectBounds[m_ObjectIndices[i]].IsEmpty())
+					{
+						objects.push_back(m_ObjectIndices[i]);
+					}
+				}
+			}
+			else
+			{
+				stack.push_back(node.First);
+				stack.push_back(node.First + 1);
+			}
+		}
+	}
+}
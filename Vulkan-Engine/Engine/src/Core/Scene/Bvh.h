@@ -0,0 +1,85 @@
+/***************************************************************************
+ * Filename		: Bvh.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Bounding volume hierarchy over object bounds, built with
+ *				  the binned surface area heuristic and refit in place.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Aabb.h"
+#include "Core/Graphics/Culling/Frustum.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	struct BvhNode
+	{
+		Aabb Bounds;
+		uint32_t First = 0; // leaf: first entry in the object index array, interior: left child (the right one follows it)
+		uint32_t Count = 0; // objects in a leaf, 0 for interior nodes
+	public:
+		_NODISCARD inline bool IsLeaf() const { return Count != 0; }
+	};
+
+	struct BvhRayHit
+	{
+		uint32_t Object = UINT32_MAX;
+		float Distance = FLT_MAX; // along the (not necessarily normalized) ray direction
+	};
+
+	// objects are referenced by their index in the bounds array passed to Build / Refit, empty bounds are never returned
+	// by a query. Children are always stored after their parent, Refit walks the nodes backwards.
+	class Bvh
+	{
+	public:
+		Bvh() = default;
+		~Bvh() = default;
+		Bvh(const Bvh&) = delete;
+		Bvh& operator=(const Bvh&) = delete;
+	public:
+		// subtrees of at least s_ParallelObjects objects are built as jobs when parallel is set
+		void Build(const std::vector<Aabb>& objectBounds, bool parallel = true);
+		// moves the node bounds to the objects' new bounds without changing the tree, the object count must not change.
+		// Cheap, but the tree degrades as objects move away from where it was built (see GetCost)
+		void Refit(const std::vector<Aabb>& objectBounds);
+		void Clear();
+
+		void QueryFrustum(const Graphics::Frustum& frustum, std::vector<uint32_t>& objects) const; // appends to objects
+		void QueryBox(const Aabb& box, std::vector<uint32_t>& objects) const; // appends to objects
+		// closest object whose bounds the ray enters within [0, maxDistance], false if there is none
+		bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, BvhRayHit& hit) const;
+
+		// expected cost of a random ray query relative to testing the root alone (surface area heuristic)
+		_NODISCARD float GetCost() const;
+		_NODISCARD uint32_t GetObjectCount() const { return static_cast<uint32_t>(m_ObjectBounds.size()); }
+		_NODISCARD uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_Nodes.size()); }
+		_NODISCARD const std::vector<BvhNode>& GetNodes() const { return m_Nodes; }
+		_NODISCARD Aabb GetBounds() const { return m_Nodes.empty() ? Aabb() : m_Nodes[0].Bounds; }
+	public:
+		static constexpr uint32_t s_BinCount = 16;
+		static constexpr uint32_t s_MaxLeafObjects = 8; // larger leaves are always split, even if the heuristic prefers a leaf
+		static constexpr uint32_t s_ParallelObjects = 4096; // smaller subtrees are built on the thread that split their parent
+		static constexpr float s_TraversalCost = 1.0f; // node visit cost relative to one object test
+	private:
+		void BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, bool parallel);
+		void AppendSubtree(uint32_t nodeIndex, std::vector<uint32_t>& objects) const;
+	private:
+		std::vector<BvhNode> m_Nodes;
+		std::vector<uint32_t> m_ObjectIndices; // leaves reference contiguous ranges of this
+		std::vector<Aabb> m_ObjectBounds;
+		std::vector<glm::vec3> m_Centroids; // only used while building
+		std::atomic<uint32_t> m_NodeCount{ 0 }; // only used while building
+	};
+}
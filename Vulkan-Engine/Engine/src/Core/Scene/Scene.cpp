@@ -0,0 +1,85 @@
+/***************************************************************************
+ * Filename		: Scene.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Objects placed in the world (mesh, transform, bounds) and
+ *				  the bounding volume hierarchy that indexes them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "Scene.h"
+
+#include "Core/Core.h"
+#include "Core/Logger/Log.h"
+
+namespace Vulkan_Engine
+{
+	uint32_t Scene::AddObject(uint32_t meshId, const glm::mat4& transform, const Aabb& localBounds, uint32_t materialId)
+	{
+		uint32_t objectId;
+		if (!m_FreeIds.empty())
+		{
+			objectId = m_FreeIds.back();
+			m_FreeIds.pop_back();
+		}
+		else
+		{
+			objectId = static_cast<uint32_t>(m_Objects.size());
+			m_Objects.emplace_back();
+			m_WorldBounds.emplace_back();
+		}
+		SceneObject& object = m_Objects[objectId];
+		object.MeshId = meshId;
+		object.Transform = transform;
+		object.LocalBounds = localBounds;
+		object.WorldBounds = Aabb::Transform(transform, localBounds);
+		object.MaterialId = materialId;
+		object.Alive = true;
+		m_WorldBounds[objectId] = object.WorldBounds;
+		m_NeedsRebuild = true;
+		return objectId;
+	}
+
+	void Scene::RemoveObject(uint32_t objectId)
+	{
+		SceneObject& object = m_Objects[objectId];
+		VK_CORE_ASSERT(object.Alive, "[Scene::RemoveObject]: Object was already removed");
+		object.Alive = false;
+		object.WorldBounds = Aabb(); // empty bounds are never returned by a query
+		m_WorldBounds[objectId] = object.WorldBounds;
+		m_FreeIds.push_back(objectId);
+		m_NeedsRebuild = true;
+	}
+
+	void Scene::SetTransform(uint32_t objectId, const glm::mat4& transform)
+	{
+		SceneObject& object = m_Objects[objectId];
+		object.Transform = transform;
+		object.WorldBounds = Aabb::Transform(transform, object.LocalBounds);
+		m_WorldBounds[objectId] = object.WorldBounds;
+		m_NeedsRefit = true;
+	}
+
+	void Scene::Update()
+	{
+		if (!m_NeedsRebuild && m_NeedsRefit)
+		{
+			m_Hierarchy.Refit(m_WorldBounds);
+			m_NeedsRebuild = m_Hierarchy.GetCost() > m_BuildCost * s_RebuildCostRatio;
+		}
+		if (m_NeedsRebuild)
+		{
+			m_Hierarchy.Build(m_WorldBounds);
+			m_BuildCost = m_Hierarchy.GetCost();
+		}
+		m_NeedsRebuild = false;
+		m_NeedsRefit = false;
+	}
+}
@@ -0,0 +1,69 @@
+/***************************************************************************
+ * Filename		: Scene.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Objects placed in the world (mesh, transform, bounds) and
+ *				  the bounding volume hierarchy that indexes them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include "Bvh.h"
+
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	struct SceneObject
+	{
+		uint32_t MeshId = 0; // GeometryPool mesh
+		glm::mat4 Transform = glm::mat4(1.0f);
+		Aabb LocalBounds; // model space
+		Aabb WorldBounds; // LocalBounds under Transform, empty while the object is removed
+		uint32_t MaterialId = 0; // forwarded to the shaders by the instanced draws
+		bool Alive = false;
+	};
+
+	// object ids stay valid until the object is removed, removed ids are reused by AddObject.
+	// Changes only reach the queries after Update: moved objects refit the hierarchy, added / removed objects
+	// (or a refit tree that has degraded too far) rebuild it.
+	class Scene
+	{
+	public:
+		Scene() = default;
+		~Scene() = default;
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+	public:
+		uint32_t AddObject(uint32_t meshId, const glm::mat4& transform, const Aabb& localBounds, uint32_t materialId = 0);
+		void RemoveObject(uint32_t objectId);
+		void SetTransform(uint32_t objectId, const glm::mat4& transform);
+		void Update();
+
+		void QueryFrustum(const Graphics::Frustum& frustum, std::vector<uint32_t>& objectIds) const { m_Hierarchy.QueryFrustum(frustum, objectIds); }
+		void QueryBox(const Aabb& box, std::vector<uint32_t>& objectIds) const { m_Hierarchy.QueryBox(box, objectIds); }
+		// picking against the objects' world bounds
+		bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, BvhRayHit& hit) const { return m_Hierarchy.Raycast(origin, direction, maxDistance, hit); }
+
+		_NODISCARD const SceneObject& GetSceneObject(uint32_t objectId) const { return m_Objects[objectId]; }
+		_NODISCARD uint32_t GetObjectCapacity() const { return static_cast<uint32_t>(m_Objects.size()); } // including removed objects
+		_NODISCARD const Bvh& GetHierarchy() const { return m_Hierarchy; }
+	public:
+		static constexpr float s_RebuildCostRatio = 1.5f; // refits until the tree costs this much more than after its build
+	private:
+		std::vector<SceneObject> m_Objects;
+		std::vector<Aabb> m_WorldBounds; // m_Objects' world bounds, the array the hierarchy is built from
+		std::vector<uint32_t> m_FreeIds;
+		Bvh m_Hierarchy;
+		float m_BuildCost = 0.0f; // hierarchy cost right after the last build
+		bool m_NeedsRebuild = false;
+		bool m_NeedsRefit = false;
+	};
+}
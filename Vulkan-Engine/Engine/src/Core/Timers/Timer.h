@@ -0,0 +1,60 @@
+/***************************************************************************
+ * Filename		: Timer.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: High resolution cpu timer and running statistics used to
+ *				  measure per frame engine costs.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+namespace Vulkan_Engine
+{
+	class Timer
+	{
+	public:
+		Timer() { Reset(); }
+		~Timer() = default;
+		inline void Reset() { m_Start = std::chrono::high_resolution_clock::now(); }
+		inline float GetMilliseconds() const { return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - m_Start).count(); }
+		inline float GetSeconds() const { return GetMilliseconds() / 1000.f; }
+	private:
+		std::chrono::high_resolution_clock::time_point m_Start;
+	};
+
+	// accumulates samples (in milliseconds) until reset, used to log averages every few hundred frames
+	class TimerStatistics
+	{
+	public:
+		TimerStatistics() = default;
+		~TimerStatistics() = default;
+		inline void AddSample(float milliseconds)
+		{
+			m_Total += milliseconds;
+			m_Min = m_Count == 0 ? milliseconds : std::min(m_Min, milliseconds);
+			m_Max = std::max(m_Max, milliseconds);
+			++m_Count;
+		}
+		inline void Reset() { m_Total = 0.f; m_Min = 0.f; m_Max = 0.f; m_Count = 0; }
+		inline float GetAverage() const { return m_Count == 0 ? 0.f : m_Total / static_cast<float>(m_Count); }
+		inline float GetMin() const { return m_Min; }
+		inline float GetMax() const { return m_Max; }
+		inline uint32_t GetCount() const { return m_Count; }
+	private:
+		float m_Total = 0.f;
+		float m_Min = 0.f;
+		float m_Max = 0.f;
+		uint32_t m_Count = 0;
+	};
+}
@@ -0,0 +1,101 @@
+/***************************************************************************
+ * Filename		: CpuFeatures.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Runtime detection of the x86 SIMD extensions, so kernels
+ *				  can pick an SSE / AVX2 path or fall back to scalar code.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "CpuFeatures.h"
+
+#if VKE_SIMD_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Vulkan_Engine
+{
+#if VKE_SIMD_X86
+	static void QueryCpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+	{
+#ifdef _MSC_VER
+		int values[4];
+		__cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (int i = 0; i < 4; ++i)
+		{
+			registers[i] = static_cast<uint32_t>(values[i]);
+		}
+#else
+		__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+	}
+
+	// xgetbv, which state components the os saves on context switches
+	static uint64_t QueryEnabledStateComponents()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		uint32_t low, high;
+		__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+	}
+
+	static SimdLevel DetectSimdLevel()
+	{
+		uint32_t registers[4]; // eax, ebx, ecx, edx
+		QueryCpuid(0, 0, registers);
+		const uint32_t maxLeaf = registers[0];
+		QueryCpuid(1, 0, registers);
+		const bool sse41 = (registers[2] & (1u << 19)) != 0;
+		const bool fma = (registers[2] & (1u << 12)) != 0;
+		const bool osxsave = (registers[2] & (1u << 27)) != 0;
+		const bool avx = (registers[2] & (1u << 28)) != 0;
+		const bool f16c = (registers[2] & (1u << 29)) != 0;
+		if (!sse41)
+		{
+			return SimdLevel::Scalar;
+		}
+		// the os has to preserve xmm and ymm state (bits 1 and 2) for avx to be usable
+		if (!(osxsave && avx && fma && f16c && maxLeaf >= 7 && (QueryEnabledStateComponents() & 0x6) == 0x6))
+		{
+			return SimdLevel::SSE41;
+		}
+		QueryCpuid(7, 0, registers);
+		const bool avx2 = (registers[1] & (1u << 5)) != 0;
+		return avx2 ? SimdLevel::AVX2 : SimdLevel::SSE41;
+	}
+#endif
+
+	SimdLevel CpuFeatures::GetSimdLevel()
+	{
+#if VKE_SIMD_X86
+		static const SimdLevel level = DetectSimdLevel();
+		return level;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	const char* CpuFeatures::GetSimdLevelName(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::SSE41: return "SSE4.1";
+		case SimdLevel::AVX2: return "AVX2";
+		default: return "Scalar";
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/***************************************************************************
+ * Filename		: CpuFeatures.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Runtime detection of the x86 SIMD extensions, so kernels
+ *				  can pick an SSE / AVX2 path or fall back to scalar code.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VKE_SIMD_X86 1
+#else
+#define VKE_SIMD_X86 0
+#endif
+
+// msvc emits any intrinsic it is asked for, gcc / clang need the extensions enabled per function
+#if VKE_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define VKE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VKE_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#else
+#define VKE_TARGET_SSE41
+#define VKE_TARGET_AVX2
+#endif
+
+namespace Vulkan_Engine
+{
+	enum class SimdLevel
+	{
+		Scalar = 0,
+		SSE41, // SSE4.1
+		AVX2 // AVX2 + FMA + F16C (Haswell and later), with OS support for the ymm registers
+	};
+
+	class CpuFeatures
+	{
+	public:
+		CpuFeatures() = delete;
+		~CpuFeatures() = delete;
+	public:
+		_NODISCARD static SimdLevel GetSimdLevel(); // highest level supported by this cpu / os, detected once
+		_NODISCARD static const char* GetSimdLevelName(SimdLevel level);
+	};
+}
@@ -0,0 +1,67 @@
+/***************************************************************************
+ * Filename		: Hash.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Fast 64 bit hashing of raw bytes (MurmurHash3 style mixing),
+ *				  used for content hashes of source files and vertex data.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace Vulkan_Engine
+{
+	inline uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// final avalanche step, every input bit affects every output bit
+	inline uint64_t HashMix(uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	// processes 8 bytes per step, not suitable for cryptographic use
+	inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = seed ^ (size * 0x9e3779b97f4a7c15ull);
+		const size_t wordCount = size / sizeof(uint64_t);
+		for (size_t i = 0; i < wordCount; ++i)
+		{
+			uint64_t word;
+			std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(word)); // unaligned safe
+			word *= 0x87c37b91114253d5ull;
+			word = RotateLeft(word, 31);
+			word *= 0x4cf5ad432745937full;
+			hash ^= word;
+			hash = RotateLeft(hash, 27) * 5 + 0x52dce729;
+		}
+		uint64_t tail = 0;
+		const size_t tailSize = size % sizeof(uint64_t);
+		if (tailSize != 0)
+		{
+			std::memcpy(&tail, bytes + wordCount * sizeof(uint64_t), tailSize);
+			tail *= 0x87c37b91114253d5ull;
+			tail = RotateLeft(tail, 31);
+			tail *= 0x4cf5ad432745937full;
+			hash ^= tail;
+		}
+		return HashMix(hash);
+	}
+}
@@ -0,0 +1,212 @@
+/***************************************************************************
+ * Filename		: MeshConverter.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Command line tool converting OBJ models to the engine's
+ *				  binary mesh format, optionally benchmarking both loaders.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+#include "Core/Utility/Hash.h"
+#include "Core/Graphics/Mesh/MeshFile.h"
+#include "Core/Graphics/Mesh/MeshletBuilder.h"
+#include "Core/Graphics/Mesh/MeshOptimizer.h"
+#include "Core/Graphics/Mesh/MeshSimplifier.h"
+#include "Core/Graphics/Mesh/VertexKernels.h"
+#include "Core/Graphics/Mesh/ObjImporter.h"
+
+#include <cstring>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+static void PrintUsage()
+{
+	VK_INFO("Usage: MeshConverter <input.obj> <output.vkmesh> [--benchmark <iterations>]");
+}
+
+// times both load paths: parsing the obj vs mapping the binary mesh and reading every byte of it (as the upload would)
+static void RunLoadBenchmark(const std::string& sourcePath, const std::string& meshPath, uint32_t iterations)
+{
+	TimerStatistics objTimings;
+	TimerStatistics binaryTimings;
+	uint64_t checksum = 0; // keeps the reads of the mapped data from being optimized out
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		{
+			const Timer timer;
+			const MeshData mesh = ObjImporter::Import(sourcePath);
+			objTimings.AddSample(timer.GetMilliseconds());
+			checksum += mesh.Vertices.size();
+		}
+		{
+			const Timer timer;
+			const MeshFile meshFile(meshPath);
+			checksum += HashBytes(meshFile.GetVertices(), meshFile.GetVertexDataSize());
+			checksum += HashBytes(meshFile.GetIndices(), meshFile.GetIndexDataSize());
+			binaryTimings.AddSample(timer.GetMilliseconds());
+		}
+	}
+	VK_INFO("[MeshConverter]: obj    load avg {0:.3f}ms, min {1:.3f}ms, max {2:.3f}ms", objTimings.GetAverage(), objTimings.GetMin(), objTimings.GetMax());
+	VK_INFO("[MeshConverter]: vkmesh load avg {0:.3f}ms, min {1:.3f}ms, max {2:.3f}ms", binaryTimings.GetAverage(), binaryTimings.GetMin(), binaryTimings.GetMax());
+	VK_INFO("[MeshConverter]: speedup {0:.1f}x over {1} iterations (checksum {2:x})", objTimings.GetAverage() / binaryTimings.GetAverage(), iterations, checksum);
+}
+
+// times the serial and the sharded vertex deduplication on the same obj and checks that they agree
+static void RunDeduplicationBenchmark(const std::string& sourcePath, uint32_t iterations)
+{
+	TimerStatistics parseTimings;
+	TimerStatistics serialTimings;
+	TimerStatistics parallelTimings;
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		ObjImportStatistics serialStatistics;
+		ObjImportStatistics parallelStatistics;
+		const MeshData serialMesh = ObjImporter::Import(sourcePath, ObjDeduplication::Serial, &serialStatistics);
+		const MeshData parallelMesh = ObjImporter::Import(sourcePath, ObjDeduplication::Parallel, &parallelStatistics);
+		if (serialMesh.Vertices.size() != parallelMesh.Vertices.size() || serialMesh.Indices != parallelMesh.Indices ||
+			std::memcmp(serialMesh.Vertices.data(), parallelMesh.Vertices.data(), sizeof(Vertex) * serialMesh.Vertices.size()) != 0)
+		{
+			VK_ERROR("[MeshConverter]: Serial and parallel deduplication disagree on {0}", sourcePath);
+			return;
+		}
+		parseTimings.AddSample(serialStatistics.ParseMilliseconds);
+		parseTimings.AddSample(parallelStatistics.ParseMilliseconds);
+		serialTimings.AddSample(serialStatistics.DeduplicateMilliseconds);
+		parallelTimings.AddSample(parallelStatistics.DeduplicateMilliseconds);
+	}
+	VK_INFO("[MeshConverter]: obj parse          avg {0:.3f}ms", parseTimings.GetAverage());
+	VK_INFO("[MeshConverter]: dedup serial       avg {0:.3f}ms, min {1:.3f}ms", serialTimings.GetAverage(), serialTimings.GetMin());
+	VK_INFO("[MeshConverter]: dedup {0} threads avg {1:.3f}ms, min {2:.3f}ms ({3:.1f}x)", JobSystem::GetThreadCount(),
+		parallelTimings.GetAverage(), parallelTimings.GetMin(), serialTimings.GetAverage() / parallelTimings.GetAverage());
+}
+
+// times every simd level of the vertex kernels on the converted mesh and checks them against the scalar path
+static void RunKernelBenchmark(const MeshData& mesh, uint32_t iterations)
+{
+	// obj style attribute arrays for the mesh, one (position, normal, texcoord) triple per index
+	std::vector<float> positions;
+	std::vector<float> texcoords;
+	std::vector<int32_t> indexTriples;
+	positions.reserve(mesh.Vertices.size() * 3);
+	texcoords.reserve(mesh.Vertices.size() * 2);
+	indexTriples.reserve(mesh.Indices.size() * 3);
+	for (const Vertex& vertex : mesh.Vertices)
+	{
+		positions.insert(positions.end(), { vertex.Position.x, vertex.Position.y, vertex.Position.z });
+		texcoords.insert(texcoords.end(), { vertex.TexCoord.x, 1.0f - vertex.TexCoord.y });
+	}
+	for (const uint32_t index : mesh.Indices)
+	{
+		indexTriples.insert(indexTriples.end(), { static_cast<int32_t>(index), -1, static_cast<int32_t>(index) });
+	}
+	const PositionQuantization positionQuantization = VertexQuantization::ComputePositionQuantization(mesh.BoundsMin, mesh.BoundsMax);
+
+	std::vector<Vertex> scalarVertices(mesh.Indices.size());
+	std::vector<QuantizedVertex> scalarQuantized(mesh.Vertices.size());
+	std::vector<Vertex> vertices(mesh.Indices.size());
+	std::vector<QuantizedVertex> quantized(mesh.Vertices.size());
+	float scalarMilliseconds[3] = {};
+	for (uint32_t level = 0; level <= static_cast<uint32_t>(CpuFeatures::GetSimdLevel()); ++level)
+	{
+		const SimdLevel simdLevel = static_cast<SimdLevel>(level);
+		TimerStatistics buildTimings;
+		TimerStatistics boundsTimings;
+		TimerStatistics quantizeTimings;
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		for (uint32_t i = 0; i < iterations; ++i)
+		{
+			Timer timer;
+			VertexKernels::BuildObjVertices(positions.data(), texcoords.data(), indexTriples.data(), mesh.Indices.size(), vertices.data(), simdLevel);
+			buildTimings.AddSample(timer.GetMilliseconds());
+			timer.Reset();
+			VertexKernels::ComputeBounds(mesh.Vertices.data(), mesh.Vertices.size(), boundsMin, boundsMax, simdLevel);
+			boundsTimings.AddSample(timer.GetMilliseconds());
+			timer.Reset();
+			VertexKernels::QuantizeVertices(mesh.Vertices.data(), mesh.Vertices.size(), positionQuantization, quantized.data(), simdLevel);
+			quantizeTimings.AddSample(timer.GetMilliseconds());
+		}
+		if (simdLevel == SimdLevel::Scalar)
+		{
+			scalarVertices.swap(vertices);
+			scalarQuantized.swap(quantized);
+			scalarMilliseconds[0] = buildTimings.GetMin();
+			scalarMilliseconds[1] = boundsTimings.GetMin();
+			scalarMilliseconds[2] = quantizeTimings.GetMin();
+		}
+		else if (std::memcmp(vertices.data(), scalarVertices.data(), sizeof(Vertex) * vertices.size()) != 0 ||
+			std::memcmp(quantized.data(), scalarQuantized.data(), sizeof(QuantizedVertex) * quantized.size()) != 0 ||
+			boundsMin != mesh.BoundsMin || boundsMax != mesh.BoundsMax)
+		{
+			VK_ERROR("[MeshConverter]: {0} kernels disagree with the scalar path", CpuFeatures::GetSimdLevelName(simdLevel));
+			return;
+		}
+		VK_INFO("[MeshConverter]: {0,-7} build {1:.3f}ms ({2:.1f}x), bounds {3:.3f}ms ({4:.1f}x), quantize {5:.3f}ms ({6:.1f}x)", CpuFeatures::GetSimdLevelName(simdLevel),
+			buildTimings.GetMin(), scalarMilliseconds[0] / buildTimings.GetMin(), boundsTimings.GetMin(), scalarMilliseconds[1] / boundsTimings.GetMin(),
+			quantizeTimings.GetMin(), scalarMilliseconds[2] / quantizeTimings.GetMin());
+	}
+}
+
+static int Convert(const std::string& sourcePath, const std::string& meshPath, uint32_t benchmarkIterations)
+{
+	try
+	{
+		const Timer convertTimer;
+		const uint64_t sourceHash = MeshFile::HashSourceFile(sourcePath);
+		if (sourceHash == 0)
+		{
+			VK_ERROR("[MeshConverter]: Can't read {0}", sourcePath);
+			return EXIT_FAILURE;
+		}
+		MeshData mesh = ObjImporter::Import(sourcePath);
+		MeshOptimizer::Optimize(mesh);
+		MeshletBuilder::Build(mesh);
+		MeshSimplifier::BuildLodChain(mesh);
+		if (!MeshFile::Write(meshPath, mesh, sourceHash))
+		{
+			return EXIT_FAILURE;
+		}
+		VK_INFO("[MeshConverter]: Converted {0} -> {1} ({2} vertices, {3} indices, {4} meshlets, {5} levels of detail) in {6:.3f}ms",
+			sourcePath, meshPath, mesh.Vertices.size(), mesh.Indices.size(), mesh.Meshlets.size(), mesh.Lods.size(), convertTimer.GetMilliseconds());
+
+		if (benchmarkIterations > 0)
+		{
+			RunLoadBenchmark(sourcePath, meshPath, benchmarkIterations);
+			RunDeduplicationBenchmark(sourcePath, benchmarkIterations);
+			RunKernelBenchmark(mesh, benchmarkIterations);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+	Log::Init();
+	if (argc != 3 && !(argc == 5 && std::string(argv[3]) == "--benchmark"))
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	JobSystem::Init(); // large meshes are deduplicated on every core
+	const uint32_t benchmarkIterations = argc == 5 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[4]))) : 0;
+	const int result = Convert(argv[1], argv[2], benchmarkIterations);
+	JobSystem::Shutdown();
+	return result;
+}
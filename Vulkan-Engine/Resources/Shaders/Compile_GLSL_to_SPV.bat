@@ -1,3 +1,8 @@
 %~dp0Tools\x86\glslc.exe GLSL\Shader.vert -o SPV\Vert.spv
 %~dp0Tools\x86\glslc.exe GLSL\Shader.frag -o SPV\Frag.spv
+%~dp0Tools\x86\glslc.exe GLSL\Instanced.vert -o SPV\Instanced.spv
+%~dp0Tools\x86\glslc.exe GLSL\Bindless.frag -o SPV\Bindless.spv
+%~dp0Tools\x86\glslc.exe GLSL\Cull.comp -o SPV\Cull.spv
+%~dp0Tools\x86\glslc.exe GLSL\DepthPyramid.comp -o SPV\DepthPyramid.spv
+%~dp0Tools\x86\glslc.exe -DMULTISAMPLED GLSL\DepthPyramid.comp -o SPV\DepthPyramidMS.spv
 pause
\ No newline at end of file
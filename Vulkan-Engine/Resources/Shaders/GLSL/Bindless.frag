@@ -0,0 +1,46 @@
+/***************************************************************************
+ * Filename		: Bindless.frag
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Fragment shader of the instanced draws with descriptor indexing,
+ *				  the material id selects the material and its texture per fragment.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : require
+
+// BindlessDescriptors, bound once per command buffer
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+struct Material
+{
+    vec4 BaseColor;
+    uint AlbedoTexture;
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer Materials
+{
+    Material u_Materials[];
+};
+
+layout(location = 0) in vec3 v_FragColor;
+layout(location = 1) in vec2 v_TexCoord;
+layout(location = 2) flat in uint v_MaterialId;
+
+layout(location = 0) out vec4 o_Color;
+
+void main() 
+{
+    Material material = u_Materials[v_MaterialId];
+    // the id can differ within a subgroup once several instances of a draw use different materials
+    vec3 albedo = texture(u_Textures[nonuniformEXT(material.AlbedoTexture)], v_TexCoord).rgb;
+    o_Color = vec4(v_FragColor * albedo * material.BaseColor.rgb, 0.75 * material.BaseColor.a);
+}
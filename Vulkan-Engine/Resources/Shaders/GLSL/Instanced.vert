@@ -0,0 +1,46 @@
+/***************************************************************************
+ * Filename		: Instanced.vert
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Vertex shader of the instanced draws, the model matrix and
+ *				  material come from the per instance vertex binding.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// same block as Shader.vert, Model is unused here (the instance transform replaces it)
+layout(set = 0, binding = 0) uniform UniformBufferObject 
+{
+    mat4 Model;
+    mat4 View;
+    mat4 Projection;
+} ubo;
+
+// binding 0, per vertex
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec3 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+// binding 1, per instance (InstanceData), a mat4 input takes locations 3 - 6
+layout(location = 3) in mat4 a_InstanceTransform;
+layout(location = 7) in uint a_InstanceMaterial;
+
+layout(location = 0) out vec3 v_FragColor;
+layout(location = 1) out vec2 v_TexCoord;
+layout(location = 2) flat out uint v_MaterialId;
+
+void main() 
+{
+    gl_Position = ubo.Projection * ubo.View * a_InstanceTransform * vec4(a_Position, 1.0);
+    v_FragColor = a_Color;
+    v_TexCoord = a_TexCoord;
+    v_MaterialId = a_InstanceMaterial;
+}
@@ -28,6 +28,12 @@ layout(set = 0, binding = 0) uniform UniformBufferObject
     mat4 Projection;
 } ubo;
 
+// per draw transform, pushed with every draw instead of rewriting the uniform buffer (DrawPushConstants on the cpu)
+layout(push_constant) uniform PushConstants
+{
+    mat4 Model;
+} pc;
+
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
@@ -37,7 +43,7 @@ layout(location = 1) out vec2 v_TexCoord;
 
 void main() 
 {
-    gl_Position = ubo.Projection * ubo.View * ubo.Model * vec4(a_Position, 1.0);
+    gl_Position = ubo.Projection * ubo.View * pc.Model * vec4(a_Position, 1.0);
     v_FragColor = a_Color;
     v_TexCoord = a_TexCoord;
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+/***************************************************************************
+ * Filename		: BvhTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Frustum, box and ray queries of the bounding volume
+ *				  hierarchy against a scan of every object, built and refit.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Scene/Bvh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_ObjectCount = 12000; // several parallel subtrees
+	constexpr float s_WorldExtent = 500.0f;
+	constexpr uint32_t s_QueryCount = 64;
+
+	// random boxes of very different sizes, a few of them empty (never returned) or flat
+	std::vector<Aabb> CreateBounds(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> position(-s_WorldExtent, s_WorldExtent);
+		std::uniform_real_distribution<float> size(0.1f, 20.0f);
+		std::vector<Aabb> bounds;
+		for (uint32_t i = 0; i < s_ObjectCount; ++i)
+		{
+			if (i % 997 == 0)
+			{
+				bounds.emplace_back();
+				continue;
+			}
+			const glm::vec3 min(position(random), position(random), position(random));
+			glm::vec3 extent(size(random), size(random), size(random));
+			if (i % 101 == 0)
+			{
+				extent.y = 0.0f;
+			}
+			bounds.emplace_back(min, min + extent);
+		}
+		return bounds;
+	}
+
+	// every object moved far enough that the tree no longer matches where it was built, the empty ones stay empty
+	void MoveBounds(std::vector<Aabb>& bounds, std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> offset(-s_WorldExtent * 0.25f, s_WorldExtent * 0.25f);
+		for (Aabb& box : bounds)
+		{
+			if (!box.IsEmpty())
+			{
+				const glm::vec3 move(offset(random), offset(random), offset(random));
+				box = Aabb(box.Min + move, box.Max + move);
+			}
+		}
+	}
+
+	Frustum CreateFrustum(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> position(-s_WorldExtent, s_WorldExtent);
+		std::uniform_real_distribution<float> fov(20.0f, 90.0f);
+		const glm::vec3 eye(position(random), position(random), position(random));
+		const glm::vec3 target(position(random), position(random), position(random));
+		const glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::mat4 projection = glm::perspective(glm::radians(fov(random)), 16.0f / 9.0f, 0.1f, s_WorldExtent);
+		projection[1][1] *= -1;
+		return Frustum::FromMatrix(projection * view);
+	}
+
+	Aabb CreateQueryBox(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> position(-s_WorldExtent, s_WorldExtent);
+		std::uniform_real_distribution<float> size(0.0f, 150.0f);
+		const glm::vec3 min(position(random), position(random), position(random));
+		return Aabb(min, min + glm::vec3(size(random), size(random), size(random)));
+	}
+
+	std::vector<uint32_t> Sorted(std::vector<uint32_t> objects)
+	{
+		std::sort(objects.begin(), objects.end());
+		return objects;
+	}
+
+	// the same per object tests the tree runs at its leaves, on every object
+	std::vector<uint32_t> ScanFrustum(const std::vector<Aabb>& bounds, const Frustum& frustum)
+	{
+		std::vector<uint32_t> objects;
+		for (uint32_t i = 0; i < bounds.size(); ++i)
+		{
+			if (!bounds[i].IsEmpty() && frustum.ClassifyAabb(bounds[i]) != FrustumTest::Outside)
+			{
+				objects.push_back(i);
+			}
+		}
+		return objects;
+	}
+
+	std::vector<uint32_t> ScanBox(const std::vector<Aabb>& bounds, const Aabb& box)
+	{
+		std::vector<uint32_t> objects;
+		for (uint32_t i = 0; i < bounds.size(); ++i)
+		{
+			if (!bounds[i].IsEmpty() && bounds[i].Overlaps(box))
+			{
+				objects.push_back(i);
+			}
+		}
+		return objects;
+	}
+
+	float ScanRay(const std::vector<Aabb>& bounds, const glm::vec3& origin, const glm::vec3& direction, float maxDistance)
+	{
+		const glm::vec3 inverseDirection = glm::vec3(1.0f) / direction;
+		float closest = FLT_MAX;
+		for (const Aabb& box : bounds)
+		{
+			closest = std::min(closest, box.IntersectRay(origin, inverseDirection, maxDistance));
+		}
+		return closest;
+	}
+
+	// every query of the tree returns exactly what scanning the objects does
+	void CheckQueries(const Bvh& bvh, const std::vector<Aabb>& bounds, std::mt19937& random)
+	{
+		uint32_t frustumHits = 0;
+		uint32_t boxHits = 0;
+		uint32_t rayHits = 0;
+		std::uniform_real_distribution<float> position(-s_WorldExtent, s_WorldExtent);
+		for (uint32_t query = 0; query < s_QueryCount; ++query)
+		{
+			const Frustum frustum = CreateFrustum(random);
+			std::vector<uint32_t> objects;
+			bvh.QueryFrustum(frustum, objects);
+			const std::vector<uint32_t> expectedFrustum = ScanFrustum(bounds, frustum);
+			VKE_CHECK(Sorted(objects) == expectedFrustum); // also catches an object returned twice
+			frustumHits += expectedFrustum.empty() ? 0 : 1;
+
+			const Aabb box = CreateQueryBox(random);
+			objects.clear();
+			bvh.QueryBox(box, objects);
+			const std::vector<uint32_t> expectedBox = ScanBox(bounds, box);
+			VKE_CHECK(Sorted(objects) == expectedBox);
+			boxHits += expectedBox.empty() ? 0 : 1;
+
+			const glm::vec3 origin(position(random), position(random), position(random));
+			const glm::vec3 direction = glm::vec3(position(random), position(random), position(random)) - origin;
+			const float closest = ScanRay(bounds, origin, direction, 1.0f);
+			BvhRayHit hit;
+			VKE_CHECK(bvh.Raycast(origin, direction, 1.0f, hit) == (closest != FLT_MAX));
+			if (closest != FLT_MAX)
+			{
+				// boxes at the same distance may tie, so the distance is compared and the object checked to be at it
+				VKE_CHECK(hit.Distance == closest);
+				VKE_CHECK(bounds[hit.Object].IntersectRay(origin, glm::vec3(1.0f) / direction, 1.0f) == closest);
+				++rayHits;
+			}
+		}
+		// the random queries have to exercise both outcomes
+		VKE_CHECK(frustumHits > 0 && boxHits > 0 && boxHits < s_QueryCount && rayHits > 0 && rayHits < s_QueryCount);
+	}
+
+	// the job system is global, shut it down even when a check throws so the next test starts clean
+	struct JobSystemScope
+	{
+		JobSystemScope() { JobSystem::Init(3); }
+		~JobSystemScope() { JobSystem::Shutdown(); }
+	};
+}
+
+VKE_TEST(Bvh, QueriesMatchScanAfterBuild)
+{
+	std::mt19937 random(7);
+	const std::vector<Aabb> bounds = CreateBounds(random);
+	const JobSystemScope jobSystem;
+	for (const bool parallel : { false, true })
+	{
+		Bvh bvh;
+		bvh.Build(bounds, parallel);
+		VKE_CHECK(bvh.GetObjectCount() == s_ObjectCount);
+		CheckQueries(bvh, bounds, random);
+	}
+}
+
+VKE_TEST(Bvh, QueriesMatchScanAfterRefit)
+{
+	std::mt19937 random(11);
+	std::vector<Aabb> bounds = CreateBounds(random);
+	const JobSystemScope jobSystem;
+	Bvh bvh;
+	bvh.Build(bounds);
+	const uint32_t nodeCount = bvh.GetNodeCount();
+	const float builtCost = bvh.GetCost();
+	MoveBounds(bounds, random);
+	bvh.Refit(bounds);
+	VKE_CHECK(bvh.GetNodeCount() == nodeCount); // the tree itself is kept
+	VKE_CHECK(bvh.GetCost() > builtCost); // and fits the moved objects worse
+	CheckQueries(bvh, bounds, random);
+
+	// the root bounds every object that isn't empty
+	Aabb expectedBounds;
+	for (const Aabb& box : bounds)
+	{
+		expectedBounds.Expand(box);
+	}
+	VKE_CHECK(bvh.GetBounds().Min == expectedBounds.Min && bvh.GetBounds().Max == expectedBounds.Max);
+}
+
+VKE_TEST(Bvh, EmptyTreeReturnsNothing)
+{
+	Bvh bvh;
+	bvh.Build({});
+	std::vector<uint32_t> objects;
+	bvh.QueryBox(Aabb(glm::vec3(-1.0f), glm::vec3(1.0f)), objects);
+	BvhRayHit hit;
+	VKE_CHECK(objects.empty() && !bvh.Raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 10.0f, hit));
+}
@@ -0,0 +1,290 @@
+/***************************************************************************
+ * Filename		: DeviceMemoryAllocatorTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Buddy bookkeeping and the device memory allocator, driven
+ *				  through mock block callbacks instead of a device.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Memory/BuddyAllocator.h"
+#include "Core/Graphics/Memory/DeviceMemoryAllocator.h"
+
+#include <cstring>
+#include <map>
+#include <random>
+
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	// hands out fake memory handles, host visible blocks are backed by real storage so mapped pointers can be written
+	struct MockDevice
+	{
+		std::map<uintptr_t, std::vector<char>> Blocks; // handle -> storage (empty for device local blocks)
+		std::vector<VkDeviceSize> AllocatedSizes;
+		uintptr_t NextHandle = 1;
+		VkDeviceSize FailBlocksOfSize = 0; // AllocateBlock fails for this size, 0 never fails
+
+		DeviceMemoryCallbacks GetCallbacks()
+		{
+			DeviceMemoryCallbacks callbacks;
+			callbacks.AllocateBlock = [this](uint32_t, VkDeviceSize size, VkDeviceMemory& memory, void** mappedData)
+			{
+				if (size == FailBlocksOfSize)
+				{
+					return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+				}
+				const uintptr_t handle = NextHandle++;
+				std::vector<char>& storage = Blocks[handle];
+				if (mappedData != nullptr)
+				{
+					storage.resize(static_cast<size_t>(size));
+					*mappedData = storage.data();
+				}
+				memory = reinterpret_cast<VkDeviceMemory>(handle);
+				AllocatedSizes.push_back(size);
+				return VK_SUCCESS;
+			};
+			callbacks.FreeBlock = [this](VkDeviceMemory memory, bool)
+			{
+				const size_t erased = Blocks.erase(reinterpret_cast<uintptr_t>(memory));
+				VKE_CHECK(erased == 1); // freed twice or never allocated
+			};
+			return callbacks;
+		}
+	};
+
+	// type 0 device local on a large heap, type 1 host visible on a 256MB heap (blocks are an eighth of it)
+	VkPhysicalDeviceMemoryProperties CreateMemoryProperties()
+	{
+		VkPhysicalDeviceMemoryProperties properties = {};
+		properties.memoryTypeCount = 2;
+		properties.memoryTypes[0] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+		properties.memoryTypes[1] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1 };
+		properties.memoryHeapCount = 2;
+		properties.memoryHeaps[0] = { 8ull * 1024 * 1024 * 1024, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+		properties.memoryHeaps[1] = { 256ull * 1024 * 1024, 0 };
+		return properties;
+	}
+
+	bool Overlaps(const DeviceAllocation& a, const DeviceAllocation& b)
+	{
+		return a.Memory == b.Memory && a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+	}
+
+	constexpr VkDeviceSize s_BlockSize = 1024 * 1024;
+}
+
+VKE_TEST(BuddyAllocator, SplitsAndMergesBuddies)
+{
+	BuddyAllocator allocator(1024, 64);
+	VkDeviceSize a, b, c;
+	VKE_CHECK(allocator.Allocate(100, 1, a) && allocator.GetAllocationSize(a) == 128);
+	VKE_CHECK(allocator.Allocate(64, 1, b) && allocator.GetAllocationSize(b) == 64);
+	VKE_CHECK(allocator.Allocate(512, 1, c) && c == 512);
+	VKE_CHECK(a == 0 && b == 128); // lowest offsets first
+	VKE_CHECK(allocator.GetUsedSize() == 128 + 64 + 512);
+	allocator.Free(a);
+	allocator.Free(c);
+	allocator.Free(b);
+	// every split is merged back into the single root block
+	VKE_CHECK(allocator.IsEmpty() && allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFreeBlock() == 1024 && allocator.GetUsedSize() == 0);
+}
+
+VKE_TEST(BuddyAllocator, AlignmentAndLimits)
+{
+	BuddyAllocator allocator(4096, 256);
+	VkDeviceSize small, aligned, offset;
+	VKE_CHECK(allocator.Allocate(16, 1, small) && allocator.GetAllocationSize(small) == 256); // rounded up to the minimum block
+	VKE_CHECK(allocator.Allocate(16, 1024, aligned) && aligned % 1024 == 0 && aligned != small);
+	VKE_CHECK(!allocator.Allocate(0, 1, offset));
+	VKE_CHECK(!allocator.Allocate(8192, 1, offset)); // larger than the range
+	VKE_CHECK(!allocator.Allocate(16, 8192, offset)); // alignment larger than the range
+	VKE_CHECK(!allocator.CanAllocate(16, 8192));
+	VKE_CHECK(allocator.Allocate(2048, 2048, offset) && offset == 2048);
+	VKE_CHECK(!allocator.CanAllocate(2048, 1)); // the lower half is split
+	VKE_CHECK_THROWS(allocator.Free(small + 1));
+	VKE_CHECK_THROWS(BuddyAllocator(1000, 64));
+}
+
+VKE_TEST(BuddyAllocator, RandomAllocationsNeverOverlap)
+{
+	constexpr VkDeviceSize size = 1 << 20;
+	BuddyAllocator allocator(size, 256);
+	std::map<VkDeviceSize, VkDeviceSize> live; // offset -> block size, kept next to the allocator as the reference
+	std::mt19937 random(7);
+	for (uint32_t step = 0; step < 20000; ++step)
+	{
+		if (live.empty() || random() % 3 != 0)
+		{
+			const VkDeviceSize request = 1 + random() % 20000;
+			const VkDeviceSize alignment = VkDeviceSize(1) << (random() % 13);
+			VkDeviceSize offset;
+			if (!allocator.Allocate(request, alignment, offset))
+			{
+				VKE_CHECK(!allocator.CanAllocate(request, alignment));
+				continue;
+			}
+			const VkDeviceSize blockSize = allocator.GetAllocationSize(offset);
+			VKE_CHECK(offset % alignment == 0 && blockSize >= request && offset + blockSize <= size);
+			const auto next = live.lower_bound(offset);
+			VKE_CHECK(next == live.end() || offset + blockSize <= next->first);
+			VKE_CHECK(next == live.begin() || std::prev(next)->first + std::prev(next)->second <= offset);
+			live.emplace(offset, blockSize);
+		}
+		else
+		{
+			auto victim = live.begin();
+			std::advance(victim, random() % live.size());
+			allocator.Free(victim->first);
+			live.erase(victim);
+		}
+		VkDeviceSize used = 0;
+		for (const auto& allocation : live)
+		{
+			used += allocation.second;
+		}
+		VKE_CHECK(allocator.GetUsedSize() == used && allocator.GetAllocationCount() == live.size());
+	}
+	for (const auto& allocation : live)
+	{
+		allocator.Free(allocation.first);
+	}
+	VKE_CHECK(allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFreeBlock() == size);
+}
+
+VKE_TEST(DeviceMemoryAllocator, SubAllocatesBlocks)
+{
+	MockDevice device;
+	{
+		DeviceMemoryAllocator allocator(device.GetCallbacks(), CreateMemoryProperties(), s_BlockSize);
+		std::vector<DeviceAllocation> allocations;
+		for (uint32_t i = 0; i < 200; ++i)
+		{
+			const VkMemoryRequirements requirements = { 1000 + i * 37, 256, 0x3 };
+			allocations.push_back(allocator.Allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true));
+			const DeviceAllocation& allocation = allocations.back();
+			VKE_CHECK(allocation.IsValid() && !allocation.IsDedicated() && allocation.MemoryTypeIndex == 0);
+			VKE_CHECK(allocation.Offset % 256 == 0 && allocation.Offset + allocation.Size <= s_BlockSize);
+		}
+		for (size_t i = 0; i < allocations.size(); ++i)
+		{
+			for (size_t j = i + 1; j < allocations.size(); ++j)
+			{
+				VKE_CHECK(!Overlaps(allocations[i], allocations[j]));
+			}
+		}
+		const MemoryStatistics statistics = allocator.GetStatistics(0);
+		VKE_CHECK(statistics.AllocationCount == 200 && statistics.BlockCount == device.Blocks.size() && statistics.BlockCount < 200);
+		VKE_CHECK(statistics.ReservedBytes == statistics.BlockCount * s_BlockSize && statistics.UsedBytes >= statistics.RequestedBytes);
+
+		// host visible allocations get a pointer into their block's mapping
+		const VkMemoryRequirements hostRequirements = { 4096, 64, 0x3 };
+		DeviceAllocation host = allocator.Allocate(hostRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, true);
+		VKE_CHECK(host.MemoryTypeIndex == 1 && host.MappedData != nullptr);
+		std::memset(host.MappedData, 0xab, static_cast<size_t>(host.Size)); // inside the mock's storage, checked by the sanitizers
+
+		for (DeviceAllocation& allocation : allocations)
+		{
+			allocator.Free(allocation);
+			VKE_CHECK(!allocation.IsValid());
+		}
+		allocator.Free(host);
+		const MemoryStatistics total = allocator.GetTotalStatistics();
+		VKE_CHECK(total.AllocationCount == 0 && total.UsedBytes == 0 && total.RequestedBytes == 0);
+		VKE_CHECK(allocator.GetStatistics(0).BlockCount == 1); // one empty block is kept per pool
+		allocator.ReleaseEmptyBlocks();
+		VKE_CHECK(allocator.GetTotalStatistics().BlockCount == 0 && device.Blocks.empty());
+	}
+	VKE_CHECK(device.Blocks.empty());
+}
+
+VKE_TEST(DeviceMemoryAllocator, LargeAlignmentGetsDedicatedMemory)
+{
+	MockDevice device;
+	DeviceMemoryAllocator allocator(device.GetCallbacks(), CreateMemoryProperties(), s_BlockSize);
+	const VkMemoryRequirements small = { 256, 256, 0x1 };
+	DeviceAllocation first = allocator.Allocate(small, 0, false);
+	// the request is tiny but its alignment is larger than a block, offset 0 of a block would alias the first allocation
+	const VkMemoryRequirements aligned = { 256, s_BlockSize * 4, 0x1 };
+	DeviceAllocation second = allocator.Allocate(aligned, 0, false);
+	VKE_CHECK(second.IsDedicated() && second.Offset == 0 && second.Memory != first.Memory);
+	VKE_CHECK(!Overlaps(first, second));
+	allocator.Free(second);
+	allocator.Free(first);
+	VKE_CHECK(allocator.GetTotalStatistics().AllocationCount == 0);
+}
+
+VKE_TEST(DeviceMemoryAllocator, FailedBlockFallsBackToDedicated)
+{
+	MockDevice device;
+	device.FailBlocksOfSize = s_BlockSize; // every new pool block fails, smaller dedicated allocations succeed
+	DeviceMemoryAllocator allocator(device.GetCallbacks(), CreateMemoryProperties(), s_BlockSize);
+	const VkMemoryRequirements requirements = { 4096, 256, 0x1 };
+	DeviceAllocation allocation = allocator.Allocate(requirements, 0, true);
+	VKE_CHECK(allocation.IsValid() && allocation.IsDedicated() && device.AllocatedSizes.back() == 4096);
+	allocator.Free(allocation);
+	VKE_CHECK(device.Blocks.empty());
+}
+
+VKE_TEST(DeviceMemoryAllocator, OutOfMemoryThrows)
+{
+	MockDevice device;
+	DeviceMemoryCallbacks callbacks = device.GetCallbacks();
+	callbacks.AllocateBlock = [](uint32_t, VkDeviceSize, VkDeviceMemory&, void**) { return VK_ERROR_OUT_OF_DEVICE_MEMORY; };
+	DeviceMemoryAllocator allocator(callbacks, CreateMemoryProperties(), s_BlockSize);
+	const VkMemoryRequirements requirements = { 4096, 256, 0x1 };
+	VKE_CHECK_THROWS(allocator.Allocate(requirements, 0, true)); // neither a block nor dedicated memory
+	const VkMemoryRequirements noType = { 4096, 256, 0x0 };
+	VKE_CHECK_THROWS(allocator.Allocate(noType, 0, true));
+}
+
+VKE_TEST(DeviceMemoryAllocator, DefragmentationEmptiesBlocks)
+{
+	MockDevice device;
+	DeviceMemoryAllocator allocator(device.GetCallbacks(), CreateMemoryProperties(), s_BlockSize);
+	std::vector<DeviceAllocation> allocations;
+	const VkMemoryRequirements requirements = { s_BlockSize / 8, 256, 0x1 };
+	for (uint32_t i = 0; i < 32; ++i) // 4 full blocks
+	{
+		allocations.push_back(allocator.Allocate(requirements, 0, false));
+	}
+	VKE_CHECK(allocator.GetStatistics(0).BlockCount == 4);
+	for (size_t i = 0; i < allocations.size(); i += 2)
+	{
+		allocator.Free(allocations[i]);
+	}
+	std::vector<DeviceAllocation*> movable;
+	for (DeviceAllocation& allocation : allocations)
+	{
+		if (allocation.IsValid())
+		{
+			movable.push_back(&allocation);
+		}
+	}
+	std::vector<DefragmentationMove> moves = allocator.BeginDefragmentation(movable);
+	VKE_CHECK(!moves.empty());
+	allocator.CompleteDefragmentation(moves);
+	VKE_CHECK(allocator.GetStatistics(0).BlockCount == 2 && allocator.GetStatistics(0).AllocationCount == 16);
+	for (size_t i = 0; i < movable.size(); ++i)
+	{
+		for (size_t j = i + 1; j < movable.size(); ++j)
+		{
+			VKE_CHECK(!Overlaps(*movable[i], *movable[j]));
+		}
+	}
+	for (DeviceAllocation* allocation : movable)
+	{
+		allocator.Free(*allocation);
+	}
+}
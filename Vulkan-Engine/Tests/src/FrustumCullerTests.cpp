@@ -0,0 +1,139 @@
+/***************************************************************************
+ * Filename		: FrustumCullerTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Visibility of the simd frustum culling kernels against the
+ *				  scalar sphere test, object by object.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Culling/FrustumCuller.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <limits>
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	// not a multiple of 8, so the last visibility byte is partly padding
+	constexpr uint32_t s_ObjectCount = 100003;
+
+	Frustum CreateFrustum()
+	{
+		const glm::mat4 view = glm::lookAt(glm::vec3(8.0f, 6.0f, 4.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 20.0f);
+		projection[1][1] *= -1;
+		return Frustum::FromMatrix(projection * view);
+	}
+
+	// random spheres around the frustum, then the cases a kernel is most likely to get wrong: spheres touching a plane
+	// from outside, where the compare decides on the last bit, zero and negative radii and nan centers
+	CullingBounds CreateBounds(const Frustum& frustum)
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> radius(0.0f, 2.0f);
+		CullingBounds bounds;
+		bounds.Reserve(s_ObjectCount);
+		while (bounds.GetCount() < s_ObjectCount - 64)
+		{
+			bounds.Add(glm::vec4(position(random), position(random), position(random), radius(random)));
+		}
+		uint32_t plane = 0;
+		while (bounds.GetCount() < s_ObjectCount - 3)
+		{
+			const glm::vec4& planeEquation = frustum.Planes[plane++ % 6];
+			const glm::vec3 normal(planeEquation);
+			const glm::vec3 point(position(random), position(random), position(random));
+			const glm::vec3 onPlane = point - (glm::dot(normal, point) + planeEquation.w) * normal;
+			const float sphereRadius = radius(random);
+			bounds.Add(glm::vec4(onPlane - sphereRadius * normal, sphereRadius));
+		}
+		bounds.Add(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+		bounds.Add(glm::vec4(1.0f, 1.0f, 1.0f, -1.0f));
+		bounds.Add(glm::vec4(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f, 1.0f));
+		return bounds;
+	}
+
+	// the job system is global, shut it down even when a check throws so the next test starts clean
+	struct JobSystemScope
+	{
+		JobSystemScope() { JobSystem::Init(3); }
+		~JobSystemScope() { JobSystem::Shutdown(); }
+	};
+
+	bool IsSphereVisible(const Frustum& frustum, const CullingBounds& bounds, uint32_t index)
+	{
+		const glm::vec3 center(bounds.GetCenterX()[index], bounds.GetCenterY()[index], bounds.GetCenterZ()[index]);
+		return frustum.IntersectsSphere(center, bounds.GetRadius()[index]);
+	}
+}
+
+VKE_TEST(FrustumCuller, SimdPathsMatchScalarOnEveryObject)
+{
+	const Frustum frustum = CreateFrustum();
+	const CullingBounds bounds = CreateBounds(frustum);
+	const uint32_t byteCount = (bounds.GetCount() + 7) / 8;
+
+	std::vector<uint8_t> scalar(byteCount);
+	const uint32_t scalarCount = FrustumCuller::CullSpheres(frustum, bounds, 0, bounds.GetCount(), scalar.data(), SimdLevel::Scalar);
+	uint32_t visibleCount = 0;
+	for (uint32_t i = 0; i < bounds.GetCount(); ++i)
+	{
+		VKE_CHECK(FrustumCuller::IsVisible(scalar, i) == IsSphereVisible(frustum, bounds, i));
+		visibleCount += FrustumCuller::IsVisible(scalar, i);
+	}
+	VKE_CHECK(scalarCount == visibleCount);
+	VKE_CHECK(visibleCount > 0 && visibleCount < bounds.GetCount()); // both outcomes are covered
+
+	// levels above the cpu's are clamped, so this runs whatever the machine supports
+	for (const SimdLevel level : { SimdLevel::SSE41, SimdLevel::AVX2 })
+	{
+		std::vector<uint8_t> simd(byteCount, 0xff);
+		VKE_CHECK(FrustumCuller::CullSpheres(frustum, bounds, 0, bounds.GetCount(), simd.data(), level) == scalarCount);
+		for (uint32_t i = 0; i < bounds.GetCount(); ++i)
+		{
+			VKE_CHECK(FrustumCuller::IsVisible(simd, i) == FrustumCuller::IsVisible(scalar, i));
+		}
+		// the padding spheres are never visible
+		VKE_CHECK(simd.back() >> (bounds.GetCount() & 7) == 0);
+	}
+}
+
+VKE_TEST(FrustumCuller, BatchedCullMatchesSingleRange)
+{
+	const Frustum frustum = CreateFrustum();
+	const CullingBounds bounds = CreateBounds(frustum);
+	std::vector<uint8_t> reference((bounds.GetCount() + 7) / 8);
+	const uint32_t referenceCount = FrustumCuller::CullSpheres(frustum, bounds, 0, bounds.GetCount(), reference.data(), SimdLevel::Scalar);
+
+	// a range starting past the first byte only writes its own bytes
+	const uint32_t first = 8 * 1001;
+	std::vector<uint8_t> range(reference.size(), 0xff);
+	FrustumCuller::CullSpheres(frustum, bounds, first, bounds.GetCount(), range.data(), CpuFeatures::GetSimdLevel());
+	VKE_CHECK(std::all_of(range.begin(), range.begin() + first / 8, [](uint8_t byte) { return byte == 0xff; }));
+	VKE_CHECK(std::equal(range.begin() + first / 8, range.end(), reference.begin() + first / 8));
+
+	// the batches split across the workers cover every object once
+	const JobSystemScope jobSystem;
+	for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::AVX2 })
+	{
+		std::vector<uint8_t> visibility;
+		VKE_CHECK(FrustumCuller::Cull(frustum, bounds, visibility, level) == referenceCount);
+		VKE_CHECK(visibility == reference);
+	}
+}
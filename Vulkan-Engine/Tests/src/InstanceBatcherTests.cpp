@@ -0,0 +1,137 @@
+/***************************************************************************
+ * Filename		: InstanceBatcherTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Grouping of instances into one contiguous run per mesh and
+ *				  level of detail, and the first instance of every batch.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Commands/InstanceBatcher.h"
+
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	// a unit box at the instance's position, the material id records the order of Add
+	void AddInstance(InstanceBatcher& batcher, uint32_t meshId, uint32_t lod, const glm::vec3& position)
+	{
+		glm::mat4 transform(1.0f);
+		transform[3] = glm::vec4(position, 1.0f);
+		batcher.Add(meshId, lod, transform, batcher.GetInstanceCount(), Aabb(position - glm::vec3(0.5f), position + glm::vec3(0.5f)));
+	}
+}
+
+VKE_TEST(InstanceBatcher, GroupsByMeshAndLod)
+{
+	InstanceBatcher batcher;
+	AddInstance(batcher, 2, 0, glm::vec3(0.0f, 0.0f, 0.0f));
+	AddInstance(batcher, 1, 1, glm::vec3(1.0f, 0.0f, 0.0f));
+	AddInstance(batcher, 2, 0, glm::vec3(4.0f, 2.0f, 0.0f));
+	AddInstance(batcher, 1, 0, glm::vec3(0.0f, 3.0f, 0.0f));
+	AddInstance(batcher, 2, 1, glm::vec3(0.0f, 0.0f, 5.0f));
+	AddInstance(batcher, 1, 1, glm::vec3(-2.0f, 0.0f, 0.0f));
+	batcher.Build();
+
+	// ordered by mesh then level, the same mesh at another level is a batch of its own
+	const std::vector<InstanceBatch>& batches = batcher.GetBatches();
+	VKE_CHECK(batches.size() == 4);
+	const uint32_t expected[4][3] = { { 1, 0, 1 }, { 1, 1, 2 }, { 2, 0, 2 }, { 2, 1, 1 } }; // mesh, lod, instances
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		VKE_CHECK(batches[i].MeshId == expected[i][0] && batches[i].Lod == expected[i][1] && batches[i].InstanceCount == expected[i][2]);
+	}
+
+	// within a batch the instances keep the order they were added in, with their transforms
+	const std::vector<InstanceData>& instances = batcher.GetInstances();
+	const std::vector<uint32_t> order = { 3, 1, 5, 0, 2, 4 };
+	VKE_CHECK(instances.size() == order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		VKE_CHECK(instances[i].MaterialId == order[i]);
+	}
+	VKE_CHECK(instances[2].Transform[3] == glm::vec4(-2.0f, 0.0f, 0.0f, 1.0f));
+
+	// the bounds cover every instance of the batch and nothing else
+	VKE_CHECK(batches[1].Bounds.Min == glm::vec3(-2.5f, -0.5f, -0.5f) && batches[1].Bounds.Max == glm::vec3(1.5f, 0.5f, 0.5f));
+	VKE_CHECK(batches[2].Bounds.Min == glm::vec3(-0.5f, -0.5f, -0.5f) && batches[2].Bounds.Max == glm::vec3(4.5f, 2.5f, 0.5f));
+
+	// ids past 16 bits stay apart, the key holds the full mesh id and level
+	InstanceBatcher wide;
+	AddInstance(wide, 0x80000001u, 0xffffffffu, glm::vec3(0.0f));
+	AddInstance(wide, 0x80000001u, 0u, glm::vec3(0.0f));
+	AddInstance(wide, 1u, 0xffffffffu, glm::vec3(0.0f));
+	wide.Build();
+	VKE_CHECK(wide.GetBatches().size() == 3);
+	VKE_CHECK(wide.GetBatches()[0].MeshId == 1u && wide.GetBatches()[0].Lod == 0xffffffffu);
+	VKE_CHECK(wide.GetBatches()[1].MeshId == 0x80000001u && wide.GetBatches()[1].Lod == 0u);
+	VKE_CHECK(wide.GetBatches()[2].MeshId == 0x80000001u && wide.GetBatches()[2].Lod == 0xffffffffu);
+}
+
+VKE_TEST(InstanceBatcher, FirstInstanceIsPrefixOfCounts)
+{
+	std::mt19937 random(11);
+	std::uniform_int_distribution<uint32_t> mesh(0, 9);
+	std::uniform_int_distribution<uint32_t> lod(0, 3);
+	InstanceBatcher batcher;
+	std::vector<std::pair<uint32_t, uint32_t>> added; // (mesh, lod) per Add
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		added.emplace_back(mesh(random), lod(random));
+		AddInstance(batcher, added.back().first, added.back().second, glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+	}
+	batcher.Build();
+
+	// every batch starts where the previous one ended, which is the firstInstance its draw reads the instance buffer from
+	const std::vector<InstanceBatch>& batches = batcher.GetBatches();
+	const std::vector<InstanceData>& instances = batcher.GetInstances();
+	uint32_t firstInstance = 0;
+	for (const InstanceBatch& batch : batches)
+	{
+		VKE_CHECK(batch.FirstInstance == firstInstance);
+		VKE_CHECK(batch.InstanceCount > 0);
+		for (uint32_t i = batch.FirstInstance; i < batch.FirstInstance + batch.InstanceCount; ++i)
+		{
+			const uint32_t addIndex = instances[i].MaterialId;
+			VKE_CHECK(added[addIndex].first == batch.MeshId && added[addIndex].second == batch.Lod);
+			VKE_CHECK(i == batch.FirstInstance || instances[i - 1].MaterialId < addIndex);
+		}
+		firstInstance += batch.InstanceCount;
+	}
+	VKE_CHECK(firstInstance == instances.size() && firstInstance == batcher.GetInstanceCount());
+	VKE_CHECK(batches.size() == 40); // 1000 instances hit every (mesh, lod) pair
+}
+
+VKE_TEST(InstanceBatcher, EmptyBuildHasNoBatches)
+{
+	InstanceBatcher batcher;
+	batcher.Build();
+	VKE_CHECK(batcher.GetBatches().empty() && batcher.GetInstances().empty() && batcher.GetInstanceCount() == 0);
+
+	// a cleared batcher builds nothing of the previous frame
+	AddInstance(batcher, 3, 0, glm::vec3(0.0f));
+	AddInstance(batcher, 4, 2, glm::vec3(1.0f));
+	batcher.Build();
+	VKE_CHECK(batcher.GetBatches().size() == 2);
+	batcher.Clear();
+	batcher.Build();
+	VKE_CHECK(batcher.GetBatches().empty() && batcher.GetInstances().empty() && batcher.GetInstanceCount() == 0);
+
+	AddInstance(batcher, 7, 1, glm::vec3(2.0f));
+	batcher.Build();
+	VKE_CHECK(batcher.GetBatches().size() == 1);
+	VKE_CHECK(batcher.GetBatches()[0].MeshId == 7 && batcher.GetBatches()[0].FirstInstance == 0 && batcher.GetBatches()[0].InstanceCount == 1);
+	VKE_CHECK(batcher.GetInstances().size() == 1 && batcher.GetInstances()[0].MaterialId == 0);
+}
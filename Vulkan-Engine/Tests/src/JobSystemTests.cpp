@@ -0,0 +1,199 @@
+/***************************************************************************
+ * Filename		: JobSystemTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Work stealing, counters, continuations and waiting from
+ *				  inside jobs of the job system.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Jobs/JobSystem.h"
+
+#include <chrono>
+#include <set>
+
+using namespace Vulkan_Engine;
+
+namespace
+{
+	constexpr uint32_t s_WorkerCount = 3;
+
+	// the job system is global, shut it down even when a check throws so the next test starts clean
+	struct JobSystemScope
+	{
+		JobSystemScope() { JobSystem::Init(s_WorkerCount); }
+		~JobSystemScope() { JobSystem::Shutdown(); }
+	};
+
+	// spins until the value is reached, false after a generous timeout instead of hanging the test run
+	bool SpinUntil(const std::atomic<uint32_t>& value, uint32_t expected)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (value.load() < expected)
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				return false;
+			}
+			std::this_thread::yield();
+		}
+		return true;
+	}
+}
+
+VKE_TEST(JobSystem, RunsInlineBeforeInit)
+{
+	uint32_t value = 0;
+	JobCounter counter;
+	JobSystem::Execute([&value]() { value = 1; }, &counter);
+	VKE_CHECK(value == 1);
+	VKE_CHECK(counter.IsDone());
+	JobSystem::Wait(counter);
+	VKE_CHECK(JobSystem::GetThreadCount() == 1);
+}
+
+VKE_TEST(JobSystem, IdleWorkersStealQueuedJobs)
+{
+	JobSystemScope jobSystem;
+	VKE_CHECK(JobSystem::GetThreadCount() == s_WorkerCount + 1);
+
+	// every job lands in the main thread's queue, each one only finishes once a job runs on every thread at the same time,
+	// which the workers can only reach by stealing (and the main thread by running jobs while it waits)
+	const uint32_t threadCount = JobSystem::GetThreadCount();
+	std::atomic<uint32_t> running{ 0 };
+	std::atomic<uint32_t> timedOut{ 0 };
+	std::mutex mutex;
+	std::set<uint32_t> threadIndices;
+	JobCounter counter;
+	for (uint32_t i = 0; i < threadCount; ++i)
+	{
+		JobSystem::Execute([&]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				threadIndices.insert(JobSystem::GetThreadIndex());
+			}
+			++running;
+			if (!SpinUntil(running, threadCount))
+			{
+				++timedOut;
+			}
+		}, &counter);
+	}
+	JobSystem::Wait(counter);
+	VKE_CHECK(timedOut == 0);
+	VKE_CHECK(threadIndices.size() == threadCount);
+	VKE_CHECK(*threadIndices.rbegin() == threadCount - 1);
+}
+
+VKE_TEST(JobSystem, CounterTracksEveryJob)
+{
+	JobSystemScope jobSystem;
+	for (uint32_t round = 0; round < 20; ++round)
+	{
+		constexpr uint32_t jobCount = 500;
+		std::atomic<uint32_t> ran{ 0 };
+		JobCounter counter;
+		for (uint32_t i = 0; i < jobCount; ++i)
+		{
+			JobSystem::Execute([&ran]() { ++ran; }, &counter);
+		}
+		JobSystem::Wait(counter);
+		VKE_CHECK(counter.IsDone());
+		VKE_CHECK(ran == jobCount);
+
+		// every index is visited exactly once, also with a count that is not a multiple of the batch size
+		std::vector<std::atomic<uint32_t>> visits(10007);
+		JobSystem::ParallelFor(static_cast<uint32_t>(visits.size()), 97, [&visits](uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = first; i < last; ++i)
+			{
+				++visits[i];
+			}
+		});
+		VKE_CHECK(std::all_of(visits.begin(), visits.end(), [](const std::atomic<uint32_t>& count) { return count.load() == 1; }));
+	}
+}
+
+VKE_TEST(JobSystem, ContinuationsRunAfterTheirDependency)
+{
+	JobSystemScope jobSystem;
+	for (uint32_t round = 0; round < 20; ++round)
+	{
+		std::mutex mutex;
+		std::vector<uint32_t> order;
+		const auto record = [&mutex, &order](uint32_t step)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(step);
+		};
+
+		JobCounter first;
+		JobCounter second;
+		JobCounter third;
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			JobSystem::Execute([&record]() { record(1); }, &first);
+		}
+		JobSystem::ExecuteAfter(first, [&record]()
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+			record(2);
+		}, &second);
+		JobSystem::ExecuteAfter(second, [&record]() { record(3); }, &third);
+		// the continuation counts on third straight away, so waiting on it covers the whole chain
+		VKE_CHECK(!third.IsDone());
+		JobSystem::Wait(third);
+		VKE_CHECK(order.size() == 10);
+		VKE_CHECK(std::count(order.begin(), order.begin() + 8, 1u) == 8);
+		VKE_CHECK(order[8] == 2 && order[9] == 3);
+
+		// a dependency that is already done queues the job immediately
+		std::atomic<uint32_t> ran{ 0 };
+		JobCounter after;
+		JobSystem::ExecuteAfter(first, [&ran]() { ++ran; }, &after);
+		JobSystem::Wait(after);
+		VKE_CHECK(ran == 1);
+	}
+}
+
+VKE_TEST(JobSystem, WaitInsideJobsRunsOtherJobs)
+{
+	JobSystemScope jobSystem;
+	for (uint32_t round = 0; round < 20; ++round)
+	{
+		// more waiting jobs than threads, they only finish because every Wait keeps running queued jobs
+		std::atomic<uint32_t> innerJobs{ 0 };
+		JobCounter outer;
+		for (uint32_t i = 0; i < 64; ++i)
+		{
+			JobSystem::Execute([&innerJobs]()
+			{
+				JobCounter inner;
+				for (uint32_t j = 0; j < 16; ++j)
+				{
+					JobSystem::Execute([&innerJobs]() { ++innerJobs; }, &inner);
+				}
+				JobSystem::Wait(inner); // checks can't throw on a worker, innerJobs is verified below
+			}, &outer);
+		}
+		JobSystem::Wait(outer);
+		VKE_CHECK(innerJobs == 64 * 16);
+
+		std::atomic<uint32_t> nestedItems{ 0 };
+		JobSystem::ParallelFor(16, 1, [&nestedItems](uint32_t, uint32_t)
+		{
+			JobSystem::ParallelFor(64, 4, [&nestedItems](uint32_t first, uint32_t last) { nestedItems += last - first; });
+		});
+		VKE_CHECK(nestedItems == 16 * 64);
+	}
+}
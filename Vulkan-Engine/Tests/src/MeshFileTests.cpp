@@ -0,0 +1,164 @@
+/***************************************************************************
+ * Filename		: MeshFileTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Binary mesh files with out of range indices, levels of
+ *				  detail and meshlets are rejected when they are mapped.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Mesh/MeshFile.h"
+
+#include <cstring>
+#include <filesystem>
+
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	// a quad as one meshlet with a single level of detail, every reference in range
+	MeshData CreateQuad()
+	{
+		MeshData mesh;
+		mesh.Vertices.resize(4);
+		mesh.Vertices[0].Position = glm::vec3(0.0f, 0.0f, 0.0f);
+		mesh.Vertices[1].Position = glm::vec3(1.0f, 0.0f, 0.0f);
+		mesh.Vertices[2].Position = glm::vec3(1.0f, 1.0f, 0.0f);
+		mesh.Vertices[3].Position = glm::vec3(0.0f, 1.0f, 0.0f);
+		mesh.Indices = { 0, 1, 2, 0, 2, 3 };
+		mesh.Lods.push_back({ 0, 6, 0.0f });
+		Meshlet meshlet;
+		meshlet.FirstIndex = 0;
+		meshlet.VertexOffset = 0;
+		meshlet.VertexCount = 4;
+		meshlet.TriangleOffset = 0;
+		meshlet.TriangleCount = 2;
+		mesh.Meshlets.push_back(meshlet);
+		mesh.MeshletVertices = { 0, 1, 2, 3 };
+		mesh.MeshletTriangles = { 0, 1, 2, 0, 2, 3, 0, 0 }; // padded to 4 bytes
+		mesh.ComputeBounds();
+		return mesh;
+	}
+
+	// Write doesn't validate, so a broken mesh ends up on disk exactly like a corrupt file would
+	bool IsValidOnDisk(const MeshData& mesh)
+	{
+		const std::string filepath = (std::filesystem::temp_directory_path() / "MeshFileTests.vkmesh").string();
+		VKE_CHECK(MeshFile::Write(filepath, mesh, 1));
+		bool valid;
+		{
+			const MeshFile meshFile(filepath);
+			valid = meshFile.IsValid();
+		}
+		std::error_code error;
+		std::filesystem::remove(filepath, error);
+		return valid;
+	}
+}
+
+VKE_TEST(MeshFile, AcceptsConsistentMesh)
+{
+	const MeshData mesh = CreateQuad();
+	const std::string filepath = (std::filesystem::temp_directory_path() / "MeshFileTests.vkmesh").string();
+	VKE_CHECK(MeshFile::Write(filepath, mesh, 42));
+	{
+		const MeshFile meshFile(filepath);
+		VKE_CHECK(meshFile.IsValid());
+		VKE_CHECK(meshFile.GetSourceHash() == 42);
+		VKE_CHECK(meshFile.GetVertexCount() == 4 && meshFile.GetIndexCount() == 6);
+		VKE_CHECK(meshFile.GetMeshletCount() == 1 && meshFile.GetLodCount() == 1);
+	}
+	std::error_code error;
+	std::filesystem::remove(filepath, error);
+}
+
+VKE_TEST(MeshFile, InMemoryMatchesMappedFile)
+{
+	const MeshData mesh = CreateQuad();
+	const std::string filepath = (std::filesystem::temp_directory_path() / "MeshFileTests.vkmesh").string();
+	VKE_CHECK(MeshFile::Write(filepath, mesh, 42));
+	{
+		const MeshFile mapped(filepath);
+		const MeshFile inMemory(mesh, 42);
+		VKE_CHECK(mapped.IsValid() && inMemory.IsValid());
+		VKE_CHECK(inMemory.GetSourceHash() == 42);
+		VKE_CHECK(std::memcmp(mapped.GetVertices(), inMemory.GetVertices(), mapped.GetVertexDataSize()) == 0);
+		VKE_CHECK(std::memcmp(mapped.GetIndices(), inMemory.GetIndices(), mapped.GetIndexDataSize()) == 0);
+		VKE_CHECK(std::memcmp(mapped.GetMeshletTriangles(), inMemory.GetMeshletTriangles(), mapped.GetMeshletTriangleDataSize()) == 0);
+		VKE_CHECK(inMemory.GetMeshletCount() == 1 && inMemory.GetLodCount() == 1 && inMemory.GetLods()[0].IndexCount == 6);
+	}
+	std::error_code error;
+	std::filesystem::remove(filepath, error);
+}
+
+VKE_TEST(MeshFile, LoadObjFallsBackWhenCacheCantBeWritten)
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+	const std::string sourcePath = (directory / "MeshFileTests.obj").string();
+	{
+		std::ofstream source(sourcePath, std::ios::trunc);
+		source << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\nf 1/1 2/2 3/3\nf 1/1 3/3 4/4\n";
+	}
+	// the cache's directory would have to be created inside a regular file
+	const std::string cachePath = (directory / "MeshFileTests.obj" / "MeshFileTests.vkmesh").string();
+	const Vulkan_Engine::Scope<MeshFile> meshFile = MeshFile::LoadObj(sourcePath, cachePath);
+	VKE_CHECK(meshFile && meshFile->IsValid());
+	VKE_CHECK(meshFile->GetSourceHash() == MeshFile::HashSourceFile(sourcePath));
+	VKE_CHECK(meshFile->GetVertexCount() == 4 && meshFile->GetIndexCount() >= 6);
+	VKE_CHECK(meshFile->GetLodCount() >= 1 && meshFile->GetMeshletCount() >= 1);
+	std::error_code error;
+	std::filesystem::remove(sourcePath, error);
+}
+
+VKE_TEST(MeshFile, RejectsIndexPastVertexCount)
+{
+	MeshData mesh = CreateQuad();
+	mesh.Indices[4] = 4;
+	VKE_CHECK(!IsValidOnDisk(mesh));
+	mesh = CreateQuad();
+	mesh.Indices.push_back(0); // not a whole triangle
+	VKE_CHECK(!IsValidOnDisk(mesh));
+}
+
+VKE_TEST(MeshFile, RejectsLodOutsideIndexBuffer)
+{
+	MeshData mesh = CreateQuad();
+	mesh.Lods.push_back({ 3, 6, 0.1f });
+	VKE_CHECK(!IsValidOnDisk(mesh));
+	mesh = CreateQuad();
+	mesh.Lods[0].FirstIndex = 0xfffffffa; // wraps around in 32 bits
+	VKE_CHECK(!IsValidOnDisk(mesh));
+}
+
+VKE_TEST(MeshFile, RejectsMeshletReferencesOutOfRange)
+{
+	MeshData mesh = CreateQuad();
+	mesh.MeshletVertices[3] = 9; // past the vertices
+	VKE_CHECK(!IsValidOnDisk(mesh));
+
+	mesh = CreateQuad();
+	mesh.Meshlets[0].VertexCount = 5; // past the meshlet vertices
+	VKE_CHECK(!IsValidOnDisk(mesh));
+
+	mesh = CreateQuad();
+	mesh.Meshlets[0].VertexCount = 3;
+	mesh.MeshletVertices.pop_back();
+	VKE_CHECK(!IsValidOnDisk(mesh)); // local index 3 past the meshlet's vertices
+
+	mesh = CreateQuad();
+	mesh.Meshlets[0].TriangleOffset = 4; // second triangle past the triangle data
+	VKE_CHECK(!IsValidOnDisk(mesh));
+
+	mesh = CreateQuad();
+	mesh.Meshlets[0].FirstIndex = 3; // triangles past the index buffer
+	VKE_CHECK(!IsValidOnDisk(mesh));
+}
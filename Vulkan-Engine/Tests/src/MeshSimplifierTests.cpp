@@ -0,0 +1,151 @@
+/***************************************************************************
+ * Filename		: MeshSimplifierTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Level of detail chains (determinism, triangle budgets and
+ *				  errors) and the level picked for a given distance.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Mesh/LodSelector.h"
+#include "Core/Graphics/Mesh/MeshSimplifier.h"
+
+#include <cmath>
+
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_GridSize = 64; // 8192 triangles, enough for every level of the chain
+
+	// a grid of quads on the xz plane, displaced by heightScale along y
+	MeshData CreateTerrain(float heightScale)
+	{
+		MeshData mesh;
+		for (uint32_t z = 0; z <= s_GridSize; ++z)
+		{
+			for (uint32_t x = 0; x <= s_GridSize; ++x)
+			{
+				Vertex vertex = {};
+				const float height = std::sin(static_cast<float>(x) * 0.2f) * std::cos(static_cast<float>(z) * 0.15f) * heightScale;
+				vertex.Position = glm::vec3(static_cast<float>(x), height, static_cast<float>(z));
+				mesh.Vertices.push_back(vertex);
+			}
+		}
+		for (uint32_t z = 0; z < s_GridSize; ++z)
+		{
+			for (uint32_t x = 0; x < s_GridSize; ++x)
+			{
+				const uint32_t corner = z * (s_GridSize + 1) + x;
+				mesh.Indices.insert(mesh.Indices.end(), { corner, corner + s_GridSize + 1, corner + 1 });
+				mesh.Indices.insert(mesh.Indices.end(), { corner + 1, corner + s_GridSize + 1, corner + s_GridSize + 2 });
+			}
+		}
+		mesh.ComputeBounds();
+		return mesh;
+	}
+
+	std::vector<uint32_t> GetTriangleCounts(const MeshData& mesh)
+	{
+		std::vector<uint32_t> triangleCounts;
+		for (const MeshLod& lod : mesh.Lods)
+		{
+			triangleCounts.push_back(lod.IndexCount / 3);
+		}
+		return triangleCounts;
+	}
+
+	// errors of 0.01, 0.05 and 0.2 model units for levels 1 to 3
+	const MeshLod s_Lods[] = { { 0, 3000, 0.0f }, { 3000, 1500, 0.01f }, { 4500, 750, 0.05f }, { 5250, 375, 0.2f } };
+}
+
+VKE_TEST(MeshSimplifier, LodChainIsDeterministic)
+{
+	MeshData first = CreateTerrain(4.0f);
+	MeshData second = CreateTerrain(4.0f);
+	MeshSimplifier::BuildLodChain(first);
+	MeshSimplifier::BuildLodChain(second);
+	VKE_CHECK(first.Lods.size() > 2);
+	VKE_CHECK(GetTriangleCounts(first) == GetTriangleCounts(second));
+	VKE_CHECK(first.Indices == second.Indices);
+	for (size_t lod = 0; lod < first.Lods.size(); ++lod)
+	{
+		VKE_CHECK(first.Lods[lod].Error == second.Lods[lod].Error);
+	}
+}
+
+VKE_TEST(MeshSimplifier, LodTriangleCountsWithinTarget)
+{
+	MeshData mesh = CreateTerrain(4.0f);
+	MeshSimplifier::BuildLodChain(mesh);
+	VKE_CHECK(mesh.Lods.size() > 2 && mesh.Lods.size() <= MeshSimplifier::s_MaxLods);
+	VKE_CHECK(mesh.Lods[0].FirstIndex == 0 && mesh.Lods[0].IndexCount == 6 * s_GridSize * s_GridSize);
+	for (size_t lod = 1; lod < mesh.Lods.size(); ++lod)
+	{
+		// each level is simplified from the previous one to at most s_LodReduction of its triangles
+		const uint32_t target = static_cast<uint32_t>(static_cast<float>(mesh.Lods[lod - 1].IndexCount / 3) * MeshSimplifier::s_LodReduction);
+		VKE_CHECK(target >= MeshSimplifier::s_MinLodTriangles);
+		VKE_CHECK(mesh.Lods[lod].IndexCount % 3 == 0 && mesh.Lods[lod].IndexCount > 0);
+		VKE_CHECK(mesh.Lods[lod].IndexCount / 3 <= target);
+		VKE_CHECK(mesh.Lods[lod].FirstIndex == mesh.Lods[lod - 1].FirstIndex + mesh.Lods[lod - 1].IndexCount);
+	}
+	const MeshLod& last = mesh.Lods.back();
+	VKE_CHECK(last.FirstIndex + last.IndexCount == mesh.Indices.size());
+	VKE_CHECK(std::all_of(mesh.Indices.begin(), mesh.Indices.end(), [&mesh](uint32_t index) { return index < mesh.Vertices.size(); }));
+}
+
+VKE_TEST(MeshSimplifier, LodErrorsMonotonicAndBounded)
+{
+	MeshData mesh = CreateTerrain(4.0f);
+	MeshSimplifier::BuildLodChain(mesh);
+	const float diagonal = glm::length(mesh.BoundsMax - mesh.BoundsMin);
+	VKE_CHECK(mesh.Lods[0].Error == 0.0f);
+	for (size_t lod = 1; lod < mesh.Lods.size(); ++lod)
+	{
+		VKE_CHECK(std::isfinite(mesh.Lods[lod].Error));
+		VKE_CHECK(mesh.Lods[lod].Error >= mesh.Lods[lod - 1].Error);
+		VKE_CHECK(mesh.Lods[lod].Error <= diagonal);
+	}
+	VKE_CHECK(mesh.Lods.back().Error > 0.0f); // a curved surface can't lose most of its triangles for free
+
+	// a plane is simplified without leaving it
+	MeshData plane = CreateTerrain(0.0f);
+	MeshSimplifier::BuildLodChain(plane);
+	VKE_CHECK(plane.Lods.size() > 2);
+	for (const MeshLod& lod : plane.Lods)
+	{
+		VKE_CHECK(lod.Error < 1e-3f);
+	}
+}
+
+VKE_TEST(LodSelector, PicksLevelForScreenSpaceError)
+{
+	// a 90 degree field of view over 1000 pixels: one world unit at distance 1 covers 500 pixels
+	const float projectionScale = LodSelector::GetProjectionScale(glm::radians(90.0f), 1000.0f);
+	VKE_CHECK(std::abs(projectionScale - 500.0f) < 1e-3f);
+
+	// an error covers maxPixelError pixels at distance = error * projectionScale * errorScale / maxPixelError
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 1.0f, projectionScale) == 0); // 0.002 units per pixel
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 10.0f, projectionScale) == 1); // 0.02
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 30.0f, projectionScale) == 2); // 0.06
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 200.0f, projectionScale) == 3); // 0.4
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 10000.0f, projectionScale) == 3); // past the last level
+
+	// a model scaled up twice shows its errors twice as large, a looser pixel budget allows coarser levels
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 30.0f, projectionScale, 2.0f) == 1); // 0.03
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 10.0f, projectionScale, 1.0f, 4.0f) == 2); // 0.08
+
+	// inside the bounds, or a single level
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 4, 0.0f, projectionScale) == 0);
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 1, 10000.0f, projectionScale) == 0);
+	VKE_CHECK(LodSelector::SelectLod(s_Lods, 0, 10000.0f, projectionScale) == 0);
+}
@@ -0,0 +1,233 @@
+/***************************************************************************
+ * Filename		: MeshletBuilderTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Meshlet limits, triangle coverage and the bounding spheres
+ *				  / normal cones used to cull them.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Mesh/MeshletBuilder.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <array>
+#include <random>
+
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr float s_Epsilon = 1e-4f;
+
+	// a uv sphere, curved enough that meshlets get narrow normal cones
+	MeshData CreateSphere(uint32_t rings, uint32_t segments)
+	{
+		MeshData mesh;
+		for (uint32_t ring = 0; ring <= rings; ++ring)
+		{
+			const float theta = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+			for (uint32_t segment = 0; segment <= segments; ++segment)
+			{
+				const float phi = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+				Vertex vertex = {};
+				vertex.Position = glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)) * 5.0f;
+				mesh.Vertices.push_back(vertex);
+			}
+		}
+		for (uint32_t ring = 0; ring < rings; ++ring)
+		{
+			for (uint32_t segment = 0; segment < segments; ++segment)
+			{
+				const uint32_t corner = ring * (segments + 1) + segment;
+				mesh.Indices.insert(mesh.Indices.end(), { corner, corner + segments + 2, corner + 1 });
+				mesh.Indices.insert(mesh.Indices.end(), { corner, corner + segments + 1, corner + segments + 2 });
+			}
+		}
+		mesh.ComputeBounds();
+		return mesh;
+	}
+
+	// triangles between random vertices of a small cloud, few of them share edges so the vertex limit closes the meshlets.
+	// Ends with two degenerate triangles (a repeated corner and a single point)
+	MeshData CreateTriangleSoup(uint32_t triangleCount)
+	{
+		MeshData mesh;
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+		for (uint32_t i = 0; i < 500; ++i)
+		{
+			Vertex vertex = {};
+			vertex.Position = glm::vec3(position(random), position(random), position(random));
+			mesh.Vertices.push_back(vertex);
+		}
+		std::uniform_int_distribution<uint32_t> vertex(0, 499);
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			mesh.Indices.insert(mesh.Indices.end(), { vertex(random), vertex(random), vertex(random) });
+		}
+		mesh.Indices.insert(mesh.Indices.end(), { 7, 7, 8 });
+		mesh.Indices.insert(mesh.Indices.end(), { 9, 9, 9 });
+		mesh.ComputeBounds();
+		return mesh;
+	}
+
+	// rotated to start at the smallest index so the winding is kept
+	std::array<uint32_t, 3> CanonicalTriangle(uint32_t a, uint32_t b, uint32_t c)
+	{
+		if (b < a && b <= c)
+		{
+			return { b, c, a };
+		}
+		if (c < a && c < b)
+		{
+			return { c, a, b };
+		}
+		return { a, b, c };
+	}
+
+	std::vector<std::array<uint32_t, 3>> GetSortedTriangles(const std::vector<uint32_t>& indices)
+	{
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			triangles.push_back(CanonicalTriangle(indices[i], indices[i + 1], indices[i + 2]));
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	// the triangles of a meshlet, read through its local indices and vertex list
+	std::vector<std::array<uint32_t, 3>> GetMeshletTriangles(const MeshData& mesh, const Meshlet& meshlet)
+	{
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+		{
+			std::array<uint32_t, 3> corners;
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				const uint8_t local = mesh.MeshletTriangles[meshlet.TriangleOffset + triangle * 3 + corner];
+				VKE_CHECK(local < meshlet.VertexCount);
+				corners[corner] = mesh.MeshletVertices[meshlet.VertexOffset + local];
+			}
+			triangles.push_back(corners);
+		}
+		return triangles;
+	}
+
+	void CheckLimits(const MeshData& mesh)
+	{
+		VKE_CHECK(!mesh.Meshlets.empty());
+		for (const Meshlet& meshlet : mesh.Meshlets)
+		{
+			VKE_CHECK(meshlet.VertexCount > 0 && meshlet.VertexCount <= MeshletBuilder::s_MaxVertices);
+			VKE_CHECK(meshlet.TriangleCount > 0 && meshlet.TriangleCount <= MeshletBuilder::s_MaxTriangles);
+			VKE_CHECK(meshlet.TriangleOffset % 4 == 0);
+		}
+	}
+
+	// every triangle of the input is in exactly one meshlet, and each meshlet's triangles are its range of the index buffer
+	void CheckCoverage(const MeshData& mesh, const std::vector<uint32_t>& inputIndices)
+	{
+		std::vector<uint32_t> meshletIndices;
+		uint32_t firstIndex = 0;
+		for (const Meshlet& meshlet : mesh.Meshlets)
+		{
+			VKE_CHECK(meshlet.FirstIndex == firstIndex);
+			firstIndex += meshlet.TriangleCount * 3;
+			const std::vector<std::array<uint32_t, 3>> triangles = GetMeshletTriangles(mesh, meshlet);
+			for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+			{
+				for (uint32_t corner = 0; corner < 3; ++corner)
+				{
+					VKE_CHECK(mesh.Indices[meshlet.FirstIndex + triangle * 3 + corner] == triangles[triangle][corner]);
+				}
+				meshletIndices.insert(meshletIndices.end(), triangles[triangle].begin(), triangles[triangle].end());
+			}
+		}
+		VKE_CHECK(firstIndex == mesh.Indices.size());
+		VKE_CHECK(GetSortedTriangles(meshletIndices) == GetSortedTriangles(inputIndices));
+	}
+
+	void CheckBoundingSpheres(const MeshData& mesh)
+	{
+		for (const Meshlet& meshlet : mesh.Meshlets)
+		{
+			for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+			{
+				const glm::vec3& position = mesh.Vertices[mesh.MeshletVertices[meshlet.VertexOffset + i]].Position;
+				VKE_CHECK(glm::distance(position, meshlet.Center) <= meshlet.Radius * (1.0f + s_Epsilon) + s_Epsilon);
+			}
+		}
+	}
+
+	// every non degenerate triangle normal within the cone's half angle of its axis, and the apex behind every triangle
+	// (what makes IsBackfacing conservative). Returns the number of meshlets that got a cone
+	uint32_t CheckNormalCones(const MeshData& mesh)
+	{
+		uint32_t coneCount = 0;
+		for (const Meshlet& meshlet : mesh.Meshlets)
+		{
+			if (meshlet.ConeCutoff >= 1.0f)
+			{
+				continue; // too spread out, never culled
+			}
+			++coneCount;
+			VKE_CHECK(std::abs(glm::length(meshlet.ConeAxis) - 1.0f) < s_Epsilon);
+			const float minDot = std::sqrt(1.0f - meshlet.ConeCutoff * meshlet.ConeCutoff); // cos of the half angle
+			for (const std::array<uint32_t, 3>& triangle : GetMeshletTriangles(mesh, meshlet))
+			{
+				const glm::vec3& p0 = mesh.Vertices[triangle[0]].Position;
+				const glm::vec3 normal = glm::cross(mesh.Vertices[triangle[1]].Position - p0, mesh.Vertices[triangle[2]].Position - p0);
+				const float area = glm::length(normal);
+				if (!(area > 0.0f))
+				{
+					continue;
+				}
+				VKE_CHECK(glm::dot(meshlet.ConeAxis, normal / area) >= minDot - s_Epsilon);
+				VKE_CHECK(glm::dot(meshlet.ConeApex - p0, normal / area) <= s_Epsilon * (1.0f + meshlet.Radius));
+			}
+		}
+		return coneCount;
+	}
+}
+
+VKE_TEST(MeshletBuilder, SphereMeshletsWithinLimitsAndBounded)
+{
+	MeshData mesh = CreateSphere(48, 96);
+	const std::vector<uint32_t> inputIndices = mesh.Indices;
+	MeshletBuilder::Build(mesh);
+	CheckLimits(mesh);
+	CheckCoverage(mesh, inputIndices);
+	CheckBoundingSpheres(mesh);
+	VKE_CHECK(CheckNormalCones(mesh) > mesh.Meshlets.size() / 2); // most patches of a sphere are narrow enough to cull
+}
+
+VKE_TEST(MeshletBuilder, TriangleSoupMeshletsWithinLimitsAndBounded)
+{
+	MeshData mesh = CreateTriangleSoup(5000);
+	const std::vector<uint32_t> inputIndices = mesh.Indices;
+	MeshletBuilder::Build(mesh);
+	CheckLimits(mesh);
+	CheckCoverage(mesh, inputIndices);
+	CheckBoundingSpheres(mesh);
+	CheckNormalCones(mesh);
+	// unrelated triangles add up to 3 vertices each, the vertex limit has to close most meshlets
+	VKE_CHECK(std::any_of(mesh.Meshlets.begin(), mesh.Meshlets.end(), [](const Meshlet& meshlet) { return meshlet.VertexCount > MeshletBuilder::s_MaxVertices - 3; }));
+}
+
+VKE_TEST(MeshletBuilder, EmptyMeshHasNoMeshlets)
+{
+	MeshData mesh;
+	MeshletBuilder::Build(mesh);
+	VKE_CHECK(mesh.Meshlets.empty() && mesh.MeshletVertices.empty() && mesh.MeshletTriangles.empty());
+}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ * Filename		: ObjImporterTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: The parallel vertex deduplication against the serial one
+ *				  on the same obj, at several worker counts.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Mesh/ObjImporter.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_GridSize = 160; // 153600 indices, several deduplication chunks and above the Auto threshold
+	constexpr uint32_t s_SeamInterval = 7; // every 7th quad uses its own texture coordinates, so positions are shared by distinct vertices
+
+	// a grid of quads with its faces in random order, written as an obj. The first position is repeated as -0 which
+	// has to deduplicate with 0
+	std::string WriteShuffledGrid()
+	{
+		const std::string filepath = (std::filesystem::temp_directory_path() / "ObjImporterTests.obj").string();
+		std::ofstream file(filepath, std::ios::trunc);
+		for (uint32_t y = 0; y <= s_GridSize; ++y)
+		{
+			for (uint32_t x = 0; x <= s_GridSize; ++x)
+			{
+				file << "v " << x << ' ' << y << " 0\n";
+			}
+		}
+		file << "v -0 -0 0\n";
+		const uint32_t negativeZero = (s_GridSize + 1) * (s_GridSize + 1) + 1;
+		for (uint32_t y = 0; y <= s_GridSize; ++y)
+		{
+			for (uint32_t x = 0; x <= s_GridSize; ++x)
+			{
+				file << "vt " << static_cast<float>(x) / s_GridSize << ' ' << static_cast<float>(y) / s_GridSize << '\n';
+			}
+		}
+		file << "vt 0.5 0.5\n";
+		const uint32_t seamTexCoord = (s_GridSize + 1) * (s_GridSize + 1) + 1;
+
+		std::vector<std::array<uint32_t, 6>> faces; // position / texture coordinate pairs, 1 based
+		for (uint32_t y = 0; y < s_GridSize; ++y)
+		{
+			for (uint32_t x = 0; x < s_GridSize; ++x)
+			{
+				const uint32_t corner = y * (s_GridSize + 1) + x + 1;
+				const uint32_t a = corner == 1 ? negativeZero : corner;
+				const uint32_t b = corner + 1;
+				const uint32_t c = corner + s_GridSize + 2;
+				const uint32_t d = corner + s_GridSize + 1;
+				const bool seam = (y * s_GridSize + x) % s_SeamInterval == 0;
+				faces.push_back({ a, seam ? seamTexCoord : corner, b, seam ? seamTexCoord : b, c, seam ? seamTexCoord : c });
+				faces.push_back({ a, seam ? seamTexCoord : corner, c, seam ? seamTexCoord : c, d, seam ? seamTexCoord : d });
+			}
+		}
+		std::mt19937 random(1234);
+		std::shuffle(faces.begin(), faces.end(), random);
+		for (const std::array<uint32_t, 6>& face : faces)
+		{
+			file << "f " << face[0] << '/' << face[1] << ' ' << face[2] << '/' << face[3] << ' ' << face[4] << '/' << face[5] << '\n';
+		}
+		return filepath;
+	}
+
+	struct JobSystemScope
+	{
+		explicit JobSystemScope(uint32_t workerCount) { JobSystem::Init(workerCount); }
+		~JobSystemScope() { JobSystem::Shutdown(); }
+	};
+
+	bool IsSameBytes(const MeshData& a, const MeshData& b)
+	{
+		return a.Vertices.size() == b.Vertices.size() && a.Indices.size() == b.Indices.size() &&
+			std::memcmp(a.Vertices.data(), b.Vertices.data(), sizeof(Vertex) * a.Vertices.size()) == 0 &&
+			std::memcmp(a.Indices.data(), b.Indices.data(), sizeof(uint32_t) * a.Indices.size()) == 0;
+	}
+}
+
+VKE_TEST(ObjImporter, ParallelMatchesSerialAtEveryWorkerCount)
+{
+	const std::string filepath = WriteShuffledGrid();
+	const MeshData serial = ObjImporter::Import(filepath, ObjDeduplication::Serial);
+	VKE_CHECK(serial.Indices.size() == 6 * s_GridSize * s_GridSize);
+	VKE_CHECK(serial.Vertices.size() > (s_GridSize + 1) * (s_GridSize + 1)); // the seams add vertices
+	VKE_CHECK(serial.Vertices.size() < serial.Indices.size() / 2); // and most are shared
+
+	for (const uint32_t workerCount : { 1u, 2u, 0u }) // 0: one per hardware thread
+	{
+		const JobSystemScope jobSystem(workerCount);
+		const MeshData parallel = ObjImporter::Import(filepath, ObjDeduplication::Parallel);
+		const MeshData automatic = ObjImporter::Import(filepath, ObjDeduplication::Auto);
+		VKE_CHECK(IsSameBytes(serial, parallel));
+		VKE_CHECK(IsSameBytes(serial, automatic));
+	}
+	std::error_code error;
+	std::filesystem::remove(filepath, error);
+}
@@ -0,0 +1,382 @@
+/***************************************************************************
+ * Filename		: ShaderReflectionTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Sets, bindings, push constant blocks and vertex inputs read
+ *				  from the engine's compiled shaders, and their merge per pipeline.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Pipeline/Shaders/ShaderLibrary.h"
+#include "Core/Logger/Log.h"
+
+#include <filesystem>
+#include <initializer_list>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	// the tests run from their project directory, paths are relative to it like the engine's
+	const std::string s_ShaderDirectory = "../Resources/Shaders/SPV/";
+
+	ShaderReflection Reflect(const std::vector<uint32_t>& code)
+	{
+		return ShaderReflection(code.data(), code.size());
+	}
+
+	ShaderReflection LoadReflection(const std::string& name)
+	{
+		return Reflect(Shader::ReadSpirv(s_ShaderDirectory + name));
+	}
+
+	// the shaders the engine can run without aren't checked in compiled, Compile_GLSL_to_SPV.bat builds them
+	bool AreCompiled(std::initializer_list<const char*> names)
+	{
+		return std::all_of(names.begin(), names.end(), [](const char* name) { return std::filesystem::exists(s_ShaderDirectory + name); });
+	}
+
+	bool IsBinding(const ShaderBinding& binding, uint32_t set, uint32_t index, VkDescriptorType type, uint32_t count)
+	{
+		return binding.Set == set && binding.Binding == index && binding.Type == type && binding.Count == count;
+	}
+
+	bool IsLayoutBinding(const ShaderInterface& shaderInterface, uint32_t set, uint32_t binding, VkDescriptorType type, uint32_t count, VkShaderStageFlags stages)
+	{
+		const auto bindings = shaderInterface.Sets.find(set);
+		if (bindings == shaderInterface.Sets.end() || bindings->second.count(binding) == 0)
+		{
+			return false;
+		}
+		const VkDescriptorSetLayoutBinding& layoutBinding = bindings->second.at(binding);
+		return layoutBinding.binding == binding && layoutBinding.descriptorType == type && layoutBinding.descriptorCount == count && layoutBinding.stageFlags == stages;
+	}
+
+	// a module of only the declarations reflection reads, no function bodies, so a test can put a binding or block exactly where it needs one
+	class SpirvBuilder
+	{
+	public:
+		explicit SpirvBuilder(uint32_t executionModel)
+		{
+			m_Code = { 0x07230203, 0x00010000, 0, 0, 0 };
+			Emit(15, { executionModel, NewId(), 0x6e69616d, 0 }); // OpEntryPoint %main "main"
+			m_Float = NewId();
+			Emit(22, { m_Float, 32 }); // OpTypeFloat
+			m_Uint = NewId();
+			Emit(21, { m_Uint, 32, 0 }); // OpTypeInt unsigned
+		}
+	public:
+		// a block whose only member is a float ending at size bytes
+		void AddBuffer(uint32_t set, uint32_t binding, uint32_t size, bool storage)
+		{
+			const uint32_t block = AddBlock(size, storage ? 3 : 2); // BufferBlock / Block
+			AddVariable(block, 2, set, binding); // Uniform
+		}
+
+		// count 1 is a single sampler2D, 0 a runtime sized array
+		void AddSampledImages(uint32_t set, uint32_t binding, uint32_t count)
+		{
+			const uint32_t image = NewId();
+			Emit(25, { image, m_Float, 1, 0, 0, 0, 1, 0 }); // OpTypeImage 2D, sampled
+			uint32_t type = NewId();
+			Emit(27, { type, image }); // OpTypeSampledImage
+			if (count == 0)
+			{
+				const uint32_t array = NewId();
+				Emit(29, { array, type }); // OpTypeRuntimeArray
+				type = array;
+			}
+			else if (count > 1)
+			{
+				const uint32_t length = NewId();
+				Emit(43, { m_Uint, length, count }); // OpConstant
+				const uint32_t array = NewId();
+				Emit(28, { array, type, length }); // OpTypeArray
+				type = array;
+			}
+			AddVariable(type, 0, set, binding); // UniformConstant
+		}
+
+		void AddPushConstants(uint32_t size)
+		{
+			const uint32_t block = AddBlock(size, 2);
+			const uint32_t pointer = NewId();
+			Emit(32, { pointer, 9, block }); // OpTypePointer PushConstant
+			Emit(59, { pointer, NewId(), 9 }); // OpVariable
+		}
+
+		std::vector<uint32_t> GetCode() const
+		{
+			std::vector<uint32_t> code = m_Code;
+			code[3] = m_NextId; // id bound
+			return code;
+		}
+	private:
+		uint32_t AddBlock(uint32_t size, uint32_t decoration)
+		{
+			const uint32_t block = NewId();
+			Emit(30, { block, m_Float }); // OpTypeStruct
+			Emit(71, { block, decoration }); // OpDecorate
+			Emit(72, { block, 0, 35, size - 4 }); // OpMemberDecorate Offset
+			return block;
+		}
+
+		void AddVariable(uint32_t type, uint32_t storageClass, uint32_t set, uint32_t binding)
+		{
+			const uint32_t pointer = NewId();
+			Emit(32, { pointer, storageClass, type }); // OpTypePointer
+			const uint32_t variable = NewId();
+			Emit(59, { pointer, variable, storageClass }); // OpVariable
+			Emit(71, { variable, 34, set }); // OpDecorate DescriptorSet
+			Emit(71, { variable, 33, binding }); // OpDecorate Binding
+		}
+
+		uint32_t NewId() { return m_NextId++; }
+
+		void Emit(uint32_t opcode, std::initializer_list<uint32_t> operands)
+		{
+			m_Code.push_back(static_cast<uint32_t>(operands.size() + 1) << 16 | opcode);
+			m_Code.insert(m_Code.end(), operands);
+		}
+	private:
+		std::vector<uint32_t> m_Code;
+		uint32_t m_NextId = 1;
+		uint32_t m_Float = 0;
+		uint32_t m_Uint = 0;
+	};
+}
+
+VKE_TEST(ShaderReflection, VertexShaders)
+{
+	// the camera's uniform buffer (model, view, projection). Compiled from the current Shader.vert it also pushes the model
+	// matrix per draw, the checked in binary predates that block
+	const ShaderReflection vertex = LoadReflection("Vert.spv");
+	VKE_CHECK(vertex.GetStage() == VK_SHADER_STAGE_VERTEX_BIT);
+	VKE_CHECK(vertex.GetBindings().size() == 1);
+	VKE_CHECK(IsBinding(vertex.GetBindings()[0], 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1));
+	VKE_CHECK(vertex.HasPushConstants() ? vertex.GetPushConstantSize() == 64 : vertex.GetPushConstantSize() == 0);
+	const std::vector<ShaderInput>& inputs = vertex.GetInputs();
+	VKE_CHECK(inputs.size() == 3);
+	VKE_CHECK(inputs[0].Location == 0 && inputs[0].Format == VK_FORMAT_R32G32B32_SFLOAT);
+	VKE_CHECK(inputs[1].Location == 1 && inputs[1].Format == VK_FORMAT_R32G32B32_SFLOAT);
+	VKE_CHECK(inputs[2].Location == 2 && inputs[2].Format == VK_FORMAT_R32G32_SFLOAT);
+}
+
+VKE_TEST(ShaderReflection, InstancedVertexInputs)
+{
+	if (!AreCompiled({ "Instanced.spv" }))
+	{
+		VK_WARN("[Tests]: Instanced vertex shader isn't compiled, skipping its reflection");
+		return;
+	}
+
+	// the instance's transform takes a location per column, its material id is an unsigned scalar
+	const ShaderReflection instanced = LoadReflection("Instanced.spv");
+	VKE_CHECK(instanced.GetStage() == VK_SHADER_STAGE_VERTEX_BIT);
+	VKE_CHECK(instanced.GetBindings().size() == 1);
+	VKE_CHECK(IsBinding(instanced.GetBindings()[0], 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1));
+	VKE_CHECK(!instanced.HasPushConstants() && instanced.GetPushConstantSize() == 0);
+	const std::vector<ShaderInput>& instanceInputs = instanced.GetInputs();
+	VKE_CHECK(instanceInputs.size() == 8);
+	for (uint32_t location = 0; location < instanceInputs.size(); ++location)
+	{
+		VKE_CHECK(instanceInputs[location].Location == location);
+	}
+	for (uint32_t column = 3; column < 7; ++column)
+	{
+		VKE_CHECK(instanceInputs[column].Format == VK_FORMAT_R32G32B32A32_SFLOAT);
+	}
+	VKE_CHECK(instanceInputs[7].Format == VK_FORMAT_R32_UINT);
+}
+
+VKE_TEST(ShaderReflection, FragmentBindings)
+{
+	// inputs of later stages come from the stage before, they are no vertex attributes
+	const ShaderReflection fragment = LoadReflection("Frag.spv");
+	VKE_CHECK(fragment.GetStage() == VK_SHADER_STAGE_FRAGMENT_BIT);
+	VKE_CHECK(fragment.GetBindings().size() == 1);
+	VKE_CHECK(IsBinding(fragment.GetBindings()[0], 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1));
+	VKE_CHECK(fragment.GetInputs().empty() && !fragment.HasPushConstants());
+}
+
+VKE_TEST(ShaderReflection, BindlessBindings)
+{
+	// the engine draws with the classic descriptor set without it
+	if (!AreCompiled({ "Bindless.spv" }))
+	{
+		VK_WARN("[Tests]: Bindless fragment shader isn't compiled, skipping its reflection");
+		return;
+	}
+
+	// the material set, a runtime sized texture array and a BufferBlock struct (a storage buffer in SPIR-V 1.0)
+	const ShaderReflection bindless = LoadReflection("Bindless.spv");
+	VKE_CHECK(bindless.GetStage() == VK_SHADER_STAGE_FRAGMENT_BIT);
+	VKE_CHECK(bindless.GetBindings().size() == 2);
+	VKE_CHECK(IsBinding(bindless.GetBindings()[0], 1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0));
+	VKE_CHECK(IsBinding(bindless.GetBindings()[1], 1, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1));
+}
+
+VKE_TEST(ShaderReflection, ComputeBindings)
+{
+	// the engine culls on the cpu without them
+	if (!AreCompiled({ "Cull.spv", "DepthPyramid.spv", "DepthPyramidMS.spv" }))
+	{
+		VK_WARN("[Tests]: Culling shaders aren't compiled, skipping their reflection");
+		return;
+	}
+
+	const ShaderReflection cull = LoadReflection("Cull.spv");
+	VKE_CHECK(cull.GetStage() == VK_SHADER_STAGE_COMPUTE_BIT);
+	VKE_CHECK(cull.GetBindings().size() == 3);
+	VKE_CHECK(IsBinding(cull.GetBindings()[0], 0, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1));
+	VKE_CHECK(IsBinding(cull.GetBindings()[1], 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1));
+	VKE_CHECK(IsBinding(cull.GetBindings()[2], 0, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1));
+	VKE_CHECK(cull.GetInputs().empty());
+
+	// source and destination sizes (ivec2 each) and the sample count, the same block in both variants
+	for (const char* name : { "DepthPyramid.spv", "DepthPyramidMS.spv" })
+	{
+		const ShaderReflection depthPyramid = LoadReflection(name);
+		VKE_CHECK(depthPyramid.GetStage() == VK_SHADER_STAGE_COMPUTE_BIT);
+		VKE_CHECK(depthPyramid.GetBindings().size() == 2);
+		VKE_CHECK(IsBinding(depthPyramid.GetBindings()[0], 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1));
+		VKE_CHECK(IsBinding(depthPyramid.GetBindings()[1], 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1));
+		VKE_CHECK(depthPyramid.GetPushConstantSize() == 20);
+	}
+}
+
+VKE_TEST(ShaderReflection, ArraysAndBlockSizes)
+{
+	SpirvBuilder builder(4); // Fragment
+	builder.AddSampledImages(2, 3, 8);
+	builder.AddSampledImages(0, 5, 0);
+	builder.AddBuffer(2, 0, 100, false);
+	builder.AddBuffer(1, 7, 36, true);
+	builder.AddPushConstants(52);
+	const ShaderReflection reflection = Reflect(builder.GetCode());
+
+	// ordered by set then binding whatever the order of declaration
+	const std::vector<ShaderBinding>& bindings = reflection.GetBindings();
+	VKE_CHECK(bindings.size() == 4);
+	VKE_CHECK(IsBinding(bindings[0], 0, 5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0));
+	VKE_CHECK(IsBinding(bindings[1], 1, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1));
+	VKE_CHECK(IsBinding(bindings[2], 2, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1));
+	VKE_CHECK(IsBinding(bindings[3], 2, 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 8));
+	// the block ends at its last member's offset plus size
+	VKE_CHECK(reflection.GetStage() == VK_SHADER_STAGE_FRAGMENT_BIT && reflection.GetPushConstantSize() == 52);
+}
+
+VKE_TEST(ShaderReflection, RejectsMalformedCode)
+{
+	const std::vector<uint32_t> code = Shader::ReadSpirv(s_ShaderDirectory + "Vert.spv");
+	VKE_CHECK_THROWS(Reflect({}));
+	VKE_CHECK_THROWS(Reflect(std::vector<uint32_t>(code.begin(), code.begin() + 4))); // shorter than the header
+	VKE_CHECK_THROWS(Reflect({ 0x03022307, 0x00010000, 0, 1, 0 })); // byte swapped magic
+	VKE_CHECK_THROWS(Shader::ReadSpirv(s_ShaderDirectory + "Missing.spv"));
+
+	// an instruction running past the end, and one of zero words that would never advance
+	std::vector<uint32_t> truncated = code;
+	truncated[5] = (0xFFFFu << 16) | (truncated[5] & 0xFFFF);
+	VKE_CHECK_THROWS(Reflect(truncated));
+	std::vector<uint32_t> empty = code;
+	empty[5] &= 0xFFFF;
+	VKE_CHECK_THROWS(Reflect(empty));
+
+	// the header alone is a module without an interface
+	const ShaderReflection header = Reflect(std::vector<uint32_t>(code.begin(), code.begin() + 5));
+	VKE_CHECK(header.GetBindings().empty() && header.GetInputs().empty() && !header.HasPushConstants());
+}
+
+VKE_TEST(ShaderReflection, MergesStagesPerPipeline)
+{
+	// the engine's own pipeline, a uniform buffer for the vertex stage and a texture for the fragment stage
+	const ShaderReflection vertex = LoadReflection("Vert.spv");
+	const ShaderReflection fragment = LoadReflection("Frag.spv");
+	const ShaderInterface forward = ShaderLibrary::MergeReflections({ &vertex, &fragment });
+	VKE_CHECK(forward.Sets.size() == 1 && forward.Sets.at(0).size() == 2);
+	VKE_CHECK(IsLayoutBinding(forward, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT));
+	VKE_CHECK(IsLayoutBinding(forward, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT));
+	const VkShaderStageFlags pushStages = vertex.HasPushConstants() ? VK_SHADER_STAGE_VERTEX_BIT : 0;
+	VKE_CHECK(forward.PushConstantRange.stageFlags == pushStages && forward.PushConstantRange.offset == 0 && forward.PushConstantRange.size == vertex.GetPushConstantSize());
+
+	// uniform buffers only, the bindless storage buffer keeps its type. Stand-ins for Instanced.vert (the camera's block)
+	// and Bindless.frag (the texture array and the materials)
+	SpirvBuilder instancedBuilder(0); // Vertex
+	instancedBuilder.AddBuffer(0, 0, 192, false);
+	SpirvBuilder bindlessBuilder(4); // Fragment
+	bindlessBuilder.AddSampledImages(1, 0, 0);
+	bindlessBuilder.AddBuffer(1, 1, 16, true);
+	const ShaderReflection instanced = Reflect(instancedBuilder.GetCode());
+	const ShaderReflection bindless = Reflect(bindlessBuilder.GetCode());
+	const ShaderInterface bindlessInterface = ShaderLibrary::MergeReflections({ &instanced, &bindless }, true);
+	VKE_CHECK(bindlessInterface.Sets.size() == 2);
+	VKE_CHECK(IsLayoutBinding(bindlessInterface, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_VERTEX_BIT));
+	VKE_CHECK(IsLayoutBinding(bindlessInterface, 1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, VK_SHADER_STAGE_FRAGMENT_BIT));
+	VKE_CHECK(IsLayoutBinding(bindlessInterface, 1, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT));
+	VKE_CHECK(bindlessInterface.PushConstantRange.stageFlags == 0);
+
+	// a binding both stages use gets both stage flags and the larger array, a runtime array stays runtime sized
+	SpirvBuilder vertexBuilder(0);
+	vertexBuilder.AddBuffer(0, 0, 64, false);
+	vertexBuilder.AddSampledImages(0, 1, 2);
+	vertexBuilder.AddSampledImages(0, 2, 0);
+	vertexBuilder.AddPushConstants(80);
+	SpirvBuilder fragmentBuilder(4);
+	fragmentBuilder.AddBuffer(0, 0, 128, false);
+	fragmentBuilder.AddSampledImages(0, 1, 4);
+	fragmentBuilder.AddSampledImages(0, 2, 16);
+	fragmentBuilder.AddPushConstants(96);
+	const ShaderReflection vertexStage = Reflect(vertexBuilder.GetCode());
+	const ShaderReflection fragmentStage = Reflect(fragmentBuilder.GetCode());
+	const VkShaderStageFlags bothStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+	for (const ShaderInterface& shared : { ShaderLibrary::MergeReflections({ &vertexStage, &fragmentStage }), ShaderLibrary::MergeReflections({ &fragmentStage, &vertexStage }) })
+	{
+		VKE_CHECK(shared.Sets.size() == 1 && shared.Sets.at(0).size() == 3);
+		VKE_CHECK(IsLayoutBinding(shared, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, bothStages));
+		VKE_CHECK(IsLayoutBinding(shared, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4, bothStages));
+		VKE_CHECK(IsLayoutBinding(shared, 0, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, bothStages));
+		// one range over the largest block, visible to every stage declaring one
+		VKE_CHECK(shared.PushConstantRange.stageFlags == bothStages && shared.PushConstantRange.size == 96);
+	}
+}
+
+VKE_TEST(ShaderReflection, ConflictingStagesThrow)
+{
+	// binding 0 is the camera's uniform buffer in one and a storage buffer in the other, like Cull.comp's objects
+	const ShaderReflection vertex = LoadReflection("Vert.spv");
+	const ShaderReflection fragment = LoadReflection("Frag.spv");
+	SpirvBuilder cullBuilder(5); // GLCompute
+	cullBuilder.AddBuffer(0, 0, 48, true);
+	cullBuilder.AddBuffer(0, 1, 20, true);
+	cullBuilder.AddSampledImages(0, 2, 1);
+	const ShaderReflection cull = Reflect(cullBuilder.GetCode());
+	VKE_CHECK_THROWS(ShaderLibrary::MergeReflections({ &vertex, &cull }));
+	VKE_CHECK_THROWS(ShaderLibrary::MergeReflections({ &cull, &fragment })); // binding 1, storage buffer and texture
+
+	// a texture where the other stage has a uniform buffer, in the same set
+	SpirvBuilder vertexBuilder(0);
+	vertexBuilder.AddBuffer(3, 2, 16, false);
+	SpirvBuilder fragmentBuilder(4);
+	fragmentBuilder.AddSampledImages(3, 2, 1);
+	const ShaderReflection vertexStage = Reflect(vertexBuilder.GetCode());
+	const ShaderReflection fragmentStage = Reflect(fragmentBuilder.GetCode());
+	VKE_CHECK_THROWS(ShaderLibrary::MergeReflections({ &vertexStage, &fragmentStage }));
+
+	// the same binding number in another set is no conflict
+	SpirvBuilder otherSetBuilder(4);
+	otherSetBuilder.AddSampledImages(4, 2, 1);
+	const ShaderReflection otherSet = Reflect(otherSetBuilder.GetCode());
+	const ShaderInterface merged = ShaderLibrary::MergeReflections({ &vertexStage, &otherSet });
+	VKE_CHECK(IsLayoutBinding(merged, 3, 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT));
+	VKE_CHECK(IsLayoutBinding(merged, 4, 2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT));
+}
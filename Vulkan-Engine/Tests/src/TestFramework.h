@@ -0,0 +1,69 @@
+/***************************************************************************
+ * Filename		: TestFramework.h
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Minimal self registering test cases for the cpu side of the
+ *				  engine, run by the Tests project without a gpu.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Vulkan_Engine
+{
+	namespace Tests
+	{
+		struct TestCase
+		{
+			const char* Suite;
+			const char* Name;
+			void (*Function)();
+		};
+
+		// thrown by a failed check, ends the test case it was thrown from
+		class TestFailure : public std::runtime_error
+		{
+		public:
+			explicit TestFailure(const std::string& message) : std::runtime_error(message) {}
+		};
+
+		inline std::vector<TestCase>& GetTestCases()
+		{
+			static std::vector<TestCase> testCases; // filled by static registrars before main
+			return testCases;
+		}
+
+		struct TestRegistrar
+		{
+			TestRegistrar(const char* suite, const char* name, void (*function)()) { GetTestCases().push_back({ suite, name, function }); }
+		};
+
+		[[noreturn]] inline void Fail(const char* expression, const char* file, int line)
+		{
+			throw TestFailure(std::string(file) + "(" + std::to_string(line) + "): " + expression);
+		}
+	}
+}
+
+#define VKE_TEST(suite, name) \
+	static void suite##_##name(); \
+	static const ::Vulkan_Engine::Tests::TestRegistrar s_##suite##_##name##_Registrar(#suite, #name, &suite##_##name); \
+	static void suite##_##name()
+
+#define VKE_CHECK(expression) { if (!(expression)) { ::Vulkan_Engine::Tests::Fail(#expression, __FILE__, __LINE__); } }
+#define VKE_CHECK_THROWS(expression) \
+	{ \
+		bool threw = false; \
+		try { expression; } catch (const std::exception&) { threw = true; } \
+		if (!threw) { ::Vulkan_Engine::Tests::Fail("expected an exception from " #expression, __FILE__, __LINE__); } \
+	}
@@ -0,0 +1,54 @@
+/***************************************************************************
+ * Filename		: TestMain.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Runs every registered test case (or the ones matching the
+ *				  filter argument) and exits with a failure if any fails.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Logger/Log.h"
+#include "Core/Timers/Timer.h"
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Tests;
+
+int main(int argc, char** argv)
+{
+	Log::Init();
+	// Tests [filter], the filter is matched against "Suite.Name"
+	const std::string filter = argc > 1 ? argv[1] : "";
+	uint32_t passed = 0;
+	uint32_t failed = 0;
+	for (const TestCase& testCase : GetTestCases())
+	{
+		const std::string name = std::string(testCase.Suite) + "." + testCase.Name;
+		if (!filter.empty() && name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+		const Timer timer;
+		try
+		{
+			testCase.Function();
+			VK_INFO("[Tests]: {0} passed ({1:.3f}ms)", name, timer.GetMilliseconds());
+			++passed;
+		}
+		catch (const std::exception& e)
+		{
+			VK_ERROR("[Tests]: {0} failed -> {1}", name, e.what());
+			++failed;
+		}
+	}
+	VK_INFO("[Tests]: {0} passed, {1} failed", passed, failed);
+	return failed == 0 && passed > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,179 @@
+/***************************************************************************
+ * Filename		: VertexQuantizationTests.cpp
+ * Name			: Ori Lazar
+ * Date			: 18/10/2026
+ * Description	: Largest round trip error of the 16 byte vertex (position,
+ *				  octahedral normal, color and texcoord) and its simd paths.
+     .---.
+   .'_:___".
+   |__ --==|
+   [  ]  :[|
+   |__| I=[|
+   / / ____|
+  |-/.____.'
+ /___\ /___\
+***************************************************************************/
+#include "vkepch.h"
+#include "TestFramework.h"
+
+#include "Core/Graphics/Mesh/VertexKernels.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace Vulkan_Engine;
+using namespace Vulkan_Engine::Graphics;
+
+namespace
+{
+	constexpr uint32_t s_SampleCount = 100000;
+
+	// random vertices inside the bounds, with the corners of the bounds themselves at the front
+	std::vector<Vertex> CreateVertices(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint32_t count)
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::uniform_real_distribution<float> texCoord(-4.0f, 4.0f);
+		std::vector<Vertex> vertices(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vertex& vertex = vertices[i];
+			if (i < 8)
+			{
+				vertex.Position = glm::vec3(i & 1 ? boundsMax.x : boundsMin.x, i & 2 ? boundsMax.y : boundsMin.y, i & 4 ? boundsMax.z : boundsMin.z);
+			}
+			else
+			{
+				vertex.Position = boundsMin + (boundsMax - boundsMin) * glm::vec3(unit(random), unit(random), unit(random));
+			}
+			vertex.Color = glm::vec3(unit(random), unit(random), unit(random));
+			vertex.TexCoord = glm::vec2(texCoord(random), unit(random));
+		}
+		return vertices;
+	}
+
+	bool IsSameVertex(const QuantizedVertex& a, const QuantizedVertex& b)
+	{
+		return std::memcmp(&a, &b, sizeof(QuantizedVertex)) == 0;
+	}
+}
+
+VKE_TEST(VertexQuantization, PositionErrorWithinHalfStep)
+{
+	// off center and uneven bounds, the bias and scale differ per axis
+	const glm::vec3 boundsMin(-120.0f, 3.5f, -0.25f);
+	const glm::vec3 boundsMax(80.0f, 4.0f, 1000.0f);
+	const std::vector<Vertex> vertices = CreateVertices(boundsMin, boundsMax, s_SampleCount);
+	const PositionQuantization positionQuantization = VertexQuantization::ComputePositionQuantization(boundsMin, boundsMax);
+
+	glm::vec3 maxError(0.0f);
+	for (const Vertex& vertex : vertices)
+	{
+		const Vertex decoded = VertexQuantization::DequantizeVertex(VertexQuantization::QuantizeVertex(vertex, positionQuantization), positionQuantization);
+		maxError = glm::max(maxError, glm::abs(decoded.Position - vertex.Position));
+	}
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		// half a snorm16 step of the axis, plus the float rounding of the bias and scale
+		const float step = positionQuantization.Scale[axis] / 32767.0f;
+		const float rounding = 4.0f * std::numeric_limits<float>::epsilon() * (std::abs(positionQuantization.Bias[axis]) + positionQuantization.Scale[axis]);
+		VKE_CHECK(maxError[axis] <= 0.5f * step + rounding);
+		VKE_CHECK(maxError[axis] > 0.25f * step); // the samples do land between the steps
+	}
+
+	// a flat axis keeps the exact position
+	const PositionQuantization flat = VertexQuantization::ComputePositionQuantization(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(5.0f, 2.0f, 7.0f));
+	Vertex vertex = {};
+	vertex.Position = glm::vec3(4.0f, 2.0f, 6.0f);
+	VKE_CHECK(VertexQuantization::DequantizeVertex(VertexQuantization::QuantizeVertex(vertex, flat), flat).Position.y == 2.0f);
+}
+
+VKE_TEST(VertexQuantization, OctahedralNormalErrorBelowLimit)
+{
+	std::mt19937 random(7);
+	std::normal_distribution<float> gaussian(0.0f, 1.0f);
+	std::vector<glm::vec3> normals = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::normalize(glm::vec3(1.0f, -1.0f, -1.0f)), glm::normalize(glm::vec3(-1.0f, 1.0f, 0.0f))
+	};
+	for (uint32_t i = 0; i < s_SampleCount; ++i)
+	{
+		const glm::vec3 normal(gaussian(random), gaussian(random), gaussian(random)); // uniform on the sphere once normalized
+		if (glm::length(normal) > 0.001f)
+		{
+			normals.push_back(glm::normalize(normal));
+		}
+	}
+
+	double maxAngle = 0.0;
+	for (const glm::vec3& normal : normals)
+	{
+		const glm::vec3 decoded = VertexQuantization::DecodeOctahedral(VertexQuantization::EncodeOctahedral(normal));
+		VKE_CHECK(std::abs(glm::length(decoded) - 1.0f) < 1e-5f);
+		// atan2 of the cross and dot product stays accurate for tiny angles where acos does not
+		const glm::vec3 cross = glm::cross(normal, decoded);
+		maxAngle = std::max(maxAngle, std::atan2(static_cast<double>(glm::length(cross)), static_cast<double>(glm::dot(normal, decoded))));
+	}
+	VKE_CHECK(maxAngle < 0.0001);
+
+	const glm::vec3 zero = VertexQuantization::DecodeOctahedral(VertexQuantization::EncodeOctahedral(glm::vec3(0.0f)));
+	VKE_CHECK(zero == glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+VKE_TEST(VertexQuantization, TexCoordAndColorErrorWithinRounding)
+{
+	const std::vector<Vertex> vertices = CreateVertices(glm::vec3(-1.0f), glm::vec3(1.0f), s_SampleCount);
+	const PositionQuantization positionQuantization;
+	float maxRelativeTexCoordError = 0.0f;
+	float maxColorError = 0.0f;
+	for (const Vertex& vertex : vertices)
+	{
+		const Vertex decoded = VertexQuantization::DequantizeVertex(VertexQuantization::QuantizeVertex(vertex, positionQuantization), positionQuantization);
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			// below 2^-14 half is denormal, its spacing is absolute (2^-24)
+			const float magnitude = std::max(std::abs(vertex.TexCoord[axis]), std::ldexp(1.0f, -14));
+			maxRelativeTexCoordError = std::max(maxRelativeTexCoordError, std::abs(decoded.TexCoord[axis] - vertex.TexCoord[axis]) / magnitude);
+		}
+		const glm::vec3 colorError = glm::abs(decoded.Color - vertex.Color);
+		maxColorError = std::max({ maxColorError, colorError.x, colorError.y, colorError.z });
+	}
+	VKE_CHECK(maxRelativeTexCoordError <= std::ldexp(1.0f, -11));
+	VKE_CHECK(maxColorError <= 0.5f / 255.0f + 1e-6f);
+
+	// the [0, 1] range a texture usually samples keeps 2^-12 absolute accuracy at worst
+	for (uint32_t i = 0; i <= 4096; ++i)
+	{
+		const float value = static_cast<float>(i) / 4096.0f + std::ldexp(1.0f, -14);
+		VKE_CHECK(std::abs(VertexQuantization::HalfToFloat(VertexQuantization::FloatToHalf(value)) - value) <= std::ldexp(1.0f, -12));
+	}
+	VKE_CHECK(VertexQuantization::HalfToFloat(VertexQuantization::FloatToHalf(65504.0f)) == 65504.0f);
+	VKE_CHECK(std::isinf(VertexQuantization::HalfToFloat(VertexQuantization::FloatToHalf(65520.0f))));
+}
+
+VKE_TEST(VertexQuantization, SimdPathsMatchScalar)
+{
+	// an odd count so every simd path also runs its scalar tail
+	const glm::vec3 boundsMin(-3.0f, -50.0f, 10.0f);
+	const glm::vec3 boundsMax(7.0f, 50.0f, 10.5f);
+	const std::vector<Vertex> vertices = CreateVertices(boundsMin, boundsMax, 10007);
+	const PositionQuantization positionQuantization = VertexQuantization::ComputePositionQuantization(boundsMin, boundsMax);
+	std::vector<QuantizedVertex> scalar(vertices.size());
+	VertexKernels::QuantizeVertices(vertices.data(), vertices.size(), positionQuantization, scalar.data(), SimdLevel::Scalar);
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		VKE_CHECK(IsSameVertex(scalar[i], VertexQuantization::QuantizeVertex(vertices[i], positionQuantization)));
+	}
+
+	// levels above the cpu's are clamped, so this runs whatever the machine supports
+	for (const SimdLevel level : { SimdLevel::SSE41, SimdLevel::AVX2 })
+	{
+		std::vector<QuantizedVertex> simd(vertices.size());
+		VertexKernels::QuantizeVertices(vertices.data(), vertices.size(), positionQuantization, simd.data(), level);
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			VKE_CHECK(IsSameVertex(scalar[i], simd[i]));
+		}
+	}
+}
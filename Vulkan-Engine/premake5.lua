@@ -93,4 +93,205 @@ project "Engine"
 	filter "configurations:Release"
 		defines "VKE_RELEASE"
 		runtime "Release"
-		optimize "on"
\ No newline at end of file
+		optimize "on"
+
+-- Offline OBJ -> .vkmesh converter, shares the engine's mesh code
+project "MeshConverter"
+	location "MeshConverter"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("Bin/Output/" .. outputdir .. "/%{prj.name}")
+	objdir ("Bin/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.cpp",
+		"Engine/src/Core/Logger/Log.cpp",
+		"Engine/src/Core/IO/MappedFile.cpp",
+		"Engine/src/Core/Jobs/JobSystem.cpp",
+		"Engine/src/Core/Utility/CpuFeatures.cpp",
+		"Engine/src/Core/Graphics/Mesh/**.h",
+		"Engine/src/Core/Graphics/Mesh/**.cpp"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	includedirs
+	{
+		"Engine/src",
+		"Engine/Dependencies/spdlog/include",
+		"%{IncludeDir.glm}",
+		"C:/VulkanSDK/1.1.130.0/Include", -- vertex layout types only, nothing is linked
+		"Engine/Dependencies/TOL"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"VKE_PLATFORM_WINDOWS"
+		}
+
+	filter "configurations:Debug"
+		defines "VKE_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "VKE_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+-- Cpu tests of the engine's bookkeeping, mocks stand in for the device so no gpu is needed
+project "Tests"
+	location "Tests"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("Bin/Output/" .. outputdir .. "/%{prj.name}")
+	objdir ("Bin/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp",
+		"Engine/src/Core/Logger/Log.cpp",
+		"Engine/src/Core/Graphics/Memory/BuddyAllocator.cpp",
+		"Engine/src/Core/Graphics/Memory/DeviceMemoryAllocator.cpp",
+		"Engine/src/Core/IO/MappedFile.cpp",
+		"Engine/src/Core/Jobs/JobSystem.cpp",
+		"Engine/src/Core/Utility/CpuFeatures.cpp",
+		"Engine/src/Core/Graphics/Mesh/**.cpp",
+		"Engine/src/Core/Graphics/Culling/Frustum.cpp",
+		"Engine/src/Core/Graphics/Culling/FrustumCuller.cpp",
+		"Engine/src/Core/Scene/Bvh.cpp",
+		"Engine/src/Core/Graphics/Commands/InstanceBatcher.cpp",
+		"Engine/src/Core/Graphics/Descriptors/DescriptorLayoutCache.cpp",
+		"Engine/src/Core/Graphics/Pipeline/Shaders/Shader.cpp",
+		"Engine/src/Core/Graphics/Pipeline/Shaders/ShaderLibrary.cpp",
+		"Engine/src/Core/Graphics/Pipeline/Shaders/ShaderReflection.cpp"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	includedirs
+	{
+		"Engine/src",
+		"Engine/Dependencies/spdlog/include",
+		"%{IncludeDir.glm}",
+		"C:/VulkanSDK/1.1.130.0/Include",
+		"Engine/Dependencies/TOL"
+	}
+
+	-- the device callbacks of the allocators and the shader / layout objects reference the loader, the tests never call into it
+	libdirs 
+	{
+		"C:/VulkanSDK/1.1.130.0/Lib"
+	}
+	links
+	{
+		"vulkan-1.lib"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"VKE_PLATFORM_WINDOWS"
+		}
+
+	filter "configurations:Debug"
+		defines "VKE_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "VKE_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+-- Cpu benchmarks of engine systems, run the Release configuration for meaningful numbers
+project "Benchmarks"
+	location "Benchmarks"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("Bin/Output/" .. outputdir .. "/%{prj.name}")
+	objdir ("Bin/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp",
+		"Engine/src/Core/Logger/Log.cpp",
+		"Engine/src/Core/Jobs/JobSystem.cpp",
+		"Engine/src/Core/Utility/CpuFeatures.cpp",
+		"Engine/src/Core/Graphics/Culling/Frustum.cpp",
+		"Engine/src/Core/Graphics/Culling/FrustumCuller.cpp",
+		"Engine/src/Core/Scene/Bvh.cpp",
+		"Engine/src/Core/Graphics/Commands/DrawList.cpp",
+		"Engine/src/Core/Graphics/Commands/FrameCommandPool.cpp",
+		"Engine/src/Core/Graphics/Commands/ParallelCommandRecorder.cpp",
+		"Engine/src/Core/Graphics/Memory/BuddyAllocator.cpp",
+		"Engine/src/Core/Graphics/Memory/DeviceMemoryAllocator.cpp",
+		"Engine/src/Core/Graphics/Memory/UniformRingBuffer.cpp",
+		"Engine/src/Core/Graphics/Pipeline/Shaders/Shader.cpp",
+		"Engine/src/Core/Graphics/Pipeline/Shaders/ShaderReflection.cpp"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	includedirs
+	{
+		"Engine/src",
+		"Engine/Dependencies/spdlog/include",
+		"%{IncludeDir.glm}",
+		"C:/VulkanSDK/1.1.130.0/Include",
+		"Engine/Dependencies/TOL"
+	}
+
+	-- the recording benchmarks run on a device without a window, they are skipped when there is none
+	libdirs 
+	{
+		"C:/VulkanSDK/1.1.130.0/Lib"
+	}
+	links
+	{
+		"vulkan-1.lib"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"VKE_PLATFORM_WINDOWS"
+		}
+
+	filter "configurations:Debug"
+		defines "VKE_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "VKE_RELEASE"
+		runtime "Release"
+		optimize "on"